@@ -0,0 +1,2400 @@
+#ifdef __SSE2__
+typedef long long int v2di __attribute__((vector_size(16)));
+#endif
+
+#if BSVEC_BITS == 512 && defined(__GFNI__) && defined(__AVX512VBMI__)
+#include <immintrin.h>
+#define BITSLICE_GFNI
+#endif
+
+#ifdef __SSE2__
+#include <immintrin.h>
+#define BITSLICE_NT
+
+/* Copy n (a multiple of 16) words from src to dst, both 64-byte
+   aligned, with non-temporal stores */
+static inline void BitSliceStream(uint32_t *dst, const uint32_t *src, int n)
+{
+  int i;
+
+#ifdef __AVX512F__
+  for (i = 0; i < n; i += 16)
+    _mm512_stream_si512((void *)(dst + i), _mm512_load_si512(src + i));
+#elif defined(__AVX__)
+  for (i = 0; i < n; i += 8)
+    _mm256_stream_si256((__m256i *)(dst + i), _mm256_load_si256((const __m256i *)(src + i)));
+#else
+  for (i = 0; i < n; i += 4)
+    _mm_stream_si128((__m128i *)(dst + i), _mm_load_si128((const __m128i *)(src + i)));
+#endif
+}
+#endif
+
+#ifdef __SSE2__
+
+/* Auto-generated by BitSliceK_sse2_print */
+static inline void BitSlice24_64(int slen, const uint64_t *src, int dlen, uint32_t *dst)
+{
+  int i;
+  uint64_t a;
+  union { uint64_t t[64]; v2di vt[32]; } u;
+  v2di va;
+  static const v2di bsmask128[6] = {
+    { UINT64_C(0xaaaaaaaaaaaaaaaa), UINT64_C(0xaaaaaaaaaaaaaaaa) }, 
+    { UINT64_C(0xcccccccccccccccc), UINT64_C(0xcccccccccccccccc) }, 
+    { UINT64_C(0xf0f0f0f0f0f0f0f0), UINT64_C(0xf0f0f0f0f0f0f0f0) }, 
+    { UINT64_C(0xff00ff00ff00ff00), UINT64_C(0xff00ff00ff00ff00) }, 
+    { UINT64_C(0xffff0000ffff0000), UINT64_C(0xffff0000ffff0000) }, 
+    { UINT64_C(0xffffffff00000000), UINT64_C(0xffffffff00000000) }
+  };
+
+  memset(&u, 0, sizeof(u));
+  memcpy(u.t, src, slen*sizeof(uint64_t));
+  a = (u.t[0] ^ (u.t[1] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[0] ^= a;
+  u.t[1] ^= a >> 1;
+  a = (u.t[2] ^ (u.t[3] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[2] ^= a;
+  u.t[3] ^= a >> 1;
+  a = (u.t[4] ^ (u.t[5] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[4] ^= a;
+  u.t[5] ^= a >> 1;
+  a = (u.t[6] ^ (u.t[7] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[6] ^= a;
+  u.t[7] ^= a >> 1;
+  a = (u.t[8] ^ (u.t[9] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[8] ^= a;
+  u.t[9] ^= a >> 1;
+  a = (u.t[10] ^ (u.t[11] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[10] ^= a;
+  u.t[11] ^= a >> 1;
+  a = (u.t[12] ^ (u.t[13] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[12] ^= a;
+  u.t[13] ^= a >> 1;
+  a = (u.t[14] ^ (u.t[15] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[14] ^= a;
+  u.t[15] ^= a >> 1;
+  a = (u.t[16] ^ (u.t[17] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[16] ^= a;
+  u.t[17] ^= a >> 1;
+  a = (u.t[18] ^ (u.t[19] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[18] ^= a;
+  u.t[19] ^= a >> 1;
+  a = (u.t[20] ^ (u.t[21] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[20] ^= a;
+  u.t[21] ^= a >> 1;
+  a = (u.t[22] ^ (u.t[23] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[22] ^= a;
+  u.t[23] ^= a >> 1;
+    va = (u.vt[0] ^ __builtin_ia32_psllqi128(u.vt[1], 2)) & bsmask128[1];
+    u.vt[0] ^= va;
+    u.vt[1] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[2] ^ __builtin_ia32_psllqi128(u.vt[3], 2)) & bsmask128[1];
+    u.vt[2] ^= va;
+    u.vt[3] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[4] ^ __builtin_ia32_psllqi128(u.vt[5], 2)) & bsmask128[1];
+    u.vt[4] ^= va;
+    u.vt[5] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[6] ^ __builtin_ia32_psllqi128(u.vt[7], 2)) & bsmask128[1];
+    u.vt[6] ^= va;
+    u.vt[7] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[8] ^ __builtin_ia32_psllqi128(u.vt[9], 2)) & bsmask128[1];
+    u.vt[8] ^= va;
+    u.vt[9] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[10] ^ __builtin_ia32_psllqi128(u.vt[11], 2)) & bsmask128[1];
+    u.vt[10] ^= va;
+    u.vt[11] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[12] ^ __builtin_ia32_psllqi128(u.vt[13], 2)) & bsmask128[1];
+    u.vt[12] ^= va;
+    u.vt[13] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[14] ^ __builtin_ia32_psllqi128(u.vt[15], 2)) & bsmask128[1];
+    u.vt[14] ^= va;
+    u.vt[15] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[0] ^ __builtin_ia32_psllqi128(u.vt[2], 4)) & bsmask128[2];
+    u.vt[0] ^= va;
+    u.vt[2] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[1] ^ __builtin_ia32_psllqi128(u.vt[3], 4)) & bsmask128[2];
+    u.vt[1] ^= va;
+    u.vt[3] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[4] ^ __builtin_ia32_psllqi128(u.vt[6], 4)) & bsmask128[2];
+    u.vt[4] ^= va;
+    u.vt[6] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[5] ^ __builtin_ia32_psllqi128(u.vt[7], 4)) & bsmask128[2];
+    u.vt[5] ^= va;
+    u.vt[7] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[8] ^ __builtin_ia32_psllqi128(u.vt[10], 4)) & bsmask128[2];
+    u.vt[8] ^= va;
+    u.vt[10] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[9] ^ __builtin_ia32_psllqi128(u.vt[11], 4)) & bsmask128[2];
+    u.vt[9] ^= va;
+    u.vt[11] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[12] ^ __builtin_ia32_psllqi128(u.vt[14], 4)) & bsmask128[2];
+    u.vt[12] ^= va;
+    u.vt[14] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[13] ^ __builtin_ia32_psllqi128(u.vt[15], 4)) & bsmask128[2];
+    u.vt[13] ^= va;
+    u.vt[15] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[0] ^ __builtin_ia32_psllqi128(u.vt[4], 8)) & bsmask128[3];
+    u.vt[0] ^= va;
+    u.vt[4] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[1] ^ __builtin_ia32_psllqi128(u.vt[5], 8)) & bsmask128[3];
+    u.vt[1] ^= va;
+    u.vt[5] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[2] ^ __builtin_ia32_psllqi128(u.vt[6], 8)) & bsmask128[3];
+    u.vt[2] ^= va;
+    u.vt[6] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[3] ^ __builtin_ia32_psllqi128(u.vt[7], 8)) & bsmask128[3];
+    u.vt[3] ^= va;
+    u.vt[7] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[8] ^ __builtin_ia32_psllqi128(u.vt[12], 8)) & bsmask128[3];
+    u.vt[8] ^= va;
+    u.vt[12] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[9] ^ __builtin_ia32_psllqi128(u.vt[13], 8)) & bsmask128[3];
+    u.vt[9] ^= va;
+    u.vt[13] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[10] ^ __builtin_ia32_psllqi128(u.vt[14], 8)) & bsmask128[3];
+    u.vt[10] ^= va;
+    u.vt[14] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[11] ^ __builtin_ia32_psllqi128(u.vt[15], 8)) & bsmask128[3];
+    u.vt[11] ^= va;
+    u.vt[15] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[0] ^ __builtin_ia32_psllqi128(u.vt[8], 16)) & bsmask128[4];
+    u.vt[0] ^= va;
+    u.vt[8] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[1] ^ __builtin_ia32_psllqi128(u.vt[9], 16)) & bsmask128[4];
+    u.vt[1] ^= va;
+    u.vt[9] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[2] ^ __builtin_ia32_psllqi128(u.vt[10], 16)) & bsmask128[4];
+    u.vt[2] ^= va;
+    u.vt[10] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[3] ^ __builtin_ia32_psllqi128(u.vt[11], 16)) & bsmask128[4];
+    u.vt[3] ^= va;
+    u.vt[11] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[4] ^ __builtin_ia32_psllqi128(u.vt[12], 16)) & bsmask128[4];
+    u.vt[4] ^= va;
+    u.vt[12] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[5] ^ __builtin_ia32_psllqi128(u.vt[13], 16)) & bsmask128[4];
+    u.vt[5] ^= va;
+    u.vt[13] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[6] ^ __builtin_ia32_psllqi128(u.vt[14], 16)) & bsmask128[4];
+    u.vt[6] ^= va;
+    u.vt[14] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[7] ^ __builtin_ia32_psllqi128(u.vt[15], 16)) & bsmask128[4];
+    u.vt[7] ^= va;
+    u.vt[15] ^= __builtin_ia32_psrlqi128(va, 16);
+  for (i = 0; i < dlen; i++)
+    dst[i] = u.t[i & 0x1f] >> (i & 0xe0);
+}
+
+/* Auto-generated by BitSliceK_sse2_print */
+static inline void BitSlice24_64_nt(int slen, const uint64_t *src, int dlen, uint32_t *dst)
+{
+  int i;
+  uint64_t a;
+  union { uint64_t t[64]; v2di vt[32]; } u;
+  v2di va;
+  static const v2di bsmask128[6] = {
+    { UINT64_C(0xaaaaaaaaaaaaaaaa), UINT64_C(0xaaaaaaaaaaaaaaaa) }, 
+    { UINT64_C(0xcccccccccccccccc), UINT64_C(0xcccccccccccccccc) }, 
+    { UINT64_C(0xf0f0f0f0f0f0f0f0), UINT64_C(0xf0f0f0f0f0f0f0f0) }, 
+    { UINT64_C(0xff00ff00ff00ff00), UINT64_C(0xff00ff00ff00ff00) }, 
+    { UINT64_C(0xffff0000ffff0000), UINT64_C(0xffff0000ffff0000) }, 
+    { UINT64_C(0xffffffff00000000), UINT64_C(0xffffffff00000000) }
+  };
+
+  memset(&u, 0, sizeof(u));
+  memcpy(u.t, src, slen*sizeof(uint64_t));
+  a = (u.t[0] ^ (u.t[1] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[0] ^= a;
+  u.t[1] ^= a >> 1;
+  a = (u.t[2] ^ (u.t[3] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[2] ^= a;
+  u.t[3] ^= a >> 1;
+  a = (u.t[4] ^ (u.t[5] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[4] ^= a;
+  u.t[5] ^= a >> 1;
+  a = (u.t[6] ^ (u.t[7] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[6] ^= a;
+  u.t[7] ^= a >> 1;
+  a = (u.t[8] ^ (u.t[9] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[8] ^= a;
+  u.t[9] ^= a >> 1;
+  a = (u.t[10] ^ (u.t[11] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[10] ^= a;
+  u.t[11] ^= a >> 1;
+  a = (u.t[12] ^ (u.t[13] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[12] ^= a;
+  u.t[13] ^= a >> 1;
+  a = (u.t[14] ^ (u.t[15] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[14] ^= a;
+  u.t[15] ^= a >> 1;
+  a = (u.t[16] ^ (u.t[17] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[16] ^= a;
+  u.t[17] ^= a >> 1;
+  a = (u.t[18] ^ (u.t[19] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[18] ^= a;
+  u.t[19] ^= a >> 1;
+  a = (u.t[20] ^ (u.t[21] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[20] ^= a;
+  u.t[21] ^= a >> 1;
+  a = (u.t[22] ^ (u.t[23] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[22] ^= a;
+  u.t[23] ^= a >> 1;
+    va = (u.vt[0] ^ __builtin_ia32_psllqi128(u.vt[1], 2)) & bsmask128[1];
+    u.vt[0] ^= va;
+    u.vt[1] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[2] ^ __builtin_ia32_psllqi128(u.vt[3], 2)) & bsmask128[1];
+    u.vt[2] ^= va;
+    u.vt[3] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[4] ^ __builtin_ia32_psllqi128(u.vt[5], 2)) & bsmask128[1];
+    u.vt[4] ^= va;
+    u.vt[5] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[6] ^ __builtin_ia32_psllqi128(u.vt[7], 2)) & bsmask128[1];
+    u.vt[6] ^= va;
+    u.vt[7] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[8] ^ __builtin_ia32_psllqi128(u.vt[9], 2)) & bsmask128[1];
+    u.vt[8] ^= va;
+    u.vt[9] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[10] ^ __builtin_ia32_psllqi128(u.vt[11], 2)) & bsmask128[1];
+    u.vt[10] ^= va;
+    u.vt[11] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[12] ^ __builtin_ia32_psllqi128(u.vt[13], 2)) & bsmask128[1];
+    u.vt[12] ^= va;
+    u.vt[13] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[14] ^ __builtin_ia32_psllqi128(u.vt[15], 2)) & bsmask128[1];
+    u.vt[14] ^= va;
+    u.vt[15] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[0] ^ __builtin_ia32_psllqi128(u.vt[2], 4)) & bsmask128[2];
+    u.vt[0] ^= va;
+    u.vt[2] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[1] ^ __builtin_ia32_psllqi128(u.vt[3], 4)) & bsmask128[2];
+    u.vt[1] ^= va;
+    u.vt[3] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[4] ^ __builtin_ia32_psllqi128(u.vt[6], 4)) & bsmask128[2];
+    u.vt[4] ^= va;
+    u.vt[6] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[5] ^ __builtin_ia32_psllqi128(u.vt[7], 4)) & bsmask128[2];
+    u.vt[5] ^= va;
+    u.vt[7] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[8] ^ __builtin_ia32_psllqi128(u.vt[10], 4)) & bsmask128[2];
+    u.vt[8] ^= va;
+    u.vt[10] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[9] ^ __builtin_ia32_psllqi128(u.vt[11], 4)) & bsmask128[2];
+    u.vt[9] ^= va;
+    u.vt[11] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[12] ^ __builtin_ia32_psllqi128(u.vt[14], 4)) & bsmask128[2];
+    u.vt[12] ^= va;
+    u.vt[14] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[13] ^ __builtin_ia32_psllqi128(u.vt[15], 4)) & bsmask128[2];
+    u.vt[13] ^= va;
+    u.vt[15] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[0] ^ __builtin_ia32_psllqi128(u.vt[4], 8)) & bsmask128[3];
+    u.vt[0] ^= va;
+    u.vt[4] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[1] ^ __builtin_ia32_psllqi128(u.vt[5], 8)) & bsmask128[3];
+    u.vt[1] ^= va;
+    u.vt[5] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[2] ^ __builtin_ia32_psllqi128(u.vt[6], 8)) & bsmask128[3];
+    u.vt[2] ^= va;
+    u.vt[6] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[3] ^ __builtin_ia32_psllqi128(u.vt[7], 8)) & bsmask128[3];
+    u.vt[3] ^= va;
+    u.vt[7] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[8] ^ __builtin_ia32_psllqi128(u.vt[12], 8)) & bsmask128[3];
+    u.vt[8] ^= va;
+    u.vt[12] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[9] ^ __builtin_ia32_psllqi128(u.vt[13], 8)) & bsmask128[3];
+    u.vt[9] ^= va;
+    u.vt[13] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[10] ^ __builtin_ia32_psllqi128(u.vt[14], 8)) & bsmask128[3];
+    u.vt[10] ^= va;
+    u.vt[14] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[11] ^ __builtin_ia32_psllqi128(u.vt[15], 8)) & bsmask128[3];
+    u.vt[11] ^= va;
+    u.vt[15] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[0] ^ __builtin_ia32_psllqi128(u.vt[8], 16)) & bsmask128[4];
+    u.vt[0] ^= va;
+    u.vt[8] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[1] ^ __builtin_ia32_psllqi128(u.vt[9], 16)) & bsmask128[4];
+    u.vt[1] ^= va;
+    u.vt[9] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[2] ^ __builtin_ia32_psllqi128(u.vt[10], 16)) & bsmask128[4];
+    u.vt[2] ^= va;
+    u.vt[10] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[3] ^ __builtin_ia32_psllqi128(u.vt[11], 16)) & bsmask128[4];
+    u.vt[3] ^= va;
+    u.vt[11] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[4] ^ __builtin_ia32_psllqi128(u.vt[12], 16)) & bsmask128[4];
+    u.vt[4] ^= va;
+    u.vt[12] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[5] ^ __builtin_ia32_psllqi128(u.vt[13], 16)) & bsmask128[4];
+    u.vt[5] ^= va;
+    u.vt[13] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[6] ^ __builtin_ia32_psllqi128(u.vt[14], 16)) & bsmask128[4];
+    u.vt[6] ^= va;
+    u.vt[14] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[7] ^ __builtin_ia32_psllqi128(u.vt[15], 16)) & bsmask128[4];
+    u.vt[7] ^= va;
+    u.vt[15] ^= __builtin_ia32_psrlqi128(va, 16);
+  for (i = 0; i < 32 && i < dlen; i += 4)
+    _mm_stream_si128((__m128i *)(dst + i),
+                     (__m128i)_mm_shuffle_ps((__m128)u.vt[i/2], (__m128)u.vt[i/2 + 1], 0x88));
+  for (i = 32; i < dlen; i += 4)
+    _mm_stream_si128((__m128i *)(dst + i),
+                     (__m128i)_mm_shuffle_ps((__m128)u.vt[i/2 - 16], (__m128)u.vt[i/2 - 15], 0xdd));
+}
+
+#else
+
+/* Auto-generated by BitSliceK_print */
+static inline void BitSlice24_64(int slen, const uint64_t *src, int dlen, uint32_t *dst)
+{
+ uint64_t i, a, t[32];
+
+  memcpy(t, src, slen*sizeof(uint64_t));
+  memset(t+slen, 0, (32-slen)*sizeof(uint64_t));
+
+  a = (t[ 0] ^ (t[ 1] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 0] ^= a;
+  t[ 1] ^= a >>  1;
+  a = (t[ 2] ^ (t[ 3] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 2] ^= a;
+  t[ 3] ^= a >>  1;
+  a = (t[ 4] ^ (t[ 5] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 4] ^= a;
+  t[ 5] ^= a >>  1;
+  a = (t[ 6] ^ (t[ 7] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 6] ^= a;
+  t[ 7] ^= a >>  1;
+  a = (t[ 8] ^ (t[ 9] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 8] ^= a;
+  t[ 9] ^= a >>  1;
+  a = (t[10] ^ (t[11] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[10] ^= a;
+  t[11] ^= a >>  1;
+  a = (t[12] ^ (t[13] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[12] ^= a;
+  t[13] ^= a >>  1;
+  a = (t[14] ^ (t[15] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[14] ^= a;
+  t[15] ^= a >>  1;
+  a = (t[16] ^ (t[17] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[16] ^= a;
+  t[17] ^= a >>  1;
+  a = (t[18] ^ (t[19] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[18] ^= a;
+  t[19] ^= a >>  1;
+  a = (t[20] ^ (t[21] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[20] ^= a;
+  t[21] ^= a >>  1;
+  a = (t[22] ^ (t[23] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[22] ^= a;
+  t[23] ^= a >>  1;
+  a = (t[ 0] ^ (t[ 2] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 0] ^= a;
+  t[ 2] ^= a >>  2;
+  a = (t[ 1] ^ (t[ 3] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 1] ^= a;
+  t[ 3] ^= a >>  2;
+  a = (t[ 4] ^ (t[ 6] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 4] ^= a;
+  t[ 6] ^= a >>  2;
+  a = (t[ 5] ^ (t[ 7] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 5] ^= a;
+  t[ 7] ^= a >>  2;
+  a = (t[ 8] ^ (t[10] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 8] ^= a;
+  t[10] ^= a >>  2;
+  a = (t[ 9] ^ (t[11] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 9] ^= a;
+  t[11] ^= a >>  2;
+  a = (t[12] ^ (t[14] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[12] ^= a;
+  t[14] ^= a >>  2;
+  a = (t[13] ^ (t[15] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[13] ^= a;
+  t[15] ^= a >>  2;
+  a = (t[16] ^ (t[18] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[16] ^= a;
+  t[18] ^= a >>  2;
+  a = (t[17] ^ (t[19] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[17] ^= a;
+  t[19] ^= a >>  2;
+  a = (t[20] ^ (t[22] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[20] ^= a;
+  t[22] ^= a >>  2;
+  a = (t[21] ^ (t[23] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[21] ^= a;
+  t[23] ^= a >>  2;
+  a = (t[ 0] ^ (t[ 4] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 0] ^= a;
+  t[ 4] ^= a >>  4;
+  a = (t[ 1] ^ (t[ 5] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 1] ^= a;
+  t[ 5] ^= a >>  4;
+  a = (t[ 2] ^ (t[ 6] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 2] ^= a;
+  t[ 6] ^= a >>  4;
+  a = (t[ 3] ^ (t[ 7] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 3] ^= a;
+  t[ 7] ^= a >>  4;
+  a = (t[ 8] ^ (t[12] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 8] ^= a;
+  t[12] ^= a >>  4;
+  a = (t[ 9] ^ (t[13] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 9] ^= a;
+  t[13] ^= a >>  4;
+  a = (t[10] ^ (t[14] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[10] ^= a;
+  t[14] ^= a >>  4;
+  a = (t[11] ^ (t[15] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[11] ^= a;
+  t[15] ^= a >>  4;
+  a = (t[16] ^ (t[20] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[16] ^= a;
+  t[20] ^= a >>  4;
+  a = (t[17] ^ (t[21] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[17] ^= a;
+  t[21] ^= a >>  4;
+  a = (t[18] ^ (t[22] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[18] ^= a;
+  t[22] ^= a >>  4;
+  a = (t[19] ^ (t[23] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[19] ^= a;
+  t[23] ^= a >>  4;
+  a = (t[ 0] ^ (t[ 8] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 0] ^= a;
+  t[ 8] ^= a >>  8;
+  a = (t[ 1] ^ (t[ 9] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 1] ^= a;
+  t[ 9] ^= a >>  8;
+  a = (t[ 2] ^ (t[10] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 2] ^= a;
+  t[10] ^= a >>  8;
+  a = (t[ 3] ^ (t[11] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 3] ^= a;
+  t[11] ^= a >>  8;
+  a = (t[ 4] ^ (t[12] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 4] ^= a;
+  t[12] ^= a >>  8;
+  a = (t[ 5] ^ (t[13] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 5] ^= a;
+  t[13] ^= a >>  8;
+  a = (t[ 6] ^ (t[14] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 6] ^= a;
+  t[14] ^= a >>  8;
+  a = (t[ 7] ^ (t[15] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 7] ^= a;
+  t[15] ^= a >>  8;
+  a = (t[16] ^ (t[24] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[16] ^= a;
+  t[24] ^= a >>  8;
+  a = (t[17] ^ (t[25] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[17] ^= a;
+  t[25] ^= a >>  8;
+  a = (t[18] ^ (t[26] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[18] ^= a;
+  t[26] ^= a >>  8;
+  a = (t[19] ^ (t[27] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[19] ^= a;
+  t[27] ^= a >>  8;
+  a = (t[20] ^ (t[28] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[20] ^= a;
+  t[28] ^= a >>  8;
+  a = (t[21] ^ (t[29] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[21] ^= a;
+  t[29] ^= a >>  8;
+  a = (t[22] ^ (t[30] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[22] ^= a;
+  t[30] ^= a >>  8;
+  a = (t[23] ^ (t[31] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[23] ^= a;
+  t[31] ^= a >>  8;
+  a = (t[ 0] ^ (t[16] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 0] ^= a;
+  t[16] ^= a >> 16;
+  a = (t[ 1] ^ (t[17] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 1] ^= a;
+  t[17] ^= a >> 16;
+  a = (t[ 2] ^ (t[18] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 2] ^= a;
+  t[18] ^= a >> 16;
+  a = (t[ 3] ^ (t[19] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 3] ^= a;
+  t[19] ^= a >> 16;
+  a = (t[ 4] ^ (t[20] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 4] ^= a;
+  t[20] ^= a >> 16;
+  a = (t[ 5] ^ (t[21] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 5] ^= a;
+  t[21] ^= a >> 16;
+  a = (t[ 6] ^ (t[22] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 6] ^= a;
+  t[22] ^= a >> 16;
+  a = (t[ 7] ^ (t[23] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 7] ^= a;
+  t[23] ^= a >> 16;
+  a = (t[ 8] ^ (t[24] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 8] ^= a;
+  t[24] ^= a >> 16;
+  a = (t[ 9] ^ (t[25] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 9] ^= a;
+  t[25] ^= a >> 16;
+  a = (t[10] ^ (t[26] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[10] ^= a;
+  t[26] ^= a >> 16;
+  a = (t[11] ^ (t[27] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[11] ^= a;
+  t[27] ^= a >> 16;
+  a = (t[12] ^ (t[28] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[12] ^= a;
+  t[28] ^= a >> 16;
+  a = (t[13] ^ (t[29] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[13] ^= a;
+  t[29] ^= a >> 16;
+  a = (t[14] ^ (t[30] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[14] ^= a;
+  t[30] ^= a >> 16;
+  a = (t[15] ^ (t[31] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[15] ^= a;
+  t[31] ^= a >> 16;
+  for (i = 0; i < 32 && i < dlen; i++)
+    dst[i] = t[i];
+  for (i = 32; i < 64 && i < dlen; i++)
+    dst[i] = t[i-32] >> 32;
+}
+
+#endif /* __SSE2__ */
+
+#if BSVEC_BITS > 64
+
+/* Auto-generated by BitSliceK_vec_print */
+static inline void BitSlice24_vec(int slen, const bsvec_t *src, int dlen, uint32_t *dst)
+{
+  bsvec_t a, t[32];
+  int i, w;
+
+  for (i = 0; i < slen; i++)
+    t[i] = src[i];
+  for (; i < 32; i++)
+    t[i] = BS_ZERO;
+
+  a = (t[ 0] ^ (t[ 1] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 0] ^= a;
+  t[ 1] ^= a >>  1;
+  a = (t[ 2] ^ (t[ 3] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 2] ^= a;
+  t[ 3] ^= a >>  1;
+  a = (t[ 4] ^ (t[ 5] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 4] ^= a;
+  t[ 5] ^= a >>  1;
+  a = (t[ 6] ^ (t[ 7] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 6] ^= a;
+  t[ 7] ^= a >>  1;
+  a = (t[ 8] ^ (t[ 9] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 8] ^= a;
+  t[ 9] ^= a >>  1;
+  a = (t[10] ^ (t[11] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[10] ^= a;
+  t[11] ^= a >>  1;
+  a = (t[12] ^ (t[13] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[12] ^= a;
+  t[13] ^= a >>  1;
+  a = (t[14] ^ (t[15] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[14] ^= a;
+  t[15] ^= a >>  1;
+  a = (t[16] ^ (t[17] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[16] ^= a;
+  t[17] ^= a >>  1;
+  a = (t[18] ^ (t[19] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[18] ^= a;
+  t[19] ^= a >>  1;
+  a = (t[20] ^ (t[21] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[20] ^= a;
+  t[21] ^= a >>  1;
+  a = (t[22] ^ (t[23] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[22] ^= a;
+  t[23] ^= a >>  1;
+  a = (t[ 0] ^ (t[ 2] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 0] ^= a;
+  t[ 2] ^= a >>  2;
+  a = (t[ 1] ^ (t[ 3] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 1] ^= a;
+  t[ 3] ^= a >>  2;
+  a = (t[ 4] ^ (t[ 6] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 4] ^= a;
+  t[ 6] ^= a >>  2;
+  a = (t[ 5] ^ (t[ 7] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 5] ^= a;
+  t[ 7] ^= a >>  2;
+  a = (t[ 8] ^ (t[10] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 8] ^= a;
+  t[10] ^= a >>  2;
+  a = (t[ 9] ^ (t[11] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 9] ^= a;
+  t[11] ^= a >>  2;
+  a = (t[12] ^ (t[14] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[12] ^= a;
+  t[14] ^= a >>  2;
+  a = (t[13] ^ (t[15] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[13] ^= a;
+  t[15] ^= a >>  2;
+  a = (t[16] ^ (t[18] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[16] ^= a;
+  t[18] ^= a >>  2;
+  a = (t[17] ^ (t[19] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[17] ^= a;
+  t[19] ^= a >>  2;
+  a = (t[20] ^ (t[22] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[20] ^= a;
+  t[22] ^= a >>  2;
+  a = (t[21] ^ (t[23] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[21] ^= a;
+  t[23] ^= a >>  2;
+  a = (t[ 0] ^ (t[ 4] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 0] ^= a;
+  t[ 4] ^= a >>  4;
+  a = (t[ 1] ^ (t[ 5] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 1] ^= a;
+  t[ 5] ^= a >>  4;
+  a = (t[ 2] ^ (t[ 6] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 2] ^= a;
+  t[ 6] ^= a >>  4;
+  a = (t[ 3] ^ (t[ 7] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 3] ^= a;
+  t[ 7] ^= a >>  4;
+  a = (t[ 8] ^ (t[12] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 8] ^= a;
+  t[12] ^= a >>  4;
+  a = (t[ 9] ^ (t[13] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 9] ^= a;
+  t[13] ^= a >>  4;
+  a = (t[10] ^ (t[14] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[10] ^= a;
+  t[14] ^= a >>  4;
+  a = (t[11] ^ (t[15] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[11] ^= a;
+  t[15] ^= a >>  4;
+  a = (t[16] ^ (t[20] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[16] ^= a;
+  t[20] ^= a >>  4;
+  a = (t[17] ^ (t[21] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[17] ^= a;
+  t[21] ^= a >>  4;
+  a = (t[18] ^ (t[22] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[18] ^= a;
+  t[22] ^= a >>  4;
+  a = (t[19] ^ (t[23] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[19] ^= a;
+  t[23] ^= a >>  4;
+  a = (t[ 0] ^ (t[ 8] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 0] ^= a;
+  t[ 8] ^= a >>  8;
+  a = (t[ 1] ^ (t[ 9] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 1] ^= a;
+  t[ 9] ^= a >>  8;
+  a = (t[ 2] ^ (t[10] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 2] ^= a;
+  t[10] ^= a >>  8;
+  a = (t[ 3] ^ (t[11] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 3] ^= a;
+  t[11] ^= a >>  8;
+  a = (t[ 4] ^ (t[12] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 4] ^= a;
+  t[12] ^= a >>  8;
+  a = (t[ 5] ^ (t[13] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 5] ^= a;
+  t[13] ^= a >>  8;
+  a = (t[ 6] ^ (t[14] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 6] ^= a;
+  t[14] ^= a >>  8;
+  a = (t[ 7] ^ (t[15] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 7] ^= a;
+  t[15] ^= a >>  8;
+  a = (t[16] ^ (t[24] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[16] ^= a;
+  t[24] ^= a >>  8;
+  a = (t[17] ^ (t[25] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[17] ^= a;
+  t[25] ^= a >>  8;
+  a = (t[18] ^ (t[26] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[18] ^= a;
+  t[26] ^= a >>  8;
+  a = (t[19] ^ (t[27] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[19] ^= a;
+  t[27] ^= a >>  8;
+  a = (t[20] ^ (t[28] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[20] ^= a;
+  t[28] ^= a >>  8;
+  a = (t[21] ^ (t[29] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[21] ^= a;
+  t[29] ^= a >>  8;
+  a = (t[22] ^ (t[30] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[22] ^= a;
+  t[30] ^= a >>  8;
+  a = (t[23] ^ (t[31] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[23] ^= a;
+  t[31] ^= a >>  8;
+  a = (t[ 0] ^ (t[16] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 0] ^= a;
+  t[16] ^= a >> 16;
+  a = (t[ 1] ^ (t[17] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 1] ^= a;
+  t[17] ^= a >> 16;
+  a = (t[ 2] ^ (t[18] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 2] ^= a;
+  t[18] ^= a >> 16;
+  a = (t[ 3] ^ (t[19] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 3] ^= a;
+  t[19] ^= a >> 16;
+  a = (t[ 4] ^ (t[20] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 4] ^= a;
+  t[20] ^= a >> 16;
+  a = (t[ 5] ^ (t[21] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 5] ^= a;
+  t[21] ^= a >> 16;
+  a = (t[ 6] ^ (t[22] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 6] ^= a;
+  t[22] ^= a >> 16;
+  a = (t[ 7] ^ (t[23] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 7] ^= a;
+  t[23] ^= a >> 16;
+  a = (t[ 8] ^ (t[24] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 8] ^= a;
+  t[24] ^= a >> 16;
+  a = (t[ 9] ^ (t[25] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 9] ^= a;
+  t[25] ^= a >> 16;
+  a = (t[10] ^ (t[26] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[10] ^= a;
+  t[26] ^= a >> 16;
+  a = (t[11] ^ (t[27] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[11] ^= a;
+  t[27] ^= a >> 16;
+  a = (t[12] ^ (t[28] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[12] ^= a;
+  t[28] ^= a >> 16;
+  a = (t[13] ^ (t[29] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[13] ^= a;
+  t[29] ^= a >> 16;
+  a = (t[14] ^ (t[30] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[14] ^= a;
+  t[30] ^= a >> 16;
+  a = (t[15] ^ (t[31] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[15] ^= a;
+  t[31] ^= a >> 16;
+  for (w = 0; w < BSWORDS && 64*w < dlen; w++) {
+    for (i = 0; i < 32 && 64*w + i < dlen; i++)
+      dst[64*w + i] = t[i][w];
+    for (i = 32; i < 64 && 64*w + i < dlen; i++)
+      dst[64*w + i] = t[i-32][w] >> 32;
+  }
+}
+
+#ifdef BITSLICE_NT
+
+/* Auto-generated by BitSliceK_vec_print */
+static inline void BitSlice24_vec_nt(int slen, const bsvec_t *src, int dlen, uint32_t *dst)
+{
+  bsvec_t a, t[32];
+  uint32_t o[64] __attribute__((aligned(64)));
+  int i, w;
+
+  for (i = 0; i < slen; i++)
+    t[i] = src[i];
+  for (; i < 32; i++)
+    t[i] = BS_ZERO;
+
+  a = (t[ 0] ^ (t[ 1] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 0] ^= a;
+  t[ 1] ^= a >>  1;
+  a = (t[ 2] ^ (t[ 3] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 2] ^= a;
+  t[ 3] ^= a >>  1;
+  a = (t[ 4] ^ (t[ 5] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 4] ^= a;
+  t[ 5] ^= a >>  1;
+  a = (t[ 6] ^ (t[ 7] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 6] ^= a;
+  t[ 7] ^= a >>  1;
+  a = (t[ 8] ^ (t[ 9] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 8] ^= a;
+  t[ 9] ^= a >>  1;
+  a = (t[10] ^ (t[11] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[10] ^= a;
+  t[11] ^= a >>  1;
+  a = (t[12] ^ (t[13] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[12] ^= a;
+  t[13] ^= a >>  1;
+  a = (t[14] ^ (t[15] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[14] ^= a;
+  t[15] ^= a >>  1;
+  a = (t[16] ^ (t[17] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[16] ^= a;
+  t[17] ^= a >>  1;
+  a = (t[18] ^ (t[19] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[18] ^= a;
+  t[19] ^= a >>  1;
+  a = (t[20] ^ (t[21] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[20] ^= a;
+  t[21] ^= a >>  1;
+  a = (t[22] ^ (t[23] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[22] ^= a;
+  t[23] ^= a >>  1;
+  a = (t[ 0] ^ (t[ 2] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 0] ^= a;
+  t[ 2] ^= a >>  2;
+  a = (t[ 1] ^ (t[ 3] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 1] ^= a;
+  t[ 3] ^= a >>  2;
+  a = (t[ 4] ^ (t[ 6] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 4] ^= a;
+  t[ 6] ^= a >>  2;
+  a = (t[ 5] ^ (t[ 7] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 5] ^= a;
+  t[ 7] ^= a >>  2;
+  a = (t[ 8] ^ (t[10] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 8] ^= a;
+  t[10] ^= a >>  2;
+  a = (t[ 9] ^ (t[11] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 9] ^= a;
+  t[11] ^= a >>  2;
+  a = (t[12] ^ (t[14] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[12] ^= a;
+  t[14] ^= a >>  2;
+  a = (t[13] ^ (t[15] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[13] ^= a;
+  t[15] ^= a >>  2;
+  a = (t[16] ^ (t[18] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[16] ^= a;
+  t[18] ^= a >>  2;
+  a = (t[17] ^ (t[19] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[17] ^= a;
+  t[19] ^= a >>  2;
+  a = (t[20] ^ (t[22] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[20] ^= a;
+  t[22] ^= a >>  2;
+  a = (t[21] ^ (t[23] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[21] ^= a;
+  t[23] ^= a >>  2;
+  a = (t[ 0] ^ (t[ 4] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 0] ^= a;
+  t[ 4] ^= a >>  4;
+  a = (t[ 1] ^ (t[ 5] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 1] ^= a;
+  t[ 5] ^= a >>  4;
+  a = (t[ 2] ^ (t[ 6] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 2] ^= a;
+  t[ 6] ^= a >>  4;
+  a = (t[ 3] ^ (t[ 7] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 3] ^= a;
+  t[ 7] ^= a >>  4;
+  a = (t[ 8] ^ (t[12] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 8] ^= a;
+  t[12] ^= a >>  4;
+  a = (t[ 9] ^ (t[13] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 9] ^= a;
+  t[13] ^= a >>  4;
+  a = (t[10] ^ (t[14] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[10] ^= a;
+  t[14] ^= a >>  4;
+  a = (t[11] ^ (t[15] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[11] ^= a;
+  t[15] ^= a >>  4;
+  a = (t[16] ^ (t[20] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[16] ^= a;
+  t[20] ^= a >>  4;
+  a = (t[17] ^ (t[21] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[17] ^= a;
+  t[21] ^= a >>  4;
+  a = (t[18] ^ (t[22] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[18] ^= a;
+  t[22] ^= a >>  4;
+  a = (t[19] ^ (t[23] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[19] ^= a;
+  t[23] ^= a >>  4;
+  a = (t[ 0] ^ (t[ 8] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 0] ^= a;
+  t[ 8] ^= a >>  8;
+  a = (t[ 1] ^ (t[ 9] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 1] ^= a;
+  t[ 9] ^= a >>  8;
+  a = (t[ 2] ^ (t[10] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 2] ^= a;
+  t[10] ^= a >>  8;
+  a = (t[ 3] ^ (t[11] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 3] ^= a;
+  t[11] ^= a >>  8;
+  a = (t[ 4] ^ (t[12] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 4] ^= a;
+  t[12] ^= a >>  8;
+  a = (t[ 5] ^ (t[13] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 5] ^= a;
+  t[13] ^= a >>  8;
+  a = (t[ 6] ^ (t[14] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 6] ^= a;
+  t[14] ^= a >>  8;
+  a = (t[ 7] ^ (t[15] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 7] ^= a;
+  t[15] ^= a >>  8;
+  a = (t[16] ^ (t[24] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[16] ^= a;
+  t[24] ^= a >>  8;
+  a = (t[17] ^ (t[25] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[17] ^= a;
+  t[25] ^= a >>  8;
+  a = (t[18] ^ (t[26] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[18] ^= a;
+  t[26] ^= a >>  8;
+  a = (t[19] ^ (t[27] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[19] ^= a;
+  t[27] ^= a >>  8;
+  a = (t[20] ^ (t[28] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[20] ^= a;
+  t[28] ^= a >>  8;
+  a = (t[21] ^ (t[29] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[21] ^= a;
+  t[29] ^= a >>  8;
+  a = (t[22] ^ (t[30] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[22] ^= a;
+  t[30] ^= a >>  8;
+  a = (t[23] ^ (t[31] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[23] ^= a;
+  t[31] ^= a >>  8;
+  a = (t[ 0] ^ (t[16] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 0] ^= a;
+  t[16] ^= a >> 16;
+  a = (t[ 1] ^ (t[17] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 1] ^= a;
+  t[17] ^= a >> 16;
+  a = (t[ 2] ^ (t[18] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 2] ^= a;
+  t[18] ^= a >> 16;
+  a = (t[ 3] ^ (t[19] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 3] ^= a;
+  t[19] ^= a >> 16;
+  a = (t[ 4] ^ (t[20] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 4] ^= a;
+  t[20] ^= a >> 16;
+  a = (t[ 5] ^ (t[21] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 5] ^= a;
+  t[21] ^= a >> 16;
+  a = (t[ 6] ^ (t[22] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 6] ^= a;
+  t[22] ^= a >> 16;
+  a = (t[ 7] ^ (t[23] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 7] ^= a;
+  t[23] ^= a >> 16;
+  a = (t[ 8] ^ (t[24] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 8] ^= a;
+  t[24] ^= a >> 16;
+  a = (t[ 9] ^ (t[25] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 9] ^= a;
+  t[25] ^= a >> 16;
+  a = (t[10] ^ (t[26] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[10] ^= a;
+  t[26] ^= a >> 16;
+  a = (t[11] ^ (t[27] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[11] ^= a;
+  t[27] ^= a >> 16;
+  a = (t[12] ^ (t[28] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[12] ^= a;
+  t[28] ^= a >> 16;
+  a = (t[13] ^ (t[29] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[13] ^= a;
+  t[29] ^= a >> 16;
+  a = (t[14] ^ (t[30] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[14] ^= a;
+  t[30] ^= a >> 16;
+  a = (t[15] ^ (t[31] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[15] ^= a;
+  t[31] ^= a >> 16;
+  for (w = 0; w < BSWORDS && 64*w < dlen; w++) {
+    for (i = 0; i < 32; i++) {
+      o[i] = t[i][w];
+      o[i+32] = t[i][w] >> 32;
+    }
+    BitSliceStream(dst + 64*w, o, dlen - 64*w < 64 ? dlen - 64*w : 64);
+  }
+}
+
+#endif /* BITSLICE_NT */
+
+#endif /* BSVEC_BITS > 64 */
+
+#ifdef BITSLICE_GFNI
+
+/* Auto-generated by BitSliceK_gfni_print */
+static inline void BitSlice24_gfni(int slen, const bsvec_t *src, int dlen, uint32_t *dst)
+{
+  static const unsigned char perm[64] __attribute__((aligned(64))) = {
+    56, 48, 40, 32, 24, 16,  8,  0, 57, 49, 41, 33, 25, 17,  9,  1,
+    58, 50, 42, 34, 26, 18, 10,  2, 59, 51, 43, 35, 27, 19, 11,  3,
+    60, 52, 44, 36, 28, 20, 12,  4, 61, 53, 45, 37, 29, 21, 13,  5,
+    62, 54, 46, 38, 30, 22, 14,  6, 63, 55, 47, 39, 31, 23, 15,  7,
+  };
+  static const unsigned char merge[4][64] __attribute__((aligned(64))) = {
+    {
+       0, 64,  0, 64,  1, 65,  1, 65,  2, 66,  2, 66,  3, 67,  3, 67,
+       4, 68,  4, 68,  5, 69,  5, 69,  6, 70,  6, 70,  7, 71,  7, 71,
+       8, 72,  8, 72,  9, 73,  9, 73, 10, 74, 10, 74, 11, 75, 11, 75,
+      12, 76, 12, 76, 13, 77, 13, 77, 14, 78, 14, 78, 15, 79, 15, 79,
+    },
+    {
+      16, 80, 16, 80, 17, 81, 17, 81, 18, 82, 18, 82, 19, 83, 19, 83,
+      20, 84, 20, 84, 21, 85, 21, 85, 22, 86, 22, 86, 23, 87, 23, 87,
+      24, 88, 24, 88, 25, 89, 25, 89, 26, 90, 26, 90, 27, 91, 27, 91,
+      28, 92, 28, 92, 29, 93, 29, 93, 30, 94, 30, 94, 31, 95, 31, 95,
+    },
+    {
+      32, 96, 32, 96, 33, 97, 33, 97, 34, 98, 34, 98, 35, 99, 35, 99,
+      36, 100, 36, 100, 37, 101, 37, 101, 38, 102, 38, 102, 39, 103, 39, 103,
+      40, 104, 40, 104, 41, 105, 41, 105, 42, 106, 42, 106, 43, 107, 43, 107,
+      44, 108, 44, 108, 45, 109, 45, 109, 46, 110, 46, 110, 47, 111, 47, 111,
+    },
+    {
+      48, 112, 48, 112, 49, 113, 49, 113, 50, 114, 50, 114, 51, 115, 51, 115,
+      52, 116, 52, 116, 53, 117, 53, 117, 54, 118, 54, 118, 55, 119, 55, 119,
+      56, 120, 56, 120, 57, 121, 57, 121, 58, 122, 58, 122, 59, 123, 59, 123,
+      60, 124, 60, 124, 61, 125, 61, 125, 62, 126, 62, 126, 63, 127, 63, 127,
+    },
+  };
+  const __m512i identity = _mm512_set1_epi64(UINT64_C(0x8040201008040201));
+  const __m512i slices = _mm512_set_epi64(7*BSWORDS, 6*BSWORDS, 5*BSWORDS, 4*BSWORDS,
+                                          3*BSWORDS, 2*BSWORDS, BSWORDS, 0);
+  __m512i x, z[3];
+  int g, n, q, w;
+
+  for (w = 0; w < BSWORDS && 64*w < dlen; w++) {
+    for (g = 0; g < 3; g++) {
+      n = slen - 8*g;
+      n = n < 0 ? 0 : n > 8 ? 8 : n;
+      x = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), (1 << n) - 1, slices,
+                                      (const long long *)&src[8*g] + w, 8);
+      x = _mm512_permutexvar_epi8(_mm512_load_si512(perm), x);
+      z[g] = _mm512_gf2p8affine_epi64_epi8(identity, x, 0);
+    }
+    for (q = 0; q < 4; q++) {
+      __m512i m = _mm512_load_si512(merge[q]);
+
+      x = _mm512_maskz_permutex2var_epi8(UINT64_C(0x3333333333333333), z[0], m, z[1]);
+      x |= _mm512_maskz_permutexvar_epi8(UINT64_C(0x4444444444444444), m, z[2]);
+      n = dlen - 64*w - 16*q;
+      n = n < 0 ? 0 : n > 16 ? 16 : n;
+      _mm512_mask_storeu_epi32(dst + 64*w + 16*q, (1 << n) - 1, x);
+    }
+  }
+}
+
+/* Auto-generated by BitSliceK_gfni_print */
+static inline void BitSlice24_gfni_nt(int slen, const bsvec_t *src, int dlen, uint32_t *dst)
+{
+  static const unsigned char perm[64] __attribute__((aligned(64))) = {
+    56, 48, 40, 32, 24, 16,  8,  0, 57, 49, 41, 33, 25, 17,  9,  1,
+    58, 50, 42, 34, 26, 18, 10,  2, 59, 51, 43, 35, 27, 19, 11,  3,
+    60, 52, 44, 36, 28, 20, 12,  4, 61, 53, 45, 37, 29, 21, 13,  5,
+    62, 54, 46, 38, 30, 22, 14,  6, 63, 55, 47, 39, 31, 23, 15,  7,
+  };
+  static const unsigned char merge[4][64] __attribute__((aligned(64))) = {
+    {
+       0, 64,  0, 64,  1, 65,  1, 65,  2, 66,  2, 66,  3, 67,  3, 67,
+       4, 68,  4, 68,  5, 69,  5, 69,  6, 70,  6, 70,  7, 71,  7, 71,
+       8, 72,  8, 72,  9, 73,  9, 73, 10, 74, 10, 74, 11, 75, 11, 75,
+      12, 76, 12, 76, 13, 77, 13, 77, 14, 78, 14, 78, 15, 79, 15, 79,
+    },
+    {
+      16, 80, 16, 80, 17, 81, 17, 81, 18, 82, 18, 82, 19, 83, 19, 83,
+      20, 84, 20, 84, 21, 85, 21, 85, 22, 86, 22, 86, 23, 87, 23, 87,
+      24, 88, 24, 88, 25, 89, 25, 89, 26, 90, 26, 90, 27, 91, 27, 91,
+      28, 92, 28, 92, 29, 93, 29, 93, 30, 94, 30, 94, 31, 95, 31, 95,
+    },
+    {
+      32, 96, 32, 96, 33, 97, 33, 97, 34, 98, 34, 98, 35, 99, 35, 99,
+      36, 100, 36, 100, 37, 101, 37, 101, 38, 102, 38, 102, 39, 103, 39, 103,
+      40, 104, 40, 104, 41, 105, 41, 105, 42, 106, 42, 106, 43, 107, 43, 107,
+      44, 108, 44, 108, 45, 109, 45, 109, 46, 110, 46, 110, 47, 111, 47, 111,
+    },
+    {
+      48, 112, 48, 112, 49, 113, 49, 113, 50, 114, 50, 114, 51, 115, 51, 115,
+      52, 116, 52, 116, 53, 117, 53, 117, 54, 118, 54, 118, 55, 119, 55, 119,
+      56, 120, 56, 120, 57, 121, 57, 121, 58, 122, 58, 122, 59, 123, 59, 123,
+      60, 124, 60, 124, 61, 125, 61, 125, 62, 126, 62, 126, 63, 127, 63, 127,
+    },
+  };
+  const __m512i identity = _mm512_set1_epi64(UINT64_C(0x8040201008040201));
+  const __m512i slices = _mm512_set_epi64(7*BSWORDS, 6*BSWORDS, 5*BSWORDS, 4*BSWORDS,
+                                          3*BSWORDS, 2*BSWORDS, BSWORDS, 0);
+  __m512i x, z[3];
+  int g, n, q, w;
+
+  for (w = 0; w < BSWORDS && 64*w < dlen; w++) {
+    for (g = 0; g < 3; g++) {
+      n = slen - 8*g;
+      n = n < 0 ? 0 : n > 8 ? 8 : n;
+      x = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), (1 << n) - 1, slices,
+                                      (const long long *)&src[8*g] + w, 8);
+      x = _mm512_permutexvar_epi8(_mm512_load_si512(perm), x);
+      z[g] = _mm512_gf2p8affine_epi64_epi8(identity, x, 0);
+    }
+    for (q = 0; q < 4; q++) {
+      __m512i m = _mm512_load_si512(merge[q]);
+
+      x = _mm512_maskz_permutex2var_epi8(UINT64_C(0x3333333333333333), z[0], m, z[1]);
+      x |= _mm512_maskz_permutexvar_epi8(UINT64_C(0x4444444444444444), m, z[2]);
+      if (64*w + 16*q < dlen)
+        _mm512_stream_si512((void *)(dst + 64*w + 16*q), x);
+    }
+  }
+}
+
+#endif /* BITSLICE_GFNI */
+#ifdef __SSE2__
+
+/* Auto-generated by BitSliceK_sse2_print */
+static inline void BitSlice32_64(int slen, const uint64_t *src, int dlen, uint32_t *dst)
+{
+  int i;
+  uint64_t a;
+  union { uint64_t t[64]; v2di vt[32]; } u;
+  v2di va;
+  static const v2di bsmask128[6] = {
+    { UINT64_C(0xaaaaaaaaaaaaaaaa), UINT64_C(0xaaaaaaaaaaaaaaaa) }, 
+    { UINT64_C(0xcccccccccccccccc), UINT64_C(0xcccccccccccccccc) }, 
+    { UINT64_C(0xf0f0f0f0f0f0f0f0), UINT64_C(0xf0f0f0f0f0f0f0f0) }, 
+    { UINT64_C(0xff00ff00ff00ff00), UINT64_C(0xff00ff00ff00ff00) }, 
+    { UINT64_C(0xffff0000ffff0000), UINT64_C(0xffff0000ffff0000) }, 
+    { UINT64_C(0xffffffff00000000), UINT64_C(0xffffffff00000000) }
+  };
+
+  memset(&u, 0, sizeof(u));
+  memcpy(u.t, src, slen*sizeof(uint64_t));
+  a = (u.t[0] ^ (u.t[1] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[0] ^= a;
+  u.t[1] ^= a >> 1;
+  a = (u.t[2] ^ (u.t[3] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[2] ^= a;
+  u.t[3] ^= a >> 1;
+  a = (u.t[4] ^ (u.t[5] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[4] ^= a;
+  u.t[5] ^= a >> 1;
+  a = (u.t[6] ^ (u.t[7] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[6] ^= a;
+  u.t[7] ^= a >> 1;
+  a = (u.t[8] ^ (u.t[9] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[8] ^= a;
+  u.t[9] ^= a >> 1;
+  a = (u.t[10] ^ (u.t[11] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[10] ^= a;
+  u.t[11] ^= a >> 1;
+  a = (u.t[12] ^ (u.t[13] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[12] ^= a;
+  u.t[13] ^= a >> 1;
+  a = (u.t[14] ^ (u.t[15] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[14] ^= a;
+  u.t[15] ^= a >> 1;
+  a = (u.t[16] ^ (u.t[17] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[16] ^= a;
+  u.t[17] ^= a >> 1;
+  a = (u.t[18] ^ (u.t[19] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[18] ^= a;
+  u.t[19] ^= a >> 1;
+  a = (u.t[20] ^ (u.t[21] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[20] ^= a;
+  u.t[21] ^= a >> 1;
+  a = (u.t[22] ^ (u.t[23] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[22] ^= a;
+  u.t[23] ^= a >> 1;
+  a = (u.t[24] ^ (u.t[25] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[24] ^= a;
+  u.t[25] ^= a >> 1;
+  a = (u.t[26] ^ (u.t[27] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[26] ^= a;
+  u.t[27] ^= a >> 1;
+  a = (u.t[28] ^ (u.t[29] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[28] ^= a;
+  u.t[29] ^= a >> 1;
+  a = (u.t[30] ^ (u.t[31] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[30] ^= a;
+  u.t[31] ^= a >> 1;
+    va = (u.vt[0] ^ __builtin_ia32_psllqi128(u.vt[1], 2)) & bsmask128[1];
+    u.vt[0] ^= va;
+    u.vt[1] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[2] ^ __builtin_ia32_psllqi128(u.vt[3], 2)) & bsmask128[1];
+    u.vt[2] ^= va;
+    u.vt[3] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[4] ^ __builtin_ia32_psllqi128(u.vt[5], 2)) & bsmask128[1];
+    u.vt[4] ^= va;
+    u.vt[5] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[6] ^ __builtin_ia32_psllqi128(u.vt[7], 2)) & bsmask128[1];
+    u.vt[6] ^= va;
+    u.vt[7] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[8] ^ __builtin_ia32_psllqi128(u.vt[9], 2)) & bsmask128[1];
+    u.vt[8] ^= va;
+    u.vt[9] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[10] ^ __builtin_ia32_psllqi128(u.vt[11], 2)) & bsmask128[1];
+    u.vt[10] ^= va;
+    u.vt[11] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[12] ^ __builtin_ia32_psllqi128(u.vt[13], 2)) & bsmask128[1];
+    u.vt[12] ^= va;
+    u.vt[13] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[14] ^ __builtin_ia32_psllqi128(u.vt[15], 2)) & bsmask128[1];
+    u.vt[14] ^= va;
+    u.vt[15] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[0] ^ __builtin_ia32_psllqi128(u.vt[2], 4)) & bsmask128[2];
+    u.vt[0] ^= va;
+    u.vt[2] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[1] ^ __builtin_ia32_psllqi128(u.vt[3], 4)) & bsmask128[2];
+    u.vt[1] ^= va;
+    u.vt[3] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[4] ^ __builtin_ia32_psllqi128(u.vt[6], 4)) & bsmask128[2];
+    u.vt[4] ^= va;
+    u.vt[6] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[5] ^ __builtin_ia32_psllqi128(u.vt[7], 4)) & bsmask128[2];
+    u.vt[5] ^= va;
+    u.vt[7] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[8] ^ __builtin_ia32_psllqi128(u.vt[10], 4)) & bsmask128[2];
+    u.vt[8] ^= va;
+    u.vt[10] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[9] ^ __builtin_ia32_psllqi128(u.vt[11], 4)) & bsmask128[2];
+    u.vt[9] ^= va;
+    u.vt[11] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[12] ^ __builtin_ia32_psllqi128(u.vt[14], 4)) & bsmask128[2];
+    u.vt[12] ^= va;
+    u.vt[14] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[13] ^ __builtin_ia32_psllqi128(u.vt[15], 4)) & bsmask128[2];
+    u.vt[13] ^= va;
+    u.vt[15] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[0] ^ __builtin_ia32_psllqi128(u.vt[4], 8)) & bsmask128[3];
+    u.vt[0] ^= va;
+    u.vt[4] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[1] ^ __builtin_ia32_psllqi128(u.vt[5], 8)) & bsmask128[3];
+    u.vt[1] ^= va;
+    u.vt[5] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[2] ^ __builtin_ia32_psllqi128(u.vt[6], 8)) & bsmask128[3];
+    u.vt[2] ^= va;
+    u.vt[6] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[3] ^ __builtin_ia32_psllqi128(u.vt[7], 8)) & bsmask128[3];
+    u.vt[3] ^= va;
+    u.vt[7] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[8] ^ __builtin_ia32_psllqi128(u.vt[12], 8)) & bsmask128[3];
+    u.vt[8] ^= va;
+    u.vt[12] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[9] ^ __builtin_ia32_psllqi128(u.vt[13], 8)) & bsmask128[3];
+    u.vt[9] ^= va;
+    u.vt[13] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[10] ^ __builtin_ia32_psllqi128(u.vt[14], 8)) & bsmask128[3];
+    u.vt[10] ^= va;
+    u.vt[14] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[11] ^ __builtin_ia32_psllqi128(u.vt[15], 8)) & bsmask128[3];
+    u.vt[11] ^= va;
+    u.vt[15] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[0] ^ __builtin_ia32_psllqi128(u.vt[8], 16)) & bsmask128[4];
+    u.vt[0] ^= va;
+    u.vt[8] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[1] ^ __builtin_ia32_psllqi128(u.vt[9], 16)) & bsmask128[4];
+    u.vt[1] ^= va;
+    u.vt[9] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[2] ^ __builtin_ia32_psllqi128(u.vt[10], 16)) & bsmask128[4];
+    u.vt[2] ^= va;
+    u.vt[10] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[3] ^ __builtin_ia32_psllqi128(u.vt[11], 16)) & bsmask128[4];
+    u.vt[3] ^= va;
+    u.vt[11] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[4] ^ __builtin_ia32_psllqi128(u.vt[12], 16)) & bsmask128[4];
+    u.vt[4] ^= va;
+    u.vt[12] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[5] ^ __builtin_ia32_psllqi128(u.vt[13], 16)) & bsmask128[4];
+    u.vt[5] ^= va;
+    u.vt[13] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[6] ^ __builtin_ia32_psllqi128(u.vt[14], 16)) & bsmask128[4];
+    u.vt[6] ^= va;
+    u.vt[14] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[7] ^ __builtin_ia32_psllqi128(u.vt[15], 16)) & bsmask128[4];
+    u.vt[7] ^= va;
+    u.vt[15] ^= __builtin_ia32_psrlqi128(va, 16);
+  for (i = 0; i < dlen; i++)
+    dst[i] = u.t[i & 0x1f] >> (i & 0xe0);
+}
+
+/* Auto-generated by BitSliceK_sse2_print */
+static inline void BitSlice32_64_nt(int slen, const uint64_t *src, int dlen, uint32_t *dst)
+{
+  int i;
+  uint64_t a;
+  union { uint64_t t[64]; v2di vt[32]; } u;
+  v2di va;
+  static const v2di bsmask128[6] = {
+    { UINT64_C(0xaaaaaaaaaaaaaaaa), UINT64_C(0xaaaaaaaaaaaaaaaa) }, 
+    { UINT64_C(0xcccccccccccccccc), UINT64_C(0xcccccccccccccccc) }, 
+    { UINT64_C(0xf0f0f0f0f0f0f0f0), UINT64_C(0xf0f0f0f0f0f0f0f0) }, 
+    { UINT64_C(0xff00ff00ff00ff00), UINT64_C(0xff00ff00ff00ff00) }, 
+    { UINT64_C(0xffff0000ffff0000), UINT64_C(0xffff0000ffff0000) }, 
+    { UINT64_C(0xffffffff00000000), UINT64_C(0xffffffff00000000) }
+  };
+
+  memset(&u, 0, sizeof(u));
+  memcpy(u.t, src, slen*sizeof(uint64_t));
+  a = (u.t[0] ^ (u.t[1] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[0] ^= a;
+  u.t[1] ^= a >> 1;
+  a = (u.t[2] ^ (u.t[3] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[2] ^= a;
+  u.t[3] ^= a >> 1;
+  a = (u.t[4] ^ (u.t[5] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[4] ^= a;
+  u.t[5] ^= a >> 1;
+  a = (u.t[6] ^ (u.t[7] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[6] ^= a;
+  u.t[7] ^= a >> 1;
+  a = (u.t[8] ^ (u.t[9] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[8] ^= a;
+  u.t[9] ^= a >> 1;
+  a = (u.t[10] ^ (u.t[11] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[10] ^= a;
+  u.t[11] ^= a >> 1;
+  a = (u.t[12] ^ (u.t[13] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[12] ^= a;
+  u.t[13] ^= a >> 1;
+  a = (u.t[14] ^ (u.t[15] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[14] ^= a;
+  u.t[15] ^= a >> 1;
+  a = (u.t[16] ^ (u.t[17] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[16] ^= a;
+  u.t[17] ^= a >> 1;
+  a = (u.t[18] ^ (u.t[19] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[18] ^= a;
+  u.t[19] ^= a >> 1;
+  a = (u.t[20] ^ (u.t[21] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[20] ^= a;
+  u.t[21] ^= a >> 1;
+  a = (u.t[22] ^ (u.t[23] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[22] ^= a;
+  u.t[23] ^= a >> 1;
+  a = (u.t[24] ^ (u.t[25] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[24] ^= a;
+  u.t[25] ^= a >> 1;
+  a = (u.t[26] ^ (u.t[27] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[26] ^= a;
+  u.t[27] ^= a >> 1;
+  a = (u.t[28] ^ (u.t[29] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[28] ^= a;
+  u.t[29] ^= a >> 1;
+  a = (u.t[30] ^ (u.t[31] << 1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  u.t[30] ^= a;
+  u.t[31] ^= a >> 1;
+    va = (u.vt[0] ^ __builtin_ia32_psllqi128(u.vt[1], 2)) & bsmask128[1];
+    u.vt[0] ^= va;
+    u.vt[1] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[2] ^ __builtin_ia32_psllqi128(u.vt[3], 2)) & bsmask128[1];
+    u.vt[2] ^= va;
+    u.vt[3] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[4] ^ __builtin_ia32_psllqi128(u.vt[5], 2)) & bsmask128[1];
+    u.vt[4] ^= va;
+    u.vt[5] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[6] ^ __builtin_ia32_psllqi128(u.vt[7], 2)) & bsmask128[1];
+    u.vt[6] ^= va;
+    u.vt[7] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[8] ^ __builtin_ia32_psllqi128(u.vt[9], 2)) & bsmask128[1];
+    u.vt[8] ^= va;
+    u.vt[9] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[10] ^ __builtin_ia32_psllqi128(u.vt[11], 2)) & bsmask128[1];
+    u.vt[10] ^= va;
+    u.vt[11] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[12] ^ __builtin_ia32_psllqi128(u.vt[13], 2)) & bsmask128[1];
+    u.vt[12] ^= va;
+    u.vt[13] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[14] ^ __builtin_ia32_psllqi128(u.vt[15], 2)) & bsmask128[1];
+    u.vt[14] ^= va;
+    u.vt[15] ^= __builtin_ia32_psrlqi128(va, 2);
+    va = (u.vt[0] ^ __builtin_ia32_psllqi128(u.vt[2], 4)) & bsmask128[2];
+    u.vt[0] ^= va;
+    u.vt[2] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[1] ^ __builtin_ia32_psllqi128(u.vt[3], 4)) & bsmask128[2];
+    u.vt[1] ^= va;
+    u.vt[3] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[4] ^ __builtin_ia32_psllqi128(u.vt[6], 4)) & bsmask128[2];
+    u.vt[4] ^= va;
+    u.vt[6] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[5] ^ __builtin_ia32_psllqi128(u.vt[7], 4)) & bsmask128[2];
+    u.vt[5] ^= va;
+    u.vt[7] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[8] ^ __builtin_ia32_psllqi128(u.vt[10], 4)) & bsmask128[2];
+    u.vt[8] ^= va;
+    u.vt[10] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[9] ^ __builtin_ia32_psllqi128(u.vt[11], 4)) & bsmask128[2];
+    u.vt[9] ^= va;
+    u.vt[11] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[12] ^ __builtin_ia32_psllqi128(u.vt[14], 4)) & bsmask128[2];
+    u.vt[12] ^= va;
+    u.vt[14] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[13] ^ __builtin_ia32_psllqi128(u.vt[15], 4)) & bsmask128[2];
+    u.vt[13] ^= va;
+    u.vt[15] ^= __builtin_ia32_psrlqi128(va, 4);
+    va = (u.vt[0] ^ __builtin_ia32_psllqi128(u.vt[4], 8)) & bsmask128[3];
+    u.vt[0] ^= va;
+    u.vt[4] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[1] ^ __builtin_ia32_psllqi128(u.vt[5], 8)) & bsmask128[3];
+    u.vt[1] ^= va;
+    u.vt[5] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[2] ^ __builtin_ia32_psllqi128(u.vt[6], 8)) & bsmask128[3];
+    u.vt[2] ^= va;
+    u.vt[6] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[3] ^ __builtin_ia32_psllqi128(u.vt[7], 8)) & bsmask128[3];
+    u.vt[3] ^= va;
+    u.vt[7] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[8] ^ __builtin_ia32_psllqi128(u.vt[12], 8)) & bsmask128[3];
+    u.vt[8] ^= va;
+    u.vt[12] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[9] ^ __builtin_ia32_psllqi128(u.vt[13], 8)) & bsmask128[3];
+    u.vt[9] ^= va;
+    u.vt[13] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[10] ^ __builtin_ia32_psllqi128(u.vt[14], 8)) & bsmask128[3];
+    u.vt[10] ^= va;
+    u.vt[14] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[11] ^ __builtin_ia32_psllqi128(u.vt[15], 8)) & bsmask128[3];
+    u.vt[11] ^= va;
+    u.vt[15] ^= __builtin_ia32_psrlqi128(va, 8);
+    va = (u.vt[0] ^ __builtin_ia32_psllqi128(u.vt[8], 16)) & bsmask128[4];
+    u.vt[0] ^= va;
+    u.vt[8] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[1] ^ __builtin_ia32_psllqi128(u.vt[9], 16)) & bsmask128[4];
+    u.vt[1] ^= va;
+    u.vt[9] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[2] ^ __builtin_ia32_psllqi128(u.vt[10], 16)) & bsmask128[4];
+    u.vt[2] ^= va;
+    u.vt[10] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[3] ^ __builtin_ia32_psllqi128(u.vt[11], 16)) & bsmask128[4];
+    u.vt[3] ^= va;
+    u.vt[11] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[4] ^ __builtin_ia32_psllqi128(u.vt[12], 16)) & bsmask128[4];
+    u.vt[4] ^= va;
+    u.vt[12] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[5] ^ __builtin_ia32_psllqi128(u.vt[13], 16)) & bsmask128[4];
+    u.vt[5] ^= va;
+    u.vt[13] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[6] ^ __builtin_ia32_psllqi128(u.vt[14], 16)) & bsmask128[4];
+    u.vt[6] ^= va;
+    u.vt[14] ^= __builtin_ia32_psrlqi128(va, 16);
+    va = (u.vt[7] ^ __builtin_ia32_psllqi128(u.vt[15], 16)) & bsmask128[4];
+    u.vt[7] ^= va;
+    u.vt[15] ^= __builtin_ia32_psrlqi128(va, 16);
+  for (i = 0; i < 32 && i < dlen; i += 4)
+    _mm_stream_si128((__m128i *)(dst + i),
+                     (__m128i)_mm_shuffle_ps((__m128)u.vt[i/2], (__m128)u.vt[i/2 + 1], 0x88));
+  for (i = 32; i < dlen; i += 4)
+    _mm_stream_si128((__m128i *)(dst + i),
+                     (__m128i)_mm_shuffle_ps((__m128)u.vt[i/2 - 16], (__m128)u.vt[i/2 - 15], 0xdd));
+}
+
+#else
+
+/* Auto-generated by BitSliceK_print */
+static inline void BitSlice32_64(int slen, const uint64_t *src, int dlen, uint32_t *dst)
+{
+ uint64_t i, a, t[32];
+
+  memcpy(t, src, slen*sizeof(uint64_t));
+  memset(t+slen, 0, (32-slen)*sizeof(uint64_t));
+
+  a = (t[ 0] ^ (t[ 1] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 0] ^= a;
+  t[ 1] ^= a >>  1;
+  a = (t[ 2] ^ (t[ 3] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 2] ^= a;
+  t[ 3] ^= a >>  1;
+  a = (t[ 4] ^ (t[ 5] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 4] ^= a;
+  t[ 5] ^= a >>  1;
+  a = (t[ 6] ^ (t[ 7] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 6] ^= a;
+  t[ 7] ^= a >>  1;
+  a = (t[ 8] ^ (t[ 9] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 8] ^= a;
+  t[ 9] ^= a >>  1;
+  a = (t[10] ^ (t[11] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[10] ^= a;
+  t[11] ^= a >>  1;
+  a = (t[12] ^ (t[13] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[12] ^= a;
+  t[13] ^= a >>  1;
+  a = (t[14] ^ (t[15] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[14] ^= a;
+  t[15] ^= a >>  1;
+  a = (t[16] ^ (t[17] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[16] ^= a;
+  t[17] ^= a >>  1;
+  a = (t[18] ^ (t[19] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[18] ^= a;
+  t[19] ^= a >>  1;
+  a = (t[20] ^ (t[21] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[20] ^= a;
+  t[21] ^= a >>  1;
+  a = (t[22] ^ (t[23] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[22] ^= a;
+  t[23] ^= a >>  1;
+  a = (t[24] ^ (t[25] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[24] ^= a;
+  t[25] ^= a >>  1;
+  a = (t[26] ^ (t[27] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[26] ^= a;
+  t[27] ^= a >>  1;
+  a = (t[28] ^ (t[29] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[28] ^= a;
+  t[29] ^= a >>  1;
+  a = (t[30] ^ (t[31] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[30] ^= a;
+  t[31] ^= a >>  1;
+  a = (t[ 0] ^ (t[ 2] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 0] ^= a;
+  t[ 2] ^= a >>  2;
+  a = (t[ 1] ^ (t[ 3] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 1] ^= a;
+  t[ 3] ^= a >>  2;
+  a = (t[ 4] ^ (t[ 6] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 4] ^= a;
+  t[ 6] ^= a >>  2;
+  a = (t[ 5] ^ (t[ 7] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 5] ^= a;
+  t[ 7] ^= a >>  2;
+  a = (t[ 8] ^ (t[10] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 8] ^= a;
+  t[10] ^= a >>  2;
+  a = (t[ 9] ^ (t[11] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 9] ^= a;
+  t[11] ^= a >>  2;
+  a = (t[12] ^ (t[14] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[12] ^= a;
+  t[14] ^= a >>  2;
+  a = (t[13] ^ (t[15] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[13] ^= a;
+  t[15] ^= a >>  2;
+  a = (t[16] ^ (t[18] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[16] ^= a;
+  t[18] ^= a >>  2;
+  a = (t[17] ^ (t[19] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[17] ^= a;
+  t[19] ^= a >>  2;
+  a = (t[20] ^ (t[22] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[20] ^= a;
+  t[22] ^= a >>  2;
+  a = (t[21] ^ (t[23] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[21] ^= a;
+  t[23] ^= a >>  2;
+  a = (t[24] ^ (t[26] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[24] ^= a;
+  t[26] ^= a >>  2;
+  a = (t[25] ^ (t[27] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[25] ^= a;
+  t[27] ^= a >>  2;
+  a = (t[28] ^ (t[30] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[28] ^= a;
+  t[30] ^= a >>  2;
+  a = (t[29] ^ (t[31] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[29] ^= a;
+  t[31] ^= a >>  2;
+  a = (t[ 0] ^ (t[ 4] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 0] ^= a;
+  t[ 4] ^= a >>  4;
+  a = (t[ 1] ^ (t[ 5] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 1] ^= a;
+  t[ 5] ^= a >>  4;
+  a = (t[ 2] ^ (t[ 6] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 2] ^= a;
+  t[ 6] ^= a >>  4;
+  a = (t[ 3] ^ (t[ 7] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 3] ^= a;
+  t[ 7] ^= a >>  4;
+  a = (t[ 8] ^ (t[12] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 8] ^= a;
+  t[12] ^= a >>  4;
+  a = (t[ 9] ^ (t[13] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 9] ^= a;
+  t[13] ^= a >>  4;
+  a = (t[10] ^ (t[14] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[10] ^= a;
+  t[14] ^= a >>  4;
+  a = (t[11] ^ (t[15] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[11] ^= a;
+  t[15] ^= a >>  4;
+  a = (t[16] ^ (t[20] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[16] ^= a;
+  t[20] ^= a >>  4;
+  a = (t[17] ^ (t[21] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[17] ^= a;
+  t[21] ^= a >>  4;
+  a = (t[18] ^ (t[22] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[18] ^= a;
+  t[22] ^= a >>  4;
+  a = (t[19] ^ (t[23] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[19] ^= a;
+  t[23] ^= a >>  4;
+  a = (t[24] ^ (t[28] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[24] ^= a;
+  t[28] ^= a >>  4;
+  a = (t[25] ^ (t[29] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[25] ^= a;
+  t[29] ^= a >>  4;
+  a = (t[26] ^ (t[30] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[26] ^= a;
+  t[30] ^= a >>  4;
+  a = (t[27] ^ (t[31] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[27] ^= a;
+  t[31] ^= a >>  4;
+  a = (t[ 0] ^ (t[ 8] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 0] ^= a;
+  t[ 8] ^= a >>  8;
+  a = (t[ 1] ^ (t[ 9] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 1] ^= a;
+  t[ 9] ^= a >>  8;
+  a = (t[ 2] ^ (t[10] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 2] ^= a;
+  t[10] ^= a >>  8;
+  a = (t[ 3] ^ (t[11] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 3] ^= a;
+  t[11] ^= a >>  8;
+  a = (t[ 4] ^ (t[12] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 4] ^= a;
+  t[12] ^= a >>  8;
+  a = (t[ 5] ^ (t[13] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 5] ^= a;
+  t[13] ^= a >>  8;
+  a = (t[ 6] ^ (t[14] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 6] ^= a;
+  t[14] ^= a >>  8;
+  a = (t[ 7] ^ (t[15] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 7] ^= a;
+  t[15] ^= a >>  8;
+  a = (t[16] ^ (t[24] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[16] ^= a;
+  t[24] ^= a >>  8;
+  a = (t[17] ^ (t[25] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[17] ^= a;
+  t[25] ^= a >>  8;
+  a = (t[18] ^ (t[26] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[18] ^= a;
+  t[26] ^= a >>  8;
+  a = (t[19] ^ (t[27] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[19] ^= a;
+  t[27] ^= a >>  8;
+  a = (t[20] ^ (t[28] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[20] ^= a;
+  t[28] ^= a >>  8;
+  a = (t[21] ^ (t[29] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[21] ^= a;
+  t[29] ^= a >>  8;
+  a = (t[22] ^ (t[30] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[22] ^= a;
+  t[30] ^= a >>  8;
+  a = (t[23] ^ (t[31] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[23] ^= a;
+  t[31] ^= a >>  8;
+  a = (t[ 0] ^ (t[16] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 0] ^= a;
+  t[16] ^= a >> 16;
+  a = (t[ 1] ^ (t[17] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 1] ^= a;
+  t[17] ^= a >> 16;
+  a = (t[ 2] ^ (t[18] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 2] ^= a;
+  t[18] ^= a >> 16;
+  a = (t[ 3] ^ (t[19] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 3] ^= a;
+  t[19] ^= a >> 16;
+  a = (t[ 4] ^ (t[20] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 4] ^= a;
+  t[20] ^= a >> 16;
+  a = (t[ 5] ^ (t[21] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 5] ^= a;
+  t[21] ^= a >> 16;
+  a = (t[ 6] ^ (t[22] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 6] ^= a;
+  t[22] ^= a >> 16;
+  a = (t[ 7] ^ (t[23] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 7] ^= a;
+  t[23] ^= a >> 16;
+  a = (t[ 8] ^ (t[24] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 8] ^= a;
+  t[24] ^= a >> 16;
+  a = (t[ 9] ^ (t[25] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 9] ^= a;
+  t[25] ^= a >> 16;
+  a = (t[10] ^ (t[26] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[10] ^= a;
+  t[26] ^= a >> 16;
+  a = (t[11] ^ (t[27] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[11] ^= a;
+  t[27] ^= a >> 16;
+  a = (t[12] ^ (t[28] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[12] ^= a;
+  t[28] ^= a >> 16;
+  a = (t[13] ^ (t[29] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[13] ^= a;
+  t[29] ^= a >> 16;
+  a = (t[14] ^ (t[30] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[14] ^= a;
+  t[30] ^= a >> 16;
+  a = (t[15] ^ (t[31] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[15] ^= a;
+  t[31] ^= a >> 16;
+  for (i = 0; i < 32 && i < dlen; i++)
+    dst[i] = t[i];
+  for (i = 32; i < 64 && i < dlen; i++)
+    dst[i] = t[i-32] >> 32;
+}
+
+#endif /* __SSE2__ */
+
+#if BSVEC_BITS > 64
+
+/* Auto-generated by BitSliceK_vec_print */
+static inline void BitSlice32_vec(int slen, const bsvec_t *src, int dlen, uint32_t *dst)
+{
+  bsvec_t a, t[32];
+  int i, w;
+
+  for (i = 0; i < slen; i++)
+    t[i] = src[i];
+  for (; i < 32; i++)
+    t[i] = BS_ZERO;
+
+  a = (t[ 0] ^ (t[ 1] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 0] ^= a;
+  t[ 1] ^= a >>  1;
+  a = (t[ 2] ^ (t[ 3] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 2] ^= a;
+  t[ 3] ^= a >>  1;
+  a = (t[ 4] ^ (t[ 5] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 4] ^= a;
+  t[ 5] ^= a >>  1;
+  a = (t[ 6] ^ (t[ 7] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 6] ^= a;
+  t[ 7] ^= a >>  1;
+  a = (t[ 8] ^ (t[ 9] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 8] ^= a;
+  t[ 9] ^= a >>  1;
+  a = (t[10] ^ (t[11] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[10] ^= a;
+  t[11] ^= a >>  1;
+  a = (t[12] ^ (t[13] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[12] ^= a;
+  t[13] ^= a >>  1;
+  a = (t[14] ^ (t[15] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[14] ^= a;
+  t[15] ^= a >>  1;
+  a = (t[16] ^ (t[17] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[16] ^= a;
+  t[17] ^= a >>  1;
+  a = (t[18] ^ (t[19] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[18] ^= a;
+  t[19] ^= a >>  1;
+  a = (t[20] ^ (t[21] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[20] ^= a;
+  t[21] ^= a >>  1;
+  a = (t[22] ^ (t[23] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[22] ^= a;
+  t[23] ^= a >>  1;
+  a = (t[24] ^ (t[25] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[24] ^= a;
+  t[25] ^= a >>  1;
+  a = (t[26] ^ (t[27] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[26] ^= a;
+  t[27] ^= a >>  1;
+  a = (t[28] ^ (t[29] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[28] ^= a;
+  t[29] ^= a >>  1;
+  a = (t[30] ^ (t[31] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[30] ^= a;
+  t[31] ^= a >>  1;
+  a = (t[ 0] ^ (t[ 2] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 0] ^= a;
+  t[ 2] ^= a >>  2;
+  a = (t[ 1] ^ (t[ 3] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 1] ^= a;
+  t[ 3] ^= a >>  2;
+  a = (t[ 4] ^ (t[ 6] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 4] ^= a;
+  t[ 6] ^= a >>  2;
+  a = (t[ 5] ^ (t[ 7] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 5] ^= a;
+  t[ 7] ^= a >>  2;
+  a = (t[ 8] ^ (t[10] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 8] ^= a;
+  t[10] ^= a >>  2;
+  a = (t[ 9] ^ (t[11] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 9] ^= a;
+  t[11] ^= a >>  2;
+  a = (t[12] ^ (t[14] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[12] ^= a;
+  t[14] ^= a >>  2;
+  a = (t[13] ^ (t[15] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[13] ^= a;
+  t[15] ^= a >>  2;
+  a = (t[16] ^ (t[18] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[16] ^= a;
+  t[18] ^= a >>  2;
+  a = (t[17] ^ (t[19] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[17] ^= a;
+  t[19] ^= a >>  2;
+  a = (t[20] ^ (t[22] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[20] ^= a;
+  t[22] ^= a >>  2;
+  a = (t[21] ^ (t[23] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[21] ^= a;
+  t[23] ^= a >>  2;
+  a = (t[24] ^ (t[26] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[24] ^= a;
+  t[26] ^= a >>  2;
+  a = (t[25] ^ (t[27] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[25] ^= a;
+  t[27] ^= a >>  2;
+  a = (t[28] ^ (t[30] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[28] ^= a;
+  t[30] ^= a >>  2;
+  a = (t[29] ^ (t[31] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[29] ^= a;
+  t[31] ^= a >>  2;
+  a = (t[ 0] ^ (t[ 4] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 0] ^= a;
+  t[ 4] ^= a >>  4;
+  a = (t[ 1] ^ (t[ 5] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 1] ^= a;
+  t[ 5] ^= a >>  4;
+  a = (t[ 2] ^ (t[ 6] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 2] ^= a;
+  t[ 6] ^= a >>  4;
+  a = (t[ 3] ^ (t[ 7] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 3] ^= a;
+  t[ 7] ^= a >>  4;
+  a = (t[ 8] ^ (t[12] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 8] ^= a;
+  t[12] ^= a >>  4;
+  a = (t[ 9] ^ (t[13] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 9] ^= a;
+  t[13] ^= a >>  4;
+  a = (t[10] ^ (t[14] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[10] ^= a;
+  t[14] ^= a >>  4;
+  a = (t[11] ^ (t[15] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[11] ^= a;
+  t[15] ^= a >>  4;
+  a = (t[16] ^ (t[20] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[16] ^= a;
+  t[20] ^= a >>  4;
+  a = (t[17] ^ (t[21] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[17] ^= a;
+  t[21] ^= a >>  4;
+  a = (t[18] ^ (t[22] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[18] ^= a;
+  t[22] ^= a >>  4;
+  a = (t[19] ^ (t[23] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[19] ^= a;
+  t[23] ^= a >>  4;
+  a = (t[24] ^ (t[28] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[24] ^= a;
+  t[28] ^= a >>  4;
+  a = (t[25] ^ (t[29] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[25] ^= a;
+  t[29] ^= a >>  4;
+  a = (t[26] ^ (t[30] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[26] ^= a;
+  t[30] ^= a >>  4;
+  a = (t[27] ^ (t[31] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[27] ^= a;
+  t[31] ^= a >>  4;
+  a = (t[ 0] ^ (t[ 8] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 0] ^= a;
+  t[ 8] ^= a >>  8;
+  a = (t[ 1] ^ (t[ 9] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 1] ^= a;
+  t[ 9] ^= a >>  8;
+  a = (t[ 2] ^ (t[10] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 2] ^= a;
+  t[10] ^= a >>  8;
+  a = (t[ 3] ^ (t[11] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 3] ^= a;
+  t[11] ^= a >>  8;
+  a = (t[ 4] ^ (t[12] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 4] ^= a;
+  t[12] ^= a >>  8;
+  a = (t[ 5] ^ (t[13] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 5] ^= a;
+  t[13] ^= a >>  8;
+  a = (t[ 6] ^ (t[14] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 6] ^= a;
+  t[14] ^= a >>  8;
+  a = (t[ 7] ^ (t[15] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 7] ^= a;
+  t[15] ^= a >>  8;
+  a = (t[16] ^ (t[24] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[16] ^= a;
+  t[24] ^= a >>  8;
+  a = (t[17] ^ (t[25] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[17] ^= a;
+  t[25] ^= a >>  8;
+  a = (t[18] ^ (t[26] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[18] ^= a;
+  t[26] ^= a >>  8;
+  a = (t[19] ^ (t[27] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[19] ^= a;
+  t[27] ^= a >>  8;
+  a = (t[20] ^ (t[28] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[20] ^= a;
+  t[28] ^= a >>  8;
+  a = (t[21] ^ (t[29] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[21] ^= a;
+  t[29] ^= a >>  8;
+  a = (t[22] ^ (t[30] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[22] ^= a;
+  t[30] ^= a >>  8;
+  a = (t[23] ^ (t[31] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[23] ^= a;
+  t[31] ^= a >>  8;
+  a = (t[ 0] ^ (t[16] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 0] ^= a;
+  t[16] ^= a >> 16;
+  a = (t[ 1] ^ (t[17] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 1] ^= a;
+  t[17] ^= a >> 16;
+  a = (t[ 2] ^ (t[18] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 2] ^= a;
+  t[18] ^= a >> 16;
+  a = (t[ 3] ^ (t[19] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 3] ^= a;
+  t[19] ^= a >> 16;
+  a = (t[ 4] ^ (t[20] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 4] ^= a;
+  t[20] ^= a >> 16;
+  a = (t[ 5] ^ (t[21] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 5] ^= a;
+  t[21] ^= a >> 16;
+  a = (t[ 6] ^ (t[22] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 6] ^= a;
+  t[22] ^= a >> 16;
+  a = (t[ 7] ^ (t[23] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 7] ^= a;
+  t[23] ^= a >> 16;
+  a = (t[ 8] ^ (t[24] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 8] ^= a;
+  t[24] ^= a >> 16;
+  a = (t[ 9] ^ (t[25] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 9] ^= a;
+  t[25] ^= a >> 16;
+  a = (t[10] ^ (t[26] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[10] ^= a;
+  t[26] ^= a >> 16;
+  a = (t[11] ^ (t[27] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[11] ^= a;
+  t[27] ^= a >> 16;
+  a = (t[12] ^ (t[28] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[12] ^= a;
+  t[28] ^= a >> 16;
+  a = (t[13] ^ (t[29] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[13] ^= a;
+  t[29] ^= a >> 16;
+  a = (t[14] ^ (t[30] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[14] ^= a;
+  t[30] ^= a >> 16;
+  a = (t[15] ^ (t[31] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[15] ^= a;
+  t[31] ^= a >> 16;
+  for (w = 0; w < BSWORDS && 64*w < dlen; w++) {
+    for (i = 0; i < 32 && 64*w + i < dlen; i++)
+      dst[64*w + i] = t[i][w];
+    for (i = 32; i < 64 && 64*w + i < dlen; i++)
+      dst[64*w + i] = t[i-32][w] >> 32;
+  }
+}
+
+#ifdef BITSLICE_NT
+
+/* Auto-generated by BitSliceK_vec_print */
+static inline void BitSlice32_vec_nt(int slen, const bsvec_t *src, int dlen, uint32_t *dst)
+{
+  bsvec_t a, t[32];
+  uint32_t o[64] __attribute__((aligned(64)));
+  int i, w;
+
+  for (i = 0; i < slen; i++)
+    t[i] = src[i];
+  for (; i < 32; i++)
+    t[i] = BS_ZERO;
+
+  a = (t[ 0] ^ (t[ 1] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 0] ^= a;
+  t[ 1] ^= a >>  1;
+  a = (t[ 2] ^ (t[ 3] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 2] ^= a;
+  t[ 3] ^= a >>  1;
+  a = (t[ 4] ^ (t[ 5] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 4] ^= a;
+  t[ 5] ^= a >>  1;
+  a = (t[ 6] ^ (t[ 7] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 6] ^= a;
+  t[ 7] ^= a >>  1;
+  a = (t[ 8] ^ (t[ 9] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[ 8] ^= a;
+  t[ 9] ^= a >>  1;
+  a = (t[10] ^ (t[11] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[10] ^= a;
+  t[11] ^= a >>  1;
+  a = (t[12] ^ (t[13] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[12] ^= a;
+  t[13] ^= a >>  1;
+  a = (t[14] ^ (t[15] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[14] ^= a;
+  t[15] ^= a >>  1;
+  a = (t[16] ^ (t[17] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[16] ^= a;
+  t[17] ^= a >>  1;
+  a = (t[18] ^ (t[19] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[18] ^= a;
+  t[19] ^= a >>  1;
+  a = (t[20] ^ (t[21] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[20] ^= a;
+  t[21] ^= a >>  1;
+  a = (t[22] ^ (t[23] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[22] ^= a;
+  t[23] ^= a >>  1;
+  a = (t[24] ^ (t[25] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[24] ^= a;
+  t[25] ^= a >>  1;
+  a = (t[26] ^ (t[27] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[26] ^= a;
+  t[27] ^= a >>  1;
+  a = (t[28] ^ (t[29] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[28] ^= a;
+  t[29] ^= a >>  1;
+  a = (t[30] ^ (t[31] <<  1)) & UINT64_C(0xaaaaaaaaaaaaaaaa);
+  t[30] ^= a;
+  t[31] ^= a >>  1;
+  a = (t[ 0] ^ (t[ 2] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 0] ^= a;
+  t[ 2] ^= a >>  2;
+  a = (t[ 1] ^ (t[ 3] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 1] ^= a;
+  t[ 3] ^= a >>  2;
+  a = (t[ 4] ^ (t[ 6] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 4] ^= a;
+  t[ 6] ^= a >>  2;
+  a = (t[ 5] ^ (t[ 7] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 5] ^= a;
+  t[ 7] ^= a >>  2;
+  a = (t[ 8] ^ (t[10] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 8] ^= a;
+  t[10] ^= a >>  2;
+  a = (t[ 9] ^ (t[11] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[ 9] ^= a;
+  t[11] ^= a >>  2;
+  a = (t[12] ^ (t[14] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[12] ^= a;
+  t[14] ^= a >>  2;
+  a = (t[13] ^ (t[15] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[13] ^= a;
+  t[15] ^= a >>  2;
+  a = (t[16] ^ (t[18] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[16] ^= a;
+  t[18] ^= a >>  2;
+  a = (t[17] ^ (t[19] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[17] ^= a;
+  t[19] ^= a >>  2;
+  a = (t[20] ^ (t[22] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[20] ^= a;
+  t[22] ^= a >>  2;
+  a = (t[21] ^ (t[23] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[21] ^= a;
+  t[23] ^= a >>  2;
+  a = (t[24] ^ (t[26] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[24] ^= a;
+  t[26] ^= a >>  2;
+  a = (t[25] ^ (t[27] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[25] ^= a;
+  t[27] ^= a >>  2;
+  a = (t[28] ^ (t[30] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[28] ^= a;
+  t[30] ^= a >>  2;
+  a = (t[29] ^ (t[31] <<  2)) & UINT64_C(0xcccccccccccccccc);
+  t[29] ^= a;
+  t[31] ^= a >>  2;
+  a = (t[ 0] ^ (t[ 4] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 0] ^= a;
+  t[ 4] ^= a >>  4;
+  a = (t[ 1] ^ (t[ 5] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 1] ^= a;
+  t[ 5] ^= a >>  4;
+  a = (t[ 2] ^ (t[ 6] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 2] ^= a;
+  t[ 6] ^= a >>  4;
+  a = (t[ 3] ^ (t[ 7] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 3] ^= a;
+  t[ 7] ^= a >>  4;
+  a = (t[ 8] ^ (t[12] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 8] ^= a;
+  t[12] ^= a >>  4;
+  a = (t[ 9] ^ (t[13] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[ 9] ^= a;
+  t[13] ^= a >>  4;
+  a = (t[10] ^ (t[14] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[10] ^= a;
+  t[14] ^= a >>  4;
+  a = (t[11] ^ (t[15] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[11] ^= a;
+  t[15] ^= a >>  4;
+  a = (t[16] ^ (t[20] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[16] ^= a;
+  t[20] ^= a >>  4;
+  a = (t[17] ^ (t[21] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[17] ^= a;
+  t[21] ^= a >>  4;
+  a = (t[18] ^ (t[22] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[18] ^= a;
+  t[22] ^= a >>  4;
+  a = (t[19] ^ (t[23] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[19] ^= a;
+  t[23] ^= a >>  4;
+  a = (t[24] ^ (t[28] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[24] ^= a;
+  t[28] ^= a >>  4;
+  a = (t[25] ^ (t[29] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[25] ^= a;
+  t[29] ^= a >>  4;
+  a = (t[26] ^ (t[30] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[26] ^= a;
+  t[30] ^= a >>  4;
+  a = (t[27] ^ (t[31] <<  4)) & UINT64_C(0xf0f0f0f0f0f0f0f0);
+  t[27] ^= a;
+  t[31] ^= a >>  4;
+  a = (t[ 0] ^ (t[ 8] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 0] ^= a;
+  t[ 8] ^= a >>  8;
+  a = (t[ 1] ^ (t[ 9] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 1] ^= a;
+  t[ 9] ^= a >>  8;
+  a = (t[ 2] ^ (t[10] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 2] ^= a;
+  t[10] ^= a >>  8;
+  a = (t[ 3] ^ (t[11] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 3] ^= a;
+  t[11] ^= a >>  8;
+  a = (t[ 4] ^ (t[12] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 4] ^= a;
+  t[12] ^= a >>  8;
+  a = (t[ 5] ^ (t[13] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 5] ^= a;
+  t[13] ^= a >>  8;
+  a = (t[ 6] ^ (t[14] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 6] ^= a;
+  t[14] ^= a >>  8;
+  a = (t[ 7] ^ (t[15] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[ 7] ^= a;
+  t[15] ^= a >>  8;
+  a = (t[16] ^ (t[24] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[16] ^= a;
+  t[24] ^= a >>  8;
+  a = (t[17] ^ (t[25] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[17] ^= a;
+  t[25] ^= a >>  8;
+  a = (t[18] ^ (t[26] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[18] ^= a;
+  t[26] ^= a >>  8;
+  a = (t[19] ^ (t[27] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[19] ^= a;
+  t[27] ^= a >>  8;
+  a = (t[20] ^ (t[28] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[20] ^= a;
+  t[28] ^= a >>  8;
+  a = (t[21] ^ (t[29] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[21] ^= a;
+  t[29] ^= a >>  8;
+  a = (t[22] ^ (t[30] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[22] ^= a;
+  t[30] ^= a >>  8;
+  a = (t[23] ^ (t[31] <<  8)) & UINT64_C(0xff00ff00ff00ff00);
+  t[23] ^= a;
+  t[31] ^= a >>  8;
+  a = (t[ 0] ^ (t[16] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 0] ^= a;
+  t[16] ^= a >> 16;
+  a = (t[ 1] ^ (t[17] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 1] ^= a;
+  t[17] ^= a >> 16;
+  a = (t[ 2] ^ (t[18] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 2] ^= a;
+  t[18] ^= a >> 16;
+  a = (t[ 3] ^ (t[19] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 3] ^= a;
+  t[19] ^= a >> 16;
+  a = (t[ 4] ^ (t[20] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 4] ^= a;
+  t[20] ^= a >> 16;
+  a = (t[ 5] ^ (t[21] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 5] ^= a;
+  t[21] ^= a >> 16;
+  a = (t[ 6] ^ (t[22] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 6] ^= a;
+  t[22] ^= a >> 16;
+  a = (t[ 7] ^ (t[23] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 7] ^= a;
+  t[23] ^= a >> 16;
+  a = (t[ 8] ^ (t[24] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 8] ^= a;
+  t[24] ^= a >> 16;
+  a = (t[ 9] ^ (t[25] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[ 9] ^= a;
+  t[25] ^= a >> 16;
+  a = (t[10] ^ (t[26] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[10] ^= a;
+  t[26] ^= a >> 16;
+  a = (t[11] ^ (t[27] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[11] ^= a;
+  t[27] ^= a >> 16;
+  a = (t[12] ^ (t[28] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[12] ^= a;
+  t[28] ^= a >> 16;
+  a = (t[13] ^ (t[29] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[13] ^= a;
+  t[29] ^= a >> 16;
+  a = (t[14] ^ (t[30] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[14] ^= a;
+  t[30] ^= a >> 16;
+  a = (t[15] ^ (t[31] << 16)) & UINT64_C(0xffff0000ffff0000);
+  t[15] ^= a;
+  t[31] ^= a >> 16;
+  for (w = 0; w < BSWORDS && 64*w < dlen; w++) {
+    for (i = 0; i < 32; i++) {
+      o[i] = t[i][w];
+      o[i+32] = t[i][w] >> 32;
+    }
+    BitSliceStream(dst + 64*w, o, dlen - 64*w < 64 ? dlen - 64*w : 64);
+  }
+}
+
+#endif /* BITSLICE_NT */
+
+#endif /* BSVEC_BITS > 64 */
+
+#ifdef BITSLICE_GFNI
+
+/* Auto-generated by BitSliceK_gfni_print */
+static inline void BitSlice32_gfni(int slen, const bsvec_t *src, int dlen, uint32_t *dst)
+{
+  static const unsigned char perm[64] __attribute__((aligned(64))) = {
+    56, 48, 40, 32, 24, 16,  8,  0, 57, 49, 41, 33, 25, 17,  9,  1,
+    58, 50, 42, 34, 26, 18, 10,  2, 59, 51, 43, 35, 27, 19, 11,  3,
+    60, 52, 44, 36, 28, 20, 12,  4, 61, 53, 45, 37, 29, 21, 13,  5,
+    62, 54, 46, 38, 30, 22, 14,  6, 63, 55, 47, 39, 31, 23, 15,  7,
+  };
+  static const unsigned char merge[4][64] __attribute__((aligned(64))) = {
+    {
+       0, 64,  0, 64,  1, 65,  1, 65,  2, 66,  2, 66,  3, 67,  3, 67,
+       4, 68,  4, 68,  5, 69,  5, 69,  6, 70,  6, 70,  7, 71,  7, 71,
+       8, 72,  8, 72,  9, 73,  9, 73, 10, 74, 10, 74, 11, 75, 11, 75,
+      12, 76, 12, 76, 13, 77, 13, 77, 14, 78, 14, 78, 15, 79, 15, 79,
+    },
+    {
+      16, 80, 16, 80, 17, 81, 17, 81, 18, 82, 18, 82, 19, 83, 19, 83,
+      20, 84, 20, 84, 21, 85, 21, 85, 22, 86, 22, 86, 23, 87, 23, 87,
+      24, 88, 24, 88, 25, 89, 25, 89, 26, 90, 26, 90, 27, 91, 27, 91,
+      28, 92, 28, 92, 29, 93, 29, 93, 30, 94, 30, 94, 31, 95, 31, 95,
+    },
+    {
+      32, 96, 32, 96, 33, 97, 33, 97, 34, 98, 34, 98, 35, 99, 35, 99,
+      36, 100, 36, 100, 37, 101, 37, 101, 38, 102, 38, 102, 39, 103, 39, 103,
+      40, 104, 40, 104, 41, 105, 41, 105, 42, 106, 42, 106, 43, 107, 43, 107,
+      44, 108, 44, 108, 45, 109, 45, 109, 46, 110, 46, 110, 47, 111, 47, 111,
+    },
+    {
+      48, 112, 48, 112, 49, 113, 49, 113, 50, 114, 50, 114, 51, 115, 51, 115,
+      52, 116, 52, 116, 53, 117, 53, 117, 54, 118, 54, 118, 55, 119, 55, 119,
+      56, 120, 56, 120, 57, 121, 57, 121, 58, 122, 58, 122, 59, 123, 59, 123,
+      60, 124, 60, 124, 61, 125, 61, 125, 62, 126, 62, 126, 63, 127, 63, 127,
+    },
+  };
+  const __m512i identity = _mm512_set1_epi64(UINT64_C(0x8040201008040201));
+  const __m512i slices = _mm512_set_epi64(7*BSWORDS, 6*BSWORDS, 5*BSWORDS, 4*BSWORDS,
+                                          3*BSWORDS, 2*BSWORDS, BSWORDS, 0);
+  __m512i x, z[4];
+  int g, n, q, w;
+
+  for (w = 0; w < BSWORDS && 64*w < dlen; w++) {
+    for (g = 0; g < 4; g++) {
+      n = slen - 8*g;
+      n = n < 0 ? 0 : n > 8 ? 8 : n;
+      x = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), (1 << n) - 1, slices,
+                                      (const long long *)&src[8*g] + w, 8);
+      x = _mm512_permutexvar_epi8(_mm512_load_si512(perm), x);
+      z[g] = _mm512_gf2p8affine_epi64_epi8(identity, x, 0);
+    }
+    for (q = 0; q < 4; q++) {
+      __m512i m = _mm512_load_si512(merge[q]);
+
+      x = _mm512_maskz_permutex2var_epi8(UINT64_C(0x3333333333333333), z[0], m, z[1]);
+      x |= _mm512_maskz_permutex2var_epi8(UINT64_C(0xcccccccccccccccc), z[2], m, z[3]);
+      n = dlen - 64*w - 16*q;
+      n = n < 0 ? 0 : n > 16 ? 16 : n;
+      _mm512_mask_storeu_epi32(dst + 64*w + 16*q, (1 << n) - 1, x);
+    }
+  }
+}
+
+/* Auto-generated by BitSliceK_gfni_print */
+static inline void BitSlice32_gfni_nt(int slen, const bsvec_t *src, int dlen, uint32_t *dst)
+{
+  static const unsigned char perm[64] __attribute__((aligned(64))) = {
+    56, 48, 40, 32, 24, 16,  8,  0, 57, 49, 41, 33, 25, 17,  9,  1,
+    58, 50, 42, 34, 26, 18, 10,  2, 59, 51, 43, 35, 27, 19, 11,  3,
+    60, 52, 44, 36, 28, 20, 12,  4, 61, 53, 45, 37, 29, 21, 13,  5,
+    62, 54, 46, 38, 30, 22, 14,  6, 63, 55, 47, 39, 31, 23, 15,  7,
+  };
+  static const unsigned char merge[4][64] __attribute__((aligned(64))) = {
+    {
+       0, 64,  0, 64,  1, 65,  1, 65,  2, 66,  2, 66,  3, 67,  3, 67,
+       4, 68,  4, 68,  5, 69,  5, 69,  6, 70,  6, 70,  7, 71,  7, 71,
+       8, 72,  8, 72,  9, 73,  9, 73, 10, 74, 10, 74, 11, 75, 11, 75,
+      12, 76, 12, 76, 13, 77, 13, 77, 14, 78, 14, 78, 15, 79, 15, 79,
+    },
+    {
+      16, 80, 16, 80, 17, 81, 17, 81, 18, 82, 18, 82, 19, 83, 19, 83,
+      20, 84, 20, 84, 21, 85, 21, 85, 22, 86, 22, 86, 23, 87, 23, 87,
+      24, 88, 24, 88, 25, 89, 25, 89, 26, 90, 26, 90, 27, 91, 27, 91,
+      28, 92, 28, 92, 29, 93, 29, 93, 30, 94, 30, 94, 31, 95, 31, 95,
+    },
+    {
+      32, 96, 32, 96, 33, 97, 33, 97, 34, 98, 34, 98, 35, 99, 35, 99,
+      36, 100, 36, 100, 37, 101, 37, 101, 38, 102, 38, 102, 39, 103, 39, 103,
+      40, 104, 40, 104, 41, 105, 41, 105, 42, 106, 42, 106, 43, 107, 43, 107,
+      44, 108, 44, 108, 45, 109, 45, 109, 46, 110, 46, 110, 47, 111, 47, 111,
+    },
+    {
+      48, 112, 48, 112, 49, 113, 49, 113, 50, 114, 50, 114, 51, 115, 51, 115,
+      52, 116, 52, 116, 53, 117, 53, 117, 54, 118, 54, 118, 55, 119, 55, 119,
+      56, 120, 56, 120, 57, 121, 57, 121, 58, 122, 58, 122, 59, 123, 59, 123,
+      60, 124, 60, 124, 61, 125, 61, 125, 62, 126, 62, 126, 63, 127, 63, 127,
+    },
+  };
+  const __m512i identity = _mm512_set1_epi64(UINT64_C(0x8040201008040201));
+  const __m512i slices = _mm512_set_epi64(7*BSWORDS, 6*BSWORDS, 5*BSWORDS, 4*BSWORDS,
+                                          3*BSWORDS, 2*BSWORDS, BSWORDS, 0);
+  __m512i x, z[4];
+  int g, n, q, w;
+
+  for (w = 0; w < BSWORDS && 64*w < dlen; w++) {
+    for (g = 0; g < 4; g++) {
+      n = slen - 8*g;
+      n = n < 0 ? 0 : n > 8 ? 8 : n;
+      x = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), (1 << n) - 1, slices,
+                                      (const long long *)&src[8*g] + w, 8);
+      x = _mm512_permutexvar_epi8(_mm512_load_si512(perm), x);
+      z[g] = _mm512_gf2p8affine_epi64_epi8(identity, x, 0);
+    }
+    for (q = 0; q < 4; q++) {
+      __m512i m = _mm512_load_si512(merge[q]);
+
+      x = _mm512_maskz_permutex2var_epi8(UINT64_C(0x3333333333333333), z[0], m, z[1]);
+      x |= _mm512_maskz_permutex2var_epi8(UINT64_C(0xcccccccccccccccc), z[2], m, z[3]);
+      if (64*w + 16*q < dlen)
+        _mm512_stream_si512((void *)(dst + 64*w + 16*q), x);
+    }
+  }
+}
+
+#endif /* BITSLICE_GFNI */
@@ -13,12 +13,12 @@ void BitSliceK_print(int K)
   };
 
   printf("/* Auto-generated by %s */\n"
-         "static inline void BitSlice%d(int slen, bsvec_t *src, int dlen, uint32_t *dst)\n"
+         "static inline void BitSlice%d_64(int slen, const uint64_t *src, int dlen, uint32_t *dst)\n"
          "{\n"
-         " bsvec_t i, a, t[32];\n"
+         " uint64_t i, a, t[32];\n"
          "\n"
-         "  memcpy(t, src, slen*sizeof(bsvec_t));\n"
-	 "  memset(t+slen, 0, (32-slen)*sizeof(bsvec_t));\n"
+         "  memcpy(t, src, slen*sizeof(uint64_t));\n"
+	 "  memset(t+slen, 0, (32-slen)*sizeof(uint64_t));\n"
          "\n",
          __func__, K);
 
@@ -51,7 +51,9 @@ void preamble_sse2(void)
          "#endif\n\n");
 }
 
-void BitSliceK_sse2_print(int K)
+/* With nt, the streaming variant: pairs of 64-bit words are split into
+   their low and high halves with shufps and written with movntdq */
+void BitSliceK_sse2_print(int K, int nt)
 {
   static const uint64_t mask[6] = {
     UINT64_C(0xaaaaaaaaaaaaaaaa), UINT64_C(0xcccccccccccccccc), UINT64_C(0xf0f0f0f0f0f0f0f0),  
@@ -60,7 +62,7 @@ void BitSliceK_sse2_print(int K)
   int i, j, k, m;
 
   printf("/* Auto-generated by %s */\n"
-         "static inline void BitSlice%d(int slen, bsvec_t *src, int dlen, uint32_t *dst)\n"
+         "static inline void BitSlice%d_64%s(int slen, const uint64_t *src, int dlen, uint32_t *dst)\n"
          "{\n"
          "  int i;\n"
          "  uint64_t a;\n"
@@ -77,7 +79,7 @@ void BitSliceK_sse2_print(int K)
          "\n"
          "  memset(&u, 0, sizeof(u));\n"
          "  memcpy(u.t, src, slen*sizeof(uint64_t));\n",
-         __func__, K);
+         __func__, K, nt ? "_nt" : "");
 
   m = 0;
   i = 1;
@@ -111,24 +113,231 @@ void BitSliceK_sse2_print(int K)
     m++;
   }
 
-  printf("  for (i = 0; i < dlen; i++)\n"
-         "    dst[i] = u.t[i & 0x1f] >> (i & 0xe0);\n"
+  if (nt)
+    printf("  for (i = 0; i < 32 && i < dlen; i += 4)\n"
+           "    _mm_stream_si128((__m128i *)(dst + i),\n"
+           "                     (__m128i)_mm_shuffle_ps((__m128)u.vt[i/2], (__m128)u.vt[i/2 + 1], 0x88));\n"
+           "  for (i = 32; i < dlen; i += 4)\n"
+           "    _mm_stream_si128((__m128i *)(dst + i),\n"
+           "                     (__m128i)_mm_shuffle_ps((__m128)u.vt[i/2 - 16], (__m128)u.vt[i/2 - 15], 0xdd));\n"
+           "}\n");
+  else
+    printf("  for (i = 0; i < dlen; i++)\n"
+           "    dst[i] = u.t[i & 0x1f] >> (i & 0xe0);\n"
+           "}\n");
+}
+
+/* Same butterfly as BitSliceK_print, but on whole bsvec_t's, so the
+   transposes of all the 64-lane words are done at once in the widest
+   registers the target has.  With nt, the streaming variant, which
+   puts each word's 64 outputs together in o and writes them out with
+   BitSliceStream. */
+void BitSliceK_vec_print(int K, int nt)
+{
+  int i, j, k, m;
+  static const uint64_t mask[6] = {
+    UINT64_C(0x5555555555555555), UINT64_C(0x3333333333333333), UINT64_C(0x0f0f0f0f0f0f0f0f), 
+    UINT64_C(0x00ff00ff00ff00ff), UINT64_C(0x0000ffff0000ffff), UINT64_C(0x00000000ffffffff)
+  };
+
+  printf("/* Auto-generated by %s */\n"
+         "static inline void BitSlice%d_vec%s(int slen, const bsvec_t *src, int dlen, uint32_t *dst)\n"
+         "{\n"
+         "  bsvec_t a, t[32];\n"
+         "%s"
+         "  int i, w;\n"
+         "\n"
+         "  for (i = 0; i < slen; i++)\n"
+         "    t[i] = src[i];\n"
+         "  for (; i < 32; i++)\n"
+         "    t[i] = BS_ZERO;\n"
+         "\n",
+         __func__, K, nt ? "_nt" : "",
+         nt ? "  uint32_t o[64] __attribute__((aligned(64)));\n" : "");
+
+  m = 0;
+  for (i = 1; i < 32; i <<= 1) {
+    for (j = 0; j < 32; j += 2*i) {
+      for (k = 0; k < i; k++) {
+	if (j + k < K) {
+	  printf("  a = (t[%2d] ^ (t[%2d] << %2d)) & UINT64_C(0x%016" PRIx64 ");\n", 
+		 j + k, j + i + k, i, ~mask[m]);
+	  printf("  t[%2d] ^= a;\n", j + k);
+	  printf("  t[%2d] ^= a >> %2d;\n", j + i + k, i);
+	}
+      }
+    }
+    m++;
+  }
+
+  if (nt)
+    printf("  for (w = 0; w < BSWORDS && 64*w < dlen; w++) {\n"
+           "    for (i = 0; i < 32; i++) {\n"
+           "      o[i] = t[i][w];\n"
+           "      o[i+32] = t[i][w] >> 32;\n"
+           "    }\n"
+           "    BitSliceStream(dst + 64*w, o, dlen - 64*w < 64 ? dlen - 64*w : 64);\n"
+           "  }\n"
+           "}\n");
+  else
+    printf("  for (w = 0; w < BSWORDS && 64*w < dlen; w++) {\n"
+           "    for (i = 0; i < 32 && 64*w + i < dlen; i++)\n"
+           "      dst[64*w + i] = t[i][w];\n"
+           "    for (i = 32; i < 64 && 64*w + i < dlen; i++)\n"
+           "      dst[64*w + i] = t[i-32][w] >> 32;\n"
+           "  }\n"
+           "}\n");
+}
+
+void preamble_gfni(void)
+{
+  printf("#if BSVEC_BITS == 512 && defined(__GFNI__) && defined(__AVX512VBMI__)\n"
+         "#include <immintrin.h>\n"
+         "#define BITSLICE_GFNI\n"
+         "#endif\n\n");
+}
+
+static void print_bytes(const char *indent, const unsigned char *b, int n)
+{
+  int i;
+
+  for (i = 0; i < n; i++)
+    printf("%s%2d,%s", i % 16 ? "" : indent, b[i], i % 16 == 15 || i == n-1 ? "\n" : " ");
+}
+
+/* With AVX-512, GFNI and VBMI, each 64-lane word of 8 slices is
+   transposed with one byte permutation, which puts the 8 slices of
+   each group of 8 lanes in one qword (slice 0 in the top byte), and
+   one gf2p8affineqb, which transposes each qword as an 8x8 bit matrix
+   against the identity.  That leaves byte i of zmm g holding bits
+   8g..8g+7 of the output for lane i, and a pair of byte permutations
+   per 16 lanes interleaves the K/8 groups into 32-bit outputs.  With
+   nt, the streaming variant, which writes each 16 outputs with one
+   vmovntdq. */
+void BitSliceK_gfni_print(int K, int nt)
+{
+  unsigned char perm[64], merge[4][64];
+  int b, g, i, k, q;
+
+  for (b = 0; b < 8; b++)
+    for (k = 0; k < 8; k++)
+      perm[8*b + 7-k] = 8*k + b;
+  /* Output byte j of lane 16q+i comes from byte 16q+i of zmm j,
+     selected from the pair of zmm's (j & ~1, j | 1) */
+  for (q = 0; q < 4; q++)
+    for (i = 0; i < 16; i++)
+      for (g = 0; g < 4; g++)
+        merge[q][4*i + g] = (g & 1)*64 + 16*q + i;
+
+  printf("/* Auto-generated by %s */\n"
+         "static inline void BitSlice%d_gfni%s(int slen, const bsvec_t *src, int dlen, uint32_t *dst)\n"
+         "{\n"
+         "  static const unsigned char perm[64] __attribute__((aligned(64))) = {\n",
+         __func__, K, nt ? "_nt" : "");
+  print_bytes("    ", perm, 64);
+  printf("  };\n"
+         "  static const unsigned char merge[4][64] __attribute__((aligned(64))) = {\n");
+  for (q = 0; q < 4; q++) {
+    printf("    {\n");
+    print_bytes("      ", merge[q], 64);
+    printf("    },\n");
+  }
+  printf("  };\n"
+         "  const __m512i identity = _mm512_set1_epi64(UINT64_C(0x8040201008040201));\n"
+         "  const __m512i slices = _mm512_set_epi64(7*BSWORDS, 6*BSWORDS, 5*BSWORDS, 4*BSWORDS,\n"
+         "                                          3*BSWORDS, 2*BSWORDS, BSWORDS, 0);\n"
+         "  __m512i x, z[%d];\n"
+         "  int g, n, q, w;\n"
+         "\n"
+         "  for (w = 0; w < BSWORDS && 64*w < dlen; w++) {\n"
+         "    for (g = 0; g < %d; g++) {\n"
+         "      n = slen - 8*g;\n"
+         "      n = n < 0 ? 0 : n > 8 ? 8 : n;\n"
+         "      x = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), (1 << n) - 1, slices,\n"
+         "                                      (const long long *)&src[8*g] + w, 8);\n"
+         "      x = _mm512_permutexvar_epi8(_mm512_load_si512(perm), x);\n"
+         "      z[g] = _mm512_gf2p8affine_epi64_epi8(identity, x, 0);\n"
+         "    }\n"
+         "    for (q = 0; q < 4; q++) {\n"
+         "      __m512i m = _mm512_load_si512(merge[q]);\n"
+         "\n"
+         "      x = _mm512_maskz_permutex2var_epi8(UINT64_C(0x3333333333333333), z[0], m, z[1]);\n",
+         K/8, K/8);
+  if (K > 24)
+    printf("      x |= _mm512_maskz_permutex2var_epi8(UINT64_C(0xcccccccccccccccc), z[2], m, z[3]);\n");
+  else
+    printf("      x |= _mm512_maskz_permutexvar_epi8(UINT64_C(0x4444444444444444), m, z[2]);\n");
+  if (nt)
+    printf("      if (64*w + 16*q < dlen)\n"
+           "        _mm512_stream_si512((void *)(dst + 64*w + 16*q), x);\n");
+  else
+    printf("      n = dlen - 64*w - 16*q;\n"
+           "      n = n < 0 ? 0 : n > 16 ? 16 : n;\n"
+           "      _mm512_mask_storeu_epi32(dst + 64*w + 16*q, (1 << n) - 1, x);\n");
+  printf("    }\n"
+         "  }\n"
          "}\n");
 }
 
+/* The _nt variants of the kernels write their output with
+   non-temporal stores, which go around the cache instead of reading
+   each line in first (see bitslice.h for what they need of dst) */
+void preamble_nt(void)
+{
+  printf("#ifdef __SSE2__\n"
+         "#include <immintrin.h>\n"
+         "#define BITSLICE_NT\n"
+         "\n"
+         "/* Copy n (a multiple of 16) words from src to dst, both 64-byte\n"
+         "   aligned, with non-temporal stores */\n"
+         "static inline void BitSliceStream(uint32_t *dst, const uint32_t *src, int n)\n"
+         "{\n"
+         "  int i;\n"
+         "\n"
+         "#ifdef __AVX512F__\n"
+         "  for (i = 0; i < n; i += 16)\n"
+         "    _mm512_stream_si512((void *)(dst + i), _mm512_load_si512(src + i));\n"
+         "#elif defined(__AVX__)\n"
+         "  for (i = 0; i < n; i += 8)\n"
+         "    _mm256_stream_si256((__m256i *)(dst + i), _mm256_load_si256((const __m256i *)(src + i)));\n"
+         "#else\n"
+         "  for (i = 0; i < n; i += 4)\n"
+         "    _mm_stream_si128((__m128i *)(dst + i), _mm_load_si128((const __m128i *)(src + i)));\n"
+         "#endif\n"
+         "}\n"
+         "#endif\n\n");
+}
+
 void BitSliceK_all(int K)
 {
   printf("#ifdef __SSE2__\n\n");
-  BitSliceK_sse2_print(K);
+  BitSliceK_sse2_print(K, 0);
+  printf("\n");
+  BitSliceK_sse2_print(K, 1);
   printf("\n#else\n\n");
   BitSliceK_print(K);
   printf("\n#endif /* __SSE2__ */\n");
+
+  printf("\n#if BSVEC_BITS > 64\n\n");
+  BitSliceK_vec_print(K, 0);
+  printf("\n#ifdef BITSLICE_NT\n\n");
+  BitSliceK_vec_print(K, 1);
+  printf("\n#endif /* BITSLICE_NT */\n");
+  printf("\n#endif /* BSVEC_BITS > 64 */\n");
+
+  printf("\n#ifdef BITSLICE_GFNI\n\n");
+  BitSliceK_gfni_print(K, 0);
+  printf("\n");
+  BitSliceK_gfni_print(K, 1);
+  printf("\n#endif /* BITSLICE_GFNI */\n");
 }
 
 void preamble_all(void)
 {
   /* preamble() */
   preamble_sse2();
+  preamble_gfni();
+  preamble_nt();
 }
 
 int main(int argc, char **argv)
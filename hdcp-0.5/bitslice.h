@@ -2,28 +2,76 @@
 #define __BITSLICE_H__
 
 #include <inttypes.h>
+#include <stdio.h>
 #include <string.h>
 
+/* The number of bit-slice lanes.  The default (64) uses plain 64-bit
+   words.  Wider lanes use gcc vector types, and hdcp_cipher.c is
+   compiled once for each width (see the Makefile and hdcp_engine.h). */
+#ifndef BSVEC_BITS
+#define BSVEC_BITS 64
+#endif
+
+#if BSVEC_BITS == 64
 typedef uint64_t bsvec_t;
+#define BS_WORD(v,w) (v)
+#else
+typedef uint64_t bsvec_t __attribute__((vector_size(BSVEC_BITS / 8)));
+#define BS_WORD(v,w) ((v)[w])
+#endif
 
 #define BSBITS (8*sizeof(bsvec_t))
 
+/* Number of 64-bit words in a bsvec_t */
+#define BSWORDS (BSVEC_BITS / 64)
+
+#define BS_ZERO ((bsvec_t){ 0 })
+
+/* Bit i of v, i.e. the value of lane i */
+#define BS_LANE(v,i) ((BS_WORD(v, (i) / 64) >> ((i) % 64)) & UINT64_C(1))
+
 /* Compute the transpose of a slen x 64 bit matrix stored in src */
-static inline void BitSlice(int slen, bsvec_t *src, int dlen, bsvec_t *dst)
+static inline void BitSlice64(int slen, const uint64_t *src, int dlen, uint64_t *dst)
 {
   int i, j, k, m;
-  bsvec_t a, t[BSBITS];
-  static const bsvec_t mask[6] = {
-    UINT64_C(0xaaaaaaaaaaaaaaaa), UINT64_C(0xcccccccccccccccc), UINT64_C(0xf0f0f0f0f0f0f0f0),  
+  uint64_t a, t[64];
+  static const uint64_t mask[6] = {
+    UINT64_C(0xaaaaaaaaaaaaaaaa), UINT64_C(0xcccccccccccccccc), UINT64_C(0xf0f0f0f0f0f0f0f0),
     UINT64_C(0xff00ff00ff00ff00), UINT64_C(0xffff0000ffff0000), UINT64_C(0xffffffff00000000)
   };
 
   memset(t, 0, sizeof(t));
-  memcpy(t, src, slen*sizeof(bsvec_t));
+  memcpy(t, src, slen*sizeof(uint64_t));
+
+  m = 0;
+  for (i = 1; i < 64; i <<= 1) {
+    for (j = 0; j < 64; j += 2*i) {
+      for (k = 0; k < i; k++) {
+	a = (t[j + k] ^ (t[j + i + k] << i)) & mask[m];
+	t[j + k] ^= a;
+	t[j + i + k] ^= a >> i;
+      }
+    }
+    m++;
+  }
+
+  memcpy(dst, t, dlen*sizeof(uint64_t));
+}
+
+#if BSVEC_BITS > 64
+/* BitSlice64 on all the 64-bit words of 64 bsvec_t's at once */
+static inline void BitSliceVec(bsvec_t t[64])
+{
+  int i, j, k, m;
+  bsvec_t a;
+  static const uint64_t mask[6] = {
+    UINT64_C(0xaaaaaaaaaaaaaaaa), UINT64_C(0xcccccccccccccccc), UINT64_C(0xf0f0f0f0f0f0f0f0),
+    UINT64_C(0xff00ff00ff00ff00), UINT64_C(0xffff0000ffff0000), UINT64_C(0xffffffff00000000)
+  };
 
   m = 0;
-  for (i = 1; i < BSBITS; i <<= 1) {
-    for (j = 0; j < BSBITS; j += 2*i) {
+  for (i = 1; i < 64; i <<= 1) {
+    for (j = 0; j < 64; j += 2*i) {
       for (k = 0; k < i; k++) {
 	a = (t[j + k] ^ (t[j + i + k] << i)) & mask[m];
 	t[j + k] ^= a;
@@ -32,17 +80,85 @@ static inline void BitSlice(int slen, bsvec_t *src, int dlen, bsvec_t *dst)
     }
     m++;
   }
+}
+#endif
+
+/* Bit-slice slen values of up to 64 bits: bit i of src[j] becomes lane
+   j of dst[i], for i < dlen. */
+static inline void BitSlice(int slen, const uint64_t *src, int dlen, bsvec_t *dst)
+{
+#if BSVEC_BITS == 64
+  BitSlice64(slen, src, dlen, dst);
+#else
+  bsvec_t t[64];
+  int i, w;
 
+  for (i = 0; i < 64; i++)
+    for (w = 0; w < BSWORDS; w++)
+      t[i][w] = 64*w + i < slen ? src[64*w + i] : 0;
+  BitSliceVec(t);
   memcpy(dst, t, dlen*sizeof(bsvec_t));
+#endif
+}
+
+/* The inverse of BitSlice: lane j of src[i] becomes bit i of dst[j],
+   for j < dlen. */
+static inline void BitUnslice(int slen, const bsvec_t *src, int dlen, uint64_t *dst)
+{
+#if BSVEC_BITS == 64
+  BitSlice64(slen, src, dlen, dst);
+#else
+  bsvec_t t[64];
+  int i, w;
+
+  memcpy(t, src, slen*sizeof(bsvec_t));
+  for (i = slen; i < 64; i++)
+    t[i] = BS_ZERO;
+  BitSliceVec(t);
+  for (w = 0; w < BSWORDS && 64*w < dlen; w++)
+    for (i = 0; i < 64 && 64*w + i < dlen; i++)
+      dst[64*w + i] = t[i][w];
+#endif
 }
 
 static inline void BS_print(int dlen, int which, bsvec_t *data)
 {
-  bsvec_t bsd[BSBITS];
-  BitSlice(dlen, data, which + 1, bsd);
+  uint64_t bsd[BSBITS];
+  BitUnslice(dlen, data, which + 1, bsd);
   printf("%0*" PRIx64, (dlen + 3) / 4, bsd[which]);
 }
 
 #include "bitslice-autogen.h"
 
+/* Transpose slen (<= 24 or 32) slices into dlen values of output.
+   Which version is used depends on what the lane width's build is
+   compiled for (see bitslice-gen.c). */
+#if BSVEC_BITS == 64
+#define BitSlice24 BitSlice24_64
+#define BitSlice32 BitSlice32_64
+#elif defined(BITSLICE_GFNI)
+#define BitSlice24 BitSlice24_gfni
+#define BitSlice32 BitSlice32_gfni
+#else
+#define BitSlice24 BitSlice24_vec
+#define BitSlice32 BitSlice32_vec
+#endif
+
+/* The same with non-temporal stores, where the target has them
+   (BITSLICE_NT is defined): dst must be 64-byte aligned and dlen a
+   multiple of 16, and the stores need an _mm_sfence() before another
+   thread can count on seeing them */
+#ifdef BITSLICE_NT
+#if BSVEC_BITS == 64
+#define BitSlice24_nt BitSlice24_64_nt
+#define BitSlice32_nt BitSlice32_64_nt
+#elif defined(BITSLICE_GFNI)
+#define BitSlice24_nt BitSlice24_gfni_nt
+#define BitSlice32_nt BitSlice32_gfni_nt
+#else
+#define BitSlice24_nt BitSlice24_vec_nt
+#define BitSlice32_nt BitSlice32_vec_nt
+#endif
+#endif
+
 #endif /* __BITSLICE_H__ */
@@ -13,22 +13,1098 @@
 #include <time.h>
 #include <stdint.h>
 #include <string.h>
+#include <unistd.h>
+#include <pthread.h>
 #include "bitslice.h"
 #include "hdcp_cipher.h"
+#include "hdcp_scalar.h"
+#include "hdcp_engine.h"
+#include "hdcp_pool.h"
+#include "hdcp_pipeline.h"
+#include "hdcp_stream.h"
+#include "hdcp_cache.h"
+#include "hdcp_auth.h"
+#include "hdcp_chain.h"
+#include "hdcp_seek.h"
+#include "hdcp_budget.h"
+#include "hdcp_tune.h"
+#include "hdcp_mem.h"
+#include "hdcp_bench.h"
+#include "hdcp_profile.h"
 
 
+/* Check that every engine this CPU supports produces the same output
+   as the default 64-lane cipher, which processes its frames in batches
+   of 64 (or fewer, for the scalar engine), and the same output again
+   when asked for it frame-major. */
+int check_engines(void)
+{
+  const uint64_t Ks = UINT64_C(0x1234567890abcd), M0 = UINT64_C(0xfedcba0987654321);
+  const int height = 3, width = 70;
+  const HDCPEngine *e;
+  int i, j, b, lanes, all_passed = 1;
+
+  for (i = 0; (e = HDCPListEngines(i)); i++) {
+    uint64_t Ki[e->lanes], Ri[e->lanes], Mi[e->lanes], Ki64[64], Ri64[64], Mi64[64];
+    uint32_t (*outputs)[width][e->lanes] = malloc(sizeof(uint32_t) * height * width * e->lanes);
+    uint32_t (*major)[height][width] = malloc(sizeof(uint32_t) * height * width * e->lanes);
+    uint32_t outputs64[height * width * 64];
+    HDCPCipherState *hs = HDCPNewCipherState(e);
+    BS_HDCPCipherState hs64;
+    int passed = 1;
+
+    lanes = e->lanes;
+    e->InitializeMultiFrameState(lanes, Ks, 0, M0, hs, Ki, Ri, Mi);
+    e->FrameStream(lanes, height, width, hs, &outputs[0][0][0]);
+    e->InitializeMultiFrameState(lanes, Ks, 0, M0, hs, Ki, Ri, Mi);
+    e->FrameStreamFrameMajor(lanes, height, width, hs, &major[0][0][0]);
+
+    Mi64[63] = M0;
+    for (b = 0; b < lanes; b += 64) {
+      int n = lanes < 64 ? lanes : 64;
+
+      HDCPInitializeMultiFrameState(n, Ks, 0, Mi64[63], &hs64, Ki64, Ri64, Mi64);
+      HDCPFrameStream(n, height, width, &hs64, (uint32_t (*)[width][n])outputs64);
+      for (j = 0; j < n; j++) {
+        int line, x;
+
+        passed &= Ki[b+j] == Ki64[j] && Ri[b+j] == Ri64[j] && Mi[b+j] == Mi64[j];
+        for (line = 0; line < height; line++)
+          for (x = 0; x < width; x++)
+            passed &= outputs[line][x][b+j] == outputs64[(line * width + x) * n + j] &&
+              major[b+j][line][x] == outputs64[(line * width + x) * n + j];
+      }
+      Mi64[63] = Mi64[n-1];
+    }
+
+    passed &= e->CheckSBoxes();
+    printf("engine %-10s %4d lanes  %s\n", e->name, lanes, passed ? " " : "!");
+    all_passed &= passed;
+    HDCPFreeCipherState(hs);
+    free(outputs);
+    free(major);
+  }
+  printf("\n");
+
+  return all_passed;
+}
+
+/* Check that a pool of threads xors the same stream into a sequence of
+   batches (the last one short) as doing it one batch at a time, and
+   turns down batches of the wrong size. */
+int check_pool(void)
+{
+  const uint64_t Ks = UINT64_C(0x1234567890abcd), M0 = UINT64_C(0xfedcba0987654321);
+  enum { height = 3, width = 70, nbatches = 5 };
+  const HDCPEngine *e = HDCPGetEngine();
+  int nframes = nbatches * e->lanes - e->lanes / 2;
+  uint32_t (*pooled)[height][width] = malloc(sizeof(*pooled) * nframes);
+  uint32_t (*serial)[height][width] = malloc(sizeof(*serial) * nframes);
+  uint32_t *frames[e->lanes], *done[e->lanes];
+  uint64_t Ki[e->lanes], Ri[e->lanes], Mi[e->lanes], pKi[e->lanes], pRi[e->lanes], pMi[e->lanes];
+  HDCPCipherState *hs = HDCPNewCipherState(e);
+  HDCPPool *pool = HDCPNewPool(e, 2, 3, height, width, Ks, 0, M0);
+  int b, i, n = 0, passed = 1;
+
+  for (i = 0; i < nframes; i++) {
+    memset(pooled[i], i, sizeof(pooled[i]));
+    memset(serial[i], i, sizeof(serial[i]));
+  }
+
+  /* Batches of no frames or more frames than lanes are turned away */
+  passed &= HDCPPoolSubmit(pool, 0, frames, sizeof(pooled[0][0])) == -1;
+  passed &= HDCPPoolSubmit(pool, e->lanes + 1, frames, sizeof(pooled[0][0])) == -1;
+
+  Mi[e->lanes-1] = M0;
+  for (b = 0; b < nframes; b += n) {
+    n = nframes - b < e->lanes ? nframes - b : e->lanes;
+
+    for (i = 0; i < n; i++)
+      frames[i] = &serial[b+i][0][0];
+    e->InitializeMultiFrameState(n, Ks, 0, Mi[e->lanes-1], hs, Ki, Ri, Mi);
+    e->FrameStreamXor(n, height, width, hs, frames, sizeof(serial[0][0]));
+    Mi[e->lanes-1] = Mi[n-1];
+
+    for (i = 0; i < n; i++)
+      frames[i] = &pooled[b+i][0][0];
+    if (HDCPPoolSubmit(pool, n, frames, sizeof(pooled[0][0])) < 0) {
+      /* make room by retiring the oldest batch */
+      passed &= HDCPPoolWait(pool, NULL, NULL, NULL, NULL) == e->lanes;
+      passed &= HDCPPoolSubmit(pool, n, frames, sizeof(pooled[0][0])) == 0;
+    }
+  }
+
+  /* The last batch must come back last, with the right Ki, Ri and Mi */
+  while ((i = HDCPPoolWait(pool, done, pKi, pRi, pMi)))
+    n = i;
+  passed &= done[0] == frames[0];
+  passed &= memcmp(pKi, Ki, n * sizeof(*Ki)) == 0;
+  passed &= memcmp(pRi, Ri, n * sizeof(*Ri)) == 0;
+  passed &= memcmp(pMi, Mi, n * sizeof(*Mi)) == 0;
+  passed &= memcmp(pooled, serial, sizeof(*pooled) * nframes) == 0;
+
+  printf("pool     %4d frames  %s\n\n", nframes, passed ? " " : "!");
+
+  HDCPFreePool(pool);
+  HDCPFreeCipherState(hs);
+  free(pooled);
+  free(serial);
+  return passed;
+}
+
+/* Check that the batches coming out of a pipeline, capped to a batch
+   size that is not a whole number of lanes, are the same as the ones
+   generated serially. */
+int check_pipeline(void)
+{
+  const uint64_t Ks = UINT64_C(0x1234567890abcd), M0 = UINT64_C(0xfedcba0987654321);
+  enum { height = 3, width = 70, nbatches = 4 };
+  const HDCPEngine *e = HDCPGetEngine();
+  const int nframes = e->lanes < 37 ? e->lanes : 37;
+  size_t cap = 3 * (e->state_size + nframes * (sizeof(uint32_t) * height * width + 3 * sizeof(uint64_t)));
+  HDCPPipeline *p = HDCPNewPipeline(e, 3, cap, height, width, Ks, 0, M0);
+  HDCPCipherState *hs = HDCPNewCipherState(e);
+  uint32_t outputs[height][width][nframes];
+  uint32_t piped[nframes][height][width], serial[nframes][height][width];
+  uint32_t *pframes[nframes], *sframes[nframes];
+  uint64_t Ki[nframes], Ri[nframes], Mi[nframes], Mi0 = M0;
+  int b, i, passed = p && HDCPPipelineFrames(p) == nframes;
+
+  for (i = 0; i < nframes; i++) {
+    pframes[i] = &piped[i][0][0];
+    sframes[i] = &serial[i][0][0];
+  }
+
+  for (b = 0; passed && b < nbatches; b++) {
+    HDCPPipelineBatch *batch = HDCPPipelineNext(p);
+
+    e->InitializeMultiFrameState(nframes, Ks, 0, Mi0, hs, Ki, Ri, Mi);
+    e->FrameStream(nframes, height, width, hs, &outputs[0][0][0]);
+    passed &= batch->nframes == nframes;
+    passed &= memcmp(batch->Ki, Ki, sizeof(Ki)) == 0;
+    passed &= memcmp(batch->Ri, Ri, sizeof(Ri)) == 0;
+    passed &= memcmp(batch->Mi, Mi, sizeof(Mi)) == 0;
+    passed &= memcmp(batch->outputs, outputs, sizeof(outputs)) == 0;
+
+    memset(piped, b, sizeof(piped));
+    memset(serial, b, sizeof(serial));
+    HDCPPipelineXor(p, batch, pframes, sizeof(piped[0][0]));
+    e->InitializeMultiFrameState(nframes, Ks, 0, Mi0, hs, Ki, Ri, Mi);
+    e->FrameStreamXor(nframes, height, width, hs, sframes, sizeof(serial[0][0]));
+    passed &= memcmp(piped, serial, sizeof(piped)) == 0;
+
+    HDCPPipelineRelease(p, batch);
+    Mi0 = Mi[nframes-1];
+  }
+
+  printf("pipeline %4d frames  %s\n\n", nbatches * nframes, passed ? " " : "!");
+
+  if (p)
+    HDCPFreePipeline(p);
+  HDCPFreeCipherState(hs);
+  return passed;
+}
+
+/* Check that three links packed into the lanes of one batch on every
+   engine (one of them a single frame, one filling the rest of the
+   lanes) get the same keys and output as each would on its own, and
+   that more frames than lanes are turned down. */
+int check_sessions(void)
+{
+  enum { height = 3, width = 70, nsessions = 3 };
+  const HDCPEngine *e;
+  int i, s, all_passed = 1;
+
+  for (i = 0; (e = HDCPListEngines(i)); i++) {
+    if (e->lanes < 64)
+      continue;   /* no room for three links */
+
+    HDCPSessionFrames sessions[nsessions] = {
+      { UINT64_C(0x1234567890abcd), 0, UINT64_C(0xfedcba0987654321), 5 },
+      { UINT64_C(0xf6aee46089c923), 1, UINT64_C(0x445e62a53ad10fe5), 1 },
+      { UINT64_C(0x4afe34dbec1205), 0, UINT64_C(0x83bec2bb01c66e07), e->lanes - 6 },
+    };
+    uint64_t Ki[e->lanes], Ri[e->lanes], Mi[e->lanes], sKi[e->lanes], sRi[e->lanes], sMi[e->lanes];
+    uint32_t (*packed)[height][width] = malloc(sizeof(*packed) * e->lanes);
+    uint32_t *outputs = malloc(sizeof(uint32_t) * height * width * e->lanes);
+    uint32_t *frames[e->lanes];
+    HDCPCipherState *hs = HDCPNewCipherState(e);
+    int lane, passed;
+
+    for (lane = 0; lane < e->lanes; lane++)
+      frames[lane] = &packed[lane][0][0];
+    passed = e->InitializeMultiSessionState(nsessions, sessions, hs, Ki, Ri, Mi) == e->lanes;
+    e->FrameStreamScatter(e->lanes, height, width, hs, frames, sizeof(packed[0][0]));
+
+    for (s = lane = 0; s < nsessions; lane += sessions[s++].nframes) {
+      int n = sessions[s].nframes, j, line, x;
+
+      e->InitializeMultiFrameState(n, sessions[s].Ks, sessions[s].REPEATER, sessions[s].Mi0,
+                                   hs, sKi, sRi, sMi);
+      e->FrameStream(n, height, width, hs, outputs);
+      passed &= memcmp(&Ki[lane], sKi, n * sizeof(*Ki)) == 0;
+      passed &= memcmp(&Ri[lane], sRi, n * sizeof(*Ri)) == 0;
+      passed &= memcmp(&Mi[lane], sMi, n * sizeof(*Mi)) == 0;
+      for (j = 0; j < n; j++)
+        for (line = 0; line < height; line++)
+          for (x = 0; x < width; x++)
+            passed &= packed[lane+j][line][x] == outputs[(line * width + x) * n + j];
+    }
+
+    /* One frame too many, or a negative number of them */
+    sessions[2].nframes = e->lanes - 5;
+    passed &= e->InitializeMultiSessionState(nsessions, sessions, hs, Ki, Ri, Mi) == -1;
+    sessions[2].nframes = -1;
+    passed &= e->InitializeMultiSessionState(nsessions, sessions, hs, Ki, Ri, Mi) == -1;
+
+    printf("sessions %-10s %4d lanes  %s\n", e->name, e->lanes, passed ? " " : "!");
+    all_passed &= passed;
+    HDCPFreeCipherState(hs);
+    free(packed);
+    free(outputs);
+  }
+  printf("\n");
+
+  return all_passed;
+}
+
+/* Check that pulling the output of a few batches out of an HDCPStream
+   in odd-sized chunks, which cross lines and frames (and run to
+   several whole lines, generated two at a time), gives the same output
+   as generating each batch in one go. */
+int check_stream(void)
+{
+  const uint64_t Ks = UINT64_C(0x1234567890abcd), M0 = UINT64_C(0xfedcba0987654321);
+  enum { height = 3, width = 70, nbatches = 3, npixels = height * width };
+  static const int chunks[] = { 1, 5, 64, 69, 133, 300 };
+  const HDCPEngine *e = HDCPGetEngine();
+  const int nframes = e->lanes < 37 ? e->lanes : 37;
+  HDCPStream *s = HDCPNewStream(e, nframes, height, width, Ks, 0, M0);
+  HDCPCipherState *hs = HDCPNewCipherState(e);
+  uint32_t (*serial)[npixels * nframes] = malloc(sizeof(*serial) * nbatches);
+  uint32_t (*chunked)[npixels * nframes] = malloc(sizeof(*chunked) * nbatches);
+  uint32_t (*video)[nframes][npixels] = calloc(nbatches, sizeof(*video));
+  uint64_t Ki[nframes], Ri[nframes], Mi[nframes], sKi[nframes], sRi[nframes], sMi[nframes];
+  uint32_t *dst[nframes];
+  int b, i, p, n, c, passed = s != NULL;
+
+  Mi[nframes-1] = M0;
+  for (b = 0; b < nbatches; b++) {
+    e->InitializeMultiFrameState(nframes, Ks, 0, Mi[nframes-1], hs, Ki, Ri, Mi);
+    e->FrameStream(nframes, height, width, hs, serial[b]);
+  }
+
+  if (passed)
+    HDCPStreamSetLines(s, 2);
+  for (p = c = 0; passed && p < nbatches * npixels; p += n, c++) {
+    n = chunks[c % 6] < nbatches * npixels - p ? chunks[c % 6] : nbatches * npixels - p;
+    HDCPStreamGenerate(s, n, &chunked[0][0] + (size_t)p * nframes);
+  }
+  if (passed) {
+    HDCPStreamKeys(s, sKi, sRi, sMi);
+    passed &= memcmp(serial, chunked, sizeof(*serial) * nbatches) == 0;
+    passed &= memcmp(sKi, Ki, sizeof(Ki)) == 0 && memcmp(sRi, Ri, sizeof(Ri)) == 0 &&
+      memcmp(sMi, Mi, sizeof(Mi)) == 0;
+
+    /* The same, xored into each batch's frames */
+    HDCPFreeStream(s);
+    s = HDCPNewStream(e, nframes, height, width, Ks, 0, M0);
+    passed &= s != NULL;
+  }
+  for (b = c = 0; passed && b < nbatches; b++)
+    for (p = 0; p < npixels; p += n, c++) {
+      for (i = 0; i < nframes; i++)
+        dst[i] = &video[b][i][p];
+      n = HDCPStreamGenerateXor(s, chunks[c % 6], dst);
+    }
+  for (b = 0; b < nbatches; b++)
+    for (i = 0; i < nframes; i++)
+      for (p = 0; p < npixels; p++)
+        passed &= video[b][i][p] == serial[b][p * nframes + i];
+
+  printf("stream   %4d frames  %s\n\n", nbatches * nframes, passed ? " " : "!");
+
+  if (s)
+    HDCPFreeStream(s);
+  HDCPFreeCipherState(hs);
+  free(serial);
+  free(chunked);
+  free(video);
+  return passed;
+}
+
+/* Read the 24-bit value of pixel x of a line back out of a frame of
+   format l as channel 2, 1, 0 (the whole word for HDCP_PIXEL_XRGB32) */
+static uint32_t read_pixel(const HDCPLayout *l, const uint8_t *line, int x)
+{
+  const uint8_t *p = line + x * HDCPPixelBytes(l->format);
+  uint32_t word;
+
+  switch (l->format) {
+  case HDCP_PIXEL_XRGB32:
+    memcpy(&word, p, sizeof(word));
+    return word;
+  case HDCP_PIXEL_RGB24:
+    return p[0] << 16 | p[1] << 8 | p[2];
+  case HDCP_PIXEL_BGR24:
+    return p[2] << 16 | p[1] << 8 | p[0];
+  case HDCP_PIXEL_YCBCR444P:
+    return p[2 * l->plane_pitch] << 16 | p[0] << 8 | p[l->plane_pitch];
+  default:
+    return 0;
+  }
+}
+
+/* Check that every engine stores and xors each pixel format with the
+   output bytes on the right TMDS channels, leaving the padding at the
+   end of each line alone. */
+int check_formats(void)
+{
+  const uint64_t Ks = UINT64_C(0x1234567890abcd), M0 = UINT64_C(0xfedcba0987654321);
+  enum { height = 3, width = 70, pad = 5, fill = 0x5a };
+  const HDCPEngine *e;
+  int i, all_passed = 1;
+
+  for (i = 0; (e = HDCPListEngines(i)); i++) {
+    const int n = e->lanes;
+    uint64_t Ki[n], Ri[n], Mi[n];
+    uint32_t (*keys)[height][width] = malloc(sizeof(*keys) * n);
+    uint8_t *frames[n];
+    HDCPCipherState *hs = HDCPNewCipherState(e);
+    int f, xor, j, line, x, passed = 1;
+
+    e->InitializeMultiFrameState(n, Ks, 0, M0, hs, Ki, Ri, Mi);
+    e->FrameStreamFrameMajor(n, height, width, hs, &keys[0][0][0]);
+
+    for (f = 0; f < HDCP_NPIXEL_FORMATS; f++)
+      for (xor = 0; xor < 2; xor++) {
+        HDCPLayout l = { f, width * HDCPPixelBytes(f) + pad, 0 };
+        int nplanes = f == HDCP_PIXEL_YCBCR444P ? 3 : 1, plane;
+        size_t size = (size_t)nplanes * height * l.pitch;
+        uint8_t *video = malloc(size * n);
+        uint32_t background = f == HDCP_PIXEL_XRGB32 ? 0x5a5a5a5a : 0x5a5a5a;
+
+        l.plane_pitch = (size_t)height * l.pitch;
+        memset(video, fill, size * n);
+        for (j = 0; j < n; j++)
+          frames[j] = video + j * size;
+        e->InitializeMultiFrameState(n, Ks, 0, M0, hs, Ki, Ri, Mi);
+        e->FrameStreamFormat(n, height, width, hs, frames, &l, xor);
+
+        for (j = 0; j < n; j++)
+          for (line = 0; line < height; line++) {
+            for (x = 0; x < width; x++)
+              passed &= read_pixel(&l, frames[j] + line * l.pitch, x) ==
+                ((xor ? background : 0) ^ keys[j][line][x]);
+            for (plane = 0; plane < nplanes; plane++)
+              for (x = l.pitch - pad; x < l.pitch; x++)
+                passed &= frames[j][plane * l.plane_pitch + line * l.pitch + x] == fill;
+          }
+        free(video);
+      }
+
+    printf("formats  %-10s %4d lanes  %s\n", e->name, n, passed ? " " : "!");
+    all_passed &= passed;
+    HDCPFreeCipherState(hs);
+    free(keys);
+  }
+  printf("\n");
+
+  return all_passed;
+}
+
+/* Flip the bits of the byte at offset in the file at path */
+static void corrupt_file(const char *path, off_t offset)
+{
+  FILE *f = fopen(path, "r+b");
+  int c;
+
+  if (!f)
+    return;
+  fseeko(f, offset, SEEK_SET);
+  c = fgetc(f);
+  fseeko(f, offset, SEEK_SET);
+  fputc(c ^ 0xff, f);
+  fclose(f);
+}
+
+/* Key a batch and generate a 4K line of it, interleaved and xored
+   into frames, as a worker thread would */
+typedef struct
+{
+  const HDCPEngine *e;
+  uint32_t *outputs, *frames[512];
+} StreamJob;
+
+enum { JOB_WIDTH = 3840 };
+
+static void *stream_job(void *arg)
+{
+  const uint64_t Ks = UINT64_C(0x1234567890abcd), M0 = UINT64_C(0xfedcba0987654321);
+  StreamJob *job = arg;
+  const HDCPEngine *e = job->e;
+  HDCPCipherState *hs = HDCPNewCipherState(e);
+  uint64_t Ki[512], Ri[512], Mi[512];
+
+  if (!hs)
+    return NULL;
+  e->InitializeMultiFrameState(e->lanes, Ks, 0, M0, hs, Ki, Ri, Mi);
+  e->FrameStream(e->lanes, 1, JOB_WIDTH, hs, job->outputs);
+  e->InitializeMultiFrameState(e->lanes, Ks, 0, M0, hs, Ki, Ri, Mi);
+  e->FrameStreamXor(e->lanes, 1, JOB_WIDTH, hs, job->frames, JOB_WIDTH * sizeof(uint32_t));
+  HDCPFreeCipherState(hs);
+  return job;
+}
+
+/* Check that the engines run on a thread with a 64 KB stack, since
+   their cipher state holds all the scratch space they need, and give
+   the same output there as on the main thread. */
+int check_small_stack(void)
+{
+  const HDCPEngine *e;
+  int i, j, all_passed = 1;
+
+  for (i = 0; (e = HDCPListEngines(i)); i++) {
+    size_t n = (size_t)JOB_WIDTH * e->lanes;
+    uint32_t *buf = calloc(4 * n, sizeof(uint32_t));
+    StreamJob main_job = { e }, small_job = { e };
+    pthread_attr_t attr;
+    pthread_t thread;
+    void *done = NULL;
+    int passed = buf != NULL;
+
+    if (buf) {
+      main_job.outputs = buf;
+      small_job.outputs = buf + n;
+      for (j = 0; j < e->lanes; j++) {
+        main_job.frames[j] = buf + 2 * n + (size_t)j * JOB_WIDTH;
+        small_job.frames[j] = buf + 3 * n + (size_t)j * JOB_WIDTH;
+      }
+      stream_job(&main_job);
+      pthread_attr_init(&attr);
+      pthread_attr_setstacksize(&attr, 64 << 10);
+      if (pthread_create(&thread, &attr, stream_job, &small_job) == 0)
+        pthread_join(thread, &done);
+      pthread_attr_destroy(&attr);
+      passed = done == &small_job && memcmp(buf, buf + n, n * sizeof(uint32_t)) == 0 &&
+        memcmp(buf + 2 * n, buf + 3 * n, n * sizeof(uint32_t)) == 0;
+    }
+
+    printf("stack    %-10s %4d lanes  %s\n", e->name, e->lanes, passed ? " " : "!");
+    all_passed &= passed;
+    free(buf);
+  }
+  printf("\n");
+
+  return all_passed;
+}
+
+/* Check that a cache of nframes frames keyed batch at a time holds
+   what an HDCPStream of batches of batch frames gives, when the last
+   batch of the cache is cut short. */
+static int check_cache_stream(const HDCPEngine *e, int batch, int nframes)
+{
+  const uint64_t Ks = UINT64_C(0x1234567890abcd), M0 = UINT64_C(0xfedcba0987654321);
+  enum { height = 3, width = 70 };
+  uint32_t (*outputs)[batch] = malloc(sizeof(*outputs) * height * width);
+  uint64_t Ki[batch], Ri[batch], Mi[batch];
+  HDCPStream *s = HDCPNewStream(e, batch, height, width, Ks, 0, M0);
+  char path[] = "/tmp/hdcp-test-XXXXXX";
+  HDCPCacheEntry entry;
+  HDCPCache *c = NULL;
+  int f, i, p, fd, passed;
+
+  if ((fd = mkstemp(path)) >= 0) {
+    close(fd);
+    if (HDCPCreateCache(path, e, batch, nframes, height, width, Ks, 0, M0) == 0)
+      c = HDCPOpenCache(path);
+  }
+  passed = c && s && outputs;
+  for (f = 0; passed && f < nframes; f += batch) {
+    HDCPStreamGenerate(s, height * width, &outputs[0][0]);
+    HDCPStreamKeys(s, Ki, Ri, Mi);
+    for (i = 0; i < batch && f + i < nframes; i++) {
+      const uint32_t *frame = HDCPCacheFrame(c, f + i, &entry);
+
+      passed &= frame && entry.Ki == Ki[i] && entry.Ri == Ri[i] && entry.Mi == Mi[i];
+      for (p = 0; frame && p < height * width; p++)
+        passed &= frame[p] == outputs[p][i];
+    }
+  }
+  if (c)
+    HDCPCloseCache(c);
+  if (s)
+    HDCPFreeStream(s);
+  unlink(path);
+  free(outputs);
+  return passed;
+}
+
+/* Check that a keystream cache holds the same keys and output as
+   generating the batches serially, that the cached xor matches, and
+   that the CRCs catch a damaged frame and a damaged index. */
+int check_cache(void)
+{
+  const uint64_t Ks = UINT64_C(0x1234567890abcd), M0 = UINT64_C(0xfedcba0987654321);
+  enum { height = 3, width = 70 };
+  const HDCPEngine *e = HDCPGetEngine();
+  const int batch = e->lanes < 37 ? e->lanes : 37, nframes = 2 * batch + 3;
+  uint32_t (*serial)[height][width] = malloc(sizeof(*serial) * nframes);
+  uint32_t (*video)[height][width] = calloc(nframes, sizeof(*video));
+  uint64_t Ki[nframes], Ri[nframes], Mi[nframes];
+  uint32_t *frames[nframes];
+  HDCPCipherState *hs = HDCPNewCipherState(e);
+  HDCPCacheEntry entry;
+  HDCPCache *c = NULL;
+  char path[] = "/tmp/hdcp-test-XXXXXX";
+  int b, i, n, fd, passed;
+
+  passed = HDCPCrc32(0, "123456789", 9) == 0xcbf43926;
+
+  for (b = 0; b < nframes; b += n) {
+    n = nframes - b < batch ? nframes - b : batch;
+    e->InitializeMultiFrameState(n, Ks, 0, b ? Mi[b-1] : M0, hs, &Ki[b], &Ri[b], &Mi[b]);
+    e->FrameStreamFrameMajor(n, height, width, hs, &serial[b][0][0]);
+  }
+
+  if ((fd = mkstemp(path)) >= 0) {
+    close(fd);
+    if (HDCPCreateCache(path, e, batch, nframes, height, width, Ks, 0, M0) == 0)
+      c = HDCPOpenCache(path);
+  }
+  passed &= c != NULL;
+  for (i = 0; c && i < nframes; i++) {
+    const uint32_t *frame = HDCPCacheFrame(c, i, &entry);
+
+    passed &= frame && memcmp(frame, serial[i], sizeof(serial[i])) == 0;
+    passed &= entry.Ki == Ki[i] && entry.Ri == Ri[i] && entry.Mi == Mi[i];
+    passed &= HDCPCacheFind(c, Mi[i]) == i && HDCPCacheVerifyFrame(c, i);
+    frames[i] = &video[i][0][0];
+  }
+  if (c) {
+    passed &= HDCPCacheFrame(c, nframes, NULL) == NULL;
+    passed &= HDCPCacheFrameStreamXor(c, 1, nframes, frames, sizeof(video[0][0])) == nframes - 1;
+    for (i = 0; i < nframes - 1; i++)
+      passed &= memcmp(video[i], serial[i+1], sizeof(video[i])) == 0;
+
+    /* A damaged frame still opens but fails its CRC; a damaged index
+       doesn't open */
+    HDCPCacheFrame(c, nframes - 2, &entry);
+    HDCPCloseCache(c);
+    corrupt_file(path, entry.offset + 17);
+    c = HDCPOpenCache(path);
+    passed &= c && !HDCPCacheVerifyFrame(c, nframes - 2) && HDCPCacheVerifyFrame(c, nframes - 3);
+    if (c)
+      HDCPCloseCache(c);
+    corrupt_file(path, sizeof(HDCPCacheHeader) + 3);
+    passed &= HDCPOpenCache(path) == NULL;
+  }
+  unlink(path);
+  if (batch > 1)
+    passed &= check_cache_stream(e, batch, 2 * batch + 1);
+
+  printf("cache    %4d frames  %s\n\n", nframes, passed ? " " : "!");
+
+  HDCPFreeCipherState(hs);
+  free(serial);
+  free(video);
+  return passed;
+}
+
+/* Check that authenticating a few batches' worth of handshakes at
+   once, on two threads, gives what the scalar cipher does one at a
+   time, on every engine, with Km given or derived from device keys. */
+int check_auth(void)
+{
+  enum { n = 2 * HDCP_AUTH_PER_THREAD + 5 };
+  static uint64_t Km[n], REPEATER[n], An[n], Ks[n], R0[n], M0[n], ksv[n], dKm[n];
+  static uint64_t keys[3][HDCP_NKEYS];
+  static const uint64_t *keyp[n];
+  uint64_t x = UINT64_C(0x5309c7d22fcecc), sKs, sR0, sM0;
+  const HDCPEngine *e;
+  int i, j, k, all_passed = 1;
+
+#define NEXT() (x = x * UINT64_C(6364136223846793005) + 1442695040888963407)
+  for (i = 0; i < 3; i++)
+    for (k = 0; k < HDCP_NKEYS; k++)
+      keys[i][k] = NEXT() >> 8;
+  for (i = 0; i < n; i++) {
+    NEXT();
+    Km[i] = x >> 8;
+    An[i] = x * UINT64_C(0x9e3779b97f4a7c15);
+    REPEATER[i] = x >> 63;
+
+    /* A valid KSV: 20 of the 40 bits, picked at random */
+    for (ksv[i] = 0; __builtin_popcountll(ksv[i]) < HDCP_NKEYS / 2; )
+      ksv[i] |= UINT64_C(1) << (NEXT() >> 33) % HDCP_NKEYS;
+    keyp[i] = keys[i % 3];
+  }
+#undef NEXT
+  all_passed &= HDCPValidKsv(ksv[0]) && !HDCPValidKsv(ksv[0] ^ 1) && !HDCPValidKsv(ksv[0] | UINT64_C(1) << HDCP_NKEYS);
+
+  for (j = 0; (e = HDCPListEngines(j)); j++) {
+    int passed = HDCPAuthenticationBatch(e, 2, n, Km, REPEATER, An, Ks, R0, M0) == 0;
+
+    for (i = 0; i < n; i++) {
+      HDCPScalarAuthentication(Km[i], REPEATER[i], An[i], &sKs, &sR0, &sM0);
+      passed &= Ks[i] == sKs && R0[i] == sR0 && M0[i] == sM0;
+    }
+    /* And again with Km from a KSV and device keys, against summing
+       the keys one at a time */
+    passed &= HDCPAuthenticationFromKeys(e, 2, n, ksv, keyp, REPEATER, An, Ks, R0, M0) == 0;
+    e->DeriveKm(n, ksv, keyp, dKm);
+    for (i = 0; i < n; i++) {
+      uint64_t sum = 0;
+
+      for (k = 0; k < HDCP_NKEYS; k++)
+        if (ksv[i] >> k & 1)
+          sum += keyp[i][k];
+      passed &= dKm[i] == (sum & ((UINT64_C(1) << 56) - 1));
+      HDCPScalarAuthentication(dKm[i], REPEATER[i], An[i], &sKs, &sR0, &sM0);
+      passed &= Ks[i] == sKs && R0[i] == sR0 && M0[i] == sM0;
+    }
+
+    printf("auth     %-10s %4d lanes  %s\n", e->name, e->lanes, passed ? " " : "!");
+    all_passed &= passed;
+  }
+  printf("\n");
+
+  return all_passed;
+}
+
+/* Check that walking the chains of more links than an engine has
+   lanes, keyed in batches of several sizes, gives the Ki, Ri and Mi
+   that keying the batches one by one does, on every engine, and that
+   the frame numbers carry on from one walk to the next. */
+int check_chain(void)
+{
+  enum { nframes = 23, first = 10, interval = 3 };
+  static const int batches[] = { 1, 2, 5, 16 };
+  const HDCPEngine *ref = HDCPGetEngine(), *e;
+  int nsessions = ref->lanes + 2, i, j, s, f, b, n, all_passed = 1;
+  HDCPSessionFrames *sessions = malloc(nsessions * sizeof(*sessions));
+  uint64_t *Ki = malloc(3 * nframes * nsessions * sizeof(uint64_t));
+  uint64_t *Ri = Ki + nframes * nsessions, *Mi = Ri + nframes * nsessions;
+  uint64_t *wKi = malloc(3 * nframes * nsessions * sizeof(uint64_t));
+  uint64_t *wRi = wKi + nframes * nsessions, *wMi = wRi + nframes * nsessions;
+  HDCPCipherState *hs = HDCPNewCipherState(ref);
+
+  /* The frames of each link, a batch at a time: Ki[f*nsessions + s] */
+  for (s = 0; s < nsessions; s++) {
+    uint64_t bKi[16], bRi[16], bMi[16], Mi0;
+
+    sessions[s].Ks = (UINT64_C(0x1234567890abcd) * (s + 1)) & ((UINT64_C(1) << 56) - 1);
+    sessions[s].REPEATER = s & 1;
+    sessions[s].Mi0 = Mi0 = UINT64_C(0xfedcba0987654321) ^ (uint64_t)s << 40;
+    sessions[s].nframes = batches[s % 4] <= ref->lanes ? batches[s % 4] : 1;
+    for (f = 0; f < nframes; f += n) {
+      n = sessions[s].nframes;
+      ref->InitializeMultiFrameState(n, sessions[s].Ks, sessions[s].REPEATER, Mi0, hs, bKi, bRi, bMi);
+      for (b = 0; b < n && f + b < nframes; b++) {
+        Ki[(f+b) * nsessions + s] = bKi[b];
+        Ri[(f+b) * nsessions + s] = bRi[b];
+        Mi[(f+b) * nsessions + s] = bMi[b];
+      }
+      Mi0 = bMi[n-1];
+    }
+  }
+
+  for (j = 0; (e = HDCPListEngines(j)); j++) {
+    HDCPChains *c = HDCPNewChains(e, nsessions, sessions);
+    int64_t nout;
+    int passed = c != NULL;
+
+    if (c) {
+      /* Every frame of the first walk, every third of the second */
+      nout = HDCPWalkChains(c, first, 1, wKi, wRi, wMi);
+      passed &= nout == first && memcmp(wKi, Ki, first * nsessions * sizeof(*Ki)) == 0 &&
+        memcmp(wRi, Ri, first * nsessions * sizeof(*Ri)) == 0 &&
+        memcmp(wMi, Mi, first * nsessions * sizeof(*Mi)) == 0;
+      nout = HDCPWalkChains(c, nframes - first, interval, NULL, wRi, wMi);
+      passed &= HDCPChainsPosition(c) == nframes;
+      for (i = 0, f = first; f < nframes; f++)
+        if (f % interval == 0) {
+          for (s = 0; s < nsessions; s++)
+            passed &= wRi[i * nsessions + s] == Ri[f * nsessions + s] &&
+              wMi[i * nsessions + s] == Mi[f * nsessions + s];
+          i++;
+        }
+      passed &= nout == i;
+      HDCPFreeChains(c);
+    }
+
+    printf("chain    %-10s %4d links  %s\n", e->name, nsessions, passed ? " " : "!");
+    all_passed &= passed;
+  }
+  printf("\n");
+
+  HDCPFreeCipherState(hs);
+  free(sessions);
+  free(Ki);
+  free(wKi);
+  return all_passed;
+}
+
+/* Overwrite the frame count in the header of the index at path */
+static int seek_header_frames(const char *path, int64_t nframes)
+{
+  FILE *f = fopen(path, "r+b");
+  HDCPSeekHeader h;
+  int ok;
+
+  if (!f)
+    return 0;
+  ok = fread(&h, sizeof(h), 1, f) == 1;
+  h.nframes = nframes;
+  ok = ok && fseek(f, 0, SEEK_SET) == 0 && fwrite(&h, sizeof(h), 1, f) == 1;
+  return fclose(f) == 0 && ok;
+}
+
+/* Check that seeking with an index, loaded back from a file, keys frames
+   in and past the indexed range the same as running batches of one and
+   of several frames from the start, and that a damaged index doesn't
+   load. */
+int check_seek(void)
+{
+  const uint64_t Ks = UINT64_C(0x1234567890abcd), M0 = UINT64_C(0xfedcba0987654321);
+  enum { nframes = 100, interval = 16, total = 140 };
+  static const int64_t seeks[] = { 0, 1, 15, 16, 47, 99, 100, 131 };
+  const HDCPEngine *e = HDCPGetEngine();
+  const int batches[2] = { 1, e->lanes < 5 ? e->lanes : 5 };
+  uint64_t Ki[2][total + 5], Ri[2][total + 5], Mi[2][total + 5];
+  uint64_t sKi[5], sRi[5], sMi[5], Mi0;
+  HDCPCipherState *hs = HDCPNewCipherState(e);
+  HDCPSeekIndex *built = HDCPNewSeekIndex(Ks, 1, M0, nframes, interval), *x = NULL;
+  HDCPStream *s;
+  char path[] = "/tmp/hdcp-test-XXXXXX";
+  int b, f, i, j, n, fd, passed = built != NULL;
+
+  for (b = 0; b < 2; b++) {
+    n = batches[b];
+    for (f = 0; f < total; f += n)
+      e->InitializeMultiFrameState(n, Ks, 1, f ? Mi[b][f-1] : M0, hs, &Ki[b][f], &Ri[b][f], &Mi[b][f]);
+  }
+
+  if (built && (fd = mkstemp(path)) >= 0) {
+    close(fd);
+    if (HDCPSaveSeekIndex(built, path) == 0)
+      x = HDCPLoadSeekIndex(path);
+  }
+  passed &= x != NULL;
+
+  for (i = 0; x && i < (int)(sizeof(seeks) / sizeof(seeks[0])); i++)
+    for (b = 0; b < 2; b++) {
+      int64_t runs = HDCPSeek(x, seeks[i], &Mi0);
+
+      passed &= runs == (seeks[i] < nframes ? seeks[i] % interval : seeks[i] - nframes / interval * interval);
+      n = batches[b];
+      e->InitializeMultiFrameState(n, Ks, 1, Mi0, hs, sKi, sRi, sMi);
+      for (j = 0; j < n; j++)
+        passed &= sKi[j] == Ki[b][seeks[i]+j] && sRi[j] == Ri[b][seeks[i]+j] && sMi[j] == Mi[b][seeks[i]+j];
+
+      /* A stream picks up from there too */
+      if ((s = HDCPSeekStream(x, e, n, 2, 3, seeks[i]))) {
+        HDCPStreamKeys(s, sKi, sRi, sMi);
+        passed &= memcmp(sRi, &Ri[b][seeks[i]], n * sizeof(*sRi)) == 0;
+        HDCPFreeStream(s);
+      } else
+        passed = 0;
+    }
+  if (x) {
+    passed &= HDCPSeek(x, -1, &Mi0) < 0;
+    passed &= HDCPSeekInfo(x)->nframes == nframes && HDCPSeekInfo(x)->Ks == Ks;
+    HDCPFreeSeekIndex(x);
+    corrupt_file(path, sizeof(HDCPSeekHeader) + 8 * 3 + 2);
+    passed &= HDCPLoadSeekIndex(path) == NULL;
+
+    /* A header claiming far more checkpoints than the file holds */
+    passed &= HDCPSaveSeekIndex(built, path) == 0 && seek_header_frames(path, INT64_MAX - 1);
+    passed &= HDCPLoadSeekIndex(path) == NULL;
+  }
+  unlink(path);
+
+  printf("seek     %4d frames  %s\n\n", total, passed ? " " : "!");
+
+  if (built)
+    HDCPFreeSeekIndex(built);
+  HDCPFreeCipherState(hs);
+  return passed;
+}
+
+/* Generate a batch of output into frames[nframes][height][width] (zeroed
+   beforehand) the way plan p says to */
+static void run_plan(const HDCPEngine *e, const HDCPPlan *p, int height, int width,
+                     HDCPCipherState *hs, uint32_t *frames)
+{
+  uint32_t *rows[p->nframes], *buf = malloc(p->bytes);
+  int i, x, line, n;
+
+  switch (p->output) {
+  case HDCP_OUTPUT_FRAMES:
+    e->FrameStreamFrameMajor(p->nframes, height, width, hs, frames);
+    break;
+  case HDCP_OUTPUT_LINES:
+    for (line = 0; line < height; line += n) {
+      n = height - line < p->lines ? height - line : p->lines;
+      e->FrameStream(p->nframes, n, width, hs, buf);
+      for (i = 0; i < p->nframes; i++)
+        for (x = 0; x < n * width; x++)
+          frames[((size_t)i * height + line) * width + x] ^= buf[(size_t)x * p->nframes + i];
+    }
+    break;
+  case HDCP_OUTPUT_XOR:
+    for (i = 0; i < p->nframes; i++)
+      rows[i] = frames + (size_t)i * height * width;
+    e->FrameStreamXor(p->nframes, height, width, hs, rows, width * sizeof(uint32_t));
+    break;
+  }
+  free(buf);
+}
+
+/* Check that a budget keeps to its memory and latency limits as 1080p
+   and 4K sessions come and go, plans them again each time, and that
+   the output of each kind of plan is the same. */
+int check_budget(void)
+{
+  enum { height = 8, width = 40 };
+  const uint64_t Ks = UINT64_C(0x1234567890abcd), M0 = UINT64_C(0xfedcba0987654321);
+  const HDCPEngine *e = HDCPGetEngine();
+  const size_t max_bytes = 32 << 20, fixed = e->state_size + 3 * sizeof(uint64_t) * e->lanes;
+  const size_t budgets[3] = { 0, fixed + sizeof(uint32_t) * width * e->lanes * 3, fixed + 1 };
+  const HDCPOutput outputs[3] = { HDCP_OUTPUT_FRAMES, HDCP_OUTPUT_LINES, HDCP_OUTPUT_XOR };
+  size_t frame_words = (size_t)e->lanes * height * width;
+  uint32_t *ref = malloc(frame_words * sizeof(uint32_t)), *out = calloc(frame_words, sizeof(uint32_t));
+  uint64_t Ki[e->lanes], Ri[e->lanes], Mi[e->lanes];
+  HDCPCipherState *hs = HDCPNewCipherState(e);
+  HDCPBudget *b = HDCPNewBudget(e, max_bytes, 0.1);
+  HDCPPlan hd, hd2, uhd;
+  size_t lines;
+  int i, id, hd_id, uhd_id, passed = 1;
+  uint64_t g;
+
+  /* 1080p60 alone gets all of it, in batches of no more than 0.1s */
+  hd_id = HDCPBudgetAdd(b, 1080, 1920, 60);
+  passed &= HDCPBudgetPlan(b, hd_id, &hd) == 0 && hd.nframes == (e->lanes < 6 ? e->lanes : 6);
+  lines = (max_bytes - fixed) / (sizeof(uint32_t) * 1920 * hd.nframes);
+  passed &= hd.lines == (lines < 1080 ? lines : 1080) && hd.bytes <= max_bytes &&
+    hd.output == (lines < 1080 ? HDCP_OUTPUT_LINES : HDCP_OUTPUT_FRAMES);
+
+  /* A 4K session makes it give some of that up */
+  g = HDCPBudgetGeneration(b);
+  uhd_id = HDCPBudgetAdd(b, 2160, 3840, 30);
+  passed &= uhd_id >= 0 && uhd_id != hd_id && HDCPBudgetGeneration(b) == g + 1;
+  passed &= HDCPBudgetPlan(b, hd_id, &hd2) == 0 && HDCPBudgetPlan(b, uhd_id, &uhd) == 0;
+  passed &= hd2.generation == g + 1 && hd2.lines < hd.lines && uhd.nframes == (e->lanes < 3 ? e->lanes : 3);
+  passed &= uhd.output == HDCP_OUTPUT_LINES && uhd.bytes > hd2.bytes && HDCPBudgetUsed(b) <= max_bytes;
+
+  /* and gets it back when the 4K one goes */
+  HDCPBudgetRemove(b, uhd_id);
+  passed &= HDCPBudgetPlan(b, uhd_id, &uhd) < 0 && HDCPBudgetPlan(b, hd_id, &hd2) == 0;
+  passed &= hd2.bytes == hd.bytes && hd2.lines == hd.lines && hd2.output == hd.output;
+  passed &= HDCPBudgetAdd(b, 480, 640, 30) == uhd_id;
+  HDCPFreeBudget(b);
+
+  /* No room for even a cipher state */
+  b = HDCPNewBudget(e, e->state_size, 0);
+  passed &= HDCPBudgetAdd(b, 480, 640, 30) < 0;
+  HDCPFreeBudget(b);
+
+  /* Every kind of plan generates the same output */
+  e->InitializeMultiFrameState(e->lanes, Ks, 1, M0, hs, Ki, Ri, Mi);
+  e->FrameStreamFrameMajor(e->lanes, height, width, hs, ref);
+  for (i = 0; i < 3; i++) {
+    HDCPPlan p;
+
+    b = HDCPNewBudget(e, budgets[i], 0);
+    id = HDCPBudgetAdd(b, height, width, 30);
+    if (id >= 0 && HDCPBudgetPlan(b, id, &p) == 0 && p.output == outputs[i] &&
+        p.nframes == e->lanes && (budgets[i] == 0 || p.bytes <= budgets[i])) {
+      memset(out, 0, frame_words * sizeof(uint32_t));
+      e->InitializeMultiFrameState(e->lanes, Ks, 1, M0, hs, Ki, Ri, Mi);
+      run_plan(e, &p, height, width, hs, out);
+      passed &= memcmp(out, ref, frame_words * sizeof(uint32_t)) == 0;
+    } else
+      passed = 0;
+    HDCPFreeBudget(b);
+  }
+
+  printf("budget   %4d lanes  %s\n\n", e->lanes, passed ? " " : "!");
+
+  HDCPFreeCipherState(hs);
+  free(ref);
+  free(out);
+  return passed;
+}
+
+/* Compare two batches of a stream tuned by t against a plain one */
+static int check_tuned_stream(const HDCPTuning *t, int height, int width)
+{
+  const uint64_t Ks = UINT64_C(0x1234567890abcd), M0 = UINT64_C(0xfedcba0987654321);
+  const HDCPTuned *r = HDCPTuningFor(t, height, width);
+  const HDCPEngine *e = getenv("HDCP_ENGINE") ? HDCPGetEngine() : r->e;
+  size_t n = (size_t)2 * height * width * e->lanes;
+  HDCPStream *tuned = HDCPNewTunedStream(t, height, width, Ks, 0, M0);
+  HDCPStream *plain = HDCPNewStream(e, e->lanes, height, width, Ks, 0, M0);
+  uint32_t *a = malloc(n * sizeof(uint32_t)), *b = malloc(n * sizeof(uint32_t));
+  int passed = tuned && plain && a && b;
+
+  if (passed) {
+    HDCPStreamGenerate(tuned, n / e->lanes, a);
+    HDCPStreamGenerate(plain, n / e->lanes, b);
+    passed = memcmp(a, b, n * sizeof(uint32_t)) == 0;
+  }
+  if (tuned)
+    HDCPFreeStream(tuned);
+  if (plain)
+    HDCPFreeStream(plain);
+  free(a);
+  free(b);
+  return passed;
+}
+
+/* Check that tuning picks settings within range for each size, that
+   they survive being saved and loaded again, that a tuning naming an
+   engine this CPU doesn't have doesn't load, and that a tuned stream
+   gives the same output as a plain one. */
+int check_tune(void)
+{
+  static const int heights[2] = { 8, 3 }, widths[2] = { 40, 100 };
+  int ncpu = sysconf(_SC_NPROCESSORS_ONLN), i, fd, passed;
+  char path[] = "/tmp/hdcp-test-XXXXXX";
+  HDCPTuning t, loaded;
+  HDCPPool *pool;
+  FILE *f;
+
+  passed = HDCPTune(2, heights, widths, 0.001, &t) == 0 && t.n == 2 && t.block && t.block_ns > 0;
+  for (i = 0; passed && i < 2; i++) {
+    const HDCPTuned *r = &t.res[i];
+
+    passed &= r->e && r->lines >= 1 && r->lines <= heights[i] && (r->lines & (r->lines - 1)) == 0 &&
+      r->threads >= 1 && r->threads <= (ncpu < 1 ? 1 : ncpu) && r->ns > 0;
+  }
+  passed &= t.engine == t.res[0].e;
+  passed &= HDCPTuningFor(&t, 3, 100) == &t.res[1] && HDCPTuningFor(&t, 2, 150) == &t.res[1] &&
+    HDCPTuningFor(&t, 1080, 1920) == &t.res[0];
+  if (passed)
+    passed &= check_tuned_stream(&t, 3, 100);
+  if (passed && (pool = HDCPNewTunedPool(&t, 0, 2, 3, 100, 1, 0, 2)))
+    HDCPFreePool(pool);
+  else
+    passed = 0;
+
+  if (passed && (fd = mkstemp(path)) >= 0) {
+    close(fd);
+    passed &= HDCPSaveTuning(&t, path) == 0 && HDCPLoadTuning(path, &loaded) == 0;
+    passed &= loaded.n == t.n && loaded.engine == t.engine && loaded.block == t.block;
+    for (i = 0; passed && i < t.n; i++)
+      passed &= loaded.res[i].height == t.res[i].height && loaded.res[i].width == t.res[i].width &&
+        loaded.res[i].e == t.res[i].e && loaded.res[i].lines == t.res[i].lines &&
+        loaded.res[i].threads == t.res[i].threads &&
+        loaded.res[i].ns > 0.999 * t.res[i].ns && loaded.res[i].ns < 1.001 * t.res[i].ns;
+
+    if ((f = fopen(path, "a"))) {
+      fprintf(f, "res 480 720 nosuchengine 4 1 1.0\n");
+      fclose(f);
+      passed &= HDCPLoadTuning(path, &loaded) < 0;
+    } else
+      passed = 0;
+    unlink(path);
+  } else
+    passed = 0;
+
+  printf("tune     %4d sizes  %s\n\n", 2, passed ? " " : "!");
+  return passed;
+}
+
+/* Check that HDCPAlloc gives aligned, zeroed, writable memory whatever
+   pages it is asked for (falling back when there are none to be had),
+   and that a thread can be bound to the node it is on. */
+int check_mem(void)
+{
+  static const size_t sizes[4] = { 100, 2 << 20, 3 << 20, 5 << 20 };
+  int p, i, passed = HDCPNodes() >= 1 && HDCPCurrentNode() >= 0 &&
+    HDCPBindThread(HDCPCurrentNode()) == 0;
+
+  for (p = HDCP_PAGES_1G; p <= HDCP_PAGES_4K; p++) {
+    passed &= HDCPFindPages(HDCPPagesName(p)) == p;
+    for (i = 0; i < 4; i++) {
+      uint8_t *m = HDCPAlloc(sizes[i], p, -1);
+
+      if (!m) {
+        passed = 0;
+        continue;
+      }
+      passed &= (uintptr_t)m % HDCP_ALLOC_ALIGN == 0 && HDCPAllocPages(m) >= (HDCPPages)p;
+      /* Huge pages start at the memory itself, with nothing in front */
+      passed &= HDCPAllocPages(m) == HDCP_PAGES_4K || (uintptr_t)m % (2 << 20) == 0;
+      passed &= m[0] == 0 && m[sizes[i] - 1] == 0;
+      memset(m, 0xa5, sizes[i]);
+      HDCPFree(m);
+    }
+  }
+  passed &= HDCPFindPages("8k") < 0;
+  HDCPFree(NULL);
+
+  printf("mem      %4d nodes  %s\n\n", HDCPNodes(), passed ? " " : "!");
+  return passed;
+}
+
+/* Check that FrameStream gives the same output when it writes it with
+   non-temporal stores (all of it, for the check) as StreamCipher gives
+   a line at a time, for batches of every engine's lanes and of 16
+   fewer, which leaves part of a word of lanes over. */
+int check_streaming(void)
+{
+  const uint64_t Ks = UINT64_C(0x1234567890abcd), M0 = UINT64_C(0xfedcba0987654321);
+  const int height = 3, width = 70;
+  size_t saved = HDCPStreamingBytes();
+  const HDCPEngine *e;
+  int i, k, n, line, passed = 1;
+
+  HDCPSetStreamingBytes(0);
+  for (i = 0; (e = HDCPListEngines(i)); i++)
+    for (k = 0; k < 2 && (k == 0 || e->lanes > 16); k++) {
+      uint64_t Ki[e->lanes], Ri[e->lanes], Mi[e->lanes];
+      size_t bytes = sizeof(uint32_t) * height * width * e->lanes;
+      uint32_t *streamed = HDCPAlloc(bytes, HDCP_PAGES_4K, -1), *lines = malloc(bytes);
+      HDCPCipherState *hs = HDCPNewCipherState(e);
+
+      n = k ? e->lanes - 16 : e->lanes;
+      if (!streamed || !lines || !hs)
+        passed = 0;
+      else {
+        e->InitializeMultiFrameState(n, Ks, 0, M0, hs, Ki, Ri, Mi);
+        e->FrameStream(n, height, width, hs, streamed);
+        e->InitializeMultiFrameState(n, Ks, 0, M0, hs, Ki, Ri, Mi);
+        for (line = 0; line < height; line++) {
+          e->StreamCipher(n, hs, width, lines + (size_t)line * width * n);
+          e->Rekeycipher(hs);
+        }
+        passed &= memcmp(streamed, lines, sizeof(uint32_t) * height * width * n) == 0;
+      }
+      HDCPFree(streamed);
+      free(lines);
+      if (hs)
+        HDCPFreeCipherState(hs);
+    }
+  HDCPSetStreamingBytes(saved);
+
+  printf("nt       %4d engines %s\n\n", i, passed ? " " : "!");
+  return passed;
+}
+
 /* Print test vectors (See Tables A-3 and A-4 of HDCP Specification) */
 int print_test_vectors(void)
 {
-  static bsvec_t Km[8] = {
+  static uint64_t Km[8] = {
     UINT64_C(0x5309c7d22fcecc), UINT64_C(0xf6aee46089c923), UINT64_C(0x4afe34dbec1205), UINT64_C(0xa423d78b8676a7),
     UINT64_C(0x5309c7d22fcecc), UINT64_C(0xf6aee46089c923), UINT64_C(0x4afe34dbec1205), UINT64_C(0xa423d78b8676a7) 
   };
-  static bsvec_t REPEATER[8] = { 
+  static uint64_t REPEATER[8] = { 
     0, 0, 0, 0, 
     1, 1, 1, 1 
   };
-  static bsvec_t An[8] = {
+  static uint64_t An[8] = {
     UINT64_C(0x34271c130c070403), UINT64_C(0x445e62a53ad10fe5), UINT64_C(0x83bec2bb01c66e07), UINT64_C(0x0351f7175406a74d),
     UINT64_C(0x34271c130c070403), UINT64_C(0x445e62a53ad10fe5), UINT64_C(0x83bec2bb01c66e07), UINT64_C(0x0351f7175406a74d) 
   };
@@ -89,18 +1165,38 @@ int print_test_vectors(void)
   
 
   for (i = 0; i < 8; i++) {
-    BS_HDCPCipherState hs;
-    bsvec_t Ks, R0, M0, K1, R1, M1;
-    uint32_t outputs[2][8][1];
+    BS_HDCPCipherState hs, xor_hs;
+    HDCPScalarCipherState shs;
+    uint64_t Ks, R0, M0, K1, R1, M1, sKs, sR0, sM0, sK1, sR1, sM1;
+    uint32_t outputs[2][8][1], frame[2][8], *frames[1] = { &frame[0][0] };
+    uint32_t soutputs[2][8], sframe[2][8];
     int passed;
 
     HDCPBlockCipher(1, &Km[i], &REPEATER[i], &An[i], &hs, &Ks, &R0, &M0);
     HDCPInitializeMultiFrameState(1, Ks, REPEATER[i], M0, &hs, &K1, &R1, &M1);
+    xor_hs = hs;
     HDCPFrameStream(1, 2, 8, &hs, outputs);
 
+    /* xoring into a blank frame must give the same stream */
+    memset(frame, 0, sizeof(frame));
+    HDCPFrameStreamXor(1, 2, 8, &xor_hs, frames, sizeof(frame[0]));
+
 #define PASSED(x) (x == x ## _true[i])
     passed = PASSED(Ks) && PASSED(M0) && PASSED(R0) && PASSED(K1)  &&PASSED(M1);
 
+    /* The scalar cipher must agree with the bit-sliced one */
+    HDCPScalarBlockCipher(Km[i], REPEATER[i], An[i], &shs, &sKs, &sR0, &sM0);
+    passed &= sKs == Ks && sR0 == R0 && sM0 == M0;
+    HDCPScalarInitializeFrameState(Ks, REPEATER[i], M0, &shs, &sK1, &sR1, &sM1);
+    passed &= sK1 == K1 && sR1 == R1 && sM1 == M1;
+    HDCPScalarFrameStream(2, 8, &shs, soutputs);
+
+    /* ... and so must the scalar engine, a line at a time */
+    memset(sframe, 0, sizeof(sframe));
+    HDCPScalarInitializeFrameState(Ks, REPEATER[i], M0, &shs, NULL, NULL, NULL);
+    for (r = 0; r < 2; r++)
+      HDCPScalarFrameStreamXor(1, 8, &shs, sframe[r], sizeof(sframe[0]));
+
     printf("%014" PRIx64 "%s %016" PRIx64 "%s %04" PRIx64 "%s %014" PRIx64 "%s %016" PRIx64 "%s    %s\n",
            Ks, PASSED(Ks) ? " " : "!",
            M0, PASSED(M0) ? " " : "!",
@@ -112,7 +1208,8 @@ int print_test_vectors(void)
 
     all_passed &= passed;
 
-#define PASSED(i,r,j) (outputs[r][j][0] == outputs_true[i][r][j])
+#define PASSED(i,r,j) (outputs[r][j][0] == outputs_true[i][r][j] && frame[r][j] == outputs_true[i][r][j] && \
+                       soutputs[r][j] == outputs_true[i][r][j] && sframe[r][j] == outputs_true[i][r][j])
     
     for (r = 0; r < 2; r++) {
       passed = 1;
@@ -130,6 +1227,22 @@ int print_test_vectors(void)
 
 #undef PASSED
 
+  all_passed &= check_engines();
+  all_passed &= check_pool();
+  all_passed &= check_pipeline();
+  all_passed &= check_sessions();
+  all_passed &= check_stream();
+  all_passed &= check_formats();
+  all_passed &= check_small_stack();
+  all_passed &= check_cache();
+  all_passed &= check_auth();
+  all_passed &= check_chain();
+  all_passed &= check_seek();
+  all_passed &= check_budget();
+  all_passed &= check_tune();
+  all_passed &= check_mem();
+  all_passed &= check_streaming();
+
   if (all_passed)
     printf("************* ALL TESTS PASSED ****************\n");
   else
@@ -142,15 +1255,21 @@ int print_test_vectors(void)
 
 int measure_hdcp_block_speed(void)
 {
-  bsvec_t Km[BSBITS], REPEATER[BSBITS], An[BSBITS], Ks[BSBITS], R0[BSBITS], M0[BSBITS];
+  uint64_t Km[BSBITS], REPEATER[BSBITS], An[BSBITS], Ks[BSBITS], R0[BSBITS], M0[BSBITS];
   BS_HDCPCipherState hs;
   struct timeval tv1, tv2;
   int64_t count;
+  int i;
+
+  for (i = 0; i < BSBITS; i++) {
+    Km[i] = (uint64_t)lrand48() << 24 ^ lrand48();
+    An[i] = (uint64_t)lrand48() << 32 ^ lrand48();
+    REPEATER[i] = 0;
+  }
 
   count = 0;
   gettimeofday(&tv1, NULL);
   do {
-    int i;
     for (i = 0; i < 100; i++)
       HDCPBlockCipher(BSBITS, Km, REPEATER, An, &hs, Ks, R0, M0);
     count += 100;
@@ -162,13 +1281,16 @@ int measure_hdcp_block_speed(void)
 
 int measure_hdcp_stream_speed(void)
 {
-  bsvec_t Km = UINT64_C(0x1234567890abcd), REPEATER = 0, 
+  uint64_t Km = UINT64_C(0x1234567890abcd), REPEATER = 0, 
     An = UINT64_C(0xfedcba0987654321), Ks, R0, M0, Ki[BSBITS], Ri[BSBITS], Mi[BSBITS];
-  static uint32_t outputs[480][640][BSBITS];
+  uint32_t (*outputs)[640][BSBITS] = HDCPAlloc(sizeof(uint32_t) * 480 * 640 * BSBITS,
+                                               HDCPDefaultPages(), -1);
   BS_HDCPCipherState hs;
   struct timeval tv1, tv2;
   int64_t count;
 
+  if (!outputs)
+    return 0;
   HDCPAuthentication(Km, REPEATER, An, &Ks, &R0, &M0);
 
   count = 0;
@@ -182,9 +1304,234 @@ int measure_hdcp_stream_speed(void)
     gettimeofday(&tv2, NULL);
   } while (elapsed(tv1, tv2) < 3000000);
   
+  HDCPFree(outputs);
+  return 1000000 * count/ elapsed(tv1, tv2);
+}
+
+/* Uses the engine chosen by HDCPGetEngine(), which may run more than
+   64 frames at a time.  To keep the memory use down, the frames share
+   64 buffers, which doesn't change the amount of work. */
+int measure_hdcp_xor_speed(void)
+{
+  const HDCPEngine *e = HDCPGetEngine();
+  uint64_t Km = UINT64_C(0x1234567890abcd), REPEATER = 0, 
+    An = UINT64_C(0xfedcba0987654321), Ks, R0, M0, Ki[e->lanes], Ri[e->lanes], Mi[e->lanes];
+  static uint32_t video[64][480][640];
+  uint32_t *frames[e->lanes];
+  HDCPCipherState *hs = HDCPNewCipherState(e);
+  struct timeval tv1, tv2;
+  int64_t count;
+  int i;
+
+  for (i = 0; i < e->lanes; i++)
+    frames[i] = &video[i % 64][0][0];
+
+  HDCPAuthentication(Km, REPEATER, An, &Ks, &R0, &M0);
+
+  count = 0;
+  Mi[e->lanes-1] = M0;
+  gettimeofday(&tv1, NULL);
+  do {
+    e->InitializeMultiFrameState(e->lanes, Ks, 0, Mi[e->lanes-1], hs, Ki, Ri, Mi);
+    e->FrameStreamXor(e->lanes, 480, 640, hs, frames, sizeof(video[0][0]));
+    
+    count += e->lanes;
+    gettimeofday(&tv2, NULL);
+  } while (elapsed(tv1, tv2) < 3000000);
+
+  HDCPFreeCipherState(hs);
+  return 1000000 * count/ elapsed(tv1, tv2);
+}
+
+/* Same as measure_hdcp_xor_speed, but spread over a pool of threads.
+   Each batch in flight gets its own 16 frame buffers. */
+int measure_hdcp_pool_speed(int nthreads)
+{
+  const HDCPEngine *e = HDCPGetEngine();
+  uint64_t Km = UINT64_C(0x1234567890abcd), REPEATER = 0, 
+    An = UINT64_C(0xfedcba0987654321), Ks, R0, M0;
+  int depth = 2 * nthreads;
+  uint32_t (*video)[16][480][640] = malloc(sizeof(*video) * depth);
+  uint32_t *frames[e->lanes];
+  HDCPPool *pool;
+  struct timeval tv1, tv2;
+  int64_t count;
+  long batch;
+  int i;
+
+  HDCPAuthentication(Km, REPEATER, An, &Ks, &R0, &M0);
+  pool = HDCPNewPool(e, nthreads, depth, 480, 640, Ks, 0, M0);
+
+  count = 0;
+  gettimeofday(&tv1, NULL);
+  for (batch = 0; ; batch++) {
+    for (i = 0; i < e->lanes; i++)
+      frames[i] = &video[batch % depth][i % 16][0][0];
+    if (batch >= depth)
+      count += HDCPPoolWait(pool, NULL, NULL, NULL, NULL);
+    HDCPPoolSubmit(pool, e->lanes, frames, sizeof(video[0][0][0]));
+
+    gettimeofday(&tv2, NULL);
+    if (elapsed(tv1, tv2) >= 3000000)
+      break;
+  }
+  HDCPFreePool(pool);
+  free(video);
+
+  return 1000000 * count/ elapsed(tv1, tv2);
+}
+
+/* Handshakes/second through HDCPAuthenticationBatch on nthreads threads */
+int measure_hdcp_auth_speed(int nthreads)
+{
+  enum { n = 1 << 16 };
+  static uint64_t Km[n], REPEATER[n], An[n], Ks[n], R0[n], M0[n];
+  struct timeval tv1, tv2;
+  int64_t count;
+  int i;
+
+  for (i = 0; i < n; i++) {
+    Km[i] = (uint64_t)lrand48() << 24 ^ lrand48();
+    An[i] = (uint64_t)lrand48() << 32 ^ lrand48();
+    REPEATER[i] = 0;
+  }
+
+  count = 0;
+  gettimeofday(&tv1, NULL);
+  do {
+    HDCPAuthenticationBatch(HDCPGetEngine(), nthreads, n, Km, REPEATER, An, Ks, R0, M0);
+    count += n;
+    gettimeofday(&tv2, NULL);
+  } while (elapsed(tv1, tv2) < 3000000);
+
+  return 1000000 * count / elapsed(tv1, tv2);
+}
+
+/* Frames/second when each 640x480 frame is keyed and xored on its own
+   with engine e, as a low-latency decoder would */
+int measure_hdcp_single_frame_speed(const HDCPEngine *e)
+{
+  uint64_t Km = UINT64_C(0x1234567890abcd), REPEATER = 0, 
+    An = UINT64_C(0xfedcba0987654321), Ks, R0, M0, Ki, Ri, Mi;
+  static uint32_t video[480][640];
+  uint32_t *frames[1] = { &video[0][0] };
+  HDCPCipherState *hs = HDCPNewCipherState(e);
+  struct timeval tv1, tv2;
+  int64_t count;
+
+  HDCPAuthentication(Km, REPEATER, An, &Ks, &R0, &M0);
+
+  count = 0;
+  Mi = M0;
+  gettimeofday(&tv1, NULL);
+  do {
+    e->InitializeMultiFrameState(1, Ks, 0, Mi, hs, &Ki, &Ri, &Mi);
+    e->FrameStreamXor(1, 480, 640, hs, frames, sizeof(video[0]));
+
+    count++;
+    gettimeofday(&tv2, NULL);
+  } while (elapsed(tv1, tv2) < 3000000);
+
+  HDCPFreeCipherState(hs);
   return 1000000 * count/ elapsed(tv1, tv2);
 }
 
+/* Frames/second when xoring the output of a pipeline (at most 256MB
+   of batches in flight) into 16 frame buffers.  *nframes is set to
+   the batch size and *stall to the longest time, in microseconds,
+   spent waiting for a batch. */
+int measure_hdcp_pipeline_speed(int *nframes, int64_t *stall)
+{
+  uint64_t Km = UINT64_C(0x1234567890abcd), REPEATER = 0, 
+    An = UINT64_C(0xfedcba0987654321), Ks, R0, M0;
+  uint32_t (*video)[480][640] = malloc(sizeof(*video) * 16);
+  HDCPPipeline *p;
+  struct timeval tv1, tv2, tv3;
+  int64_t count;
+  int i, n;
+
+  HDCPAuthentication(Km, REPEATER, An, &Ks, &R0, &M0);
+  p = HDCPNewPipeline(HDCPGetEngine(), 3, 256 << 20, 480, 640, Ks, 0, M0);
+  n = *nframes = HDCPPipelineFrames(p);
+  {
+    uint32_t *frames[n];
+
+    for (i = 0; i < n; i++)
+      frames[i] = &video[i % 16][0][0];
+
+    count = 0;
+    *stall = 0;
+    gettimeofday(&tv1, NULL);
+    do {
+      HDCPPipelineBatch *batch;
+
+      gettimeofday(&tv3, NULL);
+      batch = HDCPPipelineNext(p);
+      gettimeofday(&tv2, NULL);
+      /* The first batch is always a full generation time away */
+      if (count && elapsed(tv3, tv2) > *stall)
+        *stall = elapsed(tv3, tv2);
+
+      HDCPPipelineXor(p, batch, frames, sizeof(video[0][0]));
+      HDCPPipelineRelease(p, batch);
+      count += n;
+      gettimeofday(&tv2, NULL);
+    } while (elapsed(tv1, tv2) < 3000000);
+  }
+  HDCPFreePipeline(p);
+  free(video);
+
+  return 1000000 * count/ elapsed(tv1, tv2);
+}
+
+/* Where the cycles of all threads went, if the library counts them */
+void print_stage_breakdown(void)
+{
+  HDCPStageCount counts[HDCP_NSTAGES];
+  uint64_t total = 0;
+  int i;
+
+  if (!HDCPProfileEnabled())
+    return;
+
+  HDCPProfileTotalCounts(counts);
+  for (i = 0; i < HDCP_NSTAGES; i++)
+    total += counts[i].cycles;
+
+  printf("\n%-16s %12s %14s %8s %14s\n", "stage", "calls", "cycles", "share", "cycles/call");
+  for (i = 0; i < HDCP_NSTAGES; i++)
+    printf("%-16s %12" PRIu64 " %14" PRIu64 " %7.2f%% %14.1f\n",
+           HDCPStageName(i), counts[i].calls, counts[i].cycles,
+           total ? 100.0 * counts[i].cycles / total : 0.0,
+           counts[i].calls ? (double)counts[i].cycles / counts[i].calls : 0.0);
+}
+
+/* Tune for the usual resolutions, print the results and save them to
+   path, if it isn't NULL */
+int tune(const char *path)
+{
+  static const int heights[4] = { 480, 720, 1080, 2160 }, widths[4] = { 720, 1280, 1920, 3840 };
+  HDCPTuning t;
+  int i;
+
+  if (HDCPTune(4, heights, widths, 0.02, &t) < 0) {
+    fprintf(stderr, "hdcp: tuning failed\n");
+    return 1;
+  }
+
+  printf("%-11s %-11s %5s %7s %9s\n", "resolution", "engine", "lines", "threads", "ns/pixel");
+  for (i = 0; i < t.n; i++)
+    printf("%4dx%-6d %-11s %5d %7d %9.3f\n", t.res[i].width, t.res[i].height,
+           t.res[i].e->name, t.res[i].lines, t.res[i].threads, t.res[i].ns);
+  printf("block cipher: %s, %.1f ns per copy\n", t.block->name, t.block_ns);
+
+  if (path && HDCPSaveTuning(&t, path) < 0) {
+    perror(path);
+    return 1;
+  }
+  return 0;
+}
+
 int main(int argc, char *argv[])
 {
   srand48(time(NULL));
@@ -194,8 +1541,41 @@ int main(int argc, char *argv[])
   }
 
   else if (argc == 2 && strcmp(argv[1], "-S") == 0) {
-    //printf("BlockCiphers/second: %d\n", measure_hdcp_block_speed());
+    HDCPProfileReset();
+    printf("BlockCiphers/second: %d\n", measure_hdcp_block_speed());
+    {
+      int nthreads = sysconf(_SC_NPROCESSORS_ONLN);
+      printf("Authentications/second (%s engine, %d threads): %d\n",
+             HDCPGetEngine()->name, nthreads, measure_hdcp_auth_speed(nthreads));
+    }
     printf("640x480 Frames/second: %d\n", measure_hdcp_stream_speed());
+    printf("640x480 Frames/second (xor in place, %s engine, %d lanes): %d\n",
+           HDCPGetEngine()->name, HDCPLanes(), measure_hdcp_xor_speed());
+    {
+      int nthreads = sysconf(_SC_NPROCESSORS_ONLN);
+      printf("640x480 Frames/second (xor in place, %d threads): %d\n",
+             nthreads, measure_hdcp_pool_speed(nthreads));
+    }
+    {
+      int64_t stall;
+      int nframes, fps = measure_hdcp_pipeline_speed(&nframes, &stall);
+
+      printf("640x480 Frames/second (pipeline, %d frame batches): %d, longest wait %" PRId64 "us\n",
+             nframes, fps, stall);
+    }
+    printf("640x480 Frames/second (one frame at a time, scalar engine): %d\n",
+           measure_hdcp_single_frame_speed(HDCPFindEngine("scalar")));
+    printf("640x480 Frames/second (one frame at a time, %s engine): %d\n",
+           HDCPGetEngine()->name, measure_hdcp_single_frame_speed(HDCPGetEngine()));
+    print_stage_breakdown();
+  }
+
+  else if ((argc == 2 || argc == 3) && strcmp(argv[1], "--tune") == 0) {
+    return tune(argc == 3 ? argv[2] : NULL);
+  }
+
+  else if (argc >= 2 && strcmp(argv[1], "-B") == 0) {
+    return HDCPBenchmark(argc - 2, argv + 2);
   }
 
   else {
@@ -204,7 +1584,11 @@ int main(int argc, char *argv[])
 	   "  Print HDCP test vectors\n\n"
 	   "hdcp -S\n"
 	   "  Run hdcp speed trials\n\n"
+	   "hdcp --tune [file]\n"
+	   "  Time each engine, tile size and thread count on this machine and\n"
+	   "  save the fastest to file (load it with HDCP_TUNING=file)\n\n"
 	   );
+    HDCPBenchUsage(stdout);
   }
 
   return 0;
@@ -0,0 +1,126 @@
+/************************************************************
+ * Many authentications at once.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "hdcp_cipher.h"
+#include "hdcp_auth.h"
+
+typedef struct _AuthSlice
+{
+  const HDCPEngine *e;
+  int64_t first, n;
+  uint64_t *Km, *REPEATER, *An, *Ks, *R0, *M0;
+  uint64_t *ksv;             /* Km comes from these if not NULL */
+  const uint64_t *const *keys;
+  int status;
+  pthread_t thread;
+} AuthSlice;
+
+/* Authenticate handshakes first..first+n-1, a full engine's worth at a
+   time (the last batch may be short) */
+static void *AuthWorker(void *arg)
+{
+  AuthSlice *s = arg;
+  const HDCPEngine *e = s->e;
+  HDCPCipherState *hs = HDCPNewCipherState(e);
+  uint64_t Km[e->lanes], *K_;
+  int64_t i, end = s->first + s->n;
+  int k;
+
+  if (!hs) {
+    s->status = -1;
+    return NULL;
+  }
+  for (i = s->first; i < end; i += k) {
+    k = end - i < e->lanes ? end - i : e->lanes;
+    if (s->ksv) {
+      e->DeriveKm(k, &s->ksv[i], &s->keys[i], Km);
+      K_ = Km;
+    } else
+      K_ = &s->Km[i];
+    e->BlockCipher(k, K_, &s->REPEATER[i], &s->An[i], hs, &s->Ks[i], &s->R0[i], &s->M0[i]);
+  }
+  HDCPFreeCipherState(hs);
+  return NULL;
+}
+
+static int AuthBatch(const HDCPEngine *e, int nthreads, int64_t n, uint64_t *Km,
+                     uint64_t *ksv, const uint64_t *const *keys, uint64_t *REPEATER,
+                     uint64_t *An, uint64_t *Ks, uint64_t *R0, uint64_t *M0)
+{
+  AuthSlice *slices;
+  int64_t nbatches, per;
+  int i, started, status = 0;
+
+  if (n <= 0)
+    return 0;
+  if (nthreads <= 0)
+    nthreads = sysconf(_SC_NPROCESSORS_ONLN);
+  if (nthreads > n / HDCP_AUTH_PER_THREAD)
+    nthreads = n / HDCP_AUTH_PER_THREAD;
+  if (nthreads <= 0)
+    nthreads = 1;
+  if (!(slices = calloc(nthreads, sizeof(*slices))))
+    return -1;
+
+  /* Whole batches for every thread but the last, so that no lane is
+     idle except in the very last batch */
+  nbatches = (n + e->lanes - 1) / e->lanes;
+  per = (nbatches + nthreads - 1) / nthreads * e->lanes;
+  for (i = 0; i < nthreads; i++) {
+    AuthSlice *s = &slices[i];
+
+    s->e = e;
+    s->first = i * per < n ? i * per : n;
+    s->n = n - s->first < per ? n - s->first : per;
+    s->Km = Km;
+    s->ksv = ksv;
+    s->keys = keys;
+    s->REPEATER = REPEATER;
+    s->An = An;
+    s->Ks = Ks;
+    s->R0 = R0;
+    s->M0 = M0;
+  }
+
+  /* The calling thread takes the first slice itself */
+  for (started = 1; started < nthreads; started++)
+    if (pthread_create(&slices[started].thread, NULL, AuthWorker, &slices[started])) {
+      status = -1;
+      break;
+    }
+  AuthWorker(&slices[0]);
+  for (i = 1; i < started; i++)
+    pthread_join(slices[i].thread, NULL);
+  for (i = 0; i < started; i++)
+    status |= slices[i].status;
+
+  free(slices);
+  return status;
+}
+
+int HDCPAuthenticationBatch(const HDCPEngine *e, int nthreads, int64_t n,
+                            uint64_t *Km, uint64_t *REPEATER, uint64_t *An,
+                            uint64_t *Ks, uint64_t *R0, uint64_t *M0)
+{
+  return AuthBatch(e, nthreads, n, Km, NULL, NULL, REPEATER, An, Ks, R0, M0);
+}
+
+int HDCPAuthenticationFromKeys(const HDCPEngine *e, int nthreads, int64_t n,
+                               uint64_t *ksv, const uint64_t *const *keys,
+                               uint64_t *REPEATER, uint64_t *An,
+                               uint64_t *Ks, uint64_t *R0, uint64_t *M0)
+{
+  return AuthBatch(e, nthreads, n, NULL, ksv, keys, REPEATER, An, Ks, R0, M0);
+}
+
+int HDCPValidKsv(uint64_t ksv)
+{
+  return ksv >> HDCP_NKEYS == 0 && __builtin_popcountll(ksv) == HDCP_NKEYS / 2;
+}
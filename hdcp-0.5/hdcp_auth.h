@@ -0,0 +1,44 @@
+/************************************************************
+ * Many authentications at once.
+ *
+ * HDCPAuthentication runs the block cipher for one (Km, REPEATER, An)
+ * tuple, in one lane of the bit-sliced cipher.  Checking a large set
+ * of recorded handshakes can instead fill every lane of the engine
+ * with a different handshake, and spread the batches over threads.
+ * Km can also be derived from a KSV and device keys on the way, a
+ * batch at a time, so that it never has to be stored.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#ifndef __HDCP_AUTH_H__
+#define __HDCP_AUTH_H__
+
+#include <stdint.h>
+#include "hdcp_engine.h"
+
+/* Fewest handshakes worth starting another thread for */
+#define HDCP_AUTH_PER_THREAD 4096
+
+/* For each i < n, compute Ks[i], R0[i] and M0[i] from Km[i],
+   REPEATER[i] and An[i] as HDCPAuthentication does, e->lanes at a time
+   on up to nthreads threads (one per CPU if nthreads <= 0; fewer if
+   there are fewer than HDCP_AUTH_PER_THREAD handshakes for each).
+   Returns 0, or -1 if it runs out of memory or threads, in which case
+   the outputs are incomplete. */
+int HDCPAuthenticationBatch(const HDCPEngine *e, int nthreads, int64_t n,
+                            uint64_t *Km, uint64_t *REPEATER, uint64_t *An,
+                            uint64_t *Ks, uint64_t *R0, uint64_t *M0);
+
+/* Same as HDCPAuthenticationBatch, but with Km[i] derived from ksv[i]
+   and the HDCP_NKEYS device keys at keys[i], as HDCPDeriveKm does */
+int HDCPAuthenticationFromKeys(const HDCPEngine *e, int nthreads, int64_t n,
+                               uint64_t *ksv, const uint64_t *const *keys,
+                               uint64_t *REPEATER, uint64_t *An,
+                               uint64_t *Ks, uint64_t *R0, uint64_t *M0);
+
+/* 1 if ksv is a valid KSV: HDCP_NKEYS bits, half of them set */
+int HDCPValidKsv(uint64_t ksv);
+
+#endif /* __HDCP_AUTH_H__ */
@@ -0,0 +1,922 @@
+/************************************************************
+ * Benchmark suite for the HDCP engines.
+ *
+ * Each measurement runs one layer of the library in a loop for a
+ * fixed time.  The frame layers (stream, xor) generate a batch of
+ * frames a few lines at a time into small buffers that are reused for
+ * every chunk of lines, so 4K frames in batches of 512 cost no more
+ * memory than 480p ones while doing the same work per frame.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#define HAVE_PERF 1
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+#include "hdcp_cipher.h"
+#include "hdcp_engine.h"
+#include "hdcp_pool.h"
+#include "hdcp_cache.h"
+#include "hdcp_auth.h"
+#include "hdcp_chain.h"
+#include "hdcp_seek.h"
+#include "hdcp_mem.h"
+#include "hdcp_bench.h"
+
+#define MAX_LIST 32
+
+/* Largest buffer, in bytes, a chunk of lines of stream output may use */
+#define CHUNK_BYTES (16 << 20)
+
+/* Largest keystream cache file, in bytes, the cache layer writes */
+#define CACHE_BYTES (64 << 20)
+
+/* Handshakes per HDCPAuthenticationBatch call in the auth layer */
+#define AUTH_BATCH (1 << 16)
+
+/* Frames (about 18 minutes at 60Hz) and the checkpoint interval of the
+   index the seek layer seeks in */
+#define SEEK_FRAMES   (1 << 16)
+#define SEEK_INTERVAL 64
+
+typedef struct _BenchCase
+{
+  const HDCPEngine *e;
+  int layer;
+  int width, height;   /* 0 for the layers that don't work on frames */
+  int batch, threads;
+  HDCPPages pages;     /* of the frame layers' buffers */
+  double seconds;
+} BenchCase;
+
+typedef struct _BenchResult
+{
+  double seconds, cycles;  /* cycles is 0 without a cycle counter */
+  double items, pixels;
+  double tlb_misses;       /* -1 without TLB miss counters */
+  long peak_rss_kb;
+} BenchResult;
+
+/* The dTLB load and store miss counters are of the calling thread
+   only, and -1 if the kernel won't give them out */
+typedef struct _BenchClock
+{
+  struct timespec ts;
+  uint64_t tsc;
+  int tlb[2];
+} BenchClock;
+
+static void Bench_block(const BenchCase *c, BenchResult *r);
+static void Bench_auth(const BenchCase *c, BenchResult *r);
+static void Bench_authkeys(const BenchCase *c, BenchResult *r);
+static void Bench_setup(const BenchCase *c, BenchResult *r);
+static void Bench_chain(const BenchCase *c, BenchResult *r);
+static void Bench_seek(const BenchCase *c, BenchResult *r);
+static void Bench_rekey(const BenchCase *c, BenchResult *r);
+static void Bench_transpose(const BenchCase *c, BenchResult *r);
+static void Bench_stream(const BenchCase *c, BenchResult *r);
+static void Bench_framemajor(const BenchCase *c, BenchResult *r);
+static void Bench_xor(const BenchCase *c, BenchResult *r);
+static void Bench_rgb24(const BenchCase *c, BenchResult *r);
+static void Bench_yuv444p(const BenchCase *c, BenchResult *r);
+static void Bench_cache(const BenchCase *c, BenchResult *r);
+static void Bench_pool(const BenchCase *c, BenchResult *r);
+
+/* What each layer sweeps over */
+enum { SWEEP_BATCH = 1, SWEEP_RES = 2, SWEEP_THREADS = 4, SWEEP_PAGES = 8 };
+
+static const struct {
+  const char *name, *unit;
+  int sweep;
+  void (*run)(const BenchCase *c, BenchResult *r);
+} layers[] = {
+  { "block",      "block", SWEEP_BATCH,                             Bench_block },
+  { "auth",       "auth",  SWEEP_THREADS,                           Bench_auth },
+  { "authkeys",   "auth",  SWEEP_THREADS,                           Bench_authkeys },
+  { "setup",      "frame", SWEEP_BATCH,                             Bench_setup },
+  { "chain",      "frame", SWEEP_BATCH,                             Bench_chain },
+  { "seek",       "seek",  SWEEP_BATCH,                             Bench_seek },
+  { "rekey",      "rekey", 0,                                       Bench_rekey },
+  { "transpose",  "pixel", SWEEP_BATCH,                             Bench_transpose },
+  { "stream",     "frame", SWEEP_BATCH | SWEEP_RES | SWEEP_PAGES,   Bench_stream },
+  { "framemajor", "frame", SWEEP_BATCH | SWEEP_RES | SWEEP_PAGES,   Bench_framemajor },
+  { "xor",        "frame", SWEEP_BATCH | SWEEP_RES | SWEEP_PAGES,   Bench_xor },
+  { "rgb24",      "frame", SWEEP_BATCH | SWEEP_RES | SWEEP_PAGES,   Bench_rgb24 },
+  { "yuv444p",    "frame", SWEEP_BATCH | SWEEP_RES | SWEEP_PAGES,   Bench_yuv444p },
+  { "cache",      "frame", SWEEP_RES,                               Bench_cache },
+  { "pool",       "frame", SWEEP_RES | SWEEP_THREADS | SWEEP_PAGES, Bench_pool },
+};
+#define NLAYERS ((int)(sizeof(layers) / sizeof(layers[0])))
+
+static const struct {
+  const char *name;
+  int width, height;
+} resolutions[] = {
+  { "480p",  720,  480 },
+  { "720p",  1280, 720 },
+  { "1080p", 1920, 1080 },
+  { "4k",    3840, 2160 },
+  { "2160p", 3840, 2160 },
+};
+#define NRESOLUTIONS ((int)(sizeof(resolutions) / sizeof(resolutions[0])))
+
+static const uint64_t Ks = UINT64_C(0x1234567890abcd), M0 = UINT64_C(0xfedcba0987654321);
+
+/***********************************************
+ * Timing and memory
+ ***********************************************/
+
+static uint64_t ReadTSC(void)
+{
+#ifdef HAVE_TSC
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+/* A counter of dTLB misses on op (PERF_COUNT_HW_CACHE_OP_READ or
+   _WRITE) by the calling thread, in user space, or -1 */
+static int OpenTLBCounter(int op)
+{
+#ifdef HAVE_PERF
+  struct perf_event_attr attr;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HW_CACHE;
+  attr.config = PERF_COUNT_HW_CACHE_DTLB | op << 8 | PERF_COUNT_HW_CACHE_RESULT_MISS << 16;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+  return -1;
+#endif
+}
+
+static void ClockStart(BenchClock *clk)
+{
+#ifdef HAVE_PERF
+  clk->tlb[0] = OpenTLBCounter(PERF_COUNT_HW_CACHE_OP_READ);
+  clk->tlb[1] = OpenTLBCounter(PERF_COUNT_HW_CACHE_OP_WRITE);
+#else
+  clk->tlb[0] = clk->tlb[1] = -1;
+#endif
+  clock_gettime(CLOCK_MONOTONIC, &clk->ts);
+  clk->tsc = ReadTSC();
+}
+
+static double ClockSeconds(const BenchClock *clk)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - clk->ts.tv_sec) + 1e-9 * (now.tv_nsec - clk->ts.tv_nsec);
+}
+
+static void ClockStop(const BenchClock *clk, BenchResult *r)
+{
+  uint64_t count;
+  int i;
+
+  r->seconds = ClockSeconds(clk);
+  r->cycles = clk->tsc ? (double)(ReadTSC() - clk->tsc) : 0;
+  r->tlb_misses = clk->tlb[0] < 0 ? -1 : 0;
+  for (i = 0; i < 2; i++)
+    if (clk->tlb[i] >= 0) {
+      if (r->tlb_misses >= 0 && read(clk->tlb[i], &count, sizeof(count)) == sizeof(count))
+        r->tlb_misses += count;
+      else
+        r->tlb_misses = -1;
+      close(clk->tlb[i]);
+    }
+}
+
+/* Reset the kernel's high-water mark of resident memory, so that each
+   measurement sees its own peak.  Only Linux can do this; elsewhere
+   the peak covers the whole run so far. */
+static void ResetPeakRSS(void)
+{
+  FILE *f = fopen("/proc/self/clear_refs", "w");
+
+  if (f) {
+    fputs("5", f);
+    fclose(f);
+  }
+}
+
+static long PeakRSS(void)
+{
+  FILE *f = fopen("/proc/self/status", "r");
+  char line[256];
+  long kb = -1;
+  struct rusage ru;
+
+  if (f) {
+    while (fgets(line, sizeof(line), f))
+      if (sscanf(line, "VmHWM: %ld kB", &kb) == 1)
+        break;
+    fclose(f);
+  }
+  if (kb < 0 && getrusage(RUSAGE_SELF, &ru) == 0)
+    kb = ru.ru_maxrss;
+  return kb;
+}
+
+/***********************************************
+ * The layers
+ ***********************************************/
+
+/* c->batch copies of the block cipher per call, with random inputs */
+static void Bench_block(const BenchCase *c, BenchResult *r)
+{
+  const HDCPEngine *e = c->e;
+  uint64_t K[e->lanes], REPEATER[e->lanes], Bin[e->lanes], Ki[e->lanes], Ri[e->lanes], Mi[e->lanes];
+  HDCPCipherState *hs = HDCPNewCipherState(e);
+  BenchClock clk;
+  int i;
+
+  for (i = 0; i < e->lanes; i++) {
+    K[i] = (uint64_t)lrand48() << 24 ^ lrand48();
+    Bin[i] = (uint64_t)lrand48() << 32 ^ lrand48();
+    REPEATER[i] = 0;
+  }
+
+  ClockStart(&clk);
+  do {
+    e->BlockCipher(c->batch, K, REPEATER, Bin, hs, Ki, Ri, Mi);
+    r->items += c->batch;
+  } while (ClockSeconds(&clk) < c->seconds);
+  ClockStop(&clk, r);
+
+  HDCPFreeCipherState(hs);
+}
+
+/* Handshakes through HDCPAuthenticationBatch on c->threads threads,
+   or, with keys, through HDCPAuthenticationFromKeys with the keys of
+   one device and the KSVs of many */
+static void Bench_handshakes(const BenchCase *c, BenchResult *r, int keys)
+{
+  uint64_t *buf = malloc(6 * AUTH_BATCH * sizeof(uint64_t));
+  uint64_t *Km = buf, *REPEATER = buf + AUTH_BATCH, *An = buf + 2 * AUTH_BATCH;
+  uint64_t *Ks = buf + 3 * AUTH_BATCH, *R0 = buf + 4 * AUTH_BATCH, *M0 = buf + 5 * AUTH_BATCH;
+  const uint64_t **keyp = malloc(AUTH_BATCH * sizeof(*keyp));
+  uint64_t device[HDCP_NKEYS];
+  BenchClock clk;
+  int i, status;
+
+  if (!buf || !keyp)
+    goto out;
+  for (i = 0; i < HDCP_NKEYS; i++)
+    device[i] = ((uint64_t)lrand48() << 24 ^ lrand48()) & ((UINT64_C(1) << 56) - 1);
+  for (i = 0; i < AUTH_BATCH; i++) {
+    Km[i] = (uint64_t)lrand48() << 24 ^ lrand48();   /* or the KSVs, with keys */
+    An[i] = (uint64_t)lrand48() << 32 ^ lrand48();
+    REPEATER[i] = i & 1;
+    keyp[i] = device;
+  }
+
+  ClockStart(&clk);
+  do {
+    if (keys)
+      status = HDCPAuthenticationFromKeys(c->e, c->threads, AUTH_BATCH, Km, keyp,
+                                          REPEATER, An, Ks, R0, M0);
+    else
+      status = HDCPAuthenticationBatch(c->e, c->threads, AUTH_BATCH, Km, REPEATER, An, Ks, R0, M0);
+    if (status < 0)
+      break;
+    r->items += AUTH_BATCH;
+  } while (ClockSeconds(&clk) < c->seconds);
+  ClockStop(&clk, r);
+
+ out:
+  free(buf);
+  free(keyp);
+}
+
+static void Bench_auth(const BenchCase *c, BenchResult *r)
+{
+  Bench_handshakes(c, r, 0);
+}
+
+static void Bench_authkeys(const BenchCase *c, BenchResult *r)
+{
+  Bench_handshakes(c, r, 1);
+}
+
+/* Walking the Mi chain and keying c->batch frames */
+static void Bench_setup(const BenchCase *c, BenchResult *r)
+{
+  const HDCPEngine *e = c->e;
+  uint64_t Ki[e->lanes], Ri[e->lanes], Mi[e->lanes], Mi0 = M0;
+  HDCPCipherState *hs = HDCPNewCipherState(e);
+  BenchClock clk;
+
+  ClockStart(&clk);
+  do {
+    e->InitializeMultiFrameState(c->batch, Ks, 0, Mi0, hs, Ki, Ri, Mi);
+    Mi0 = Mi[c->batch-1];
+    r->items += c->batch;
+  } while (ClockSeconds(&clk) < c->seconds);
+  ClockStop(&clk, r);
+
+  HDCPFreeCipherState(hs);
+}
+
+/* Walking the Mi chains of c->batch links, keyed a whole engine's
+   worth of frames at a time, and keeping the Ri of every 128th frame
+   as a link integrity check would */
+static void Bench_chain(const BenchCase *c, BenchResult *r)
+{
+  const HDCPEngine *e = c->e;
+  HDCPSessionFrames sessions[c->batch];
+  uint64_t Ri[c->batch];
+  HDCPChains *chains;
+  BenchClock clk;
+  int i;
+
+  for (i = 0; i < c->batch; i++) {
+    sessions[i].Ks = Ks ^ i;
+    sessions[i].REPEATER = 0;
+    sessions[i].Mi0 = M0;
+    sessions[i].nframes = e->lanes;
+  }
+  if (!(chains = HDCPNewChains(e, c->batch, sessions)))
+    return;
+
+  ClockStart(&clk);
+  do {
+    HDCPWalkChains(chains, 128, 128, NULL, Ri, NULL);
+    r->items += 128 * c->batch;
+  } while (ClockSeconds(&clk) < c->seconds);
+  ClockStop(&clk, r);
+
+  HDCPFreeChains(chains);
+}
+
+/* Seeking to a random frame with a seek index and keying a batch of
+   c->batch frames from there, as scrubbing through a recording does.
+   Building the index isn't timed. */
+static void Bench_seek(const BenchCase *c, BenchResult *r)
+{
+  const HDCPEngine *e = c->e;
+  uint64_t Ki[e->lanes], Ri[e->lanes], Mi[e->lanes], Mi0;
+  HDCPSeekIndex *x = HDCPNewSeekIndex(Ks, 0, M0, SEEK_FRAMES, SEEK_INTERVAL);
+  HDCPCipherState *hs = HDCPNewCipherState(e);
+  BenchClock clk;
+
+  if (!x || !hs)
+    goto out;
+
+  ClockStart(&clk);
+  do {
+    HDCPSeek(x, lrand48() % SEEK_FRAMES, &Mi0);
+    e->InitializeMultiFrameState(c->batch, Ks, 0, Mi0, hs, Ki, Ri, Mi);
+    r->items++;
+  } while (ClockSeconds(&clk) < c->seconds);
+  ClockStop(&clk, r);
+
+ out:
+  if (x)
+    HDCPFreeSeekIndex(x);
+  HDCPFreeCipherState(hs);
+}
+
+/* One rekey of all lanes per item */
+static void Bench_rekey(const BenchCase *c, BenchResult *r)
+{
+  const HDCPEngine *e = c->e;
+  uint64_t Ki[e->lanes], Ri[e->lanes], Mi[e->lanes];
+  HDCPCipherState *hs = HDCPNewCipherState(e);
+  BenchClock clk;
+
+  e->InitializeMultiFrameState(e->lanes, Ks, 0, M0, hs, Ki, Ri, Mi);
+  ClockStart(&clk);
+  do {
+    int i;
+
+    for (i = 0; i < 64; i++)
+      e->Rekeycipher(hs);
+    r->items += 64;
+  } while (ClockSeconds(&clk) < c->seconds);
+  ClockStop(&clk, r);
+
+  HDCPFreeCipherState(hs);
+}
+
+/* Transposing 64 pixels of random slices for c->batch frames */
+static void Bench_transpose(const BenchCase *c, BenchResult *r)
+{
+  const HDCPEngine *e = c->e;
+  size_t slices_bytes = 64 * 24 * (e->lanes / 8);
+  unsigned char *slices;
+  uint32_t *outputs = malloc(sizeof(uint32_t) * 64 * c->batch);
+  BenchClock clk;
+  size_t i;
+
+  if (posix_memalign((void **)&slices, 64, slices_bytes))
+    slices = NULL;
+  if (!slices || !outputs)
+    goto out;
+  for (i = 0; i < slices_bytes; i++)
+    slices[i] = lrand48();
+
+  ClockStart(&clk);
+  do {
+    e->Transpose(c->batch, 64, slices, outputs);
+    r->items += 64 * c->batch;
+  } while (ClockSeconds(&clk) < c->seconds);
+  ClockStop(&clk, r);
+  r->pixels = r->items;
+
+ out:
+  free(slices);
+  free(outputs);
+}
+
+enum { FRAMES_STREAM, FRAMES_FRAME_MAJOR, FRAMES_XOR };
+
+/* Generate (or xor in place into frames of the given format) c->batch
+   frames, a chunk of lines at a time, keying the next batch whenever a
+   whole frame is done. */
+static void Bench_frames(const BenchCase *c, BenchResult *r, int mode, HDCPPixelFormat format)
+{
+  const HDCPEngine *e = c->e;
+  int n = c->batch, w = c->width, h = c->height;
+  int nbuf = n < 4 ? n : 4;
+  int chunk = CHUNK_BYTES / ((size_t)w * n * sizeof(uint32_t));
+  uint64_t Ki[e->lanes], Ri[e->lanes], Mi[e->lanes], Mi0 = M0;
+  uint32_t *frames[e->lanes], *video, *outputs = NULL;
+  uint8_t *bytes[e->lanes];
+  HDCPLayout l = { format, w * HDCPPixelBytes(format), 0 };
+  HDCPCipherState *hs = HDCPNewCipherState(e);
+  BenchClock clk;
+  int64_t lines = 0;
+  int i, line, k;
+
+  chunk = chunk < 1 ? 1 : chunk > h ? h : chunk;
+  video = HDCPAlloc(sizeof(uint32_t) * nbuf * chunk * w, c->pages, -1);
+  if (mode != FRAMES_XOR)
+    outputs = HDCPAlloc(sizeof(uint32_t) * chunk * w * n, c->pages, -1);
+  if (!video || (mode != FRAMES_XOR && !outputs))
+    goto out;
+  l.plane_pitch = (size_t)chunk * l.pitch;
+  for (i = 0; i < n; i++) {
+    frames[i] = video + (size_t)(i % nbuf) * chunk * w;
+    bytes[i] = (uint8_t *)frames[i];
+  }
+
+  line = h;
+  ClockStart(&clk);
+  do {
+    if (line == h) {
+      e->InitializeMultiFrameState(n, Ks, 0, Mi0, hs, Ki, Ri, Mi);
+      Mi0 = Mi[n-1];
+      line = 0;
+    }
+    k = h - line < chunk ? h - line : chunk;
+    if (mode == FRAMES_XOR && format != HDCP_PIXEL_XRGB32)
+      e->FrameStreamFormat(n, k, w, hs, bytes, &l, 1);
+    else if (mode == FRAMES_XOR)
+      e->FrameStreamXor(n, k, w, hs, frames, w * sizeof(uint32_t));
+    else if (mode == FRAMES_FRAME_MAJOR)
+      e->FrameStreamFrameMajor(n, k, w, hs, outputs);
+    else
+      e->FrameStream(n, k, w, hs, outputs);
+    line += k;
+    lines += k;
+  } while (ClockSeconds(&clk) < c->seconds);
+  ClockStop(&clk, r);
+  r->pixels = (double)lines * w * n;
+  r->items = r->pixels / ((double)w * h);
+
+ out:
+  HDCPFreeCipherState(hs);
+  HDCPFree(video);
+  HDCPFree(outputs);
+}
+
+static void Bench_stream(const BenchCase *c, BenchResult *r)
+{
+  Bench_frames(c, r, FRAMES_STREAM, HDCP_PIXEL_XRGB32);
+}
+
+static void Bench_framemajor(const BenchCase *c, BenchResult *r)
+{
+  Bench_frames(c, r, FRAMES_FRAME_MAJOR, HDCP_PIXEL_XRGB32);
+}
+
+static void Bench_xor(const BenchCase *c, BenchResult *r)
+{
+  Bench_frames(c, r, FRAMES_XOR, HDCP_PIXEL_XRGB32);
+}
+
+static void Bench_rgb24(const BenchCase *c, BenchResult *r)
+{
+  Bench_frames(c, r, FRAMES_XOR, HDCP_PIXEL_RGB24);
+}
+
+static void Bench_yuv444p(const BenchCase *c, BenchResult *r)
+{
+  Bench_frames(c, r, FRAMES_XOR, HDCP_PIXEL_YCBCR444P);
+}
+
+/* xor frames with output saved by HDCPCreateCache instead of
+   generating it: a batch of up to CACHE_BYTES of frames is written to
+   a temporary file, and then xored into one frame over and over.  Once
+   the file is in the page cache this is bound by memory bandwidth. */
+static void Bench_cache(const BenchCase *c, BenchResult *r)
+{
+  const char *tmp = getenv("TMPDIR");
+  size_t frame = (size_t)c->width * c->height;
+  int n = CACHE_BYTES / (frame * sizeof(uint32_t));
+  uint32_t *video = calloc(frame, sizeof(uint32_t));
+  HDCPCache *cache = NULL;
+  BenchClock clk;
+  char path[4096];
+  int64_t i;
+  int fd;
+
+  n = n < 1 ? 1 : n > c->batch ? c->batch : n;
+  snprintf(path, sizeof(path), "%s/hdcp-bench-XXXXXX", tmp ? tmp : "/tmp");
+  if (!video || (fd = mkstemp(path)) < 0)
+    goto out;
+  close(fd);
+  if (HDCPCreateCache(path, c->e, n, n, c->height, c->width, Ks, 0, M0) == 0)
+    cache = HDCPOpenCache(path);
+  unlink(path);
+  if (!cache)
+    goto out;
+
+  ClockStart(&clk);
+  for (i = 0; i < n || ClockSeconds(&clk) < c->seconds; i++)
+    r->items += HDCPCacheFrameStreamXor(cache, i % n, 1, &video, c->width * sizeof(uint32_t));
+  ClockStop(&clk, r);
+  r->pixels = r->items * frame;
+
+ out:
+  if (cache)
+    HDCPCloseCache(cache);
+  free(video);
+}
+
+/* Whole frames through a pool of c->threads workers.  All the frames
+   of a batch share one buffer, since one worker xors them in turn.
+   The workers' TLB misses aren't counted. */
+static void Bench_pool(const BenchCase *c, BenchResult *r)
+{
+  const HDCPEngine *e = c->e;
+  int n = c->batch, depth = c->threads + 1;
+  size_t frame = (size_t)c->width * c->height;
+  uint32_t *video = HDCPAlloc(sizeof(uint32_t) * frame * depth, c->pages, -1);
+  uint32_t *frames[e->lanes];
+  HDCPPool *pool = HDCPNewPool(e, c->threads, depth, c->height, c->width, Ks, 0, M0);
+  BenchClock clk;
+  long batch;
+  int i;
+
+  if (!video || !pool)
+    goto out;
+
+  ClockStart(&clk);
+  for (batch = 0; ; batch++) {
+    for (i = 0; i < n; i++)
+      frames[i] = video + frame * (batch % depth);
+    if (batch >= depth)
+      r->items += HDCPPoolWait(pool, NULL, NULL, NULL, NULL);
+    HDCPPoolSubmit(pool, n, frames, c->width * sizeof(uint32_t));
+    if (batch >= depth && ClockSeconds(&clk) >= c->seconds)
+      break;
+  }
+  ClockStop(&clk, r);
+  r->pixels = r->items * frame;
+  r->tlb_misses = -1;
+
+ out:
+  if (pool)
+    HDCPFreePool(pool);
+  HDCPFree(video);
+}
+
+/***********************************************
+ * Reporting
+ ***********************************************/
+
+static void PrintNumber(const char *key, double x, int valid, int last)
+{
+  if (valid)
+    printf("\"%s\": %.6g%s", key, x, last ? "" : ", ");
+  else
+    printf("\"%s\": null%s", key, last ? "" : ", ");
+}
+
+static void PrintResult(const BenchCase *c, const BenchResult *r, int json, int first)
+{
+  double per_sec = r->seconds > 0 ? r->items / r->seconds : 0;
+  const char *pages = layers[c->layer].sweep & SWEEP_PAGES ? HDCPPagesName(c->pages) : NULL;
+  int tlb = r->tlb_misses >= 0 && r->pixels > 0;
+
+  if (json) {
+    printf("%s\n    { \"engine\": \"%s\", \"layer\": \"%s\", ",
+           first ? "" : ",", c->e->name, layers[c->layer].name);
+    PrintNumber("width", c->width, c->width > 0, 0);
+    PrintNumber("height", c->height, c->height > 0, 0);
+    printf("\"batch\": %d, \"threads\": %d, \"unit\": \"%s\", ",
+           c->batch, c->threads, layers[c->layer].unit);
+    if (pages)
+      printf("\"pages\": \"%s\", ", pages);
+    else
+      printf("\"pages\": null, ");
+    printf("\"seconds\": %.3f, \"items\": %.0f, ", r->seconds, r->items);
+    PrintNumber("per_sec", per_sec, 1, 0);
+    PrintNumber("frames_per_sec", per_sec, !strcmp(layers[c->layer].unit, "frame"), 0);
+    PrintNumber("pixels_per_sec", r->pixels / r->seconds, r->pixels > 0, 0);
+    PrintNumber("cycles_per_item", r->cycles / r->items, r->cycles > 0 && r->items > 0, 0);
+    PrintNumber("cycles_per_pixel", r->cycles / r->pixels, r->cycles > 0 && r->pixels > 0, 0);
+    PrintNumber("dtlb_misses_per_kpixel", 1000 * r->tlb_misses / r->pixels, tlb, 0);
+    printf("\"peak_rss_kb\": %ld }", r->peak_rss_kb);
+    return;
+  }
+
+  {
+    char res[32] = "-";
+    char pps[32] = "-", cpi[32] = "-", cpp[32] = "-", tpk[32] = "-";
+
+    if (c->width)
+      snprintf(res, sizeof(res), "%dx%d", c->width, c->height);
+    if (r->pixels > 0)
+      snprintf(pps, sizeof(pps), "%.4g", r->pixels / r->seconds);
+    if (r->cycles > 0 && r->items > 0)
+      snprintf(cpi, sizeof(cpi), "%.4g", r->cycles / r->items);
+    if (r->cycles > 0 && r->pixels > 0)
+      snprintf(cpp, sizeof(cpp), "%.3f", r->cycles / r->pixels);
+    if (tlb)
+      snprintf(tpk, sizeof(tpk), "%.3f", 1000 * r->tlb_misses / r->pixels);
+    printf("%-10s %-10s %-9s %5d %3d %-4s  %12.4g %-5s  %10s  %10s  %8s  %9s  %8ld\n",
+           c->e->name, layers[c->layer].name, res, c->batch, c->threads, pages ? pages : "-",
+           per_sec, layers[c->layer].unit, pps, cpi, cpp, tpk, r->peak_rss_kb);
+  }
+}
+
+static void RunCase(BenchCase *c, int json, int *first)
+{
+  BenchResult r;
+
+  memset(&r, 0, sizeof(r));
+  r.tlb_misses = -1;
+  ResetPeakRSS();
+  layers[c->layer].run(c, &r);
+  r.peak_rss_kb = PeakRSS();
+  if (r.seconds <= 0)
+    fprintf(stderr, "hdcp: %s %s: out of memory\n", c->e->name, layers[c->layer].name);
+  else
+    PrintResult(c, &r, json, *first);
+  *first = 0;
+  fflush(stdout);
+}
+
+/***********************************************
+ * Options
+ ***********************************************/
+
+void HDCPBenchUsage(FILE *f)
+{
+  fprintf(f,
+          "hdcp -B [-j] [-s seconds] [-e engines] [-l layers] [-r resolutions]\n"
+          "        [-b batches] [-T threads] [-p pages]\n"
+          "  Run the benchmark suite.  Lists are comma-separated.\n"
+          "  -j  print JSON instead of a table\n"
+          "  -s  time per measurement (default 0.5)\n"
+          "  -e  engine names, or all (default: the one HDCPGetEngine picks)\n"
+          "  -l  block, auth, authkeys, setup, chain, seek, rekey, transpose, stream,\n"
+          "      framemajor, xor, rgb24, yuv444p, cache, pool (default: all)\n"
+          "  -r  480p, 720p, 1080p, 4k or WIDTHxHEIGHT (default: 480p,720p,1080p,4k)\n"
+          "  -b  frames per batch, or lanes (default: 1,8,64,lanes)\n"
+          "  -T  pool and auth threads (default: powers of two up to the CPU count)\n"
+          "  -p  pages of the frame buffers: 1g, 2m, thp or 4k (default: HDCP_PAGES,\n"
+          "      or thp); dTLB/kpix is the dTLB misses per 1000 pixels, where the\n"
+          "      kernel allows counting them\n\n");
+}
+
+/* Split the comma-separated list s, calling parse on each element.
+   Returns the number of elements, or -1 if parse fails or there are
+   more than max of them. */
+static int ParseList(const char *s, int max, int (*parse)(const char *item, int i, void *arg), void *arg)
+{
+  char *copy = strdup(s), *save = NULL, *item;
+  int n = 0;
+
+  for (item = strtok_r(copy, ",", &save); item; item = strtok_r(NULL, ",", &save)) {
+    if (n == max || !parse(item, n, arg)) {
+      n = -1;
+      break;
+    }
+    n++;
+  }
+  free(copy);
+  return n;
+}
+
+static int ParseInt(const char *item, int i, void *arg)
+{
+  int *vals = arg;
+  char *end;
+
+  if (!strcmp(item, "lanes")) {
+    vals[i] = 0;  /* filled in per engine */
+    return 1;
+  }
+  vals[i] = strtol(item, &end, 10);
+  return *end == 0 && vals[i] > 0;
+}
+
+static int ParseResolution(const char *item, int i, void *arg)
+{
+  int (*res)[2] = arg;
+  int j;
+
+  for (j = 0; j < NRESOLUTIONS; j++)
+    if (!strcasecmp(item, resolutions[j].name)) {
+      res[i][0] = resolutions[j].width;
+      res[i][1] = resolutions[j].height;
+      return 1;
+    }
+  return sscanf(item, "%dx%d", &res[i][0], &res[i][1]) == 2 && res[i][0] > 0 && res[i][1] > 0;
+}
+
+static int ParseLayer(const char *item, int i, void *arg)
+{
+  int *vals = arg;
+  int j;
+
+  for (j = 0; j < NLAYERS; j++)
+    if (!strcmp(item, layers[j].name)) {
+      vals[i] = j;
+      return 1;
+    }
+  return 0;
+}
+
+static int ParsePages(const char *item, int i, void *arg)
+{
+  int *vals = arg;
+
+  return (vals[i] = HDCPFindPages(item)) >= 0;
+}
+
+static int ParseEngine(const char *item, int i, void *arg)
+{
+  const HDCPEngine **engines = arg;
+
+  return (engines[i] = HDCPFindEngine(item)) != NULL;
+}
+
+int HDCPBenchmark(int argc, char **argv)
+{
+  const HDCPEngine *engines[MAX_LIST];
+  int layer_list[MAX_LIST], batches[MAX_LIST], threads[MAX_LIST], res[MAX_LIST][2];
+  int pages[MAX_LIST];
+  int nengines = 1, nlayers = NLAYERS, nbatches = 4, nthreads = 0, nres = 4, npages = 1;
+  int ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+  int json = 0, first = 1;
+  double seconds = 0.5;
+  int a, i, j, l, b, t, x, pg;
+
+  engines[0] = HDCPGetEngine();
+  pages[0] = HDCPDefaultPages();
+  for (i = 0; i < NLAYERS; i++)
+    layer_list[i] = i;
+  batches[0] = 1;
+  batches[1] = 8;
+  batches[2] = 64;
+  batches[3] = 0;
+  for (i = 0; i < 4; i++) {
+    res[i][0] = resolutions[i].width;
+    res[i][1] = resolutions[i].height;
+  }
+  for (t = 1; t < ncpus && nthreads < MAX_LIST - 1; t *= 2)
+    threads[nthreads++] = t;
+  threads[nthreads++] = ncpus > 0 ? ncpus : 1;
+
+  for (a = 0; a < argc; a++) {
+    const char *opt = argv[a], *val = a + 1 < argc ? argv[a+1] : NULL;
+    int n = 0;
+
+    if (!strcmp(opt, "-j")) {
+      json = 1;
+      continue;
+    }
+    if (!val || opt[0] != '-' || opt[1] == 0 || opt[2] != 0) {
+      HDCPBenchUsage(stderr);
+      return 1;
+    }
+    a++;
+    switch (opt[1]) {
+    case 's':
+      n = (seconds = atof(val)) > 0;
+      break;
+    case 'e':
+      if (!strcmp(val, "all")) {
+        for (n = 0; n < MAX_LIST && (engines[n] = HDCPListEngines(n)); n++)
+          ;
+        nengines = n;
+      } else
+        n = nengines = ParseList(val, MAX_LIST, ParseEngine, engines);
+      break;
+    case 'l':
+      n = nlayers = ParseList(val, MAX_LIST, ParseLayer, layer_list);
+      break;
+    case 'r':
+      n = nres = ParseList(val, MAX_LIST, ParseResolution, res);
+      break;
+    case 'b':
+      n = nbatches = ParseList(val, MAX_LIST, ParseInt, batches);
+      break;
+    case 'T':
+      n = nthreads = ParseList(val, MAX_LIST, ParseInt, threads);
+      break;
+    case 'p':
+      n = npages = ParseList(val, MAX_LIST, ParsePages, pages);
+      break;
+    default:
+      fprintf(stderr, "hdcp: unknown option %s\n", opt);
+      HDCPBenchUsage(stderr);
+      return 1;
+    }
+    if (n <= 0) {
+      fprintf(stderr, "hdcp: bad value for %s: %s\n", opt, val);
+      HDCPBenchUsage(stderr);
+      return 1;
+    }
+  }
+
+  if (json)
+    printf("{\n  \"cpus\": %d,\n  \"seconds_per_case\": %g,\n  \"cycle_counter\": \"%s\",\n  \"results\": [",
+           ncpus, seconds, ReadTSC() ? "tsc" : "none");
+  else
+    printf("%-10s %-10s %-9s %5s %3s %-4s  %12s %-5s  %10s  %10s  %8s  %9s  %8s\n",
+           "engine", "layer", "size", "batch", "thr", "page", "per sec", "unit",
+           "pixels/s", "cycles/it", "cyc/pix", "dTLB/kpix", "peak KB");
+
+  for (i = 0; i < nengines; i++)
+    for (l = 0; l < nlayers; l++) {
+      int sweep = layers[layer_list[l]].sweep;
+      int nb = sweep & SWEEP_BATCH ? nbatches : 1;
+      int nr = sweep & SWEEP_RES ? nres : 1;
+      int nt = sweep & SWEEP_THREADS ? nthreads : 1;
+      int np = sweep & SWEEP_PAGES ? npages : 1;
+
+      for (x = 0; x < nr; x++)
+        for (b = 0; b < nb; b++)
+          for (t = 0; t < nt; t++)
+            for (pg = 0; pg < np; pg++) {
+              BenchCase c;
+
+              c.e = engines[i];
+              c.layer = layer_list[l];
+              c.width = sweep & SWEEP_RES ? res[x][0] : 0;
+              c.height = sweep & SWEEP_RES ? res[x][1] : 0;
+              c.batch = sweep & SWEEP_BATCH ? batches[b] : 0;
+              c.threads = sweep & SWEEP_THREADS ? threads[t] : 1;
+              c.pages = pages[pg];
+              c.seconds = seconds;
+
+              /* "lanes", or layers that always run every lane */
+              if (c.batch == 0)
+                c.batch = c.e->lanes;
+              if (c.batch > c.e->lanes)
+                continue;
+              if (layers[c.layer].run == Bench_transpose && !c.e->Transpose)
+                continue;
+              /* the same batch can come up twice once lanes is filled in */
+              for (j = 0; j < b; j++)
+                if ((batches[j] ? batches[j] : c.e->lanes) == c.batch)
+                  break;
+              if (j < b)
+                continue;
+
+              RunCase(&c, json, &first);
+            }
+    }
+
+  if (json)
+    printf("\n  ]\n}\n");
+  return 0;
+}
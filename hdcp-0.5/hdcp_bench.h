@@ -0,0 +1,31 @@
+/************************************************************
+ * Benchmark suite for the HDCP engines.
+ *
+ * HDCPBenchmark() times each layer of the library on its own -- the
+ * block cipher, the Mi chain and frame key setup, stream generation,
+ * rekeying, the bit-slice transpose, xoring into frames in place, and
+ * the thread pool -- across a sweep of resolutions, batch sizes,
+ * thread counts and engines.  Every measurement reports items/s,
+ * pixels/s, cycles per item and per pixel, dTLB misses per 1000
+ * pixels (with 4 KB or huge pages, where the kernel allows counting
+ * them) and the peak resident set size, either as a table or as JSON
+ * that can be diffed between builds.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#ifndef __HDCP_BENCH_H__
+#define __HDCP_BENCH_H__
+
+#include <stdio.h>
+
+/* Run the benchmarks selected by the options in argv[0..argc-1] (see
+   HDCPBenchUsage) and print the results to stdout.  Returns 0, or 1
+   if the options could not be parsed. */
+int HDCPBenchmark(int argc, char **argv);
+
+/* Describe the options HDCPBenchmark accepts */
+void HDCPBenchUsage(FILE *f);
+
+#endif /* __HDCP_BENCH_H__ */
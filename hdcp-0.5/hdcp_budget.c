@@ -0,0 +1,209 @@
+/************************************************************
+ * Sizing batches to fit a memory budget.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hdcp_budget.h"
+
+typedef struct _BudgetSession
+{
+  int used;
+  int height, width;
+  double fps;
+  HDCPPlan plan;
+} BudgetSession;
+
+struct _HDCPBudget
+{
+  const HDCPEngine *e;
+  size_t max_bytes;
+  double latency;
+  pthread_mutex_t lock;
+  uint64_t generation;
+  int nsessions;             /* slots, used or not */
+  BudgetSession *sessions;
+};
+
+/* What a session needs whatever its plan: a cipher state and the
+   Ki, Ri and Mi of a batch */
+static size_t FixedBytes(const HDCPEngine *e)
+{
+  return e->state_size + 3 * sizeof(uint64_t) * e->lanes;
+}
+
+static int BatchFrames(const HDCPBudget *b, const BudgetSession *s)
+{
+  int n = b->e->lanes;
+
+  if (b->latency > 0 && b->latency * s->fps < n)
+    n = b->latency * s->fps < 1 ? 1 : (int)(b->latency * s->fps);
+  return n;
+}
+
+/* x * a / area, rounded down, for a <= area (which isn't 0), without
+   needing wider integers than 64 bits */
+static uint64_t Share(uint64_t x, uint64_t a, uint64_t area)
+{
+  uint64_t r = x % area;
+
+  if (r <= UINT64_MAX / a)
+    return x / area * a + r * a / area;
+  /* Only past 2^32 pixels in all, where rounding down a little further
+     doesn't matter */
+  return x / area * a + r / ((area + a - 1) / a);
+}
+
+/* Plan every session; the lock is held */
+static void Replan(HDCPBudget *b)
+{
+  size_t fixed = FixedBytes(b->e), spare = 0;
+  uint64_t area = 0;
+  int i;
+
+  for (i = 0; i < b->nsessions; i++)
+    if (b->sessions[i].used) {
+      area += (uint64_t)b->sessions[i].height * b->sessions[i].width;
+      spare += fixed;
+    }
+  spare = b->max_bytes > spare ? b->max_bytes - spare : 0;
+
+  b->generation++;
+  for (i = 0; i < b->nsessions; i++) {
+    BudgetSession *s = &b->sessions[i];
+    HDCPPlan *p = &s->plan;
+    size_t line_bytes, lines;
+
+    if (!s->used)
+      continue;
+    p->nframes = BatchFrames(b, s);
+    line_bytes = sizeof(uint32_t) * s->width * p->nframes;
+    /* Rounded down, so the shares never add up to more than spare */
+    if (b->max_bytes)
+      lines = Share(spare, (uint64_t)s->height * s->width, area) / line_bytes;
+    else
+      lines = s->height;
+
+    if (lines >= (size_t)s->height) {
+      p->output = HDCP_OUTPUT_FRAMES;
+      p->lines = s->height;
+    } else if (lines >= 1) {
+      p->output = HDCP_OUTPUT_LINES;
+      p->lines = lines;
+    } else {
+      p->output = HDCP_OUTPUT_XOR;
+      p->lines = 0;
+    }
+    p->bytes = fixed + line_bytes * p->lines;
+    p->generation = b->generation;
+  }
+}
+
+HDCPBudget *HDCPNewBudget(const HDCPEngine *e, size_t max_bytes, double latency)
+{
+  HDCPBudget *b = calloc(1, sizeof(*b));
+
+  if (!b)
+    return NULL;
+  b->e = e;
+  b->max_bytes = max_bytes;
+  b->latency = latency;
+  pthread_mutex_init(&b->lock, NULL);
+  return b;
+}
+
+void HDCPFreeBudget(HDCPBudget *b)
+{
+  pthread_mutex_destroy(&b->lock);
+  free(b->sessions);
+  free(b);
+}
+
+int HDCPBudgetAdd(HDCPBudget *b, int height, int width, double fps)
+{
+  int i, n = 0;
+
+  if (height < 1 || width < 1 || fps <= 0)
+    return -1;
+
+  pthread_mutex_lock(&b->lock);
+  for (i = 0; i < b->nsessions; i++)
+    n += b->sessions[i].used;
+  if (b->max_bytes && (size_t)(n + 1) * FixedBytes(b->e) > b->max_bytes) {
+    pthread_mutex_unlock(&b->lock);
+    return -1;
+  }
+
+  /* Reuse the slot of a removed session, if there is one */
+  for (i = 0; i < b->nsessions && b->sessions[i].used; i++)
+    ;
+  if (i == b->nsessions) {
+    BudgetSession *grown = realloc(b->sessions, (i + 1) * sizeof(*grown));
+
+    if (!grown) {
+      pthread_mutex_unlock(&b->lock);
+      return -1;
+    }
+    b->sessions = grown;
+    b->nsessions++;
+  }
+
+  memset(&b->sessions[i], 0, sizeof(b->sessions[i]));
+  b->sessions[i].used = 1;
+  b->sessions[i].height = height;
+  b->sessions[i].width = width;
+  b->sessions[i].fps = fps;
+  Replan(b);
+  pthread_mutex_unlock(&b->lock);
+  return i;
+}
+
+void HDCPBudgetRemove(HDCPBudget *b, int id)
+{
+  pthread_mutex_lock(&b->lock);
+  if (id >= 0 && id < b->nsessions && b->sessions[id].used) {
+    b->sessions[id].used = 0;
+    Replan(b);
+  }
+  pthread_mutex_unlock(&b->lock);
+}
+
+int HDCPBudgetPlan(HDCPBudget *b, int id, HDCPPlan *plan)
+{
+  int ret = -1;
+
+  pthread_mutex_lock(&b->lock);
+  if (id >= 0 && id < b->nsessions && b->sessions[id].used) {
+    *plan = b->sessions[id].plan;
+    ret = 0;
+  }
+  pthread_mutex_unlock(&b->lock);
+  return ret;
+}
+
+uint64_t HDCPBudgetGeneration(HDCPBudget *b)
+{
+  uint64_t g;
+
+  pthread_mutex_lock(&b->lock);
+  g = b->generation;
+  pthread_mutex_unlock(&b->lock);
+  return g;
+}
+
+size_t HDCPBudgetUsed(HDCPBudget *b)
+{
+  size_t used = 0;
+  int i;
+
+  pthread_mutex_lock(&b->lock);
+  for (i = 0; i < b->nsessions; i++)
+    if (b->sessions[i].used)
+      used += b->sessions[i].plan.bytes;
+  pthread_mutex_unlock(&b->lock);
+  return used;
+}
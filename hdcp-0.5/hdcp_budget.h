@@ -0,0 +1,83 @@
+/************************************************************
+ * Sizing batches to fit a memory budget.
+ *
+ * The more frames a batch holds the faster the bit-sliced engines go,
+ * but a batch of whole frames of output takes nframes * height * width
+ * * 4 bytes: 2 GB for 64 frames of 4K.  An HDCPBudget shares a fixed
+ * amount of memory between the sessions that are running and plans,
+ * for each one, how many frames to key at a time, and how much of
+ * their output to generate at once:
+ *
+ *  - HDCP_OUTPUT_FRAMES: whole frames, outputs[nframes][height][width]
+ *    from FrameStreamFrameMajor;
+ *  - HDCP_OUTPUT_LINES: lines lines at a time,
+ *    outputs[lines][width][nframes] from FrameStream;
+ *  - HDCP_OUTPUT_XOR: no output buffer at all, FrameStreamXor (or
+ *    FrameStreamFormat) straight into the video.
+ *
+ * A batch holds as many frames as the engine has lanes, unless that
+ * would make the first frame wait longer than the target latency for
+ * the last one to arrive.  What is left of the budget once every
+ * session has a cipher state is split between them in proportion to
+ * their frame size, and each one generates the most lines that fit in
+ * its share.  Adding or removing a session plans them all again, so
+ * a 4K input coming along shrinks the others' buffers rather than
+ * going over the budget.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#ifndef __HDCP_BUDGET_H__
+#define __HDCP_BUDGET_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hdcp_engine.h"
+
+typedef enum
+{
+  HDCP_OUTPUT_FRAMES,
+  HDCP_OUTPUT_LINES,
+  HDCP_OUTPUT_XOR,
+} HDCPOutput;
+
+typedef struct _HDCPPlan
+{
+  int nframes;              /* frames keyed at a time */
+  int lines;                /* lines of each frame generated at a time, 0 for HDCP_OUTPUT_XOR */
+  HDCPOutput output;
+  size_t bytes;             /* cipher state, keys and output buffer */
+  uint64_t generation;      /* HDCPBudgetGeneration() it was planned in */
+} HDCPPlan;
+
+typedef struct _HDCPBudget HDCPBudget;
+
+/* Share max_bytes (0 for no limit) between sessions run with engine e,
+   keeping batches to latency seconds of video (0 for no limit).
+   Returns NULL on failure. */
+HDCPBudget *HDCPNewBudget(const HDCPEngine *e, size_t max_bytes, double latency);
+
+void HDCPFreeBudget(HDCPBudget *b);
+
+/* Add a session of fps frames a second of height x width video and
+   plan every session again.  Returns its id, or -1 if the budget can't
+   hold one more cipher state. */
+int HDCPBudgetAdd(HDCPBudget *b, int height, int width, double fps);
+
+/* Remove session id and plan the rest again */
+void HDCPBudgetRemove(HDCPBudget *b, int id);
+
+/* Copy session id's current plan to *plan.  Returns 0, or -1 if there
+   is no such session. */
+int HDCPBudgetPlan(HDCPBudget *b, int id, HDCPPlan *plan);
+
+/* Goes up by one every time the sessions are planned again, so a
+   session can check at the end of each batch whether its plan is
+   still current.  Safe to call from any thread. */
+uint64_t HDCPBudgetGeneration(HDCPBudget *b);
+
+/* Bytes the current plans use, which is never more than max_bytes */
+size_t HDCPBudgetUsed(HDCPBudget *b);
+
+#endif /* __HDCP_BUDGET_H__ */
@@ -0,0 +1,287 @@
+/************************************************************
+ * An on-disk cache of stream cipher output.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "hdcp_cache.h"
+#include "hdcp_scalar.h"
+
+struct _HDCPCache
+{
+  uint8_t *map;
+  size_t size;
+  const HDCPCacheHeader *h;
+  const HDCPCacheEntry *index;
+};
+
+/***********************************************
+ * CRC-32, eight bytes at a time
+ ***********************************************/
+
+static uint32_t crc_table[8][256];
+static pthread_once_t crc_once = PTHREAD_ONCE_INIT;
+
+static void InitCrcTable(void)
+{
+  uint32_t c;
+  int i, k;
+
+  for (i = 0; i < 256; i++) {
+    c = i;
+    for (k = 0; k < 8; k++)
+      c = c & 1 ? 0xedb88320 ^ (c >> 1) : c >> 1;
+    crc_table[0][i] = c;
+  }
+  for (i = 0; i < 256; i++)
+    for (k = 1; k < 8; k++)
+      crc_table[k][i] = (crc_table[k-1][i] >> 8) ^ crc_table[0][crc_table[k-1][i] & 0xff];
+}
+
+uint32_t HDCPCrc32(uint32_t crc, const void *p, size_t n)
+{
+  const uint8_t *b = p;
+
+  pthread_once(&crc_once, InitCrcTable);
+  crc = ~crc;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  for (; n >= 8; n -= 8, b += 8) {
+    uint32_t lo, hi;
+
+    memcpy(&lo, b, 4);
+    memcpy(&hi, b + 4, 4);
+    lo ^= crc;
+    crc = crc_table[7][lo & 0xff] ^ crc_table[6][(lo >> 8) & 0xff] ^
+      crc_table[5][(lo >> 16) & 0xff] ^ crc_table[4][lo >> 24] ^
+      crc_table[3][hi & 0xff] ^ crc_table[2][(hi >> 8) & 0xff] ^
+      crc_table[1][(hi >> 16) & 0xff] ^ crc_table[0][hi >> 24];
+  }
+#endif
+  for (; n > 0; n--)
+    crc = crc_table[0][(crc ^ *b++) & 0xff] ^ (crc >> 8);
+  return ~crc;
+}
+
+/* The CRC of a header (ignoring its crc field) and the index after it */
+static uint32_t HeaderCrc(const HDCPCacheHeader *h, const HDCPCacheEntry *index)
+{
+  HDCPCacheHeader copy = *h;
+
+  copy.crc = 0;
+  return HDCPCrc32(HDCPCrc32(0, &copy, sizeof(copy)), index, h->nframes * sizeof(*index));
+}
+
+/***********************************************
+ * Writing
+ ***********************************************/
+
+int HDCPCreateCache(const char *path, const HDCPEngine *e, int batch, int64_t nframes,
+                    int height, int width, uint64_t Ks, uint64_t REPEATER, uint64_t Mi0)
+{
+  size_t page = sysconf(_SC_PAGESIZE);
+  HDCPCacheHeader h;
+  HDCPCacheEntry *index;
+  HDCPCipherState *hs = NULL;
+  uint8_t *map = MAP_FAILED;
+  uint64_t data, size;
+  int fd, err = 0;
+  int64_t f;
+
+  if (batch < 1 || batch > e->lanes || nframes < 1 || height < 1 || width < 1) {
+    errno = EINVAL;
+    return -1;
+  }
+
+  memset(&h, 0, sizeof(h));
+  h.version = HDCP_CACHE_VERSION;
+  h.Ks = Ks;
+  h.REPEATER = REPEATER;
+  h.Mi0 = Mi0;
+  h.nframes = nframes;
+  h.height = height;
+  h.width = width;
+  h.batch = batch;
+  h.pixel_bytes = sizeof(uint32_t);
+  h.index_offset = sizeof(h);
+  h.frame_bytes = (uint64_t)height * width * sizeof(uint32_t);
+  data = (h.index_offset + nframes * sizeof(*index) + page - 1) / page * page;
+  size = data + nframes * h.frame_bytes;
+
+  if ((fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644)) < 0)
+    return -1;
+  if (ftruncate(fd, size) < 0 ||
+      (map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED) {
+    err = errno;
+    goto out;
+  }
+  if (!(hs = HDCPNewCipherState(e))) {
+    err = ENOMEM;
+    goto out;
+  }
+
+  index = (HDCPCacheEntry *)(map + h.index_offset);
+  for (f = 0; f < nframes; f += batch) {
+    int n = nframes - f < batch ? nframes - f : batch, j;
+    uint64_t Ki[n], Ri[n], Mi[n];
+    uint32_t *frames[n];
+
+    /* A batch of one frame is keyed from Mi0 itself, so a last frame
+       left over from longer batches is keyed from the next link of the
+       chain instead, as it would have been in a whole batch */
+    if (n == 1 && batch > 1) {
+      HDCPScalarMiChain(1, Ks, REPEATER, Mi0, &Mi0);
+      e->InitializeMultiFrameState(1, Ks, REPEATER, Mi0, hs, Ki, Ri, Mi);
+      Mi[0] = Mi0;
+    } else
+      e->InitializeMultiFrameState(n, Ks, REPEATER, Mi0, hs, Ki, Ri, Mi);
+    for (j = 0; j < n; j++)
+      frames[j] = (uint32_t *)(map + data + (f + j) * h.frame_bytes);
+    e->FrameStreamScatter(n, height, width, hs, frames, width * sizeof(uint32_t));
+    for (j = 0; j < n; j++) {
+      index[f+j].Ki = Ki[j];
+      index[f+j].Ri = Ri[j];
+      index[f+j].Mi = Mi[j];
+      index[f+j].offset = data + (f + j) * h.frame_bytes;
+      index[f+j].crc = HDCPCrc32(0, frames[j], h.frame_bytes);
+    }
+    Mi0 = Mi[n-1];
+  }
+
+  /* The magic goes in last, so a file that was cut short won't open */
+  memcpy(h.magic, HDCP_CACHE_MAGIC, sizeof(h.magic));
+  h.crc = HeaderCrc(&h, index);
+  memcpy(map, &h, sizeof(h));
+  memset(map, 0, sizeof(h.magic));
+  if (msync(map, size, MS_SYNC) < 0) {
+    err = errno;
+    goto out;
+  }
+  memcpy(map, h.magic, sizeof(h.magic));
+  if (msync(map, page, MS_SYNC) < 0)
+    err = errno;
+
+ out:
+  if (map != MAP_FAILED)
+    munmap(map, size);
+  HDCPFreeCipherState(hs);
+  close(fd);
+  if (err) {
+    unlink(path);
+    errno = err;
+    return -1;
+  }
+  return 0;
+}
+
+/***********************************************
+ * Reading
+ ***********************************************/
+
+HDCPCache *HDCPOpenCache(const char *path)
+{
+  HDCPCache *c = calloc(1, sizeof(*c));
+  const HDCPCacheHeader *h;
+  struct stat st;
+  int fd;
+
+  if (!c)
+    return NULL;
+  if ((fd = open(path, O_RDONLY)) < 0) {
+    free(c);
+    return NULL;
+  }
+  if (fstat(fd, &st) < 0 || st.st_size < (off_t)sizeof(*h) ||
+      (c->map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0)) == MAP_FAILED) {
+    close(fd);
+    free(c);
+    return NULL;
+  }
+  close(fd);
+  c->size = st.st_size;
+  c->h = h = (const HDCPCacheHeader *)c->map;
+  c->index = (const HDCPCacheEntry *)(c->map + h->index_offset);
+
+  if (memcmp(h->magic, HDCP_CACHE_MAGIC, sizeof(h->magic)) ||
+      h->version != HDCP_CACHE_VERSION ||
+      h->pixel_bytes != sizeof(uint32_t) ||
+      h->height < 1 || h->width < 1 || h->batch < 1 || h->nframes < 1 ||
+      h->frame_bytes != (uint64_t)h->height * h->width * h->pixel_bytes ||
+      h->index_offset < sizeof(*h) || h->index_offset > c->size ||
+      (uint64_t)h->nframes > (c->size - h->index_offset) / sizeof(HDCPCacheEntry) ||
+      HeaderCrc(h, c->index) != h->crc) {
+    HDCPCloseCache(c);
+    return NULL;
+  }
+
+  madvise(c->map, c->size, MADV_SEQUENTIAL);
+  return c;
+}
+
+void HDCPCloseCache(HDCPCache *c)
+{
+  munmap(c->map, c->size);
+  free(c);
+}
+
+const HDCPCacheHeader *HDCPCacheInfo(HDCPCache *c)
+{
+  return c->h;
+}
+
+const uint32_t *HDCPCacheFrame(HDCPCache *c, int64_t i, HDCPCacheEntry *entry)
+{
+  const HDCPCacheEntry *x;
+
+  if (i < 0 || i >= c->h->nframes)
+    return NULL;
+  x = &c->index[i];
+  if (x->offset > c->size || c->size - x->offset < c->h->frame_bytes)
+    return NULL;
+  if (entry)
+    *entry = *x;
+  return (const uint32_t *)(c->map + x->offset);
+}
+
+int64_t HDCPCacheFind(HDCPCache *c, uint64_t Mi)
+{
+  int64_t i;
+
+  for (i = 0; i < c->h->nframes; i++)
+    if (c->index[i].Mi == Mi)
+      return i;
+  return -1;
+}
+
+int HDCPCacheVerifyFrame(HDCPCache *c, int64_t i)
+{
+  HDCPCacheEntry x;
+  const uint32_t *frame = HDCPCacheFrame(c, i, &x);
+
+  return frame && HDCPCrc32(0, frame, c->h->frame_bytes) == x.crc;
+}
+
+int HDCPCacheFrameStreamXor(HDCPCache *c, int64_t first, int nframes,
+                            uint32_t **frames, int pitch)
+{
+  int height = c->h->height, width = c->h->width;
+  const uint32_t *src;
+  int i, line, x;
+
+  for (i = 0; i < nframes && (src = HDCPCacheFrame(c, first + i, NULL)); i++)
+    for (line = 0; line < height; line++, src += width) {
+      uint32_t *dst = (uint32_t *)((char *)frames[i] + (size_t)line * pitch);
+
+      for (x = 0; x < width; x++)
+        dst[x] ^= src[x];
+    }
+  return i;
+}
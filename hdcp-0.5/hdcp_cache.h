@@ -0,0 +1,103 @@
+/************************************************************
+ * An on-disk cache of stream cipher output.
+ *
+ * The output for a frame depends only on Ks, REPEATER and where the
+ * frame sits in the Mi chain, so the output for a recorded session can
+ * be generated once, saved, and memory-mapped by every later run
+ * instead of being generated again.
+ *
+ * A cache file holds, in the byte order of the machine that wrote it:
+ *
+ *   HDCPCacheHeader   what was generated, and where the rest is
+ *   HDCPCacheEntry    one per frame: its Ki, Ri, Mi, offset and CRC
+ *   frames            each a height x width array of 32-bit outputs,
+ *                     as HDCPFrameStreamFrameMajor lays them out,
+ *                     starting on a page boundary
+ *
+ * The header's CRC covers the header and the index, and is checked
+ * when the file is opened.  Each frame has a CRC of its own, which is
+ * only checked on request, since that means reading the whole frame.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#ifndef __HDCP_CACHE_H__
+#define __HDCP_CACHE_H__
+
+#include <stdint.h>
+#include "hdcp_engine.h"
+
+#define HDCP_CACHE_MAGIC   "HDCPKEYS"
+#define HDCP_CACHE_VERSION 1
+
+typedef struct _HDCPCacheHeader
+{
+  char magic[8];            /* HDCP_CACHE_MAGIC, written last */
+  uint32_t version;         /* HDCP_CACHE_VERSION */
+  uint32_t crc;             /* CRC-32 of the header (with crc = 0) and index */
+  uint64_t Ks, REPEATER, Mi0;
+  int64_t nframes;
+  int32_t height, width;
+  int32_t batch;            /* frames keyed at a time (see below) */
+  uint32_t pixel_bytes;     /* 4 */
+  uint64_t index_offset;    /* of the first HDCPCacheEntry */
+  uint64_t frame_bytes;     /* height * width * pixel_bytes */
+} HDCPCacheHeader;
+
+typedef struct _HDCPCacheEntry
+{
+  uint64_t Ki, Ri, Mi;      /* as HDCPInitializeMultiFrameState returns them */
+  uint64_t offset;          /* of the frame's output, from the start of the file */
+  uint32_t crc;             /* CRC-32 of the frame's output */
+  uint32_t reserved;        /* 0 */
+} HDCPCacheEntry;
+
+typedef struct _HDCPCache HDCPCache;
+
+/* Generate the output for nframes height x width frames with engine e
+   and save it to a new cache file at path.  The frames are keyed batch
+   (<= e->lanes) at a time, the first batch from Mi0 and each batch
+   from the Mi of the last frame of the one before, as HDCPStream does
+   with batches of that size.  Since a batch of one frame is keyed
+   differently from a longer one, a cache only stands in for runs that
+   use the same batch size.  A last frame left over on its own is keyed
+   as it would be in a whole batch, so it differs from what HDCPPool
+   gives for a last batch of one frame, which is keyed from Mi0 as by
+   HDCPInitializeMultiFrameState.  The output is generated straight
+   into the mapped file.  Returns 0, or -1 with errno set on failure. */
+int HDCPCreateCache(const char *path, const HDCPEngine *e, int batch, int64_t nframes,
+                    int height, int width, uint64_t Ks, uint64_t REPEATER, uint64_t Mi0);
+
+/* Map the cache file at path.  Returns NULL if it can't be read, isn't
+   a cache file of this version, or fails its header CRC. */
+HDCPCache *HDCPOpenCache(const char *path);
+
+void HDCPCloseCache(HDCPCache *c);
+
+/* The header, as checked by HDCPOpenCache */
+const HDCPCacheHeader *HDCPCacheInfo(HDCPCache *c);
+
+/* Frame i's output, height x width 32-bit words that stay mapped until
+   the cache is closed, and its entry in the index (if entry isn't
+   NULL).  Returns NULL if there is no frame i. */
+const uint32_t *HDCPCacheFrame(HDCPCache *c, int64_t i, HDCPCacheEntry *entry);
+
+/* The first frame whose Mi is Mi, or -1 if there is none */
+int64_t HDCPCacheFind(HDCPCache *c, uint64_t Mi);
+
+/* 1 if frame i's output matches its CRC, 0 if not */
+int HDCPCacheVerifyFrame(HDCPCache *c, int64_t i);
+
+/* The cached stand-in for HDCPFrameStreamXor: xor the output of frames
+   first, first+1, ... into frames[0..nframes-1], whose lines are pitch
+   bytes apart.  Returns the number of frames done, which is less than
+   nframes if the cache runs out. */
+int HDCPCacheFrameStreamXor(HDCPCache *c, int64_t first, int nframes,
+                            uint32_t **frames, int pitch);
+
+/* The CRC-32 (as in zlib) of n bytes at p, continuing from crc (0 to
+   start) */
+uint32_t HDCPCrc32(uint32_t crc, const void *p, size_t n);
+
+#endif /* __HDCP_CACHE_H__ */
@@ -0,0 +1,128 @@
+/************************************************************
+ * Walking Mi chains without generating any stream cipher output.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "hdcp_chain.h"
+
+/* A link keyed nframes > 1 frames at a time keys frame i with the
+   block cipher run on the Mi output of the run for frame i-1 (or, for
+   frame 0, of the run on Mi0), and reports that input as the frame's
+   Mi.  One keyed a frame at a time runs it on Mi0 itself, and reports
+   the output.  Either way each frame's input is the previous frame's
+   output, so a link only needs the input of its next frame. */
+struct _HDCPChains
+{
+  const HDCPEngine *e;
+  HDCPCipherState *hs;
+  int nsessions;
+  int64_t frame;             /* frames walked so far */
+  uint64_t *Ks, *REPEATER;
+  uint64_t *Bin;             /* block cipher input of the next frame */
+  uint8_t *single;           /* keyed a frame at a time */
+};
+
+HDCPChains *HDCPNewChains(const HDCPEngine *e, int nsessions, const HDCPSessionFrames *sessions)
+{
+  HDCPChains *c;
+  int s, g, k;
+
+  if (nsessions < 1)
+    return NULL;
+  for (s = 0; s < nsessions; s++)
+    if (sessions[s].nframes < 1)
+      return NULL;
+  if (!(c = calloc(1, sizeof(*c))))
+    return NULL;
+
+  c->e = e;
+  c->nsessions = nsessions;
+  c->hs = HDCPNewCipherState(e);
+  c->Ks = malloc(nsessions * sizeof(uint64_t));
+  c->REPEATER = malloc(nsessions * sizeof(uint64_t));
+  c->Bin = malloc(nsessions * sizeof(uint64_t));
+  c->single = malloc(nsessions);
+  if (!c->hs || !c->Ks || !c->REPEATER || !c->Bin || !c->single) {
+    HDCPFreeChains(c);
+    return NULL;
+  }
+
+  for (s = 0; s < nsessions; s++) {
+    c->Ks[s] = sessions[s].Ks;
+    c->REPEATER[s] = sessions[s].REPEATER;
+    c->Bin[s] = sessions[s].Mi0;
+    c->single[s] = sessions[s].nframes == 1;
+  }
+
+  /* Links keyed several frames at a time start one run further on */
+  for (g = 0; g < nsessions; g += k) {
+    uint64_t Ki[e->lanes], Ri[e->lanes], Mi[e->lanes];
+
+    k = nsessions - g < e->lanes ? nsessions - g : e->lanes;
+    e->BlockCipher(k, &c->Ks[g], &c->REPEATER[g], &c->Bin[g], c->hs, Ki, Ri, Mi);
+    for (s = 0; s < k; s++)
+      if (!c->single[g+s])
+        c->Bin[g+s] = Mi[s];
+  }
+
+  return c;
+}
+
+void HDCPFreeChains(HDCPChains *c)
+{
+  HDCPFreeCipherState(c->hs);
+  free(c->Ks);
+  free(c->REPEATER);
+  free(c->Bin);
+  free(c->single);
+  free(c);
+}
+
+int64_t HDCPWalkChains(HDCPChains *c, int64_t nframes, int interval,
+                       uint64_t *Ki, uint64_t *Ri, uint64_t *Mi)
+{
+  const HDCPEngine *e = c->e;
+  int n = c->nsessions, g, k, s;
+  int64_t f, out, nout = 0;
+
+  if (interval < 1)
+    interval = 1;
+
+  /* A group of links at a time, all the way, so that its inputs stay
+     in cache */
+  for (g = 0; g < n; g += k) {
+    uint64_t Ki_[e->lanes], Ri_[e->lanes], Mi_[e->lanes];
+
+    k = n - g < e->lanes ? n - g : e->lanes;
+    for (f = c->frame, out = 0; f < c->frame + nframes; f++) {
+      e->BlockCipher(k, &c->Ks[g], &c->REPEATER[g], &c->Bin[g], c->hs, Ki_, Ri_, Mi_);
+      if (f % interval == 0) {
+        for (s = 0; s < k; s++) {
+          size_t i = (size_t)out * n + g + s;
+
+          if (Ki)
+            Ki[i] = Ki_[s];
+          if (Ri)
+            Ri[i] = Ri_[s];
+          if (Mi)
+            Mi[i] = c->single[g+s] ? Mi_[s] : c->Bin[g+s];
+        }
+        out++;
+      }
+      memcpy(&c->Bin[g], Mi_, k * sizeof(*Mi_));
+    }
+    nout = out;
+  }
+
+  c->frame += nframes > 0 ? nframes : 0;
+  return nout;
+}
+
+int64_t HDCPChainsPosition(HDCPChains *c)
+{
+  return c->frame;
+}
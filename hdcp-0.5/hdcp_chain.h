@@ -0,0 +1,50 @@
+/************************************************************
+ * Walking Mi chains without generating any stream cipher output.
+ *
+ * Every frame of an HDCP link is keyed by a run of the block cipher
+ * whose input comes from the run before, so a frame's Ki, Ri and Mi
+ * can't be had without walking the chain up to it.  They don't need
+ * the frame's stream cipher output, though, which is by far the larger
+ * cost, so checking Ri over hours of video can walk the chain alone.
+ *
+ * One link's chain is serial, but the chains of different links are
+ * independent, so an HDCPChains walks one link per lane of the engine:
+ * each run of the block cipher takes every link one frame further.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#ifndef __HDCP_CHAIN_H__
+#define __HDCP_CHAIN_H__
+
+#include <stdint.h>
+#include "hdcp_cipher.h"
+#include "hdcp_engine.h"
+
+typedef struct _HDCPChains HDCPChains;
+
+/* Start walking the chains of nsessions links with engine e, each from
+   the Mi0 of its sessions[s], and keyed sessions[s].nframes frames at
+   a time, i.e. the batch size its video is generated in.  Frames get
+   the same Ki, Ri and Mi as batches of that size from
+   HDCPInitializeMultiFrameState (a batch of one frame is keyed
+   differently from a longer one).  There may be more links than
+   lanes; they are walked e->lanes at a time.  Returns NULL on
+   failure. */
+HDCPChains *HDCPNewChains(const HDCPEngine *e, int nsessions, const HDCPSessionFrames *sessions);
+
+void HDCPFreeChains(HDCPChains *c);
+
+/* Take every link nframes frames further, and return the Ki, Ri and Mi
+   of each frame whose number (counting from 0 at the first frame of
+   the link) is a multiple of interval: Ri[k*nsessions + s] is that of
+   the k'th such frame of link s.  Any of Ki, Ri and Mi may be NULL.
+   Returns the number of frames returned for each link. */
+int64_t HDCPWalkChains(HDCPChains *c, int64_t nframes, int interval,
+                       uint64_t *Ki, uint64_t *Ri, uint64_t *Mi);
+
+/* Frames walked so far, which is also the number of the next frame */
+int64_t HDCPChainsPosition(HDCPChains *c);
+
+#endif /* __HDCP_CHAIN_H__ */
@@ -10,6 +10,10 @@
 #include <stdio.h>
 #include <string.h>
 #include "hdcp_cipher.h"
+#include "hdcp_mem.h"
+#include "hdcp_scalar.h"
+#include "hdcp_engine.h"
+#include "hdcp_profile.h"
 #include "bitslice.h"
 
 #define BS_LFSRBit(r,i) ((r)->state[((r)->zero + i) % (r)->len])
@@ -21,7 +25,7 @@ void BS_LFSR(BS_LFSReg * r)
   bsvec_t newbit;
   int i;
   
-  newbit = 0;
+  newbit = BS_ZERO;
   for (i = 0; i < 6 && r->feedbacks[i] >= 0; i++)
     newbit ^= BS_LFSRBit(r, r->feedbacks[i]);
 
@@ -44,17 +48,17 @@ bsvec_t BS_ShuffleNetwork(bsvec_t *A, bsvec_t *B,
 
 void BS_LFSRModule_print(BS_LFSRModule *m, int which)
 {
-  bsvec_t reg;
+  uint64_t reg;
   int i, j;
 
   for (i = 0; i < 4; i++) {
     reg = 0;
     for (j = 0; j < m->lfsrs[i].len; j++)
-      reg |= ((BS_LFSRBit(&m->lfsrs[i], j) & (UINT64_C(1) << which)) ? UINT64_C(1) : UINT64_C(0)) << j;
+      reg |= BS_LANE(BS_LFSRBit(&m->lfsrs[i], j), which) << j;
     printf("%0*" PRIx64 " ", (m->lfsrs[i].len + 3) / 4, reg);
   }
   for (i = 0; i < 4; i++)
-    printf("%1" PRIx64 "%1" PRIx64 " ", (m->snA[i] >> which) & UINT64_C(1), (m->snB[i] >> which) & UINT64_C(1));
+    printf("%1" PRIx64 "%1" PRIx64 " ", BS_LANE(m->snA[i], which), BS_LANE(m->snB[i], which));
 }
 
 void BS_LFSRModule_init(BS_LFSRModule *m, bsvec_t input[56])
@@ -68,25 +72,25 @@ void BS_LFSRModule_init(BS_LFSRModule *m, bsvec_t input[56])
 			      { 4, 8, 10, 12, -1 },    /* feedbacks */
 			      0,                       /* zero */
 			      13,                      /* len */
-			      { 0 }                    /* state */ 
+			      { BS_ZERO }              /* state */ 
   };
   m->lfsrs[1] = (BS_LFSReg) { { 4, 8, 13},             /* taps */
 			      { 3, 5, 6, 9, 10, 13},   /* feedbacks */
 			      0,                       /* zero */
 			      14,                      /* len */
-			      { 0 }                    /* state */ 
+			      { BS_ZERO }              /* state */ 
   };
   m->lfsrs[2] = (BS_LFSReg) { { 5, 9, 15},             /* taps */
 			      { 4, 6, 7, 11, 14, 15},  /* feedbacks */
 			      0,                       /* zero */
 			      16,                      /* len */
-			      { 0 }                    /* state */ 
+			      { BS_ZERO }              /* state */ 
   };
   m->lfsrs[3] = (BS_LFSReg) { { 5, 11, 16},            /* taps */
 			      { 4, 10, 14, 16, -1},    /* feedbacks */
 			      0,                       /* zero */
 			      17,                      /* len */
-			      { 0 }                    /* state */ 
+			      { BS_ZERO }              /* state */ 
   };
 
   for (i = 0; i < 12; i++)
@@ -111,7 +115,7 @@ bsvec_t BS_LFSRModule_clock(BS_LFSRModule * m)
   bsvec_t D;
   int i;
 
-  D = 0;
+  D = BS_ZERO;
   for (i = 0; i < 4; i++)
     D ^= BS_LFSRMTap(m, i, 0);
 
@@ -424,7 +428,7 @@ bsvec_t I[7][8], O[7][8];
 
 #define BI(i,j) (Bzmap[i][j] ? Bz[BImap[i][j]] : By[BImap[i][j]])
 #define BO(i,j) (*(j == 0 || j > 4 ? &Bx[BOmap[i][j]] : &By[BOmap[i][j]]))
-#define BK(i,j) (j == 0 ? Ky[i] : j < 5 ? 0 : Ky[7*(j-4) + i])
+#define BK(i,j) (j == 0 ? Ky[i] : j < 5 ? BS_ZERO : Ky[7*(j-4) + i])
 void    BS_DiffuseNetworkB_ (bsvec_t Bz[28], bsvec_t By[28], bsvec_t Bx[28], bsvec_t Ky[28])
 {
   static const char Bzmap[7][8] = { { 1, 1, 1, 1, 1, 0, 0, 0},
@@ -816,7 +820,9 @@ void    BS_DiffuseNetworkB (bsvec_t Bz[28], bsvec_t By[28], bsvec_t Bx[28], bsve
 #define LOADINPUTS(i) D = input[i]; C = input[i + 7]; \
                       B = input[i + 14]; A = input[i + 21];
 
-void BS_SBoxB(bsvec_t input[28], bsvec_t output[28])
+/* Easy-to-read versions of the S-boxes.  BS_SBoxB and BS_SBoxK below
+   use the smaller circuits generated by sbox-gen.c. */
+void BS_SBoxB_(bsvec_t input[28], bsvec_t output[28])
 {
   bsvec_t A, B, C, D;
 
@@ -863,7 +869,7 @@ void BS_SBoxB(bsvec_t input[28], bsvec_t output[28])
   output[27] = (C&((A&D)|(~A&B)))|(A&~D&(~B|~C))|(~A&~B&~C&D);
 }
 
-void BS_SBoxK(bsvec_t input[28], bsvec_t output[28])
+void BS_SBoxK_(bsvec_t input[28], bsvec_t output[28])
 {
   bsvec_t A, B, C, D;
 
@@ -910,6 +916,49 @@ void BS_SBoxK(bsvec_t input[28], bsvec_t output[28])
   output[27] = (B&D&(C|~A)) |(A&~B&(~D|~C)) | (~C&~D&(A|~B));
 }
 
+#include "sbox-autogen.h"
+
+void BS_SBoxB(bsvec_t input[28], bsvec_t output[28])
+{
+#ifdef BS_SBOX_TERNLOG
+  BS_SBoxB_ternlog(input, output);
+#else
+  BS_SBoxB_gates(input, output);
+#endif
+}
+
+void BS_SBoxK(bsvec_t input[28], bsvec_t output[28])
+{
+#ifdef BS_SBOX_TERNLOG
+  BS_SBoxK_ternlog(input, output);
+#else
+  BS_SBoxK_gates(input, output);
+#endif
+}
+
+/* Check BS_SBoxB and BS_SBoxK against BS_SBoxB_ and BS_SBoxK_ on all
+   16 inputs of every S-box: lane j of every word gets input j % 16. */
+int BS_CheckSBoxes(void)
+{
+  bsvec_t input[28], out[28], ref[28];
+  int i, j, w;
+
+  for (i = 0; i < 28; i++)
+    for (w = 0; w < BSWORDS; w++) {
+      BS_WORD(input[i], w) = 0;
+      for (j = 0; j < 64; j++)
+        BS_WORD(input[i], w) |= (uint64_t)(((j % 16) >> (i / 7)) & 1) << j;
+    }
+
+  BS_SBoxB(input, out);
+  BS_SBoxB_(input, ref);
+  if (memcmp(out, ref, sizeof(out)))
+    return 0;
+  BS_SBoxK(input, out);
+  BS_SBoxK_(input, ref);
+  return memcmp(out, ref, sizeof(out)) == 0;
+}
+
 void BS_RoundFunctionK(bsvec_t Kz[28], bsvec_t Ky[28], bsvec_t Kx[28])
 {
   bsvec_t newKz[28];
@@ -973,7 +1022,7 @@ void BS_OutputFunction_(bsvec_t Bz[28], bsvec_t By[28],
   int i, j;
 
   for (i = 0; i < 24; i++) {
-    result[i] = 0;
+    result[i] = BS_ZERO;
     for (j = 0; j < 7; j++) {
       result[i] ^= Bz[BS_OutputTable[i][j]] & Kz[BS_OutputTable[i][j+8]];
     }
@@ -1073,13 +1122,18 @@ void BS_HDCPRound(BS_HDCPCipherState *hs, bsvec_t output[24])
   bsvec_t t;
 
   if (output)
-    BS_OutputFunction(hs->bm.B[2], hs->bm.B[1], hs->bm.K[2], hs->bm.K[1], output);
-  BS_BlockModule(&hs->bm);
-  t = BS_LFSRModule_clock(&hs->lm);
+    HDCP_TIMED(HDCP_STAGE_OUTPUT,
+                 BS_OutputFunction(hs->bm.B[2], hs->bm.B[1], hs->bm.K[2], hs->bm.K[1], output));
+  HDCP_TIMED(HDCP_STAGE_BLOCK_MODULE, BS_BlockModule(&hs->bm));
+  HDCP_TIMED(HDCP_STAGE_LFSR, t = BS_LFSRModule_clock(&hs->lm));
   if (hs->rekey)
     hs->bm.K[1][13] = t;
 }
 
+/* Unrolled multi-round kernels, generated by round-gen.c:
+   BS_HDCPRounds8/16/64 and BS_HDCPRekeyRounds52/56 */
+#include "round-autogen.h"
+
 void BS_HDCP_print(int which, BS_LFSRModule *lm,
 		   bsvec_t Kz[28], bsvec_t Ky[28], bsvec_t Kx[28],
 		   bsvec_t Bz[28], bsvec_t By[28], bsvec_t Bx[28],
@@ -1119,7 +1173,7 @@ void BS_HDCPBlockCipher(bsvec_t K_[56], bsvec_t REPEATER_Bin[65],
 
   /*  48 warm-up rounds */
   for (i = 0; i < 48; i++)
-    BS_BlockModule(&hs->bm);
+    HDCP_TIMED(HDCP_STAGE_BLOCK_MODULE, BS_BlockModule(&hs->bm));
 
   /* Save the output to Ki */
   memcpy(Ki, hs->bm.B, 56 * sizeof(bsvec_t));
@@ -1132,8 +1186,7 @@ void BS_HDCPBlockCipher(bsvec_t K_[56], bsvec_t REPEATER_Bin[65],
   hs->rekey = 1;
 
   /*  54 additional rounds */
-  for (i = 0; i < 52; i++)
-    BS_HDCPRound(hs, NULL);
+  HDCP_TIMED(HDCP_STAGE_ROUNDS, BS_HDCPRekeyRounds52(hs));
 
   /* Four more rounds, with output to Mi and Ri.  Note that we only
      need to compute the output function for the last round. */
@@ -1155,28 +1208,49 @@ void BS_HDCPBlockCipher(bsvec_t K_[56], bsvec_t REPEATER_Bin[65],
   hs->rekey = 0;
 }
 
+/* Run the block cipher on Bin, with K_ and REPEATER already sliced into
+   ws->K and ws->REPEATER_Bin[64] */
+static void SlicedBlockCipher(BS_HDCPBlockWorkspace *ws, int ncopies, const uint64_t *Bin,
+                              BS_HDCPCipherState *hs, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi)
+{
+  HDCP_TIMED(HDCP_STAGE_TRANSPOSE, BitSlice(ncopies, Bin, 64, ws->REPEATER_Bin));
+  BS_HDCPBlockCipher(ws->K, ws->REPEATER_Bin, hs, ws->Ki, ws->Ri, ws->Mi);
+  HDCP_TIMED(HDCP_STAGE_TRANSPOSE,
+               BitUnslice(56, ws->Ki, ncopies, Ki);
+               BitUnslice(16, ws->Ri, ncopies, Ri);
+               BitUnslice(64, ws->Mi, ncopies, Mi));
+}
+
+/* Slice the same nbits-bit value into every lane */
+static void Broadcast(uint64_t x, int nbits, bsvec_t *dst)
+{
+  int i;
+
+  for (i = 0; i < nbits; i++)
+    dst[i] = BS_ZERO - ((x >> i) & 1);
+}
+
+static void BlockCipher(BS_HDCPBlockWorkspace *ws, int ncopies, uint64_t *K_, uint64_t *REPEATER,
+                        uint64_t *Bin, BS_HDCPCipherState *hs, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi)
+{
+  HDCP_TIMED(HDCP_STAGE_TRANSPOSE,
+               BitSlice(ncopies, K_, 56, ws->K);
+               BitSlice(ncopies, REPEATER, 1, ws->REPEATER_Bin + 64));
+  SlicedBlockCipher(ws, ncopies, Bin, hs, Ki, Ri, Mi);
+}
+
 /* Execute n copies of the HDCP block cipher, with initialization key
    K_, and nonce Bin.  The cipherstate hs will be initialized, and the
    outputs Ki, Ri, and Mi returned.
    - during authentication, pass Km = K_ , and the output Ki = Ks.
    - during vertical blanks, pass Ks = K_.
  */
-void HDCPBlockCipher(int ncopies, bsvec_t *K_, bsvec_t *REPEATER, bsvec_t *Bin, 
-                     BS_HDCPCipherState *hs, bsvec_t *Ki, bsvec_t *Ri, bsvec_t *Mi)
+void HDCPBlockCipher(int ncopies, uint64_t *K_, uint64_t *REPEATER, uint64_t *Bin, 
+                     BS_HDCPCipherState *hs, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi)
 {
-  bsvec_t BSK_[56];
-  bsvec_t BSREPEATER_Bin[65];
-  bsvec_t BSKi[56];
-  bsvec_t BSRi[16];
-  bsvec_t BSMi[64];
+  BS_HDCPBlockWorkspace ws;
 
-  BitSlice(ncopies, K_, 56, BSK_);
-  BitSlice(ncopies, Bin, 64, BSREPEATER_Bin);
-  BitSlice(ncopies, REPEATER, 1, BSREPEATER_Bin + 64);
-  BS_HDCPBlockCipher(BSK_, BSREPEATER_Bin, hs, BSKi, BSRi, BSMi);
-  BitSlice(56, BSKi, ncopies, Ki);
-  BitSlice(16, BSRi, ncopies, Ri);
-  BitSlice(64, BSMi, ncopies, Mi);
+  BlockCipher(&ws, ncopies, K_, REPEATER, Bin, hs, Ki, Ri, Mi);
 }
 
 void BS_HDCPStreamCipher(BS_HDCPCipherState *hs, int noutputs, bsvec_t outputs[noutputs][24])
@@ -1184,69 +1258,470 @@ void BS_HDCPStreamCipher(BS_HDCPCipherState *hs, int noutputs, bsvec_t outputs[n
   int i;
 
   hs->rekey = 0;
-  for (i = 0; i < noutputs; i++)
+  HDCP_TIMED(HDCP_STAGE_ROUNDS,
+               for (i = 0; noutputs - i >= 64; i += 64)
+                 BS_HDCPRounds64(hs, &outputs[i]);
+               for (; noutputs - i >= 16; i += 16)
+                 BS_HDCPRounds16(hs, &outputs[i]);
+               for (; noutputs - i >= 8; i += 8)
+                 BS_HDCPRounds8(hs, &outputs[i]));
+  for (; i < noutputs; i++)
     BS_HDCPRound(hs, outputs[i]);
 }
 
-void HDCPStreamCipher(int ncopies, BS_HDCPCipherState *hs, int noutputs, uint32_t outputs[noutputs][ncopies])
+/* Transpose n pixels of output, with non-temporal stores if nt (which
+   StreamOutputs must have allowed) */
+static inline void TransposeOutputs(int ncopies, int n, bsvec_t slices[n][24],
+                                    uint32_t outputs[n][ncopies], int nt)
 {
-  bsvec_t bs_outputs[noutputs][24];
   int i;
 
-  BS_HDCPStreamCipher(hs, noutputs, bs_outputs);
-  for (i = 0; i < noutputs; i++) {
-    BitSlice24(24, bs_outputs[i], ncopies, outputs[i]);
+#ifdef BITSLICE_NT
+  if (nt) {
+    for (i = 0; i < n; i++)
+      BitSlice24_nt(24, slices[i], ncopies, outputs[i]);
+    return;
   }
+#endif
+  for (i = 0; i < n; i++)
+    BitSlice24(24, slices[i], ncopies, outputs[i]);
 }
 
-void HDCPRekeycipher(BS_HDCPCipherState *hs)
+/* Whether bytes of output at outputs should be written with
+   non-temporal stores: there is more of it than HDCPStreamingBytes(),
+   and every pixel's ncopies outputs are whole, aligned cache lines. */
+static int StreamOutputs(int ncopies, size_t bytes, const void *outputs)
 {
+#ifdef BITSLICE_NT
+  return ncopies % 16 == 0 && ((uintptr_t)outputs & 63) == 0 && bytes > HDCPStreamingBytes();
+#else
+  return 0;
+#endif
+}
+
+/* The outputs are generated and transposed HDCP_ROUNDS_CHUNK pixels at
+   a time, so that however long the line, the bit-sliced output only
+   needs slices.  With nt, the caller fences. */
+static void StreamCipher(bsvec_t slices[HDCP_ROUNDS_CHUNK][24], int ncopies, BS_HDCPCipherState *hs,
+                         int noutputs, uint32_t outputs[noutputs][ncopies], int nt)
+{
+  int n, x;
+
+  for (x = 0; x < noutputs; x += n) {
+    n = noutputs - x < HDCP_ROUNDS_CHUNK ? noutputs - x : HDCP_ROUNDS_CHUNK;
+    BS_HDCPStreamCipher(hs, n, slices);
+    HDCP_TIMED(HDCP_STAGE_TRANSPOSE, TransposeOutputs(ncopies, n, slices, outputs + x, nt));
+  }
+}
+
+void HDCPStreamCipher(int ncopies, BS_HDCPCipherState *hs, int noutputs, uint32_t outputs[noutputs][ncopies])
+{
+  bsvec_t slices[HDCP_ROUNDS_CHUNK][24];
+
+  StreamCipher(slices, ncopies, hs, noutputs, outputs, 0);
+}
+
+/* Xor (or store) the outputs for copy i into pixels 0..noutputs-1 of
+   the line at lines[i], laid out as l says.  The outputs are generated
+   HDCP_XOR_CHUNK pixels at a time, so the only temporary storage is
+   ws->slices and ws->outputs. */
+static void HDCPStreamCipherLines(BS_HDCPStreamWorkspace *ws, int ncopies, BS_HDCPCipherState *hs,
+                                  int noutputs, uint8_t *lines[ncopies], const HDCPLayout *l, int xor)
+{
+  uint32_t (*outputs)[ncopies] = (uint32_t (*)[ncopies])ws->outputs;
+  int bytes = HDCPPixelBytes(l->format);
+  int i, j, n, x;
+
+  for (x = 0; x < noutputs; x += n) {
+    n = noutputs - x < HDCP_XOR_CHUNK ? noutputs - x : HDCP_XOR_CHUNK;
+    BS_HDCPStreamCipher(hs, n, ws->slices);
+    HDCP_TIMED(HDCP_STAGE_TRANSPOSE,
+                 for (i = 0; i < n; i++)
+                   BitSlice24(24, ws->slices[i], ncopies, outputs[i]));
+    HDCP_TIMED(HDCP_STAGE_XOR,
+                 for (j = 0; j < ncopies; j++) {
+                   uint32_t *line = (uint32_t *)lines[j] + x;
+                   /* With ncopies lines on the go the hardware prefetcher
+                      loses track, so ask for a later chunk ourselves */
+                   __builtin_prefetch(lines[j] + (x + 2*n) * bytes, 1);
+                   if (l->format != HDCP_PIXEL_XRGB32)
+                     HDCPWritePixels(l, lines[j], x, n, &outputs[0][j], ncopies, xor);
+                   else if (xor)
+                     for (i = 0; i < n; i++)
+                       line[i] ^= outputs[i][j];
+                   else
+                     for (i = 0; i < n; i++)
+                       line[i] = outputs[i][j];
+                 });
+  }
+}
+
+static void StreamCipherXor(BS_HDCPStreamWorkspace *ws, int ncopies, BS_HDCPCipherState *hs,
+                            int noutputs, uint32_t *lines[ncopies])
+{
+  HDCPLayout l = { HDCP_PIXEL_XRGB32, 0, 0 };
   int i;
-  hs->rekey = 1;
-  for (i = 0; i < 56; i++)
-    BS_HDCPRound(hs, NULL);
+
+  for (i = 0; i < ncopies; i++)
+    ws->lines[i] = (uint8_t *)lines[i];
+  HDCPStreamCipherLines(ws, ncopies, hs, noutputs, ws->lines, &l, 1);
+}
+
+/* Like HDCPStreamCipher, but xor the outputs for copy i into
+   lines[i][0..noutputs-1] instead of returning them. */
+void HDCPStreamCipherXor(int ncopies, BS_HDCPCipherState *hs, int noutputs, uint32_t *lines[ncopies])
+{
+  BS_HDCPStreamWorkspace ws;
+
+  StreamCipherXor(&ws, ncopies, hs, noutputs, lines);
+}
+
+void HDCPRekeycipher(BS_HDCPCipherState *hs)
+{
+  HDCP_TIMED(HDCP_STAGE_REKEY, BS_HDCPRekeyRounds56(hs));
   hs->rekey = 0;
 }
 
-void HDCPAuthentication(bsvec_t Km, bsvec_t REPEATER, bsvec_t An, bsvec_t *Ks, bsvec_t *R0, bsvec_t *M0)
+void HDCPAuthentication(uint64_t Km, uint64_t REPEATER, uint64_t An, uint64_t *Ks, uint64_t *R0, uint64_t *M0)
 {
   BS_HDCPCipherState hs;
   HDCPBlockCipher(1, &Km, &REPEATER, &An, &hs, Ks, R0, M0);
 }
 
+/* The keys are summed a vector of them at a time, each key masked by
+   its bit of the KSV, so that every lane width gets masked vector adds
+   (one lane, i.e. plain 64-bit adds, in the 64-lane build) */
+typedef uint64_t km_vec_t __attribute__((vector_size(BSVEC_BITS / 8)));
+#define KM_LANES ((int)(sizeof(km_vec_t) / sizeof(uint64_t)))
+
+void HDCPDeriveKm(int n, const uint64_t *ksv, const uint64_t *const *keys, uint64_t *Km)
+{
+  km_vec_t lane, key, sum;
+  uint64_t total;
+  int i, j;
+
+  for (j = 0; j < KM_LANES; j++)
+    lane[j] = j;
+
+  for (i = 0; i < n; i++) {
+    sum = lane ^ lane;
+    for (j = 0; j < HDCP_NKEYS; j += KM_LANES) {
+      memcpy(&key, &keys[i][j], sizeof(key));
+      sum += key & -((ksv[i] >> (lane + j)) & 1);
+    }
+    total = 0;
+    for (j = 0; j < KM_LANES; j++)
+      total += sum[j];
+    Km[i] = total & ((UINT64_C(1) << 56) - 1);
+  }
+}
+
+static void InitializeMultiFrameState(BS_HDCPKeyWorkspace *ws, int nframes, uint64_t Ks,
+                                      uint64_t REPEATER, uint64_t Mi0, BS_HDCPCipherState *hs,
+                                      uint64_t *Ki, uint64_t *Ri, uint64_t *Mi)
+{
+  /* Every frame has the same Ks and REPEATER, so rather than transpose
+     nframes copies of them, spread each of their bits over all the
+     lanes */
+  HDCP_TIMED(HDCP_STAGE_TRANSPOSE,
+               Broadcast(Ks, 56, ws->block.K);
+               Broadcast(REPEATER, 1, ws->block.REPEATER_Bin + 64));
+
+  if (nframes == 1) {
+    SlicedBlockCipher(&ws->block, 1, &Mi0, hs, Ki, Ri, Mi);
+    return;
+  }
+
+  /* The Mi chain is inherently serial, so walk it one copy at a time
+     with the scalar cipher, ... */
+  HDCP_TIMED(HDCP_STAGE_MI_CHAIN, HDCPScalarMiChain(nframes, Ks, REPEATER, Mi0, ws->Bin));
+
+  /* ... and then set up all the frames at once. */
+  SlicedBlockCipher(&ws->block, nframes, ws->Bin, hs, Ki, Ri, &ws->Bin[1]);
+
+  memcpy(Mi, ws->Bin, nframes * sizeof(*Mi));
+}
+
 /* Given Km, REPEATER, and An, set up the cipher state for the first
    nframe frames, and return other authentication values.  */
-void HDCPInitializeMultiFrameState(int nframes, bsvec_t Ks, bsvec_t REPEATER, bsvec_t Mi0, 
+void HDCPInitializeMultiFrameState(int nframes, uint64_t Ks, uint64_t REPEATER, uint64_t Mi0, 
                                    BS_HDCPCipherState *hs, 
-                                   bsvec_t *Ki, bsvec_t *Ri, bsvec_t *Mi)
+                                   uint64_t *Ki, uint64_t *Ri, uint64_t *Mi)
 {
-  int i;
-  bsvec_t Ks_[nframes], REPEATER_[nframes], Mi_[nframes+1];
+  BS_HDCPKeyWorkspace ws;
 
-  for (i = 0; i < nframes; i++) {
-    Ks_[i] = Ks;
-    REPEATER_[i] = REPEATER;
+  InitializeMultiFrameState(&ws, nframes, Ks, REPEATER, Mi0, hs, Ki, Ri, Mi);
+}
+
+static int InitializeMultiSessionState(BS_HDCPKeyWorkspace *ws, int nsessions,
+                                       const HDCPSessionFrames *sessions, BS_HDCPCipherState *hs,
+                                       uint64_t *Ki, uint64_t *Ri, uint64_t *Mi)
+{
+  uint64_t *Ks_ = ws->K_, *REPEATER_ = ws->REPEATER, *Min = ws->Bin, *Mout = ws->Bout;
+  int s, i, lane;
+
+  /* Every frame needs a lane of its own */
+  for (s = lane = 0; s < nsessions; s++) {
+    if (sessions[s].nframes < 0 || sessions[s].nframes > BSBITS - lane)
+      return -1;
+    lane += sessions[s].nframes;
   }
-  
-  HDCPBlockCipher(1, &Ks, &REPEATER, &Mi0, hs, Ki, Ri, Mi_);
 
-  /* Compute all the Mi values */
-  for (i = 0; i < nframes-1; i++) {
-    HDCPBlockCipher(nframes, Ks_, REPEATER_, Mi_, hs, Ki, Ri, &Mi_[1]);
+  /* Walk each session's Mi chain to get the inputs of its lanes.  A
+     session with a single frame uses Mi0 itself, as in
+     HDCPInitializeMultiFrameState. */
+  lane = 0;
+  for (s = 0; s < nsessions; s++) {
+    const HDCPSessionFrames *f = &sessions[s];
+
+    for (i = 0; i < f->nframes; i++) {
+      Ks_[lane+i] = f->Ks;
+      REPEATER_[lane+i] = f->REPEATER;
+    }
+    if (f->nframes == 1)
+      Min[lane] = f->Mi0;
+    else if (f->nframes > 1)
+      HDCP_TIMED(HDCP_STAGE_MI_CHAIN,
+                 HDCPScalarMiChain(f->nframes, f->Ks, f->REPEATER, f->Mi0, &Min[lane]));
+    lane += f->nframes;
+  }
+
+  BlockCipher(&ws->block, lane, Ks_, REPEATER_, Min, hs, Ki, Ri, Mout);
+
+  /* ... and return the same Mi values a batch of its own would */
+  lane = 0;
+  for (s = 0; s < nsessions; s++) {
+    int n = sessions[s].nframes;
+
+    if (n == 1)
+      Mi[lane] = Mout[lane];
+    else if (n > 1)
+      memcpy(&Mi[lane], &Min[lane], n * sizeof(*Mi));
+    lane += n;
   }
 
-  memcpy(Mi, Mi_, nframes * sizeof(*Mi));
+  return lane;
+}
+
+int HDCPInitializeMultiSessionState(int nsessions, const HDCPSessionFrames *sessions,
+                                    BS_HDCPCipherState *hs, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi)
+{
+  BS_HDCPKeyWorkspace ws;
+
+  return InitializeMultiSessionState(&ws, nsessions, sessions, hs, Ki, Ri, Mi);
+}
+
+/* Output bigger than the cache goes around it, since nothing will
+   read it until long after most of it has been evicted anyway. */
+static void FrameStream(bsvec_t slices[HDCP_ROUNDS_CHUNK][24], int nframes, int height, int width,
+                        BS_HDCPCipherState *hs, uint32_t outputs[height][width][nframes])
+{
+  int nt = StreamOutputs(nframes, sizeof(uint32_t) * height * width * nframes, outputs);
+  int line;
+
+  for (line = 0; line < height; line++) {
+    StreamCipher(slices, nframes, hs, width, outputs[line], nt);
+    HDCPRekeycipher(hs);
+  }
+#ifdef BITSLICE_NT
+  if (nt)
+    _mm_sfence();
+#endif
 }
 
 /* This function assumes that hs holds the initial cipher state for each frame. */
 void HDCPFrameStream(int nframes, int height, int width, BS_HDCPCipherState *hs, 
                      uint32_t outputs[height][width][nframes])
 {
-  int line;
+  bsvec_t slices[HDCP_ROUNDS_CHUNK][24];
+
+  FrameStream(slices, nframes, height, width, hs, outputs);
+}
+
+/* Like HDCPFrameStream, but xor the output straight into the caller's
+   frames instead of materializing all nframes frames of output. */
+static void FrameStreamFormat(BS_HDCPStreamWorkspace *ws, int nframes, int height, int width,
+                              BS_HDCPCipherState *hs, uint8_t *frames[nframes],
+                              const HDCPLayout *l, int xor)
+{
+  int line, i;
 
   for (line = 0; line < height; line++) {
-    HDCPStreamCipher(nframes, hs, width, outputs[line]);
+    for (i = 0; i < nframes; i++)
+      ws->lines[i] = frames[i] + (size_t)line * l->pitch;
+    HDCPStreamCipherLines(ws, nframes, hs, width, ws->lines, l, xor);
     HDCPRekeycipher(hs);
   }
 }
 
+void HDCPFrameStreamFormat(int nframes, int height, int width, BS_HDCPCipherState *hs, 
+                           uint8_t *frames[nframes], const HDCPLayout *l, int xor)
+{
+  BS_HDCPStreamWorkspace ws;
+
+  FrameStreamFormat(&ws, nframes, height, width, hs, frames, l, xor);
+}
+
+/* FrameStreamFormat for frames of 32-bit pixels */
+static void FrameStreamWords(BS_HDCPStreamWorkspace *ws, int nframes, int height, int width,
+                             BS_HDCPCipherState *hs, uint32_t *frames[nframes], int pitch, int xor)
+{
+  HDCPLayout l = { HDCP_PIXEL_XRGB32, pitch, 0 };
+  int i;
+
+  for (i = 0; i < nframes; i++)
+    ws->frames[i] = (uint8_t *)frames[i];
+  FrameStreamFormat(ws, nframes, height, width, hs, ws->frames, &l, xor);
+}
+
+void HDCPFrameStreamXor(int nframes, int height, int width, BS_HDCPCipherState *hs, 
+                        uint32_t *frames[nframes], int pitch)
+{
+  BS_HDCPStreamWorkspace ws;
+
+  FrameStreamWords(&ws, nframes, height, width, hs, frames, pitch, 1);
+}
+
+void HDCPFrameStreamScatter(int nframes, int height, int width, BS_HDCPCipherState *hs, 
+                            uint32_t *frames[nframes], int pitch)
+{
+  BS_HDCPStreamWorkspace ws;
+
+  FrameStreamWords(&ws, nframes, height, width, hs, frames, pitch, 0);
+}
+
+static void FrameStreamFrameMajor(BS_HDCPStreamWorkspace *ws, int nframes, int height, int width,
+                                  BS_HDCPCipherState *hs, uint32_t outputs[nframes][height][width])
+{
+  HDCPLayout l = { HDCP_PIXEL_XRGB32, width * sizeof(uint32_t), 0 };
+  int i;
+
+  for (i = 0; i < nframes; i++)
+    ws->frames[i] = (uint8_t *)&outputs[i][0][0];
+  FrameStreamFormat(ws, nframes, height, width, hs, ws->frames, &l, 0);
+}
+
+void HDCPFrameStreamFrameMajor(int nframes, int height, int width, BS_HDCPCipherState *hs, 
+                               uint32_t outputs[nframes][height][width])
+{
+  BS_HDCPStreamWorkspace ws;
+
+  FrameStreamFrameMajor(&ws, nframes, height, width, hs, outputs);
+}
+
+/***********************************************
+ * The engine for this lane width (see hdcp_engine.h)
+ ***********************************************/
+
+/* An engine's cipher state carries its workspace along */
+#define HS(hs) (&((BS_HDCPEngineState *)(hs))->hs)
+#define KW(hs) (&((BS_HDCPEngineState *)(hs))->key)
+#define SL(hs) (((BS_HDCPEngineState *)(hs))->slices)
+#define SW(hs) (&((BS_HDCPEngineState *)(hs))->stream)
+
+static void Engine_BlockCipher(int ncopies, uint64_t *K_, uint64_t *REPEATER, uint64_t *Bin, 
+                               HDCPCipherState *hs, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi)
+{
+  BlockCipher(&KW(hs)->block, ncopies, K_, REPEATER, Bin, HS(hs), Ki, Ri, Mi);
+}
+
+static void Engine_StreamCipher(int ncopies, HDCPCipherState *hs, int noutputs, uint32_t *outputs)
+{
+  StreamCipher(SL(hs), ncopies, HS(hs), noutputs, (uint32_t (*)[ncopies])outputs, 0);
+}
+
+static void Engine_StreamCipherXor(int ncopies, HDCPCipherState *hs, int noutputs, uint32_t **lines)
+{
+  StreamCipherXor(SW(hs), ncopies, HS(hs), noutputs, lines);
+}
+
+static void Engine_Rekeycipher(HDCPCipherState *hs)
+{
+  HDCPRekeycipher(HS(hs));
+}
+
+static void Engine_InitializeMultiFrameState(int nframes, uint64_t Ks, uint64_t REPEATER, uint64_t Mi0, 
+                                             HDCPCipherState *hs, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi)
+{
+  InitializeMultiFrameState(KW(hs), nframes, Ks, REPEATER, Mi0, HS(hs), Ki, Ri, Mi);
+}
+
+static void Engine_FrameStream(int nframes, int height, int width, HDCPCipherState *hs, uint32_t *outputs)
+{
+  FrameStream(SL(hs), nframes, height, width, HS(hs), (uint32_t (*)[width][nframes])outputs);
+}
+
+static void Engine_FrameStreamXor(int nframes, int height, int width, HDCPCipherState *hs, 
+                                  uint32_t **frames, int pitch)
+{
+  FrameStreamWords(SW(hs), nframes, height, width, HS(hs), frames, pitch, 1);
+}
+
+static void Engine_FrameStreamScatter(int nframes, int height, int width, HDCPCipherState *hs, 
+                                      uint32_t **frames, int pitch)
+{
+  FrameStreamWords(SW(hs), nframes, height, width, HS(hs), frames, pitch, 0);
+}
+
+static void Engine_FrameStreamFrameMajor(int nframes, int height, int width, HDCPCipherState *hs,
+                                         uint32_t *outputs)
+{
+  FrameStreamFrameMajor(SW(hs), nframes, height, width, HS(hs), (uint32_t (*)[height][width])outputs);
+}
+
+static void Engine_FrameStreamFormat(int nframes, int height, int width, HDCPCipherState *hs,
+                                     uint8_t **frames, const HDCPLayout *l, int xor)
+{
+  FrameStreamFormat(SW(hs), nframes, height, width, HS(hs), frames, l, xor);
+}
+
+static int Engine_InitializeMultiSessionState(int nsessions, const HDCPSessionFrames *sessions,
+                                              HDCPCipherState *hs, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi)
+{
+  return InitializeMultiSessionState(KW(hs), nsessions, sessions, HS(hs), Ki, Ri, Mi);
+}
+
+static void Engine_Transpose(int ncopies, int noutputs, const void *slices, uint32_t *outputs)
+{
+  const bsvec_t (*bs)[24] = slices;
+  int i;
+
+  for (i = 0; i < noutputs; i++)
+    BitSlice24(24, bs[i], ncopies, outputs + (size_t)i * ncopies);
+}
+
+#undef HS
+#undef KW
+#undef SL
+#undef SW
+
+const HDCPEngine HDCPEngineBS = {
+#if BSVEC_BITS == 64
+  "generic",
+#elif BSVEC_BITS == 128
+  "sse2",
+#elif BSVEC_BITS == 256
+  "avx2",
+#elif BSVEC_BITS == 512 && defined(BITSLICE_GFNI)
+  "avx512gfni",
+#elif BSVEC_BITS == 512
+  "avx512",
+#endif
+  BSBITS,
+  sizeof(BS_HDCPEngineState),
+  __alignof__(BS_HDCPEngineState) > 64 ? __alignof__(BS_HDCPEngineState) : 64,
+  Engine_BlockCipher,
+  Engine_StreamCipher,
+  Engine_StreamCipherXor,
+  Engine_Rekeycipher,
+  Engine_InitializeMultiFrameState,
+  Engine_FrameStream,
+  Engine_FrameStreamXor,
+  Engine_FrameStreamScatter,
+  Engine_FrameStreamFrameMajor,
+  Engine_FrameStreamFormat,
+  Engine_InitializeMultiSessionState,
+  Engine_Transpose,
+  HDCPDeriveKm,
+  BS_CheckSBoxes
+};
@@ -10,6 +10,63 @@
 
 #include <stdint.h>
 #include "bitslice.h"
+#include "hdcp_format.h"
+
+/* hdcp_cipher.c can be compiled for several lane widths (see
+   bitslice.h).  Only the default 64-lane build uses the names below
+   as-is; the others get a _<BSVEC_BITS> suffix so that they can all
+   be linked into one program, and are reached through hdcp_engine.h.
+   Builds of the same width for different instruction sets set
+   BS_VARIANT_SUFFIX to tell them apart. */
+#if BSVEC_BITS != 64
+#ifndef BS_VARIANT_SUFFIX
+#define BS_VARIANT_SUFFIX BSVEC_BITS
+#endif
+#define BS_VARIANT__(name, suffix) name ## _ ## suffix
+#define BS_VARIANT_(name, suffix) BS_VARIANT__(name, suffix)
+#define BS_VARIANT(name) BS_VARIANT_(name, BS_VARIANT_SUFFIX)
+#define BS_LFSR                       BS_VARIANT(BS_LFSR)
+#define BS_ShuffleNetwork             BS_VARIANT(BS_ShuffleNetwork)
+#define BS_LFSRModule_print           BS_VARIANT(BS_LFSRModule_print)
+#define BS_LFSRModule_init            BS_VARIANT(BS_LFSRModule_init)
+#define BS_LFSRModule_clock           BS_VARIANT(BS_LFSRModule_clock)
+#define BS_DiffuseNetworkK_           BS_VARIANT(BS_DiffuseNetworkK_)
+#define BS_DiffuseNetworkK_print      BS_VARIANT(BS_DiffuseNetworkK_print)
+#define BS_DiffuseNetworkK            BS_VARIANT(BS_DiffuseNetworkK)
+#define BS_DiffuseNetworkB_           BS_VARIANT(BS_DiffuseNetworkB_)
+#define BS_DiffuseNetworkB__          BS_VARIANT(BS_DiffuseNetworkB__)
+#define BS_DiffuseNetworkB_print      BS_VARIANT(BS_DiffuseNetworkB_print)
+#define BS_DiffuseNetworkB            BS_VARIANT(BS_DiffuseNetworkB)
+#define BS_SBoxB_                     BS_VARIANT(BS_SBoxB_)
+#define BS_SBoxK_                     BS_VARIANT(BS_SBoxK_)
+#define BS_SBoxB                      BS_VARIANT(BS_SBoxB)
+#define BS_SBoxK                      BS_VARIANT(BS_SBoxK)
+#define BS_CheckSBoxes                BS_VARIANT(BS_CheckSBoxes)
+#define BS_RoundFunctionK             BS_VARIANT(BS_RoundFunctionK)
+#define BS_RoundFunctionB             BS_VARIANT(BS_RoundFunctionB)
+#define BS_BlockModule                BS_VARIANT(BS_BlockModule)
+#define BS_OutputFunction_            BS_VARIANT(BS_OutputFunction_)
+#define BS_OutputFunction_print       BS_VARIANT(BS_OutputFunction_print)
+#define BS_OutputFunction             BS_VARIANT(BS_OutputFunction)
+#define BS_HDCPRound                  BS_VARIANT(BS_HDCPRound)
+#define BS_HDCP_print                 BS_VARIANT(BS_HDCP_print)
+#define BS_HDCPBlockCipher            BS_VARIANT(BS_HDCPBlockCipher)
+#define HDCPBlockCipher               BS_VARIANT(HDCPBlockCipher)
+#define BS_HDCPStreamCipher           BS_VARIANT(BS_HDCPStreamCipher)
+#define HDCPStreamCipher              BS_VARIANT(HDCPStreamCipher)
+#define HDCPStreamCipherXor           BS_VARIANT(HDCPStreamCipherXor)
+#define HDCPRekeycipher               BS_VARIANT(HDCPRekeycipher)
+#define HDCPAuthentication            BS_VARIANT(HDCPAuthentication)
+#define HDCPDeriveKm                  BS_VARIANT(HDCPDeriveKm)
+#define HDCPInitializeMultiFrameState BS_VARIANT(HDCPInitializeMultiFrameState)
+#define HDCPFrameStream               BS_VARIANT(HDCPFrameStream)
+#define HDCPFrameStreamXor            BS_VARIANT(HDCPFrameStreamXor)
+#define HDCPInitializeMultiSessionState BS_VARIANT(HDCPInitializeMultiSessionState)
+#define HDCPFrameStreamScatter        BS_VARIANT(HDCPFrameStreamScatter)
+#define HDCPFrameStreamFrameMajor     BS_VARIANT(HDCPFrameStreamFrameMajor)
+#define HDCPFrameStreamFormat         BS_VARIANT(HDCPFrameStreamFormat)
+#define HDCPEngineBS                  BS_VARIANT(HDCPEngineBS)
+#endif
 
 /***********************************************
  * Low-level interface to cipher operations
@@ -45,16 +102,74 @@ typedef struct _BS_HDCPCipherState
   int rekey;
 } BS_HDCPCipherState;
 
+/* Number of pixels HDCPStreamCipherXor generates and transposes
+   between xors.  Wider lanes use shorter chunks to keep the scratch
+   space small. */
+#define HDCP_XOR_CHUNK (BSBITS <= 128 ? 64 : 8192 / BSBITS)
+
+/* Number of pixels HDCPStreamCipher generates at a time, which lets
+   every width use the 64-round kernel */
+#define HDCP_ROUNDS_CHUNK 64
+
+/* Scratch space for keying and generating output, split by what needs
+   it so that the functions below that take a BS_HDCPCipherState can put
+   just their own part on the stack: the block cipher's slices (2 KB
+   with 64 lanes), keying's Mi chains, or a chunk of stream output and
+   its transpose.  The engines (hdcp_engine.h) keep all of it in every
+   HDCPCipherState instead, so that their entry points use no large
+   stack buffers and allocate nothing once the state exists. */
+typedef struct _BS_HDCPBlockWorkspace
+{
+  bsvec_t K[56], REPEATER_Bin[65];            /* block cipher inputs */
+  bsvec_t Ki[56], Ri[16], Mi[64];             /* ... and outputs */
+} BS_HDCPBlockWorkspace;
+
+typedef struct _BS_HDCPKeyWorkspace
+{
+  BS_HDCPBlockWorkspace block;
+  uint64_t K_[BSBITS], REPEATER[BSBITS];
+  uint64_t Bin[BSBITS + 1], Bout[BSBITS];     /* the Mi chain while keying */
+} BS_HDCPKeyWorkspace;
+
+typedef struct _BS_HDCPStreamWorkspace
+{
+  bsvec_t slices[HDCP_XOR_CHUNK][24];         /* a chunk of stream output */
+  uint32_t outputs[HDCP_XOR_CHUNK * BSBITS];  /* ... transposed */
+  uint8_t *frames[BSBITS], *lines[BSBITS];
+} BS_HDCPStreamWorkspace;
+
+/* An engine's HDCPCipherState */
+typedef struct _BS_HDCPEngineState
+{
+  BS_HDCPCipherState hs;
+  BS_HDCPKeyWorkspace key;
+  bsvec_t slices[HDCP_ROUNDS_CHUNK][24];      /* for HDCPStreamCipher */
+  BS_HDCPStreamWorkspace stream;
+} BS_HDCPEngineState;
+
+/* The round primitives.  Each register is 28 bit-sliced bits. */
+void BS_SBoxB(bsvec_t input[28], bsvec_t output[28]);
+void BS_SBoxK(bsvec_t input[28], bsvec_t output[28]);
+void BS_SBoxB_(bsvec_t input[28], bsvec_t output[28]);
+void BS_SBoxK_(bsvec_t input[28], bsvec_t output[28]);
+
+/* Returns 1 if BS_SBoxB/K agree with BS_SBoxB_/K_ on all inputs */
+int BS_CheckSBoxes(void);
+void BS_DiffuseNetworkK(bsvec_t Kz[28], bsvec_t Ky[28], bsvec_t Kx[28]);
+void BS_DiffuseNetworkB(bsvec_t Bz[28], bsvec_t By[28], bsvec_t Bx[28], bsvec_t Ky[28]);
+
 void BS_HDCPBlockCipher(bsvec_t K_[56], bsvec_t REPEATER_An[65], 
                         BS_HDCPCipherState *hs, bsvec_t Ki[56], bsvec_t Ri[16], bsvec_t Mi[64]);
 
-void HDCPBlockCipher(int ncopies, bsvec_t *K_, bsvec_t *REPEATER, bsvec_t *An, 
-                     BS_HDCPCipherState *hs, bsvec_t *Ki, bsvec_t *Ri, bsvec_t *Mi);
+void HDCPBlockCipher(int ncopies, uint64_t *K_, uint64_t *REPEATER, uint64_t *An, 
+                     BS_HDCPCipherState *hs, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi);
 
 void BS_HDCPStreamCipher(BS_HDCPCipherState *hs, int noutputs, bsvec_t outputs[noutputs][24]);
 
 void HDCPStreamCipher(int ncopies, BS_HDCPCipherState *hs, int noutputs, uint32_t outputs[noutputs][ncopies]);
 
+void HDCPStreamCipherXor(int ncopies, BS_HDCPCipherState *hs, int noutputs, uint32_t *lines[ncopies]);
+
 void HDCPRekeycipher(BS_HDCPCipherState *hs);
 
 /*************************************************
@@ -62,14 +177,23 @@ void HDCPRekeycipher(BS_HDCPCipherState *hs);
  *************************************************/
 
 /* Generate Ks, R0, and M0 from Km, REPEATER, and An */
-void HDCPAuthentication(bsvec_t Km, bsvec_t REPEATER, bsvec_t An, 
-                        bsvec_t *Ks, bsvec_t *R0, bsvec_t *M0);
+void HDCPAuthentication(uint64_t Km, uint64_t REPEATER, uint64_t An, 
+                        uint64_t *Ks, uint64_t *R0, uint64_t *M0);
+
+/* A device has HDCP_NKEYS 56-bit private keys, and a KSV of as many
+   bits, HDCP_NKEYS/2 of them set */
+#define HDCP_NKEYS 40
+
+/* For each i < n, set Km[i] to the sum mod 2^56 of keys[i][j] for
+   each bit j set in ksv[i], i.e. Km from one device's keys and the
+   other device's KSV.  keys[i] may all point to the same keys. */
+void HDCPDeriveKm(int n, const uint64_t *ksv, const uint64_t *const *keys, uint64_t *Km);
 
 /* Generate the following information for the next nframe frames:
    - initialize hs for generating ciphertext
    - output Ki, Ri, and Mi for each frame */
-void HDCPInitializeMultiFrameState(int nframes, bsvec_t Ks, bsvec_t REPEATER, bsvec_t Mi0, 
-                                   BS_HDCPCipherState *hs, bsvec_t *Ki, bsvec_t *Ri, bsvec_t *Mi);
+void HDCPInitializeMultiFrameState(int nframes, uint64_t Ks, uint64_t REPEATER, uint64_t Mi0, 
+                                   BS_HDCPCipherState *hs, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi);
 
 /* Given hs as initialized by HDCPInitializeMultiFrameState, generate
    ciphertext output for the next nframe frames.  hs will also be
@@ -78,5 +202,57 @@ void HDCPInitializeMultiFrameState(int nframes, bsvec_t Ks, bsvec_t REPEATER, bs
 void HDCPFrameStream(int nframes, int height, int width, BS_HDCPCipherState *hs, 
                      uint32_t outputs[height][width][nframes]);
 
+/* Same as HDCPFrameStream, but xor the output for frame i directly
+   into frames[i], a height x width image of 32-bit pixels whose lines
+   are pitch bytes apart.  Only the low 24 bits of each pixel change.
+   This avoids ever storing more than a few lines of stream cipher
+   output, so it is the way to encrypt/decrypt video in place. */
+void HDCPFrameStreamXor(int nframes, int height, int width, BS_HDCPCipherState *hs, 
+                        uint32_t *frames[nframes], int pitch);
+
+/* Same as HDCPFrameStream, but store the output for frame i into
+   frames[i] instead of interleaving all the frames in one array. */
+void HDCPFrameStreamScatter(int nframes, int height, int width, BS_HDCPCipherState *hs, 
+                            uint32_t *frames[nframes], int pitch);
+
+/* Same as HDCPFrameStream, but with the frames one after another
+   instead of interleaved, which is the layout most consumers want. */
+void HDCPFrameStreamFrameMajor(int nframes, int height, int width, BS_HDCPCipherState *hs, 
+                               uint32_t outputs[nframes][height][width]);
+
+/* Same as HDCPFrameStreamScatter (or, if xor, HDCPFrameStreamXor), but
+   for frames laid out as l says, e.g. packed RGB24 or planar YCbCr
+   4:4:4 (see hdcp_format.h).  Each chunk of HDCP_XOR_CHUNK pixels is
+   transposed into 32-bit pixels in a small buffer that stays in cache,
+   and packed into the frames from there, so there is no separate pass
+   over the frames. */
+void HDCPFrameStreamFormat(int nframes, int height, int width, BS_HDCPCipherState *hs, 
+                           uint8_t *frames[nframes], const HDCPLayout *l, int xor);
+
+/*************************************************
+ * Several HDCP links in one batch
+ *************************************************/
+
+/* nframes consecutive frames of one link, continuing its Mi chain from
+   Mi0 just like HDCPInitializeMultiFrameState. */
+typedef struct _HDCPSessionFrames
+{
+  uint64_t Ks, REPEATER, Mi0;
+  int nframes;
+} HDCPSessionFrames;
+
+/* Like HDCPInitializeMultiFrameState, but the lanes are shared between
+   nsessions independent links: session s gets the sessions[s].nframes
+   lanes after those of sessions 0..s-1, set up exactly as
+   HDCPInitializeMultiFrameState(sessions[s].nframes, ...) would set up
+   the lanes of a batch of its own, and Ki, Ri and Mi are indexed by
+   lane.  The lanes all generate the same number of pixels per line, so
+   only links with the same frame size can share a batch.  Returns the
+   number of lanes used, or -1 (setting up nothing) if a session has a
+   negative number of frames or there are more than BSBITS frames in
+   all. */
+int HDCPInitializeMultiSessionState(int nsessions, const HDCPSessionFrames *sessions,
+                                    BS_HDCPCipherState *hs, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi);
+
 #endif /* __HDCP_CIPHER_H__ */
 
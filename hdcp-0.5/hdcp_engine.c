@@ -0,0 +1,129 @@
+/************************************************************
+ * Run-time selection of the bit-slice lane width.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "hdcp_engine.h"
+#include "hdcp_mem.h"
+
+extern const HDCPEngine HDCPEngineScalar, HDCPEngineBS;
+#ifdef HDCP_WIDE_ENGINES
+extern const HDCPEngine HDCPEngineBS_128, HDCPEngineBS_256, HDCPEngineBS_512;
+extern const HDCPEngine HDCPEngineBS_512gfni;
+#endif
+
+static int Supported_always(void)
+{
+  return 1;
+}
+
+#ifdef HDCP_WIDE_ENGINES
+static int Supported_sse2(void)
+{
+  return __builtin_cpu_supports("sse2");
+}
+
+static int Supported_avx2(void)
+{
+  return __builtin_cpu_supports("avx2");
+}
+
+static int Supported_avx512(void)
+{
+  return __builtin_cpu_supports("avx512f");
+}
+
+static int Supported_avx512gfni(void)
+{
+  return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+    __builtin_cpu_supports("avx512vbmi") && __builtin_cpu_supports("gfni");
+}
+#endif
+
+/* In order of increasing width */
+static const struct {
+  const HDCPEngine *engine;
+  int (*supported)(void);
+} Engines[] = {
+  /* One frame at a time, for low latency (hdcp_scalar.h) */
+  { &HDCPEngineScalar, Supported_always },
+  { &HDCPEngineBS,     Supported_always },
+#ifdef HDCP_WIDE_ENGINES
+  { &HDCPEngineBS_128, Supported_sse2 },
+  { &HDCPEngineBS_256, Supported_avx2 },
+  { &HDCPEngineBS_512, Supported_avx512 },
+  /* Same width, but with the GFNI transposes of bitslice-gen.c */
+  { &HDCPEngineBS_512gfni, Supported_avx512gfni },
+#endif
+};
+
+#define NENGINES ((int)(sizeof(Engines) / sizeof(Engines[0])))
+
+static const HDCPEngine *BestEngine;
+static pthread_once_t BestEngineOnce = PTHREAD_ONCE_INIT;
+
+static void ChooseEngine(void)
+{
+  const char *name = getenv("HDCP_ENGINE");
+  int i;
+
+  if (name && (BestEngine = HDCPFindEngine(name)))
+    return;
+
+  for (i = 0; HDCPListEngines(i); i++)
+    BestEngine = HDCPListEngines(i);
+}
+
+const HDCPEngine *HDCPGetEngine(void)
+{
+  pthread_once(&BestEngineOnce, ChooseEngine);
+  return BestEngine;
+}
+
+const HDCPEngine *HDCPListEngines(int i)
+{
+  int j;
+
+  for (j = 0; j < NENGINES; j++)
+    if (Engines[j].supported() && i-- == 0)
+      return Engines[j].engine;
+  return NULL;
+}
+
+const HDCPEngine *HDCPFindEngine(const char *name)
+{
+  const HDCPEngine *e;
+  int i;
+
+  for (i = 0; (e = HDCPListEngines(i)); i++)
+    if (strcmp(e->name, name) == 0)
+      return e;
+  return NULL;
+}
+
+int HDCPLanes(void)
+{
+  return HDCPGetEngine()->lanes;
+}
+
+HDCPCipherState *HDCPNewCipherState(const HDCPEngine *e)
+{
+  return HDCPNewCipherStateOnNode(e, -1);
+}
+
+HDCPCipherState *HDCPNewCipherStateOnNode(const HDCPEngine *e, int node)
+{
+  if (e->state_align > HDCP_ALLOC_ALIGN)
+    return NULL;
+  return HDCPAlloc(e->state_size, HDCPDefaultPages(), node);
+}
+
+void HDCPFreeCipherState(HDCPCipherState *hs)
+{
+  HDCPFree(hs);
+}
@@ -0,0 +1,85 @@
+/************************************************************
+ * Run-time selection of the bit-slice lane width.
+ *
+ * hdcp_cipher.c is compiled once per lane width (64 lanes in plain
+ * 64-bit words, plus 128/256/512 lanes with SSE2/AVX2/AVX-512 on
+ * x86-64).  Each build exports an HDCPEngine, and HDCPGetEngine()
+ * picks the widest one this CPU can run.  hdcp_scalar.c adds a
+ * 1-lane "scalar" engine for generating one frame with low latency.
+ * Since the size of the cipher state depends on the width, engines
+ * work on an opaque HDCPCipherState allocated with
+ * HDCPNewCipherState().
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#ifndef __HDCP_ENGINE_H__
+#define __HDCP_ENGINE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct _HDCPCipherState HDCPCipherState;
+struct _HDCPSessionFrames;  /* see hdcp_cipher.h */
+struct _HDCPLayout;         /* see hdcp_format.h */
+
+/* The functions are the same as those of the same name in
+   hdcp_cipher.h, except that the multi-dimensional output arrays are
+   passed as flat pointers, and ncopies/nframes may be up to lanes. */
+typedef struct _HDCPEngine
+{
+  const char *name;
+  int lanes;
+  size_t state_size, state_align;
+
+  void (*BlockCipher)(int ncopies, uint64_t *K_, uint64_t *REPEATER, uint64_t *Bin,
+                      HDCPCipherState *hs, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi);
+  void (*StreamCipher)(int ncopies, HDCPCipherState *hs, int noutputs, uint32_t *outputs);
+  void (*StreamCipherXor)(int ncopies, HDCPCipherState *hs, int noutputs, uint32_t **lines);
+  void (*Rekeycipher)(HDCPCipherState *hs);
+  void (*InitializeMultiFrameState)(int nframes, uint64_t Ks, uint64_t REPEATER, uint64_t Mi0,
+                                    HDCPCipherState *hs, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi);
+  void (*FrameStream)(int nframes, int height, int width, HDCPCipherState *hs, uint32_t *outputs);
+  void (*FrameStreamXor)(int nframes, int height, int width, HDCPCipherState *hs,
+                         uint32_t **frames, int pitch);
+  void (*FrameStreamScatter)(int nframes, int height, int width, HDCPCipherState *hs,
+                             uint32_t **frames, int pitch);
+  /* outputs[nframes][height][width] */
+  void (*FrameStreamFrameMajor)(int nframes, int height, int width, HDCPCipherState *hs,
+                                uint32_t *outputs);
+  void (*FrameStreamFormat)(int nframes, int height, int width, HDCPCipherState *hs,
+                            uint8_t **frames, const struct _HDCPLayout *l, int xor);
+  /* -1 if the sessions have more than lanes frames in all */
+  int (*InitializeMultiSessionState)(int nsessions, const struct _HDCPSessionFrames *sessions,
+                                     HDCPCipherState *hs, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi);
+  /* Transpose noutputs groups of 24 slices (lanes/8 bytes each) into
+     outputs[noutputs][ncopies], as the stream cipher does.  NULL for
+     the scalar engine. */
+  void (*Transpose)(int ncopies, int noutputs, const void *slices, uint32_t *outputs);
+  void (*DeriveKm)(int n, const uint64_t *ksv, const uint64_t *const *keys, uint64_t *Km);
+  int (*CheckSBoxes)(void);   /* BS_CheckSBoxes */
+} HDCPEngine;
+
+/* The widest engine this CPU supports.  Setting the environment
+   variable HDCP_ENGINE to an engine name overrides the choice. */
+const HDCPEngine *HDCPGetEngine(void);
+
+/* The i'th engine (in order of increasing width) that this CPU
+   supports, or NULL if there are no more. */
+const HDCPEngine *HDCPListEngines(int i);
+
+/* The engine with the given name, or NULL if there is no such engine
+   or this CPU can't run it. */
+const HDCPEngine *HDCPFindEngine(const char *name);
+
+/* The number of frames HDCPGetEngine() processes in parallel */
+int HDCPLanes(void);
+
+/* Allocate/free a suitably aligned cipher state for engine e, on the
+   NUMA node of the calling thread or on node (see hdcp_mem.h) */
+HDCPCipherState *HDCPNewCipherState(const HDCPEngine *e);
+HDCPCipherState *HDCPNewCipherStateOnNode(const HDCPEngine *e, int node);
+void HDCPFreeCipherState(HDCPCipherState *hs);
+
+#endif /* __HDCP_ENGINE_H__ */
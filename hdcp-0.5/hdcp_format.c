@@ -0,0 +1,136 @@
+/************************************************************
+ * Writing cipher output straight into video of a given pixel format.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#include <string.h>
+#include "hdcp_format.h"
+
+static const struct {
+  const char *name;
+  int bytes;
+} formats[HDCP_NPIXEL_FORMATS] = {
+  [HDCP_PIXEL_XRGB32]    = { "xrgb32",  4 },
+  [HDCP_PIXEL_RGB24]     = { "rgb24",   3 },
+  [HDCP_PIXEL_BGR24]     = { "bgr24",   3 },
+  [HDCP_PIXEL_YCBCR444P] = { "yuv444p", 1 },
+};
+
+const char *HDCPPixelFormatName(HDCPPixelFormat format)
+{
+  return format >= 0 && format < HDCP_NPIXEL_FORMATS ? formats[format].name : "?";
+}
+
+int HDCPPixelFormatByName(const char *name)
+{
+  int i;
+
+  for (i = 0; i < HDCP_NPIXEL_FORMATS; i++)
+    if (!strcmp(name, formats[i].name))
+      return i;
+  return -1;
+}
+
+int HDCPPixelBytes(HDCPPixelFormat format)
+{
+  return formats[format].bytes;
+}
+
+/* Store (or xor) the Y, Cb and Cr bytes of each output to y[0..n-1],
+   cb[0..n-1] and cr[0..n-1] */
+static inline void WritePlanes(uint8_t *y, uint8_t *cb, uint8_t *cr, int n,
+                               const uint32_t *keys, int stride, int xor)
+{
+  uint32_t k;
+  int i;
+
+  for (i = 0; i < n; i++) {
+    k = keys[i * stride];
+    if (xor) {
+      y[i] ^= k >> 8;
+      cb[i] ^= k;
+      cr[i] ^= k >> 16;
+    } else {
+      y[i] = k >> 8;
+      cb[i] = k;
+      cr[i] = k >> 16;
+    }
+  }
+}
+
+/* Store (or xor) packed 24-bit pixels, whose bytes in memory are the
+   low three bytes of each output in little-endian order, or in
+   big-endian order if swap.  Four pixels at a time fill three 32-bit
+   words; the rest go byte by byte. */
+static inline void WritePacked(uint8_t *p, int swap, int n,
+                               const uint32_t *keys, int stride, int xor)
+{
+  uint32_t t[4], w[3], v[3];
+  int i, j;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  for (i = 0; n - i >= 4; i += 4, p += 12) {
+    for (j = 0; j < 4; j++) {
+      t[j] = keys[(i + j) * stride];
+      if (swap)
+        t[j] = __builtin_bswap32(t[j]) >> 8;
+    }
+    w[0] = t[0] | t[1] << 24;
+    w[1] = t[1] >> 8 | t[2] << 16;
+    w[2] = t[2] >> 16 | t[3] << 8;
+    if (xor) {
+      memcpy(v, p, sizeof(v));
+      for (j = 0; j < 3; j++)
+        w[j] ^= v[j];
+    }
+    memcpy(p, w, sizeof(w));
+  }
+#else
+  i = 0;
+#endif
+  for (; i < n; i++, p += 3)
+    for (j = 0; j < 3; j++) {
+      uint8_t b = keys[i * stride] >> (swap ? 16 - 8 * j : 8 * j);
+
+      if (xor)
+        p[j] ^= b;
+      else
+        p[j] = b;
+    }
+}
+
+void HDCPWritePixels(const HDCPLayout *l, uint8_t *dst, int x, int n,
+                     const uint32_t *keys, int stride, int xor)
+{
+  uint32_t *words;
+  int i;
+
+  switch (l->format) {
+  case HDCP_PIXEL_XRGB32:
+    words = (uint32_t *)dst + x;
+    if (xor)
+      for (i = 0; i < n; i++)
+        words[i] ^= keys[i * stride];
+    else
+      for (i = 0; i < n; i++)
+        words[i] = keys[i * stride];
+    break;
+  case HDCP_PIXEL_RGB24:
+    WritePacked(dst + 3 * x, 1, n, keys, stride, xor);
+    break;
+  case HDCP_PIXEL_BGR24:
+    WritePacked(dst + 3 * x, 0, n, keys, stride, xor);
+    break;
+  case HDCP_PIXEL_YCBCR444P:
+    dst += x;
+    /* The cipher prefetches the Y plane for us, but not the others */
+    __builtin_prefetch(dst + l->plane_pitch + 2 * n, 1);
+    __builtin_prefetch(dst + 2 * l->plane_pitch + 2 * n, 1);
+    WritePlanes(dst, dst + l->plane_pitch, dst + 2 * l->plane_pitch, n, keys, stride, xor);
+    break;
+  default:
+    break;
+  }
+}
@@ -0,0 +1,60 @@
+/************************************************************
+ * Writing cipher output straight into video of a given pixel format.
+ *
+ * The cipher produces 24 bits per pixel, one byte for each TMDS
+ * channel: bits 23-16 are xored with channel 2, bits 15-8 with
+ * channel 1 and bits 7-0 with channel 0.  For RGB the channels carry
+ * red, green and blue, and for YCbCr 4:4:4 they carry Cr, Y and Cb, so
+ * the output bytes go wherever those components sit in the frame.
+ *
+ * HDCPFrameStream and friends hand out each pixel in a 32-bit word,
+ * which is the HDCP_PIXEL_XRGB32 layout below.  The other layouts let
+ * the cipher write packed 24-bit or planar frames directly, instead of
+ * converting its output in a separate pass.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#ifndef __HDCP_FORMAT_H__
+#define __HDCP_FORMAT_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum _HDCPPixelFormat
+{
+  HDCP_PIXEL_XRGB32,     /* native-endian 32-bit words 0x00RRGGBB */
+  HDCP_PIXEL_RGB24,      /* bytes R, G, B */
+  HDCP_PIXEL_BGR24,      /* bytes B, G, R */
+  HDCP_PIXEL_YCBCR444P,  /* planes of Y, Cb and Cr bytes */
+  HDCP_NPIXEL_FORMATS
+} HDCPPixelFormat;
+
+/* How a frame is laid out in memory.  A frame starts at the first
+   pixel of its first line (of its Y plane, for planar formats), lines
+   are pitch bytes apart, and the Cb and Cr planes follow plane_pitch
+   and 2*plane_pitch bytes after the Y plane. */
+typedef struct _HDCPLayout
+{
+  HDCPPixelFormat format;
+  int pitch;
+  size_t plane_pitch;
+} HDCPLayout;
+
+/* A short name for format, for printing, and the format with that
+   name (-1 if there is none) */
+const char *HDCPPixelFormatName(HDCPPixelFormat format);
+int HDCPPixelFormatByName(const char *name);
+
+/* Bytes per pixel in each plane of a frame in this format */
+int HDCPPixelBytes(HDCPPixelFormat format);
+
+/* Store (or, if xor, xor) the n outputs keys[0], keys[stride], ...,
+   keys[(n-1)*stride] into consecutive pixels of a line, starting at
+   pixel x of the line at dst.  For planar formats dst is the line of
+   the Y plane. */
+void HDCPWritePixels(const HDCPLayout *l, uint8_t *dst, int x, int n,
+                     const uint32_t *keys, int stride, int xor);
+
+#endif /* __HDCP_FORMAT_H__ */
@@ -0,0 +1,373 @@
+/************************************************************
+ * Huge pages and NUMA nodes for batch buffers and cipher states.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#define _GNU_SOURCE
+#include <ctype.h>
+#include <dirent.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include "hdcp_mem.h"
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#define MPOL_PREFERRED 1
+
+#define SIZE_2M ((size_t)1 << 21)
+#define SIZE_1G ((size_t)1 << 30)
+
+/* If sysconf doesn't know the size of the last-level cache */
+#define DEFAULT_LLC_BYTES ((size_t)32 << 20)
+
+/* What HDCPAlloc mapped for each pointer it returned (anything not in
+   the table came from the heap).  These live in a table of their own
+   rather than in front of the memory, so that asking for exactly 2 MB
+   takes one 2 MB page and not two. */
+typedef struct _Allocation
+{
+  void *base;
+  size_t length;
+  HDCPPages pages;
+  struct _Allocation *next;
+} Allocation;
+
+#define ALLOC_BUCKETS 64
+
+static Allocation *Allocations[ALLOC_BUCKETS];
+static pthread_mutex_t AllocationsLock = PTHREAD_MUTEX_INITIALIZER;
+
+static Allocation **Bucket(const void *p)
+{
+  return &Allocations[((uintptr_t)p >> 12) % ALLOC_BUCKETS];
+}
+
+/* The entry for p, unlinked from the table if unlink is set; the lock
+   is held */
+static Allocation *FindAllocation(const void *p, int unlink)
+{
+  Allocation **a, *found;
+
+  for (a = Bucket(p); *a; a = &(*a)->next)
+    if ((*a)->base == p) {
+      found = *a;
+      if (unlink)
+        *a = found->next;
+      return found;
+    }
+  return NULL;
+}
+
+static const char *PagesNames[] = { "1g", "2m", "thp", "4k" };
+
+static size_t RoundUp(size_t n, size_t to)
+{
+  return (n + to - 1) / to * to;
+}
+
+/* Ask for node's memory, before anything touches it */
+static void Bind(void *base, size_t length, int node)
+{
+#ifdef SYS_mbind
+  unsigned long mask[16];
+
+  if (node < 0 || node >= (int)(8 * sizeof(mask)) - 1 || HDCPNodes() < 2)
+    return;
+  memset(mask, 0, sizeof(mask));
+  mask[node / (8 * sizeof(long))] = 1UL << (node % (8 * sizeof(long)));
+  syscall(SYS_mbind, base, length, MPOL_PREFERRED, mask, 8 * sizeof(mask), 0);
+#endif
+}
+
+/* Map length bytes in pages, or return NULL */
+static void *Map(size_t *length, HDCPPages pages)
+{
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+  size_t page = sysconf(_SC_PAGESIZE);
+  char *base, *aligned;
+
+  switch (pages) {
+  case HDCP_PAGES_1G:
+  case HDCP_PAGES_2M:
+#ifdef MAP_HUGETLB
+    page = pages == HDCP_PAGES_1G ? SIZE_1G : SIZE_2M;
+    /* Pages more than twice the size would mostly go to waste */
+    if (*length < page / 2)
+      return NULL;
+    *length = RoundUp(*length, page);
+    flags |= MAP_HUGETLB | (pages == HDCP_PAGES_1G ? 30 : 21) << MAP_HUGE_SHIFT;
+    base = mmap(NULL, *length, PROT_READ | PROT_WRITE, flags, -1, 0);
+    return base == MAP_FAILED ? NULL : base;
+#else
+    return NULL;
+#endif
+
+  case HDCP_PAGES_THP:
+#ifdef MADV_HUGEPAGE
+    if (*length < SIZE_2M / 2)
+      return NULL;
+    /* Over-allocate, and trim to a 2 MB boundary at each end */
+    *length = RoundUp(*length, SIZE_2M);
+    base = mmap(NULL, *length + SIZE_2M, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (base == MAP_FAILED)
+      return NULL;
+    aligned = (char *)RoundUp((uintptr_t)base, SIZE_2M);
+    if (aligned > base)
+      munmap(base, aligned - base);
+    munmap(aligned + *length, base + SIZE_2M - aligned);
+    madvise(aligned, *length, MADV_HUGEPAGE);
+    return aligned;
+#else
+    return NULL;
+#endif
+
+  default:
+    *length = RoundUp(*length, page);
+    base = mmap(NULL, *length, PROT_READ | PROT_WRITE, flags, -1, 0);
+    return base == MAP_FAILED ? NULL : base;
+  }
+}
+
+void *HDCPAlloc(size_t size, HDCPPages pages, int node)
+{
+  Allocation *a;
+  void *base = NULL;
+  size_t length = 0;
+  int p;
+
+  /* Less than a page would take a whole one, and a syscall, to map.
+     Zeroed, like the pages. */
+  if (size < (size_t)sysconf(_SC_PAGESIZE)) {
+    length = RoundUp(size ? size : 1, HDCP_ALLOC_ALIGN);
+    if ((base = aligned_alloc(HDCP_ALLOC_ALIGN, length)))
+      memset(base, 0, length);
+    return base;
+  }
+  if (!(a = malloc(sizeof(*a))))
+    return NULL;
+  if (node < 0)
+    node = HDCPCurrentNode();
+  for (p = pages; p <= HDCP_PAGES_4K && !base; p++) {
+    length = size;
+    base = Map(&length, p);
+  }
+  if (!base) {
+    free(a);
+    return NULL;
+  }
+
+  Bind(base, length, node);
+  a->base = base;
+  a->length = length;
+  a->pages = p - 1;
+  pthread_mutex_lock(&AllocationsLock);
+  a->next = *Bucket(base);
+  *Bucket(base) = a;
+  pthread_mutex_unlock(&AllocationsLock);
+  return base;
+}
+
+void HDCPFree(void *p)
+{
+  Allocation *a;
+
+  if (!p)
+    return;
+  pthread_mutex_lock(&AllocationsLock);
+  a = FindAllocation(p, 1);
+  pthread_mutex_unlock(&AllocationsLock);
+  if (a) {
+    munmap(a->base, a->length);
+    free(a);
+  } else
+    free(p);
+}
+
+HDCPPages HDCPAllocPages(const void *p)
+{
+  Allocation *a;
+  HDCPPages pages;
+
+  pthread_mutex_lock(&AllocationsLock);
+  a = FindAllocation(p, 0);
+  pages = a ? a->pages : HDCP_PAGES_4K;
+  pthread_mutex_unlock(&AllocationsLock);
+  return pages;
+}
+
+static HDCPPages DefaultPages = HDCP_PAGES_THP;
+static pthread_once_t DefaultPagesOnce = PTHREAD_ONCE_INIT;
+
+static void ChoosePages(void)
+{
+  const char *name = getenv("HDCP_PAGES");
+  int p;
+
+  if (name && (p = HDCPFindPages(name)) >= 0)
+    DefaultPages = p;
+}
+
+HDCPPages HDCPDefaultPages(void)
+{
+  pthread_once(&DefaultPagesOnce, ChoosePages);
+  return DefaultPages;
+}
+
+const char *HDCPPagesName(HDCPPages pages)
+{
+  return PagesNames[pages];
+}
+
+int HDCPFindPages(const char *name)
+{
+  int p;
+
+  for (p = 0; p <= HDCP_PAGES_4K; p++)
+    if (strcmp(name, PagesNames[p]) == 0)
+      return p;
+  return -1;
+}
+
+/* Most nodes we keep track of */
+#define MAX_NODES 256
+
+static int Nodes = 1, NodeIds[MAX_NODES];
+static pthread_once_t NodesOnce = PTHREAD_ONCE_INIT;
+
+/* Parse a list like "0-3,8-11" into ids[0..max-1], returning how many
+   there are */
+static int ParseList(const char *s, int *ids, int max)
+{
+  char *end;
+  long lo, hi;
+  int n = 0;
+
+  while (isdigit((unsigned char)*s)) {
+    lo = hi = strtol(s, &end, 10);
+    if (*end == '-')
+      hi = strtol(end + 1, &end, 10);
+    for (; lo <= hi && n < max; lo++)
+      ids[n++] = lo;
+    s = *end == ',' ? end + 1 : end;
+  }
+  return n;
+}
+
+/* The nodes this process may allocate on, which need not be numbered
+   0..n-1 */
+static void FindNodes(void)
+{
+  FILE *f = fopen("/proc/self/status", "r");
+  char line[4096];
+  DIR *d;
+  struct dirent *ent;
+  int n = 0;
+
+  while (f && !n && fgets(line, sizeof(line), f))
+    if (strncmp(line, "Mems_allowed_list:", 18) == 0)
+      n = ParseList(line + 18 + strspn(line + 18, " \t"), NodeIds, MAX_NODES);
+  if (f)
+    fclose(f);
+
+  if (!n && (d = opendir("/sys/devices/system/node"))) {
+    while ((ent = readdir(d)) && n < MAX_NODES)
+      if (strncmp(ent->d_name, "node", 4) == 0 && isdigit((unsigned char)ent->d_name[4]))
+        NodeIds[n++] = atoi(ent->d_name + 4);
+    closedir(d);
+  }
+
+  if (n > 0)
+    Nodes = n;
+  else
+    NodeIds[0] = 0;
+}
+
+int HDCPNodes(void)
+{
+  pthread_once(&NodesOnce, FindNodes);
+  return Nodes;
+}
+
+int HDCPNode(int i)
+{
+  pthread_once(&NodesOnce, FindNodes);
+  return NodeIds[i % Nodes];
+}
+
+int HDCPCurrentNode(void)
+{
+#ifdef SYS_getcpu
+  unsigned cpu, node;
+
+  if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0)
+    return node;
+#endif
+  return 0;
+}
+
+int HDCPBindThread(int node)
+{
+  char path[64], list[4096];
+  int cpus_list[CPU_SETSIZE], n, i;
+  cpu_set_t cpus;
+  FILE *f;
+
+  if (HDCPNodes() < 2)
+    return node == HDCPNode(0) ? 0 : -1;
+
+  snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+  if (!(f = fopen(path, "r")))
+    return -1;
+  n = fgets(list, sizeof(list), f) ? ParseList(list, cpus_list, CPU_SETSIZE) : 0;
+  fclose(f);
+
+  CPU_ZERO(&cpus);
+  for (i = 0; i < n; i++)
+    CPU_SET(cpus_list[i], &cpus);
+  if (CPU_COUNT(&cpus) == 0)
+    return -1;
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0 ? 0 : -1;
+}
+
+static size_t StreamingBytes = DEFAULT_LLC_BYTES;
+static pthread_once_t StreamingBytesOnce = PTHREAD_ONCE_INIT;
+
+static void FindStreamingBytes(void)
+{
+  const char *s = getenv("HDCP_STREAM_BYTES");
+#ifdef _SC_LEVEL3_CACHE_SIZE
+  long llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+
+  if (llc <= 0)
+    llc = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#else
+  long llc = 0;
+#endif
+
+  if (s && *s)
+    StreamingBytes = strtoll(s, NULL, 0) < 0 ? SIZE_MAX : strtoull(s, NULL, 0);
+  else if (llc > 0)
+    StreamingBytes = llc;
+}
+
+size_t HDCPStreamingBytes(void)
+{
+  pthread_once(&StreamingBytesOnce, FindStreamingBytes);
+  return StreamingBytes;
+}
+
+void HDCPSetStreamingBytes(size_t bytes)
+{
+  pthread_once(&StreamingBytesOnce, FindStreamingBytes);
+  StreamingBytes = bytes;
+}
@@ -0,0 +1,84 @@
+/************************************************************
+ * Huge pages and NUMA nodes for batch buffers and cipher states.
+ *
+ * A batch of output is hundreds of MB at 1080p, and the bit-sliced
+ * engines write it a line of every frame at a time, so with 4 KB pages
+ * nearly every store needs a TLB entry of its own.  On machines with
+ * several NUMA nodes, memory also lands on the node of whichever
+ * thread touches it first, which is often not the node of the thread
+ * that generates into it.
+ *
+ * HDCPAlloc() maps its memory directly, on the node asked for, in the
+ * largest pages it can get: 1 GB or 2 MB pages from hugetlbfs (which
+ * must be set aside, e.g. in /proc/sys/vm/nr_hugepages), or else 2 MB
+ * aligned memory the kernel is asked to back with transparent huge
+ * pages, or else plain 4 KB pages.  HDCPNewCipherState(), the
+ * pipeline's output buffers and the pool's workers use it, with the
+ * pages HDCPDefaultPages() names, and the pool and pipeline threads
+ * run on the node of their buffers.  On a machine with one node the
+ * node arguments make no difference.
+ *
+ * Output too big for the last-level cache is written around it (see
+ * HDCPStreamingBytes()).
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#ifndef __HDCP_MEM_H__
+#define __HDCP_MEM_H__
+
+#include <stddef.h>
+
+/* What HDCPAlloc returns is aligned to this many bytes */
+#define HDCP_ALLOC_ALIGN 64
+
+/* Pages to try for, each falling back to the next */
+typedef enum
+{
+  HDCP_PAGES_1G,            /* hugetlbfs 1 GB pages */
+  HDCP_PAGES_2M,            /* hugetlbfs 2 MB pages */
+  HDCP_PAGES_THP,           /* transparent huge pages (madvise) */
+  HDCP_PAGES_4K,            /* no huge pages */
+} HDCPPages;
+
+/* size bytes on NUMA node node (-1 for that of the calling thread),
+   in pages of the given size or the next smaller one that can be had.
+   Less than a page (e.g. the scalar engine's cipher state) comes from
+   the heap instead, wherever it is.  Returns NULL on failure. */
+void *HDCPAlloc(size_t size, HDCPPages pages, int node);
+void HDCPFree(void *p);
+
+/* The pages p was actually given */
+HDCPPages HDCPAllocPages(const void *p);
+
+/* The pages the library allocates with: HDCP_PAGES_THP, unless the
+   environment variable HDCP_PAGES is 1g, 2m, thp or 4k */
+HDCPPages HDCPDefaultPages(void);
+
+/* The name of pages ("1g", "2m", "thp" or "4k"), and the reverse,
+   which returns -1 for a name it doesn't know */
+const char *HDCPPagesName(HDCPPages pages);
+int HDCPFindPages(const char *name);
+
+/* The number of NUMA nodes this process may use, the id of the i'th
+   of them (mod their number; ids can have gaps), and the node the
+   calling thread is running on */
+int HDCPNodes(void);
+int HDCPNode(int i);
+int HDCPCurrentNode(void);
+
+/* Run the calling thread only on the CPUs of node.  Returns 0, or -1
+   if it can't (in which case it runs where it did before). */
+int HDCPBindThread(int node);
+
+/* Output that takes more than this many bytes would mostly be evicted
+   from the cache before anything reads it, so the bit-sliced engines'
+   FrameStream writes it with non-temporal stores, which skip reading
+   each cache line in before overwriting it.  The default is the size
+   of the last-level cache, or the environment variable
+   HDCP_STREAM_BYTES (0 to always stream, -1 never). */
+size_t HDCPStreamingBytes(void);
+void HDCPSetStreamingBytes(size_t bytes);
+
+#endif /* __HDCP_MEM_H__ */
@@ -0,0 +1,305 @@
+/************************************************************
+ * A three-stage pipeline that keeps the stream cipher output for the
+ * next batches of frames ready before the caller needs it.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "hdcp_pipeline.h"
+#include "hdcp_mem.h"
+
+/* A batch and the cipher state stage one leaves for stage two */
+typedef struct _HDCPPipelineSlot
+{
+  HDCPPipelineBatch batch;
+  HDCPCipherState *hs;
+} HDCPPipelineSlot;
+
+/* Tries at popping an empty ring before yielding the CPU between
+   tries, and then before going to sleep until the next push */
+#define RING_SPINS  64
+#define RING_YIELDS 64
+
+/* A single-producer, single-consumer ring of slots.  The producer only
+   writes tail and the consumer only writes head, each on its own cache
+   line.  Every ring can hold all depth slots, so a push never fails.
+   A consumer that has waited a while sets waiting and sleeps on
+   nonempty, and the producer only takes the lock to wake it then. */
+typedef struct _HDCPRing
+{
+  _Alignas(64) atomic_ulong head;
+  _Alignas(64) atomic_ulong tail;
+  _Alignas(64) int size;
+  HDCPPipelineSlot **slots;
+  atomic_int waiting;
+  pthread_mutex_t lock;
+  pthread_cond_t nonempty;
+} HDCPRing;
+
+struct _HDCPPipeline
+{
+  const HDCPEngine *e;
+  int height, width, depth, nframes;
+  int node;         /* of the buffers and both stages' threads */
+  uint64_t Ks, REPEATER, Mi0;
+
+  HDCPPipelineSlot *slots;
+  HDCPRing empty;   /* caller -> stage one */
+  HDCPRing keyed;   /* stage one -> stage two */
+  HDCPRing ready;   /* stage two -> caller */
+
+  atomic_int stop;
+  pthread_t threads[2];
+  int started[2];
+};
+
+static void RingWake(HDCPRing *r)
+{
+  pthread_mutex_lock(&r->lock);
+  pthread_cond_signal(&r->nonempty);
+  pthread_mutex_unlock(&r->lock);
+}
+
+static void RingPush(HDCPRing *r, HDCPPipelineSlot *s)
+{
+  unsigned long t = atomic_load_explicit(&r->tail, memory_order_relaxed);
+
+  r->slots[t % r->size] = s;
+  atomic_store_explicit(&r->tail, t + 1, memory_order_release);
+  /* Pairs with the fence in RingWait: either the consumer sees the new
+     tail, or we see it waiting */
+  atomic_thread_fence(memory_order_seq_cst);
+  if (atomic_load_explicit(&r->waiting, memory_order_relaxed))
+    RingWake(r);
+}
+
+static HDCPPipelineSlot *RingPop(HDCPRing *r)
+{
+  unsigned long h = atomic_load_explicit(&r->head, memory_order_relaxed);
+  HDCPPipelineSlot *s;
+
+  if (h == atomic_load_explicit(&r->tail, memory_order_acquire))
+    return NULL;
+  s = r->slots[h % r->size];
+  atomic_store_explicit(&r->head, h + 1, memory_order_release);
+  return s;
+}
+
+/* Pop the next slot, spinning briefly, then yielding the CPU, and then
+   sleeping until the next push while the ring is empty.  Returns NULL
+   once the pipeline is stopped. */
+static HDCPPipelineSlot *RingWait(HDCPPipeline *p, HDCPRing *r)
+{
+  HDCPPipelineSlot *s;
+  int tries;
+
+  for (tries = 0; tries < RING_SPINS + RING_YIELDS; tries++) {
+    if ((s = RingPop(r)))
+      return s;
+    if (atomic_load_explicit(&p->stop, memory_order_relaxed))
+      return NULL;
+    if (tries >= RING_SPINS)
+      sched_yield();
+  }
+
+  pthread_mutex_lock(&r->lock);
+  atomic_store_explicit(&r->waiting, 1, memory_order_relaxed);
+  atomic_thread_fence(memory_order_seq_cst);
+  while (!(s = RingPop(r)) && !atomic_load(&p->stop))
+    pthread_cond_wait(&r->nonempty, &r->lock);
+  atomic_store_explicit(&r->waiting, 0, memory_order_relaxed);
+  pthread_mutex_unlock(&r->lock);
+  return s;
+}
+
+static void *StageKeys(void *arg)
+{
+  HDCPPipeline *p = arg;
+  HDCPPipelineSlot *s;
+
+  HDCPBindThread(p->node);
+  while ((s = RingWait(p, &p->empty))) {
+    HDCPPipelineBatch *b = &s->batch;
+
+    p->e->InitializeMultiFrameState(b->nframes, p->Ks, p->REPEATER, p->Mi0,
+                                    s->hs, b->Ki, b->Ri, b->Mi);
+    p->Mi0 = b->Mi[b->nframes-1];
+    RingPush(&p->keyed, s);
+  }
+  return NULL;
+}
+
+static void *StageStream(void *arg)
+{
+  HDCPPipeline *p = arg;
+  HDCPPipelineSlot *s;
+
+  HDCPBindThread(p->node);
+  while ((s = RingWait(p, &p->keyed))) {
+    HDCPPipelineBatch *b = &s->batch;
+
+    p->e->FrameStream(b->nframes, p->height, p->width, s->hs, b->outputs);
+    RingPush(&p->ready, s);
+  }
+  return NULL;
+}
+
+static int RingInit(HDCPRing *r, int size)
+{
+  atomic_init(&r->head, 0);
+  atomic_init(&r->tail, 0);
+  atomic_init(&r->waiting, 0);
+  r->size = size;
+  if (!(r->slots = calloc(size, sizeof(*r->slots))))
+    return 0;
+  pthread_mutex_init(&r->lock, NULL);
+  pthread_cond_init(&r->nonempty, NULL);
+  return 1;
+}
+
+static void RingFree(HDCPRing *r)
+{
+  if (!r->slots)
+    return;
+  pthread_cond_destroy(&r->nonempty);
+  pthread_mutex_destroy(&r->lock);
+  free(r->slots);
+}
+
+HDCPPipeline *HDCPNewPipeline(const HDCPEngine *e, int depth, size_t max_bytes,
+                              int height, int width,
+                              uint64_t Ks, uint64_t REPEATER, uint64_t Mi0)
+{
+  size_t frame_bytes = sizeof(uint32_t) * height * width + 3 * sizeof(uint64_t);
+  HDCPPipeline *p;
+  int nframes = e->lanes;
+  int i;
+
+  if (depth < 2)
+    return NULL;
+  if (max_bytes) {
+    size_t per_slot = max_bytes / depth;
+
+    if (per_slot <= e->state_size)
+      return NULL;
+    if ((per_slot - e->state_size) / frame_bytes < (size_t)nframes)
+      nframes = (per_slot - e->state_size) / frame_bytes;
+    if (nframes < 1)
+      return NULL;
+  }
+
+  if (posix_memalign((void **)&p, __alignof__(HDCPPipeline), sizeof(*p)))
+    return NULL;
+  memset(p, 0, sizeof(*p));
+  p->e = e;
+  p->height = height;
+  p->width = width;
+  p->depth = depth;
+  p->nframes = nframes;
+  p->node = HDCPCurrentNode();
+  p->Ks = Ks;
+  p->REPEATER = REPEATER;
+  p->Mi0 = Mi0;
+  atomic_init(&p->stop, 0);
+
+  if (!(p->slots = calloc(depth, sizeof(*p->slots))) ||
+      !RingInit(&p->empty, depth) || !RingInit(&p->keyed, depth) || !RingInit(&p->ready, depth))
+    goto fail;
+
+  for (i = 0; i < depth; i++) {
+    HDCPPipelineSlot *s = &p->slots[i];
+
+    s->batch.nframes = nframes;
+    s->batch.outputs = HDCPAlloc(sizeof(uint32_t) * height * width * nframes,
+                                 HDCPDefaultPages(), p->node);
+    s->batch.Ki = malloc(nframes * sizeof(uint64_t));
+    s->batch.Ri = malloc(nframes * sizeof(uint64_t));
+    s->batch.Mi = malloc(nframes * sizeof(uint64_t));
+    s->hs = HDCPNewCipherStateOnNode(e, p->node);
+    if (!s->batch.outputs || !s->batch.Ki || !s->batch.Ri || !s->batch.Mi || !s->hs)
+      goto fail;
+    RingPush(&p->empty, s);
+  }
+
+  if (pthread_create(&p->threads[0], NULL, StageKeys, p))
+    goto fail;
+  p->started[0] = 1;
+  if (pthread_create(&p->threads[1], NULL, StageStream, p))
+    goto fail;
+  p->started[1] = 1;
+
+  return p;
+
+ fail:
+  HDCPFreePipeline(p);
+  return NULL;
+}
+
+void HDCPFreePipeline(HDCPPipeline *p)
+{
+  int i;
+
+  atomic_store(&p->stop, 1);
+  if (p->empty.slots)
+    RingWake(&p->empty);
+  if (p->keyed.slots)
+    RingWake(&p->keyed);
+  for (i = 0; i < 2; i++)
+    if (p->started[i])
+      pthread_join(p->threads[i], NULL);
+
+  if (p->slots)
+    for (i = 0; i < p->depth; i++) {
+      HDCPFree(p->slots[i].batch.outputs);
+      free(p->slots[i].batch.Ki);
+      free(p->slots[i].batch.Ri);
+      free(p->slots[i].batch.Mi);
+      HDCPFreeCipherState(p->slots[i].hs);
+    }
+
+  RingFree(&p->empty);
+  RingFree(&p->keyed);
+  RingFree(&p->ready);
+  free(p->slots);
+  free(p);
+}
+
+int HDCPPipelineFrames(HDCPPipeline *p)
+{
+  return p->nframes;
+}
+
+HDCPPipelineBatch *HDCPPipelineNext(HDCPPipeline *p)
+{
+  HDCPPipelineSlot *s = RingWait(p, &p->ready);
+
+  return s ? &s->batch : NULL;
+}
+
+void HDCPPipelineRelease(HDCPPipeline *p, HDCPPipelineBatch *batch)
+{
+  /* batch is the first member of its slot */
+  RingPush(&p->empty, (HDCPPipelineSlot *)batch);
+}
+
+void HDCPPipelineXor(HDCPPipeline *p, HDCPPipelineBatch *batch, uint32_t **frames, int pitch)
+{
+  const uint32_t *out = batch->outputs;
+  int n = batch->nframes;
+  int line, x, i;
+
+  for (line = 0; line < p->height; line++)
+    for (i = 0; i < n; i++) {
+      uint32_t *dst = (uint32_t *)((char *)frames[i] + (size_t)line * pitch);
+      const uint32_t *src = out + (size_t)line * p->width * n + i;
+
+      for (x = 0; x < p->width; x++)
+        dst[x] ^= src[(size_t)x * n];
+    }
+}
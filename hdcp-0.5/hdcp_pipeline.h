@@ -0,0 +1,66 @@
+/************************************************************
+ * A three-stage pipeline that keeps the stream cipher output for the
+ * next batches of frames ready before the caller needs it.
+ *
+ * Stage one walks the Mi chain and sets up the frame keys for a batch
+ * (HDCPInitializeMultiFrameState), stage two generates its stream
+ * cipher output (HDCPFrameStream), and stage three is the caller, who
+ * xors it into the video.  Stages one and two run on their own threads
+ * and the stages pass batches to each other through single-producer,
+ * single-consumer lock-free rings, so while the caller is busy with
+ * batch N, batch N+1 is being generated and batch N+2 keyed.  A stage
+ * with nothing to do spins for a moment and then sleeps until it has,
+ * so an idle or backed-up pipeline doesn't keep CPUs busy.
+ *
+ * The output buffers are allocated with HDCPAlloc() on the NUMA node
+ * of the thread that creates the pipeline, and both stages run there.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#ifndef __HDCP_PIPELINE_H__
+#define __HDCP_PIPELINE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hdcp_engine.h"
+
+typedef struct _HDCPPipeline HDCPPipeline;
+
+/* A batch of consecutive frames handed to the caller.  outputs is laid
+   out as in HDCPFrameStream, i.e. outputs[(line*width + x)*nframes + i]
+   is the output for pixel x of line in frame i. */
+typedef struct _HDCPPipelineBatch
+{
+  int nframes;
+  uint32_t *outputs;
+  uint64_t *Ki, *Ri, *Mi;
+} HDCPPipelineBatch;
+
+/* Create a pipeline for height x width frames using engine e, starting
+   from Mi0 just like HDCPInitializeMultiFrameState.  depth (>= 2)
+   batches are cycled through the stages.  Each batch has e->lanes
+   frames, or fewer if that is needed to keep the batches within
+   max_bytes of memory (0 for no limit).  Returns NULL on failure,
+   including when not even one frame per batch fits. */
+HDCPPipeline *HDCPNewPipeline(const HDCPEngine *e, int depth, size_t max_bytes,
+                              int height, int width,
+                              uint64_t Ks, uint64_t REPEATER, uint64_t Mi0);
+
+/* Stop the stage threads and free the pipeline and all its batches */
+void HDCPFreePipeline(HDCPPipeline *p);
+
+/* The number of frames in every batch */
+int HDCPPipelineFrames(HDCPPipeline *p);
+
+/* Wait for the next batch of frames.  The caller owns it until it is
+   handed back with HDCPPipelineRelease, and may hold several at once. */
+HDCPPipelineBatch *HDCPPipelineNext(HDCPPipeline *p);
+void HDCPPipelineRelease(HDCPPipeline *p, HDCPPipelineBatch *batch);
+
+/* xor the outputs of batch into frames[0..batch->nframes-1], where
+   pitch is the distance in bytes between lines of a frame */
+void HDCPPipelineXor(HDCPPipeline *p, HDCPPipelineBatch *batch, uint32_t **frames, int pitch);
+
+#endif /* __HDCP_PIPELINE_H__ */
@@ -0,0 +1,257 @@
+/************************************************************
+ * A pool of worker threads that encrypt/decrypt consecutive batches
+ * of frames in parallel.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "hdcp_scalar.h"
+#include "hdcp_pool.h"
+#include "hdcp_mem.h"
+
+typedef struct _HDCPPoolBatch
+{
+  int nframes, pitch, done;
+  uint64_t Mi0;
+  uint32_t **frames;
+  uint64_t *Ki, *Ri, *Mi;
+} HDCPPoolBatch;
+
+/* Each worker thread owns one cipher state, on the NUMA node it runs
+   on.  Workers are spread over the nodes in turn. */
+typedef struct _HDCPPoolWorker
+{
+  HDCPPool *pool;
+  HDCPCipherState *hs;
+  int node;
+  pthread_t thread;
+  int started;
+} HDCPPoolWorker;
+
+/* Batches live in a ring of depth slots.  Slots head..tail-1 are
+   outstanding, and next..tail-1 haven't been picked up by a worker
+   yet.  Only the submitting thread touches Mi0 and the slots outside
+   head..tail-1. */
+struct _HDCPPool
+{
+  const HDCPEngine *e;
+  int height, width, depth, nthreads;
+  uint64_t Ks, REPEATER, Mi0;
+  HDCPPoolBatch *batches;
+  long head, next, tail;
+  int shutdown;
+  pthread_mutex_t lock;
+  pthread_cond_t work, finished;
+  HDCPPoolWorker *workers;
+};
+
+/* Same as HDCPInitializeMultiFrameState followed by HDCPFrameStreamXor,
+   except that the Mi chain has already been computed */
+static void RunBatch(HDCPPool *pool, HDCPCipherState *hs, HDCPPoolBatch *b)
+{
+  const HDCPEngine *e = pool->e;
+  uint64_t Ks_[b->nframes], REPEATER_[b->nframes], Mi_[b->nframes];
+  int i;
+
+  for (i = 0; i < b->nframes; i++) {
+    Ks_[i] = pool->Ks;
+    REPEATER_[i] = pool->REPEATER;
+  }
+
+  /* A single frame starts from Mi0 itself, see HDCPInitializeMultiFrameState */
+  e->BlockCipher(b->nframes, Ks_, REPEATER_, b->nframes == 1 ? &b->Mi0 : b->Mi,
+                 hs, b->Ki, b->Ri, Mi_);
+  e->FrameStreamXor(b->nframes, pool->height, pool->width, hs, b->frames, b->pitch);
+}
+
+static void *PoolWorker(void *arg)
+{
+  HDCPPoolWorker *w = arg;
+  HDCPPool *pool = w->pool;
+  HDCPPoolBatch *b;
+
+  HDCPBindThread(w->node);
+  pthread_mutex_lock(&pool->lock);
+  for (;;) {
+    while (pool->next == pool->tail && !pool->shutdown)
+      pthread_cond_wait(&pool->work, &pool->lock);
+    if (pool->next == pool->tail)
+      break;
+    b = &pool->batches[pool->next++ % pool->depth];
+    pthread_mutex_unlock(&pool->lock);
+
+    RunBatch(pool, w->hs, b);
+
+    pthread_mutex_lock(&pool->lock);
+    b->done = 1;
+    pthread_cond_broadcast(&pool->finished);
+  }
+  pthread_mutex_unlock(&pool->lock);
+
+  return NULL;
+}
+
+HDCPPool *HDCPNewPool(const HDCPEngine *e, int nthreads, int depth, int height, int width,
+                      uint64_t Ks, uint64_t REPEATER, uint64_t Mi0)
+{
+  HDCPPool *pool;
+  int i;
+
+  if (nthreads <= 0)
+    nthreads = sysconf(_SC_NPROCESSORS_ONLN);
+  if (nthreads <= 0)
+    nthreads = 1;
+  if (depth <= 0)
+    return NULL;
+
+  if (!(pool = calloc(1, sizeof(*pool))))
+    return NULL;
+  pool->e = e;
+  pool->height = height;
+  pool->width = width;
+  pool->depth = depth;
+  pool->nthreads = nthreads;
+  pool->Ks = Ks;
+  pool->REPEATER = REPEATER;
+  pool->Mi0 = Mi0;
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->work, NULL);
+  pthread_cond_init(&pool->finished, NULL);
+
+  pool->batches = calloc(depth, sizeof(HDCPPoolBatch));
+  pool->workers = calloc(nthreads, sizeof(HDCPPoolWorker));
+  if (!pool->batches || !pool->workers)
+    goto fail;
+
+  for (i = 0; i < depth; i++) {
+    HDCPPoolBatch *b = &pool->batches[i];
+
+    b->frames = malloc(e->lanes * sizeof(*b->frames));
+    b->Ki = malloc(e->lanes * sizeof(*b->Ki));
+    b->Ri = malloc(e->lanes * sizeof(*b->Ri));
+    b->Mi = malloc(e->lanes * sizeof(*b->Mi));
+    if (!b->frames || !b->Ki || !b->Ri || !b->Mi)
+      goto fail;
+  }
+
+  for (i = 0; i < nthreads; i++) {
+    HDCPPoolWorker *w = &pool->workers[i];
+
+    w->pool = pool;
+    w->node = HDCPNode(i);
+    if (!(w->hs = HDCPNewCipherStateOnNode(e, w->node)))
+      goto fail;
+    if (pthread_create(&w->thread, NULL, PoolWorker, w))
+      goto fail;
+    w->started = 1;
+  }
+
+  return pool;
+
+ fail:
+  HDCPFreePool(pool);
+  return NULL;
+}
+
+void HDCPFreePool(HDCPPool *pool)
+{
+  int i;
+
+  while (HDCPPoolWait(pool, NULL, NULL, NULL, NULL))
+    ;
+
+  pthread_mutex_lock(&pool->lock);
+  pool->shutdown = 1;
+  pthread_cond_broadcast(&pool->work);
+  pthread_mutex_unlock(&pool->lock);
+
+  if (pool->workers)
+    for (i = 0; i < pool->nthreads; i++) {
+      if (pool->workers[i].started)
+        pthread_join(pool->workers[i].thread, NULL);
+      HDCPFreeCipherState(pool->workers[i].hs);
+    }
+
+  if (pool->batches)
+    for (i = 0; i < pool->depth; i++) {
+      free(pool->batches[i].frames);
+      free(pool->batches[i].Ki);
+      free(pool->batches[i].Ri);
+      free(pool->batches[i].Mi);
+    }
+
+  pthread_cond_destroy(&pool->finished);
+  pthread_cond_destroy(&pool->work);
+  pthread_mutex_destroy(&pool->lock);
+  free(pool->workers);
+  free(pool->batches);
+  free(pool);
+}
+
+int HDCPPoolSubmit(HDCPPool *pool, int nframes, uint32_t **frames, int pitch)
+{
+  HDCPPoolBatch *b;
+  int full;
+
+  if (nframes < 1 || nframes > pool->e->lanes)
+    return -1;
+
+  pthread_mutex_lock(&pool->lock);
+  full = pool->tail - pool->head >= pool->depth;
+  pthread_mutex_unlock(&pool->lock);
+  if (full)
+    return -1;
+
+  b = &pool->batches[pool->tail % pool->depth];
+  b->nframes = nframes;
+  b->pitch = pitch;
+  b->done = 0;
+  b->Mi0 = pool->Mi0;
+  memcpy(b->frames, frames, nframes * sizeof(*frames));
+  HDCPScalarMiChain(nframes, pool->Ks, pool->REPEATER, pool->Mi0, b->Mi);
+  pool->Mi0 = b->Mi[nframes-1];
+
+  pthread_mutex_lock(&pool->lock);
+  pool->tail++;
+  pthread_cond_signal(&pool->work);
+  pthread_mutex_unlock(&pool->lock);
+
+  return 0;
+}
+
+int HDCPPoolWait(HDCPPool *pool, uint32_t **frames, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi)
+{
+  HDCPPoolBatch *b;
+  int n;
+
+  pthread_mutex_lock(&pool->lock);
+  if (pool->head == pool->tail) {
+    pthread_mutex_unlock(&pool->lock);
+    return 0;
+  }
+  b = &pool->batches[pool->head % pool->depth];
+  while (!b->done)
+    pthread_cond_wait(&pool->finished, &pool->lock);
+  pthread_mutex_unlock(&pool->lock);
+
+  n = b->nframes;
+  if (frames)
+    memcpy(frames, b->frames, n * sizeof(*frames));
+  if (Ki)
+    memcpy(Ki, b->Ki, n * sizeof(*Ki));
+  if (Ri)
+    memcpy(Ri, b->Ri, n * sizeof(*Ri));
+  if (Mi)
+    memcpy(Mi, b->Mi, n * sizeof(*Mi));
+
+  pthread_mutex_lock(&pool->lock);
+  pool->head++;
+  pthread_mutex_unlock(&pool->lock);
+
+  return n;
+}
@@ -0,0 +1,49 @@
+/************************************************************
+ * A pool of worker threads that encrypt/decrypt consecutive batches
+ * of frames in parallel.
+ *
+ * Once the Mi chain is known, every batch of frames is independent,
+ * so the pool computes the chain (cheaply, with the scalar cipher) as
+ * batches are submitted, and lets each worker thread xor a whole
+ * batch with its own cipher state.  Batches are returned in the order
+ * they were submitted.
+ *
+ * Workers are spread over the NUMA nodes in turn, each running on its
+ * node with its cipher state there (hdcp_mem.h).  The frames are the
+ * caller's; HDCPAlloc() can put them on a given node.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#ifndef __HDCP_POOL_H__
+#define __HDCP_POOL_H__
+
+#include <stdint.h>
+#include "hdcp_engine.h"
+
+typedef struct _HDCPPool HDCPPool;
+
+/* Create a pool of nthreads workers (one per CPU if nthreads <= 0)
+   using engine e, with room for depth batches in flight.  Frames are
+   height x width, and the first batch starts from Mi0, just like
+   HDCPInitializeMultiFrameState.  Returns NULL on failure. */
+HDCPPool *HDCPNewPool(const HDCPEngine *e, int nthreads, int depth, int height, int width,
+                      uint64_t Ks, uint64_t REPEATER, uint64_t Mi0);
+
+/* Wait for all outstanding batches, then destroy the pool */
+void HDCPFreePool(HDCPPool *pool);
+
+/* Queue the next nframes (1..e->lanes) frames to be xored in place
+   with the stream cipher output, as HDCPFrameStreamXor would.  Returns
+   0, or -1 if nframes is out of range or depth batches are already
+   outstanding, in which case HDCPPoolWait must be called first. */
+int HDCPPoolSubmit(HDCPPool *pool, int nframes, uint32_t **frames, int pitch);
+
+/* Wait for the oldest outstanding batch to finish.  Its frame pointers
+   and the Ki, Ri and Mi of each frame are copied to the arrays that
+   are not NULL.  Returns the number of frames in the batch, or 0 if
+   none are outstanding. */
+int HDCPPoolWait(HDCPPool *pool, uint32_t **frames, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi);
+
+#endif /* __HDCP_POOL_H__ */
@@ -0,0 +1,153 @@
+/************************************************************
+ * Optional cycle accounting for the stages of the cipher.
+ *
+ * Every thread that runs an instrumented stage gets a block of counts
+ * on a global list.  When the thread exits, its counts are added to
+ * the counts of the threads that came before it and the block is
+ * freed.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "hdcp_profile.h"
+
+static const char *stage_names[HDCP_NSTAGES] = {
+  "block module",
+  "lfsr clock",
+  "output function",
+  "round kernels",
+  "transpose",
+  "xor",
+  "rekey",
+  "Mi chain",
+};
+
+int HDCPProfileEnabled(void)
+{
+#ifdef HDCP_PROFILE
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+const char *HDCPStageName(int stage)
+{
+  return stage >= 0 && stage < HDCP_NSTAGES ? stage_names[stage] : "?";
+}
+
+#ifdef HDCP_PROFILE
+
+typedef struct _HDCPProfileThread
+{
+  HDCPStageCount counts[HDCP_NSTAGES];
+  struct _HDCPProfileThread *next, **prev;
+} HDCPProfileThread;
+
+_Thread_local HDCPStageCount *HDCPProfileCounts;
+
+static pthread_mutex_t profile_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t profile_once = PTHREAD_ONCE_INIT;
+static pthread_key_t profile_key;
+static HDCPProfileThread *profile_threads;
+static HDCPStageCount profile_exited[HDCP_NSTAGES];
+
+static void ThreadExit(void *arg)
+{
+  HDCPProfileThread *t = arg;
+  int i;
+
+  pthread_mutex_lock(&profile_lock);
+  for (i = 0; i < HDCP_NSTAGES; i++) {
+    profile_exited[i].cycles += t->counts[i].cycles;
+    profile_exited[i].calls += t->counts[i].calls;
+  }
+  if (t->next)
+    t->next->prev = t->prev;
+  *t->prev = t->next;
+  pthread_mutex_unlock(&profile_lock);
+  free(t);
+}
+
+static void MakeKey(void)
+{
+  pthread_key_create(&profile_key, ThreadExit);
+}
+
+HDCPStageCount *HDCPProfileRegister(void)
+{
+  /* If there is no memory, count into a block nobody reads */
+  static _Thread_local HDCPStageCount fallback[HDCP_NSTAGES];
+  HDCPProfileThread *t = calloc(1, sizeof(*t));
+
+  if (!t)
+    return HDCPProfileCounts = fallback;
+
+  pthread_once(&profile_once, MakeKey);
+  pthread_mutex_lock(&profile_lock);
+  t->next = profile_threads;
+  t->prev = &profile_threads;
+  if (profile_threads)
+    profile_threads->prev = &t->next;
+  profile_threads = t;
+  pthread_mutex_unlock(&profile_lock);
+  pthread_setspecific(profile_key, t);
+
+  return HDCPProfileCounts = t->counts;
+}
+
+void HDCPProfileThreadCounts(HDCPStageCount counts[HDCP_NSTAGES])
+{
+  if (HDCPProfileCounts)
+    memcpy(counts, HDCPProfileCounts, HDCP_NSTAGES * sizeof(*counts));
+  else
+    memset(counts, 0, HDCP_NSTAGES * sizeof(*counts));
+}
+
+void HDCPProfileTotalCounts(HDCPStageCount counts[HDCP_NSTAGES])
+{
+  HDCPProfileThread *t;
+  int i;
+
+  pthread_mutex_lock(&profile_lock);
+  memcpy(counts, profile_exited, sizeof(profile_exited));
+  for (t = profile_threads; t; t = t->next)
+    for (i = 0; i < HDCP_NSTAGES; i++) {
+      counts[i].cycles += t->counts[i].cycles;
+      counts[i].calls += t->counts[i].calls;
+    }
+  pthread_mutex_unlock(&profile_lock);
+}
+
+void HDCPProfileReset(void)
+{
+  HDCPProfileThread *t;
+
+  pthread_mutex_lock(&profile_lock);
+  memset(profile_exited, 0, sizeof(profile_exited));
+  for (t = profile_threads; t; t = t->next)
+    memset(t->counts, 0, sizeof(t->counts));
+  pthread_mutex_unlock(&profile_lock);
+}
+
+#else
+
+void HDCPProfileThreadCounts(HDCPStageCount counts[HDCP_NSTAGES])
+{
+  memset(counts, 0, HDCP_NSTAGES * sizeof(*counts));
+}
+
+void HDCPProfileTotalCounts(HDCPStageCount counts[HDCP_NSTAGES])
+{
+  memset(counts, 0, HDCP_NSTAGES * sizeof(*counts));
+}
+
+void HDCPProfileReset(void)
+{
+}
+
+#endif /* HDCP_PROFILE */
@@ -0,0 +1,109 @@
+/************************************************************
+ * Optional cycle accounting for the stages of the cipher.
+ *
+ * When the library is compiled with -DHDCP_PROFILE (make PROFILE=1),
+ * hdcp_cipher.c reads the cycle counter around each stage of the
+ * cipher and adds the elapsed cycles and a call to that stage's count.
+ * Counts are kept per thread, so the hot path takes no locks, and
+ * threads that exit fold theirs into a running total.  Without
+ * HDCP_PROFILE the instrumentation compiles to nothing and the
+ * counts stay at zero.
+ *
+ * The stages do not nest: the unrolled round kernels (HDCP_STAGE_ROUNDS)
+ * do the work of the block module, the LFSRs and the output function
+ * in one piece, so those three stages only count the single rounds
+ * taken outside the kernels, and rekeying is counted as a whole.
+ *
+ * On x86 the counts are TSC ticks; elsewhere they are nanoseconds.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#ifndef __HDCP_PROFILE_H__
+#define __HDCP_PROFILE_H__
+
+#include <stdint.h>
+
+typedef enum _HDCPStage
+{
+  HDCP_STAGE_BLOCK_MODULE,   /* BS_BlockModule */
+  HDCP_STAGE_LFSR,           /* BS_LFSRModule_clock */
+  HDCP_STAGE_OUTPUT,         /* BS_OutputFunction */
+  HDCP_STAGE_ROUNDS,         /* unrolled round kernels */
+  HDCP_STAGE_TRANSPOSE,      /* BitSlice24, BitSlice, BitUnslice */
+  HDCP_STAGE_XOR,            /* xoring output into lines */
+  HDCP_STAGE_REKEY,          /* HDCPRekeycipher */
+  HDCP_STAGE_MI_CHAIN,       /* the Mi chain in HDCPInitializeMultiFrameState */
+  HDCP_NSTAGES
+} HDCPStage;
+
+typedef struct _HDCPStageCount
+{
+  uint64_t cycles, calls;
+} HDCPStageCount;
+
+/* 1 if the library was compiled with HDCP_PROFILE */
+int HDCPProfileEnabled(void);
+
+/* A short name for stage, for printing */
+const char *HDCPStageName(int stage);
+
+/* Copy out the counts of the calling thread */
+void HDCPProfileThreadCounts(HDCPStageCount counts[HDCP_NSTAGES]);
+
+/* Copy out the sum of the counts of all threads, including those that
+   have exited.  Threads that are still running may be mid-update. */
+void HDCPProfileTotalCounts(HDCPStageCount counts[HDCP_NSTAGES]);
+
+/* Zero the counts of all threads.  Only exact while no other thread is
+   inside the cipher. */
+void HDCPProfileReset(void);
+
+#ifdef HDCP_PROFILE
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static inline uint64_t HDCPProfileClock(void)
+{
+  return __rdtsc();
+}
+#else
+#include <time.h>
+static inline uint64_t HDCPProfileClock(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+#endif
+
+/* The calling thread's counts, set up on first use */
+extern _Thread_local HDCPStageCount *HDCPProfileCounts;
+HDCPStageCount *HDCPProfileRegister(void);
+
+static inline void HDCPProfileAdd(HDCPStage stage, uint64_t cycles)
+{
+  HDCPStageCount *c = HDCPProfileCounts;
+
+  if (!c)
+    c = HDCPProfileRegister();
+  c[stage].cycles += cycles;
+  c[stage].calls++;
+}
+
+/* Run the statement(s) and charge the time they take to stage */
+#define HDCP_TIMED(stage, ...) do {                                 \
+    uint64_t hdcp_profile_start_ = HDCPProfileClock();               \
+    __VA_ARGS__;                                                     \
+    HDCPProfileAdd(stage, HDCPProfileClock() - hdcp_profile_start_); \
+  } while (0)
+
+#else
+
+#define HDCP_TIMED(stage, ...) do { __VA_ARGS__; } while (0)
+
+#endif /* HDCP_PROFILE */
+
+#endif /* __HDCP_PROFILE_H__ */
@@ -0,0 +1,642 @@
+/************************************************************
+ * A scalar (one copy at a time) implementation of the HDCP cipher.
+ *
+ * The bit-sliced code in hdcp_cipher.c costs the same whether it
+ * computes 1 or 64 copies of the cipher, which is a waste for inherently
+ * serial work like walking the Mi chain.  This version keeps each
+ * register in a single word and evaluates the S-boxes, diffusion
+ * networks and output function with table lookups.  The tables are
+ * built by running the bit-sliced primitives, so the two
+ * implementations can't disagree.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#include <assert.h>
+#include <string.h>
+#include <pthread.h>
+#include "hdcp_cipher.h"
+#include "hdcp_scalar.h"
+#include "hdcp_engine.h"
+
+/* Where bit j of a register lives in the packed word */
+#define SC_BIT(j) (4*((j) % 7) + (j) / 7)
+
+#define SC_MASK28 ((UINT32_C(1) << 28) - 1)
+
+/* Output function, same as BS_OutputTable in hdcp_cipher.c */
+static const unsigned char SC_OutputTable[24][16] =
+  {
+    {17, 26, 22, 27, 21, 18,  2,  5,  3,  6,  0,  9,  4, 22,  5, 10},
+    { 5, 20, 15, 24,  2, 25,  0, 16, 20, 18,  7, 23, 15,  5,  3, 25},
+    {22,  5, 14, 16, 25, 17, 20, 11,  7, 19,  2, 10, 22,  4, 13, 21},
+    {19,  3, 15, 11, 21, 16, 27,  1,  6, 14,  9,  8, 17, 18, 12, 24},
+
+    {19,  6, 17, 18, 22,  7,  9, 12, 25,  6,  5,  2, 10, 15, 21,  8},
+    { 3,  7,  4,  8, 16,  6,  5, 17, 27, 14,  2,  4, 24, 19,  1, 12},
+    { 8, 21, 27,  2, 11, 24, 12,  3, 17, 26,  4, 16, 27,  7, 22, 11},
+    { 9,  5,  7,  4,  8, 13,  3, 15,  9, 10, 19, 11,  7,  6,  8, 23},
+
+    {26, 13, 23, 10, 11,  7, 15, 19, 13, 12, 18, 24, 15, 23,  7, 16},
+    { 1,  0, 19, 11, 13, 16, 24, 18,  0,  5, 20, 25,  1, 24,  9, 27},
+    {26, 13,  9, 14, 10,  4,  1,  2, 14, 23, 27, 25, 17, 19,  1, 22},
+    {21, 15,  5,  3, 13, 25, 16, 27,  6, 21, 17, 15, 26, 11, 16,  7},
+
+    {20,  7, 18, 12, 17,  1, 16,  0, 11, 22, 20,  0, 26, 23, 17,  2},
+    {14, 23,  1, 12, 24,  6, 18,  9,  8,  4,  3, 14, 20, 26, 23, 15},
+    {19,  6, 21, 25, 23,  1, 10,  8, 19,  0, 18,  2, 13,  8, 24, 14},
+    { 3,  0, 27, 23, 19,  8,  4,  7, 16, 21, 24, 25, 12, 27, 15, 18},
+
+    { 6,  5, 14, 22, 24, 18,  2, 21,  3,  5,  8, 25,  7, 27,  2, 26},
+    { 3,  4,  2,  6, 22, 14, 12, 26, 11, 14, 23, 17, 22, 13, 19,  4},
+    {25, 21, 19,  9, 10, 15, 13, 22,  1, 16, 14, 11, 12,  6, 10, 19},
+    {23, 11, 10, 20,  1, 12, 14,  4, 21,  1, 10, 20, 18, 26,  9, 13},
+
+    {11, 26, 20, 17,  8, 23,  0, 24, 20, 21,  9, 25, 12,  3, 15,  0},
+    { 9, 17, 26,  4, 27,  0, 15,  6, 18, 12, 21, 27,  1, 16, 24, 20},
+    {22, 12,  2, 10,  7, 20, 25, 13, 13,  0,  3, 16, 22, 11, 26,  9},
+    {27, 24, 26,  8,  0,  9, 18, 23,  2,  0, 13,  5,  4,  8, 10,  3}
+  };
+
+/* LFSR taps and feedbacks, same as BS_LFSRModule_init */
+static const int SC_LFSRLen[4] = { 13, 14, 16, 17 };
+static const int SC_LFSRTaps[4][3] = { { 3, 7, 12 }, { 4, 8, 13 }, { 5, 9, 15 }, { 5, 11, 16 } };
+static const uint32_t SC_LFSRFeedback[4] = {
+  (1 << 4) | (1 << 8) | (1 << 10) | (1 << 12),
+  (1 << 3) | (1 << 5) | (1 << 6) | (1 << 9) | (1 << 10) | (1 << 13),
+  (1 << 4) | (1 << 6) | (1 << 7) | (1 << 11) | (1 << 14) | (1 << 15),
+  (1 << 4) | (1 << 10) | (1 << 14) | (1 << 16)
+};
+
+/* Each S-box table maps one byte (two S-boxes) of a packed register */
+static uint32_t SC_SBoxB[4][256], SC_SBoxK[4][256];
+
+/* The diffusion networks are linear, so they are tabulated one byte of
+   input at a time.  The 56-bit input is z | y << 28, and the output is
+   x | y << 32. */
+static uint64_t SC_DiffuseK[7][256], SC_DiffuseB[7][256];
+static uint32_t SC_DiffuseBKy[4][256];   /* Ky's contribution to Bx */
+
+/* Gathers for the output function.  Word s of SC_OutputBz[b][v] holds,
+   in its low and high halves, the Bz bits used by product terms 2s and
+   2s+1 of every output bit, and likewise for Kz.  By and Ky enter
+   linearly. */
+typedef struct { uint64_t s[4]; } SC_Gather;
+static SC_Gather SC_OutputBz[4][256], SC_OutputKz[4][256];
+static uint32_t SC_OutputBy[4][256], SC_OutputKy[4][256];
+
+static pthread_once_t SC_TablesOnce = PTHREAD_ONCE_INIT;
+
+static uint32_t SC_Pack(uint64_t v)
+{
+  uint32_t r = 0;
+  int j;
+
+  for (j = 0; j < 28; j++)
+    r |= (uint32_t)((v >> j) & 1) << SC_BIT(j);
+  return r;
+}
+
+static uint64_t SC_Unpack(uint32_t r)
+{
+  uint64_t v = 0;
+  int j;
+
+  for (j = 0; j < 28; j++)
+    v |= (uint64_t)((r >> SC_BIT(j)) & 1) << j;
+  return v;
+}
+
+/* Expand per-bit columns of a linear map into per-byte lookup tables */
+static void SC_TabulateLinear(int nbytes, const uint64_t *columns, uint64_t table[][256])
+{
+  int b, v, k;
+
+  for (b = 0; b < nbytes; b++)
+    for (v = 0; v < 256; v++) {
+      table[b][v] = 0;
+      for (k = 0; k < 8; k++)
+        if ((v & (1 << k)) && 8*b + k < 56)
+          table[b][v] ^= columns[8*b + k];
+    }
+}
+
+static void SC_InitSBoxes(void)
+{
+  bsvec_t in[28], outB[28], outK[28];
+  uint32_t sbB[7][16], sbK[7][16];
+  int i, k, v, b;
+
+  /* Lane v of S-box i gets input nibble v */
+  for (i = 0; i < 7; i++)
+    for (k = 0; k < 4; k++) {
+      in[i + 7*k] = 0;
+      for (v = 0; v < 16; v++)
+        if (v & (1 << k))
+          in[i + 7*k] |= UINT64_C(1) << v;
+    }
+  BS_SBoxB(in, outB);
+  BS_SBoxK(in, outK);
+
+  for (i = 0; i < 7; i++)
+    for (v = 0; v < 16; v++) {
+      sbB[i][v] = sbK[i][v] = 0;
+      for (k = 0; k < 4; k++) {
+        sbB[i][v] |= ((outB[i + 7*k] >> v) & 1) << k;
+        sbK[i][v] |= ((outK[i + 7*k] >> v) & 1) << k;
+      }
+    }
+
+  for (b = 0; b < 4; b++)
+    for (v = 0; v < 256; v++) {
+      SC_SBoxB[b][v] = sbB[2*b][v & 0xf] << (8*b);
+      SC_SBoxK[b][v] = sbK[2*b][v & 0xf] << (8*b);
+      if (2*b + 1 < 7) {
+        SC_SBoxB[b][v] |= sbB[2*b + 1][v >> 4] << (8*b + 4);
+        SC_SBoxK[b][v] |= sbK[2*b + 1][v >> 4] << (8*b + 4);
+      }
+    }
+}
+
+static void SC_InitDiffusion(void)
+{
+  bsvec_t z[28], y[28], x[28], ky[28], zero[28];
+  uint64_t colK[56], colB[56], colBKy[28];
+  uint64_t tableBKy[4][256];
+  int j, p, b, v;
+
+  /* Lane p carries packed input bit p: z for p < 28, y for p >= 28 */
+  memset(zero, 0, sizeof(zero));
+  for (j = 0; j < 28; j++) {
+    z[j] = UINT64_C(1) << SC_BIT(j);
+    y[j] = UINT64_C(1) << (28 + SC_BIT(j));
+  }
+
+  BS_DiffuseNetworkK(z, y, x);
+  for (p = 0; p < 56; p++) {
+    colK[p] = 0;
+    for (j = 0; j < 28; j++) {
+      colK[p] |= ((x[j] >> p) & 1) << SC_BIT(j);
+      colK[p] |= ((y[j] >> p) & 1) << (32 + SC_BIT(j));
+    }
+  }
+
+  for (j = 0; j < 28; j++) {
+    z[j] = UINT64_C(1) << SC_BIT(j);
+    y[j] = UINT64_C(1) << (28 + SC_BIT(j));
+  }
+  BS_DiffuseNetworkB(z, y, x, zero);
+  for (p = 0; p < 56; p++) {
+    colB[p] = 0;
+    for (j = 0; j < 28; j++) {
+      colB[p] |= ((x[j] >> p) & 1) << SC_BIT(j);
+      colB[p] |= ((y[j] >> p) & 1) << (32 + SC_BIT(j));
+    }
+  }
+
+  for (j = 0; j < 28; j++)
+    ky[j] = UINT64_C(1) << SC_BIT(j);
+  BS_DiffuseNetworkB(zero, zero, x, ky);
+  for (p = 0; p < 28; p++) {
+    colBKy[p] = 0;
+    for (j = 0; j < 28; j++)
+      colBKy[p] |= ((x[j] >> p) & 1) << SC_BIT(j);
+  }
+
+  SC_TabulateLinear(7, colK, SC_DiffuseK);
+  SC_TabulateLinear(7, colB, SC_DiffuseB);
+  SC_TabulateLinear(4, colBKy, tableBKy);
+  for (b = 0; b < 4; b++)
+    for (v = 0; v < 256; v++)
+      SC_DiffuseBKy[b][v] = tableBKy[b][v];
+}
+
+static void SC_InitOutput(void)
+{
+  int b, v, k, i, j, p;
+
+  for (b = 0; b < 4; b++)
+    for (v = 0; v < 256; v++) {
+      memset(&SC_OutputBz[b][v], 0, sizeof(SC_Gather));
+      memset(&SC_OutputKz[b][v], 0, sizeof(SC_Gather));
+      SC_OutputBy[b][v] = SC_OutputKy[b][v] = 0;
+      for (k = 0; k < 8; k++) {
+        if (!(v & (1 << k)))
+          continue;
+        p = 8*b + k;
+        for (i = 0; i < 24; i++) {
+          for (j = 0; j < 7; j++) {
+            if (SC_BIT(SC_OutputTable[i][j]) == p)
+              SC_OutputBz[b][v].s[j/2] |= UINT64_C(1) << (32*(j & 1) + i);
+            if (SC_BIT(SC_OutputTable[i][j+8]) == p)
+              SC_OutputKz[b][v].s[j/2] |= UINT64_C(1) << (32*(j & 1) + i);
+          }
+          if (SC_BIT(SC_OutputTable[i][7]) == p)
+            SC_OutputBy[b][v] |= UINT32_C(1) << i;
+          if (SC_BIT(SC_OutputTable[i][15]) == p)
+            SC_OutputKy[b][v] |= UINT32_C(1) << i;
+        }
+      }
+    }
+}
+
+static void SC_InitTables(void)
+{
+  SC_InitSBoxes();
+  SC_InitDiffusion();
+  SC_InitOutput();
+}
+
+#define SC_LOOKUP4(t,r) (t[0][(r) & 0xff] ^ t[1][((r) >> 8) & 0xff] ^ \
+                         t[2][((r) >> 16) & 0xff] ^ t[3][(r) >> 24])
+
+static inline uint32_t SC_SBox(const uint32_t table[4][256], uint32_t r)
+{
+  return SC_LOOKUP4(table, r);
+}
+
+static inline uint64_t SC_Diffuse(const uint64_t table[7][256], uint32_t z, uint32_t y)
+{
+  uint64_t v = z | ((uint64_t)y << 28);
+
+  return table[0][v & 0xff] ^ table[1][(v >> 8) & 0xff] ^
+    table[2][(v >> 16) & 0xff] ^ table[3][(v >> 24) & 0xff] ^
+    table[4][(v >> 32) & 0xff] ^ table[5][(v >> 40) & 0xff] ^
+    table[6][v >> 48];
+}
+
+static inline uint32_t SC_OutputFunction(uint32_t Bz, uint32_t By, uint32_t Kz, uint32_t Ky)
+{
+  uint64_t r = 0;
+  int s;
+
+  for (s = 0; s < 4; s++)
+    r ^= (SC_OutputBz[0][Bz & 0xff].s[s] ^ SC_OutputBz[1][(Bz >> 8) & 0xff].s[s] ^
+          SC_OutputBz[2][(Bz >> 16) & 0xff].s[s] ^ SC_OutputBz[3][Bz >> 24].s[s]) &
+         (SC_OutputKz[0][Kz & 0xff].s[s] ^ SC_OutputKz[1][(Kz >> 8) & 0xff].s[s] ^
+          SC_OutputKz[2][(Kz >> 16) & 0xff].s[s] ^ SC_OutputKz[3][Kz >> 24].s[s]);
+
+  return (uint32_t)(r ^ (r >> 32)) ^ SC_LOOKUP4(SC_OutputBy, By) ^ SC_LOOKUP4(SC_OutputKy, Ky);
+}
+
+/* One round of both the B and K round functions (BS_BlockModule) */
+static inline void SC_BlockModule(HDCPScalarCipherState *hs)
+{
+  uint32_t newBz, newKz;
+  uint64_t d;
+
+  newBz = SC_SBox(SC_SBoxB, hs->B[0]);
+  d = SC_Diffuse(SC_DiffuseB, hs->B[2], hs->B[1]);
+  hs->B[0] = (uint32_t)d ^ SC_LOOKUP4(SC_DiffuseBKy, hs->K[1]);
+  hs->B[1] = d >> 32;
+  hs->B[2] = newBz;
+
+  newKz = SC_SBox(SC_SBoxK, hs->K[0]);
+  d = SC_Diffuse(SC_DiffuseK, hs->K[2], hs->K[1]);
+  hs->K[0] = (uint32_t)d;
+  hs->K[1] = d >> 32;
+  hs->K[2] = newKz;
+}
+
+#define SC_LFSRTap(hs,i,j) (((hs)->lfsr[i] >> SC_LFSRTaps[i][j]) & 1)
+
+static inline uint32_t SC_LFSRModule_clock(HDCPScalarCipherState *hs)
+{
+  uint32_t D, S, A, B;
+  int i;
+
+  D = SC_LFSRTap(hs, 0, 0) ^ SC_LFSRTap(hs, 1, 0) ^ SC_LFSRTap(hs, 2, 0) ^ SC_LFSRTap(hs, 3, 0);
+
+  for (i = 0; i < 4; i++) {
+    S = SC_LFSRTap(hs, i, 1);
+    A = (hs->snA >> i) & 1;
+    B = (hs->snB >> i) & 1;
+    hs->snA ^= ((S ? D : B) ^ A) << i;
+    hs->snB ^= ((S ? A : D) ^ B) << i;
+    D = S ? B : A;
+  }
+
+  D ^= SC_LFSRTap(hs, 0, 2) ^ SC_LFSRTap(hs, 1, 2) ^ SC_LFSRTap(hs, 2, 2) ^ SC_LFSRTap(hs, 3, 2);
+
+  for (i = 0; i < 4; i++)
+    hs->lfsr[i] = ((hs->lfsr[i] << 1) | __builtin_parity(hs->lfsr[i] & SC_LFSRFeedback[i]))
+      & ((UINT32_C(1) << SC_LFSRLen[i]) - 1);
+
+  return D;
+}
+
+static void SC_LFSRModule_init(HDCPScalarCipherState *hs, uint64_t input)
+{
+#define IN(i) ((uint32_t)(input >> (i)) & 1)
+  hs->lfsr[0] = ((uint32_t)input & 0xfff) | ((IN(6) ^ 1) << 12);
+  hs->lfsr[1] = ((uint32_t)(input >> 12) & 0x1fff) | ((IN(18) ^ 1) << 13);
+  hs->lfsr[2] = ((uint32_t)(input >> 25) & 0x7fff) | ((IN(32) ^ 1) << 15);
+  hs->lfsr[3] = ((uint32_t)(input >> 40) & 0xffff) | ((IN(47) ^ 1) << 16);
+#undef IN
+  hs->snA = 0;
+  hs->snB = 0xf;
+}
+
+/* BS_HDCPRound, optionally returning the 24-bit output */
+static inline uint32_t SC_HDCPRound(HDCPScalarCipherState *hs, int output)
+{
+  uint32_t result = 0, t;
+
+  if (output)
+    result = SC_OutputFunction(hs->B[2], hs->B[1], hs->K[2], hs->K[1]);
+  SC_BlockModule(hs);
+  t = SC_LFSRModule_clock(hs);
+  if (hs->rekey)
+    hs->K[1] = (hs->K[1] & ~(UINT32_C(1) << SC_BIT(13))) | (t << SC_BIT(13));
+  return result;
+}
+
+static void SC_LoadB(HDCPScalarCipherState *hs, uint64_t REPEATER, uint64_t Bin)
+{
+  hs->B[0] = SC_Pack(Bin & SC_MASK28);
+  hs->B[1] = SC_Pack((Bin >> 28) & SC_MASK28);
+  hs->B[2] = SC_Pack((Bin >> 56) | ((REPEATER & 1) << 8));
+}
+
+void HDCPScalarBlockCipher(uint64_t K_, uint64_t REPEATER, uint64_t Bin,
+                           HDCPScalarCipherState *hs, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi)
+{
+  uint64_t ki, mi;
+  uint32_t output;
+  int i;
+
+  pthread_once(&SC_TablesOnce, SC_InitTables);
+
+  /*  Load initial keys */
+  hs->K[0] = SC_Pack(K_ & SC_MASK28);
+  hs->K[1] = SC_Pack((K_ >> 28) & SC_MASK28);
+  hs->K[2] = 0;
+  SC_LoadB(hs, REPEATER, Bin);
+  hs->rekey = 0;
+
+  /*  48 warm-up rounds */
+  for (i = 0; i < 48; i++)
+    SC_BlockModule(hs);
+
+  ki = SC_Unpack(hs->B[0]) | (SC_Unpack(hs->B[1]) << 28);
+  if (Ki)
+    *Ki = ki;
+
+  /*  Reload */
+  SC_LFSRModule_init(hs, ki);
+  memcpy(hs->K, hs->B, sizeof(hs->K));
+  SC_LoadB(hs, REPEATER, Bin);
+  hs->rekey = 1;
+
+  /*  52 additional rounds */
+  for (i = 0; i < 52; i++)
+    SC_HDCPRound(hs, 0);
+
+  /* Four more rounds, with output to Mi and Ri */
+  mi = (uint64_t)(SC_HDCPRound(hs, 1) & 0xffff) << 48;
+  mi |= (uint64_t)(SC_HDCPRound(hs, 1) & 0xffff) << 32;
+  output = SC_HDCPRound(hs, 1);
+  mi |= (uint64_t)(output & 0xffff) << 16;
+  if (Ri)
+    *Ri = (output >> 16) << 8;
+  output = SC_HDCPRound(hs, 1);
+  mi |= output & 0xffff;
+  if (Ri)
+    *Ri |= output >> 16;
+  if (Mi)
+    *Mi = mi;
+
+  hs->rekey = 0;
+}
+
+void HDCPScalarMiChain(int nframes, uint64_t Ks, uint64_t REPEATER, uint64_t Mi0, uint64_t *Mi)
+{
+  HDCPScalarCipherState hs;
+  int i;
+
+  for (i = 0; i < nframes; i++)
+    HDCPScalarBlockCipher(Ks, REPEATER, i == 0 ? Mi0 : Mi[i-1], &hs, NULL, NULL, &Mi[i]);
+}
+
+void HDCPScalarAuthentication(uint64_t Km, uint64_t REPEATER, uint64_t An,
+                              uint64_t *Ks, uint64_t *R0, uint64_t *M0)
+{
+  HDCPScalarCipherState hs;
+
+  HDCPScalarBlockCipher(Km, REPEATER, An, &hs, Ks, R0, M0);
+}
+
+void HDCPScalarInitializeFrameState(uint64_t Ks, uint64_t REPEATER, uint64_t Mi0,
+                                    HDCPScalarCipherState *hs, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi)
+{
+  HDCPScalarBlockCipher(Ks, REPEATER, Mi0, hs, Ki, Ri, Mi);
+}
+
+void HDCPScalarStreamCipher(HDCPScalarCipherState *hs, int noutputs, uint32_t *outputs)
+{
+  int i;
+
+  hs->rekey = 0;
+  for (i = 0; i < noutputs; i++)
+    outputs[i] = SC_HDCPRound(hs, 1);
+}
+
+void HDCPScalarStreamCipherXor(HDCPScalarCipherState *hs, int noutputs, uint32_t *line)
+{
+  int i;
+
+  hs->rekey = 0;
+  for (i = 0; i < noutputs; i++)
+    line[i] ^= SC_HDCPRound(hs, 1);
+}
+
+void HDCPScalarRekeycipher(HDCPScalarCipherState *hs)
+{
+  int i;
+
+  hs->rekey = 1;
+  for (i = 0; i < 56; i++)
+    SC_HDCPRound(hs, 0);
+  hs->rekey = 0;
+}
+
+void HDCPScalarFrameStream(int height, int width, HDCPScalarCipherState *hs,
+                           uint32_t outputs[height][width])
+{
+  int line;
+
+  for (line = 0; line < height; line++) {
+    HDCPScalarStreamCipher(hs, width, outputs[line]);
+    HDCPScalarRekeycipher(hs);
+  }
+}
+
+void HDCPScalarFrameStreamXor(int height, int width, HDCPScalarCipherState *hs,
+                              uint32_t *frame, int pitch)
+{
+  int line;
+
+  for (line = 0; line < height; line++) {
+    HDCPScalarStreamCipherXor(hs, width, (uint32_t *)((char *)frame + (size_t)line * pitch));
+    HDCPScalarRekeycipher(hs);
+  }
+}
+
+/* Returns 1 if the S-box tables agree with the easy-to-read bit-sliced
+   S-boxes on every input */
+static int SC_CheckSBoxes(void)
+{
+  bsvec_t in[28], outB[28], outK[28];
+  int i, v, passed = 1;
+
+  pthread_once(&SC_TablesOnce, SC_InitTables);
+
+  /* Lane v gets input nibble v%16 in every S-box */
+  for (i = 0; i < 28; i++) {
+    in[i] = 0;
+    for (v = 0; v < 64; v++)
+      if ((v % 16) & (1 << (i / 7)))
+        in[i] |= UINT64_C(1) << v;
+  }
+  BS_SBoxB_(in, outB);
+  BS_SBoxK_(in, outK);
+
+  for (v = 0; v < 16; v++) {
+    uint32_t r = 0, b = 0, k = 0;
+
+    for (i = 0; i < 7; i++)
+      r |= (uint32_t)v << (4*i);
+    for (i = 0; i < 28; i++) {
+      b |= (uint32_t)((outB[i] >> v) & 1) << SC_BIT(i);
+      k |= (uint32_t)((outK[i] >> v) & 1) << SC_BIT(i);
+    }
+    passed &= SC_SBox(SC_SBoxB, r) == b && SC_SBox(SC_SBoxK, r) == k;
+  }
+
+  return passed;
+}
+
+/***********************************************
+ * The scalar engine (see hdcp_engine.h): one lane, so ncopies and
+ * nframes must be 1 (callers check e->lanes).
+ ***********************************************/
+
+#define SHS(hs) ((HDCPScalarCipherState *)(hs))
+
+static void Engine_BlockCipher(int ncopies, uint64_t *K_, uint64_t *REPEATER, uint64_t *Bin, 
+                               HDCPCipherState *hs, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi)
+{
+  assert(ncopies == 1);
+  HDCPScalarBlockCipher(*K_, *REPEATER, *Bin, SHS(hs), Ki, Ri, Mi);
+}
+
+static void Engine_StreamCipher(int ncopies, HDCPCipherState *hs, int noutputs, uint32_t *outputs)
+{
+  assert(ncopies == 1);
+  HDCPScalarStreamCipher(SHS(hs), noutputs, outputs);
+}
+
+static void Engine_StreamCipherXor(int ncopies, HDCPCipherState *hs, int noutputs, uint32_t **lines)
+{
+  assert(ncopies == 1);
+  HDCPScalarStreamCipherXor(SHS(hs), noutputs, lines[0]);
+}
+
+static void Engine_Rekeycipher(HDCPCipherState *hs)
+{
+  HDCPScalarRekeycipher(SHS(hs));
+}
+
+static void Engine_InitializeMultiFrameState(int nframes, uint64_t Ks, uint64_t REPEATER, uint64_t Mi0, 
+                                             HDCPCipherState *hs, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi)
+{
+  assert(nframes == 1);
+  HDCPScalarInitializeFrameState(Ks, REPEATER, Mi0, SHS(hs), Ki, Ri, Mi);
+}
+
+static void Engine_FrameStream(int nframes, int height, int width, HDCPCipherState *hs, uint32_t *outputs)
+{
+  assert(nframes == 1);
+  HDCPScalarFrameStream(height, width, SHS(hs), (uint32_t (*)[width])outputs);
+}
+
+static void Engine_FrameStreamXor(int nframes, int height, int width, HDCPCipherState *hs, 
+                                  uint32_t **frames, int pitch)
+{
+  assert(nframes == 1);
+  HDCPScalarFrameStreamXor(height, width, SHS(hs), frames[0], pitch);
+}
+
+static void Engine_FrameStreamScatter(int nframes, int height, int width, HDCPCipherState *hs, 
+                                      uint32_t **frames, int pitch)
+{
+  int line;
+
+  assert(nframes == 1);
+
+  for (line = 0; line < height; line++) {
+    HDCPScalarStreamCipher(SHS(hs), width, (uint32_t *)((char *)frames[0] + (size_t)line * pitch));
+    HDCPScalarRekeycipher(SHS(hs));
+  }
+}
+
+static void Engine_FrameStreamFormat(int nframes, int height, int width, HDCPCipherState *hs,
+                                     uint8_t **frames, const HDCPLayout *l, int xor)
+{
+  uint32_t outputs[64];
+  int line, x, n;
+
+  assert(nframes == 1);
+
+  for (line = 0; line < height; line++) {
+    for (x = 0; x < width; x += n) {
+      n = width - x < 64 ? width - x : 64;
+      HDCPScalarStreamCipher(SHS(hs), n, outputs);
+      HDCPWritePixels(l, frames[0] + (size_t)line * l->pitch, x, n, outputs, 1, xor);
+    }
+    HDCPScalarRekeycipher(SHS(hs));
+  }
+}
+
+/* Only a single session of a single frame fits */
+static int Engine_InitializeMultiSessionState(int nsessions, const HDCPSessionFrames *sessions,
+                                              HDCPCipherState *hs, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi)
+{
+  int s, used = -1, lanes = 0;
+
+  for (s = 0; s < nsessions; s++) {
+    if (sessions[s].nframes < 0 || sessions[s].nframes > 1 - lanes)
+      return -1;
+    if (sessions[s].nframes)
+      used = s;
+    lanes += sessions[s].nframes;
+  }
+  if (used >= 0)
+    HDCPScalarInitializeFrameState(sessions[used].Ks, sessions[used].REPEATER, sessions[used].Mi0,
+                                   SHS(hs), Ki, Ri, Mi);
+  return lanes;
+}
+
+#undef SHS
+
+const HDCPEngine HDCPEngineScalar = {
+  "scalar",
+  1,
+  sizeof(HDCPScalarCipherState),
+  __alignof__(HDCPScalarCipherState),
+  Engine_BlockCipher,
+  Engine_StreamCipher,
+  Engine_StreamCipherXor,
+  Engine_Rekeycipher,
+  Engine_InitializeMultiFrameState,
+  Engine_FrameStream,
+  Engine_FrameStreamXor,
+  Engine_FrameStreamScatter,
+  Engine_FrameStream,   /* one frame is frame-major already */
+  Engine_FrameStreamFormat,
+  Engine_InitializeMultiSessionState,
+  NULL,                 /* nothing to transpose */
+  HDCPDeriveKm,         /* the 64-lane build's */
+  SC_CheckSBoxes
+};
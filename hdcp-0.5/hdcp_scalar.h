@@ -0,0 +1,67 @@
+/************************************************************
+ * A scalar (one copy at a time) implementation of the HDCP cipher.
+ *
+ * Besides walking the Mi chain for the bit-sliced code, it is a
+ * low-latency engine of its own: it keys and generates one frame at a
+ * time, line by line, with no state beyond an HDCPScalarCipherState.
+ * The functions mirror those of hdcp_cipher.h with nframes = 1, and
+ * hdcp_engine.h offers it as the 1-lane "scalar" engine.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#ifndef __HDCP_SCALAR_H__
+#define __HDCP_SCALAR_H__
+
+#include <stdint.h>
+
+/* The state of a single copy of the cipher.  Each 28-bit register is
+   packed into one word, but with its bits interleaved so that the 4
+   inputs of S-box i are bits 4i..4i+3 of the word: bit j of the
+   register (as numbered by the bit-sliced code) is stored in bit
+   4*(j%7) + j/7.  Bit i of lfsr[i] is BS_LFSRBit(lfsrs[i], i), and bit
+   i of snA/snB is the state of shuffle network i. */
+typedef struct _HDCPScalarCipherState
+{
+  uint32_t K[3], B[3];
+  uint32_t lfsr[4];
+  uint32_t snA, snB;
+  int rekey;
+} HDCPScalarCipherState;
+
+/* Same as HDCPBlockCipher with ncopies = 1, but much faster since it
+   doesn't pay for 63 unused bit-slice lanes. */
+void HDCPScalarBlockCipher(uint64_t K_, uint64_t REPEATER, uint64_t Bin,
+                           HDCPScalarCipherState *hs, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi);
+
+/* The chain of Mi values that HDCPInitializeMultiFrameState returns
+   for nframes frames starting from Mi0: Mi[0] is the Mi output of the
+   block cipher run on Mi0, Mi[1] the output of the one run on Mi[0],
+   and so on. */
+void HDCPScalarMiChain(int nframes, uint64_t Ks, uint64_t REPEATER, uint64_t Mi0, uint64_t *Mi);
+
+/* Same as HDCPAuthentication */
+void HDCPScalarAuthentication(uint64_t Km, uint64_t REPEATER, uint64_t An,
+                              uint64_t *Ks, uint64_t *R0, uint64_t *M0);
+
+/* Same as HDCPInitializeMultiFrameState with nframes = 1 */
+void HDCPScalarInitializeFrameState(uint64_t Ks, uint64_t REPEATER, uint64_t Mi0,
+                                    HDCPScalarCipherState *hs, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi);
+
+/* The next noutputs pixels of stream cipher output, stored into
+   outputs or xored into line */
+void HDCPScalarStreamCipher(HDCPScalarCipherState *hs, int noutputs, uint32_t *outputs);
+void HDCPScalarStreamCipherXor(HDCPScalarCipherState *hs, int noutputs, uint32_t *line);
+
+/* Same as HDCPRekeycipher, run at the end of every line */
+void HDCPScalarRekeycipher(HDCPScalarCipherState *hs);
+
+/* Same as HDCPFrameStream and HDCPFrameStreamXor for a single frame.
+   Pass height = 1 to go a line at a time. */
+void HDCPScalarFrameStream(int height, int width, HDCPScalarCipherState *hs,
+                           uint32_t outputs[height][width]);
+void HDCPScalarFrameStreamXor(int height, int width, HDCPScalarCipherState *hs,
+                              uint32_t *frame, int pitch);
+
+#endif /* __HDCP_SCALAR_H__ */
@@ -0,0 +1,164 @@
+/************************************************************
+ * Seeking to any frame of a recorded session.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "hdcp_scalar.h"
+#include "hdcp_cache.h"
+#include "hdcp_seek.h"
+
+struct _HDCPSeekIndex
+{
+  HDCPSeekHeader h;
+  uint64_t *Mi0;             /* Mi0[k] is that of frame k*interval */
+};
+
+/* Checkpoints for frames 0..nframes */
+static int64_t Checkpoints(const HDCPSeekHeader *h)
+{
+  return h->nframes / h->interval + 1;
+}
+
+static uint32_t IndexCrc(const HDCPSeekIndex *x)
+{
+  HDCPSeekHeader copy = x->h;
+
+  copy.crc = 0;
+  return HDCPCrc32(HDCPCrc32(0, &copy, sizeof(copy)), x->Mi0, Checkpoints(&x->h) * sizeof(uint64_t));
+}
+
+/* Run the block cipher n times along the chain from Mi */
+static uint64_t Walk(const HDCPSeekHeader *h, uint64_t Mi, int64_t n)
+{
+  HDCPScalarCipherState hs;
+
+  while (n-- > 0)
+    HDCPScalarBlockCipher(h->Ks, h->REPEATER, Mi, &hs, NULL, NULL, &Mi);
+  return Mi;
+}
+
+HDCPSeekIndex *HDCPNewSeekIndex(uint64_t Ks, uint64_t REPEATER, uint64_t Mi0,
+                                int64_t nframes, int64_t interval)
+{
+  HDCPSeekIndex *x;
+  int64_t k;
+
+  if (nframes < 0 || interval < 1 || !(x = calloc(1, sizeof(*x))))
+    return NULL;
+
+  memcpy(x->h.magic, HDCP_SEEK_MAGIC, sizeof(x->h.magic));
+  x->h.version = HDCP_SEEK_VERSION;
+  x->h.Ks = Ks;
+  x->h.REPEATER = REPEATER;
+  x->h.Mi0 = Mi0;
+  x->h.nframes = nframes;
+  x->h.interval = interval;
+  if (!(x->Mi0 = malloc(Checkpoints(&x->h) * sizeof(uint64_t)))) {
+    free(x);
+    return NULL;
+  }
+
+  x->Mi0[0] = Mi0;
+  for (k = 1; k < Checkpoints(&x->h); k++)
+    x->Mi0[k] = Walk(&x->h, x->Mi0[k-1], interval);
+  x->h.crc = IndexCrc(x);
+  return x;
+}
+
+void HDCPFreeSeekIndex(HDCPSeekIndex *x)
+{
+  free(x->Mi0);
+  free(x);
+}
+
+int HDCPSaveSeekIndex(const HDCPSeekIndex *x, const char *path)
+{
+  FILE *f = fopen(path, "wb");
+  int err = 0;
+
+  if (!f)
+    return -1;
+  if (fwrite(&x->h, sizeof(x->h), 1, f) != 1 ||
+      fwrite(x->Mi0, sizeof(uint64_t), Checkpoints(&x->h), f) != (size_t)Checkpoints(&x->h))
+    err = errno ? errno : EIO;
+  if (fclose(f) != 0 && !err)
+    err = errno;
+  if (err) {
+    remove(path);
+    errno = err;
+    return -1;
+  }
+  return 0;
+}
+
+HDCPSeekIndex *HDCPLoadSeekIndex(const char *path)
+{
+  FILE *f = fopen(path, "rb");
+  HDCPSeekIndex *x = calloc(1, sizeof(*x));
+  struct stat st;
+  int64_t n;
+
+  if (!f || !x)
+    goto fail;
+  if (fread(&x->h, sizeof(x->h), 1, f) != 1 ||
+      memcmp(x->h.magic, HDCP_SEEK_MAGIC, sizeof(x->h.magic)) ||
+      x->h.version != HDCP_SEEK_VERSION ||
+      x->h.nframes < 0 || x->h.interval < 1)
+    goto fail;
+  /* The header comes straight from the file, so don't believe its
+     count of checkpoints until the file turns out to hold them all */
+  n = Checkpoints(&x->h);
+  if (fstat(fileno(f), &st) < 0 || st.st_size < (off_t)sizeof(x->h) ||
+      n != (st.st_size - (off_t)sizeof(x->h)) / (off_t)sizeof(uint64_t))
+    goto fail;
+  if (!(x->Mi0 = malloc(n * sizeof(uint64_t))) ||
+      fread(x->Mi0, sizeof(uint64_t), n, f) != (size_t)n ||
+      fgetc(f) != EOF || IndexCrc(x) != x->h.crc)
+    goto fail;
+  fclose(f);
+  return x;
+
+ fail:
+  if (f)
+    fclose(f);
+  if (x)
+    free(x->Mi0);
+  free(x);
+  return NULL;
+}
+
+const HDCPSeekHeader *HDCPSeekInfo(const HDCPSeekIndex *x)
+{
+  return &x->h;
+}
+
+int64_t HDCPSeek(const HDCPSeekIndex *x, int64_t frame, uint64_t *Mi0)
+{
+  int64_t k, n;
+
+  if (frame < 0)
+    return -1;
+  k = frame / x->h.interval;
+  if (k >= Checkpoints(&x->h))
+    k = Checkpoints(&x->h) - 1;
+  n = frame - k * x->h.interval;
+  *Mi0 = Walk(&x->h, x->Mi0[k], n);
+  return n;
+}
+
+HDCPStream *HDCPSeekStream(const HDCPSeekIndex *x, const HDCPEngine *e, int nframes,
+                           int height, int width, int64_t frame)
+{
+  uint64_t Mi0;
+
+  if (HDCPSeek(x, frame, &Mi0) < 0)
+    return NULL;
+  return HDCPNewStream(e, nframes, height, width, x->h.Ks, x->h.REPEATER, Mi0);
+}
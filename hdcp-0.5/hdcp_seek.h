@@ -0,0 +1,77 @@
+/************************************************************
+ * Seeking to any frame of a recorded session.
+ *
+ * To key frame N, HDCPInitializeMultiFrameState needs the Mi0 that the
+ * batch starting at frame N is keyed from, which is the result of N
+ * runs of the block cipher on the session's first Mi0.  Getting it by
+ * walking the chain from the start makes a seek take time in
+ * proportion to how far into the recording it goes.  A seek index
+ * saves the Mi0 for every interval'th frame, so a seek only has to
+ * walk from the checkpoint before it: at most interval-1 runs.
+ *
+ * The Mi0 for frame N doesn't depend on the batch size the session is
+ * keyed in, so one index serves runs of any batch size.  The cipher
+ * state isn't saved: keying a batch from its Mi0 takes one run of the
+ * block cipher, which is quicker than reading a saved state back.
+ *
+ * An index file holds, in the byte order of the machine that wrote it,
+ * an HDCPSeekHeader and then one 64-bit Mi0 per checkpoint: frames 0,
+ * interval, 2*interval, ... up to nframes.  Its CRC covers the whole
+ * file and is checked when it is loaded.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#ifndef __HDCP_SEEK_H__
+#define __HDCP_SEEK_H__
+
+#include <stdint.h>
+#include "hdcp_engine.h"
+#include "hdcp_stream.h"
+
+#define HDCP_SEEK_MAGIC   "HDCPSEEK"
+#define HDCP_SEEK_VERSION 1
+
+typedef struct _HDCPSeekHeader
+{
+  char magic[8];            /* HDCP_SEEK_MAGIC */
+  uint32_t version;         /* HDCP_SEEK_VERSION */
+  uint32_t crc;             /* CRC-32 of the file, with crc = 0 */
+  uint64_t Ks, REPEATER, Mi0;
+  int64_t nframes;          /* frames the checkpoints cover */
+  int64_t interval;         /* frames between checkpoints */
+} HDCPSeekHeader;
+
+typedef struct _HDCPSeekIndex HDCPSeekIndex;
+
+/* Walk the Mi chain of a session nframes frames from Mi0, saving the
+   Mi0 of every interval'th frame.  Returns NULL on failure. */
+HDCPSeekIndex *HDCPNewSeekIndex(uint64_t Ks, uint64_t REPEATER, uint64_t Mi0,
+                                int64_t nframes, int64_t interval);
+
+void HDCPFreeSeekIndex(HDCPSeekIndex *x);
+
+/* Write x to a file at path, or read one back.  HDCPSaveSeekIndex
+   returns 0, or -1 with errno set on failure; HDCPLoadSeekIndex returns
+   NULL if the file can't be read, isn't an index of this version, is
+   not the length its header says, or fails its CRC. */
+int HDCPSaveSeekIndex(const HDCPSeekIndex *x, const char *path);
+HDCPSeekIndex *HDCPLoadSeekIndex(const char *path);
+
+/* What the index covers */
+const HDCPSeekHeader *HDCPSeekInfo(const HDCPSeekIndex *x);
+
+/* Set *Mi0 to what a batch starting at frame (>= 0) is keyed from,
+   i.e. the Mi0 to pass HDCPInitializeMultiFrameState, HDCPNewStream or
+   HDCPNewPool to carry on from that frame.  Frames past nframes are
+   reached by walking on from the last checkpoint.  Returns the number
+   of block cipher runs that took, or -1 if frame is negative. */
+int64_t HDCPSeek(const HDCPSeekIndex *x, int64_t frame, uint64_t *Mi0);
+
+/* An HDCPStream of batches of nframes frames, starting at frame, as if
+   it had been running since frame 0 */
+HDCPStream *HDCPSeekStream(const HDCPSeekIndex *x, const HDCPEngine *e, int nframes,
+                           int height, int width, int64_t frame);
+
+#endif /* __HDCP_SEEK_H__ */
@@ -0,0 +1,167 @@
+/************************************************************
+ * A resumable stream of cipher output, generated in chunks of any size.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "hdcp_stream.h"
+
+struct _HDCPStream
+{
+  const HDCPEngine *e;
+  HDCPCipherState *hs;
+  int nframes, height, width;
+  int lines;         /* most whole lines per FrameStream call */
+  int line, x;       /* position of the next pixel */
+  int64_t batch;     /* batches started so far */
+  uint64_t Ks, REPEATER;
+  uint64_t *Ki, *Ri, *Mi;
+};
+
+/* Key the batch after the current one */
+static void NextBatch(HDCPStream *s)
+{
+  s->e->InitializeMultiFrameState(s->nframes, s->Ks, s->REPEATER, s->Mi[s->nframes-1],
+                                  s->hs, s->Ki, s->Ri, s->Mi);
+  s->line = 0;
+  s->x = 0;
+  s->batch++;
+}
+
+/* Move on by n pixels within the current line, rekeying at its end.
+   There is no need to rekey after the last line, since the next batch
+   is keyed from scratch. */
+static void Advance(HDCPStream *s, int n)
+{
+  s->x += n;
+  if (s->x == s->width) {
+    s->x = 0;
+    if (++s->line < s->height)
+      s->e->Rekeycipher(s->hs);
+  }
+}
+
+/* How many pixels the engine can generate in one go from here */
+static int ChunkLength(HDCPStream *s, int npixels)
+{
+  int n = s->width - s->x;
+
+  return n < npixels ? n : npixels;
+}
+
+HDCPStream *HDCPNewStream(const HDCPEngine *e, int nframes, int height, int width,
+                          uint64_t Ks, uint64_t REPEATER, uint64_t Mi0)
+{
+  HDCPStream *s;
+
+  if (nframes < 1 || nframes > e->lanes || height < 1 || width < 1)
+    return NULL;
+  if (!(s = calloc(1, sizeof(*s))))
+    return NULL;
+
+  s->e = e;
+  s->nframes = nframes;
+  s->height = height;
+  s->width = width;
+  s->lines = 1;
+  s->Ks = Ks;
+  s->REPEATER = REPEATER;
+  s->hs = HDCPNewCipherState(e);
+  s->Ki = malloc(nframes * sizeof(uint64_t));
+  s->Ri = malloc(nframes * sizeof(uint64_t));
+  s->Mi = malloc(nframes * sizeof(uint64_t));
+  if (!s->hs || !s->Ki || !s->Ri || !s->Mi) {
+    HDCPFreeStream(s);
+    return NULL;
+  }
+
+  s->Mi[nframes-1] = Mi0;
+  NextBatch(s);
+  return s;
+}
+
+void HDCPFreeStream(HDCPStream *s)
+{
+  HDCPFreeCipherState(s->hs);
+  free(s->Ki);
+  free(s->Ri);
+  free(s->Mi);
+  free(s);
+}
+
+void HDCPStreamSetLines(HDCPStream *s, int lines)
+{
+  s->lines = lines < 1 ? 1 : lines;
+}
+
+void HDCPStreamGenerate(HDCPStream *s, int npixels, uint32_t *outputs)
+{
+  int n;
+
+  while (npixels > 0) {
+    if (s->line == s->height)
+      NextBatch(s);
+
+    /* Whole lines are laid out just as FrameStream writes them.  It
+       rekeys after the last line of the frames too, which does no harm
+       since the next batch is keyed from scratch. */
+    if (s->x == 0 && (n = npixels / s->width) > 0) {
+      n = n < s->lines ? n : s->lines;
+      n = n < s->height - s->line ? n : s->height - s->line;
+      s->e->FrameStream(s->nframes, n, s->width, s->hs, outputs);
+      outputs += (size_t)n * s->width * s->nframes;
+      npixels -= n * s->width;
+      s->line += n;
+      continue;
+    }
+
+    n = ChunkLength(s, npixels);
+    s->e->StreamCipher(s->nframes, s->hs, n, outputs);
+    outputs += (size_t)n * s->nframes;
+    npixels -= n;
+    Advance(s, n);
+  }
+}
+
+int HDCPStreamGenerateXor(HDCPStream *s, int npixels, uint32_t **dst)
+{
+  uint32_t *lines[s->nframes];
+  int done = 0, n, i;
+
+  if (npixels > 0 && s->line == s->height)
+    NextBatch(s);
+
+  memcpy(lines, dst, sizeof(lines));
+  while (done < npixels && s->line < s->height) {
+    n = ChunkLength(s, npixels - done);
+    s->e->StreamCipherXor(s->nframes, s->hs, n, lines);
+    for (i = 0; i < s->nframes; i++)
+      lines[i] += n;
+    done += n;
+    Advance(s, n);
+  }
+  return done;
+}
+
+void HDCPStreamPosition(HDCPStream *s, int64_t *batch, int *line, int *x)
+{
+  if (batch)
+    *batch = s->batch;
+  if (line)
+    *line = s->line;
+  if (x)
+    *x = s->x;
+}
+
+void HDCPStreamKeys(HDCPStream *s, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi)
+{
+  if (Ki)
+    memcpy(Ki, s->Ki, s->nframes * sizeof(*Ki));
+  if (Ri)
+    memcpy(Ri, s->Ri, s->nframes * sizeof(*Ri));
+  if (Mi)
+    memcpy(Mi, s->Mi, s->nframes * sizeof(*Mi));
+}
@@ -0,0 +1,57 @@
+/************************************************************
+ * A resumable stream of cipher output, generated in chunks of any size.
+ *
+ * HDCPFrameStream works a whole frame at a time, and HDCPStreamCipher
+ * a run of pixels within one line, leaving it to the caller to rekey
+ * at the end of every line and to key the next batch of frames at the
+ * end of every frame.  An HDCPStream keeps track of where it is in the
+ * frame and does both itself, so the output can be pulled in whatever
+ * pieces the video arrives in (a capture DMA slice, a cache-sized
+ * tile, ...), from one pixel to several frames at a time.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#ifndef __HDCP_STREAM_H__
+#define __HDCP_STREAM_H__
+
+#include <stdint.h>
+#include "hdcp_engine.h"
+
+typedef struct _HDCPStream HDCPStream;
+
+/* Create a stream of batches of nframes (<= e->lanes) height x width
+   frames, the first batch keyed from Mi0 as by
+   HDCPInitializeMultiFrameState.  Returns NULL on failure. */
+HDCPStream *HDCPNewStream(const HDCPEngine *e, int nframes, int height, int width,
+                          uint64_t Ks, uint64_t REPEATER, uint64_t Mi0);
+
+void HDCPFreeStream(HDCPStream *s);
+
+/* Generate the output for the next npixels pixels (in raster order) of
+   every frame of the batch: outputs[p*nframes + i] is pixel p of frame
+   i.  Runs on into the following batches of frames if need be. */
+void HDCPStreamGenerate(HDCPStream *s, int npixels, uint32_t *outputs);
+
+/* Have HDCPStreamGenerate produce whole lines with FrameStream, at
+   most lines (1 by default) per call, as tuned by hdcp_tune.h */
+void HDCPStreamSetLines(HDCPStream *s, int lines);
+
+/* xor the output for the next pixels of frame i into dst[i][0..],
+   stopping after npixels pixels or at the end of the frames, whichever
+   comes first.  Returns the number of pixels done, which is 0 only if
+   npixels is.  The next call starts a new batch if this one reached
+   the end of the frames. */
+int HDCPStreamGenerateXor(HDCPStream *s, int npixels, uint32_t **dst);
+
+/* The position of the next pixel: *batch counts the batches of frames
+   started so far (from 1), and *line and *x are where the next pixel is
+   in the frames, with *line = height once the batch is done.  Any of
+   the pointers may be NULL. */
+void HDCPStreamPosition(HDCPStream *s, int64_t *batch, int *line, int *x);
+
+/* Copy out the Ki, Ri and Mi of the frames of the current batch */
+void HDCPStreamKeys(HDCPStream *s, uint64_t *Ki, uint64_t *Ri, uint64_t *Mi);
+
+#endif /* __HDCP_STREAM_H__ */
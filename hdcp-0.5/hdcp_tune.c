@@ -0,0 +1,342 @@
+/************************************************************
+ * Picking the fastest engine, tile and thread count for this machine.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "hdcp_pool.h"
+#include "hdcp_stream.h"
+#include "hdcp_tune.h"
+
+/* Most pixels a batch of the pool takes, so that timing each thread
+   count takes a few ms a batch rather than seconds */
+#define TUNE_POOL_PIXELS (1 << 22)
+
+static const uint64_t Ks = UINT64_C(0x1234567890abcd), M0 = UINT64_C(0xfedcba0987654321);
+
+static double Now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+/* ns per pixel of FrameStream on all of e's lanes, lines lines per
+   call, keying the next batch (untimed) after every height lines.
+   Returns -1 if the buffer can't be had. */
+static double TimeFrameStream(const HDCPEngine *e, int height, int width, int lines, double seconds)
+{
+  int n = e->lanes, line = height, k;
+  uint64_t Ki[n], Ri[n], Mi[n], Mi0 = M0;
+  uint32_t *outputs = malloc(sizeof(uint32_t) * lines * width * n);
+  HDCPCipherState *hs = HDCPNewCipherState(e);
+  double spent = 0, pixels = 0, start;
+
+  if (!outputs || !hs) {
+    free(outputs);
+    if (hs)
+      HDCPFreeCipherState(hs);
+    return -1;
+  }
+
+  /* Once untimed, to fault the buffer in */
+  e->InitializeMultiFrameState(n, Ks, 0, Mi0, hs, Ki, Ri, Mi);
+  e->FrameStream(n, lines < height ? lines : height, width, hs, outputs);
+
+  do {
+    if (line >= height) {
+      e->InitializeMultiFrameState(n, Ks, 0, Mi0, hs, Ki, Ri, Mi);
+      Mi0 = Mi[n-1];
+      line = 0;
+    }
+    k = height - line < lines ? height - line : lines;
+    start = Now();
+    e->FrameStream(n, k, width, hs, outputs);
+    spent += Now() - start;
+    pixels += (double)k * width * n;
+    line += k;
+  } while (spent < seconds);
+
+  free(outputs);
+  HDCPFreeCipherState(hs);
+  return 1e9 * spent / pixels;
+}
+
+/* ns per copy of the block cipher on all of e's lanes */
+static double TimeBlockCipher(const HDCPEngine *e, double seconds)
+{
+  uint64_t K[e->lanes], REPEATER[e->lanes], Bin[e->lanes], Ki[e->lanes], Ri[e->lanes], Mi[e->lanes];
+  HDCPCipherState *hs = HDCPNewCipherState(e);
+  double copies = 0, start = Now(), spent;
+  int i;
+
+  if (!hs)
+    return -1;
+  for (i = 0; i < e->lanes; i++) {
+    K[i] = Ks ^ i;
+    REPEATER[i] = 0;
+    Bin[i] = M0 + i;
+  }
+
+  do {
+    e->BlockCipher(e->lanes, K, REPEATER, Bin, hs, Ki, Ri, Mi);
+    memcpy(Bin, Mi, sizeof(Bin));
+    copies += e->lanes;
+  } while ((spent = Now() - start) < seconds);
+
+  HDCPFreeCipherState(hs);
+  return 1e9 * spent / copies;
+}
+
+/* ns per pixel of whole frames xored in place by a pool of threads
+   threads.  The frames are cut short so that a batch is no more than
+   TUNE_POOL_PIXELS and the threads+1 batches in flight take no more
+   than HDCP_TUNE_BYTES, and all the frames of a batch share one
+   buffer. */
+static double TimePool(const HDCPEngine *e, int height, int width, int threads, double seconds)
+{
+  int depth = threads + 1, i;
+  int h = HDCP_TUNE_BYTES / ((size_t)depth * width * sizeof(uint32_t));
+  int most = TUNE_POOL_PIXELS / ((size_t)e->lanes * width);
+  size_t frame;
+  uint32_t *video, *frames[e->lanes];
+  HDCPPool *pool;
+  double start, items = 0;
+  long batch;
+
+  h = h < most ? h : most;
+  h = h < 1 ? 1 : h > height ? height : h;
+  frame = (size_t)h * width;
+  video = calloc(frame * depth, sizeof(uint32_t));
+  pool = HDCPNewPool(e, threads, depth, h, width, Ks, 0, M0);
+  if (!video || !pool) {
+    free(video);
+    if (pool)
+      HDCPFreePool(pool);
+    return -1;
+  }
+
+  start = Now();
+  for (batch = 0; ; batch++) {
+    for (i = 0; i < e->lanes; i++)
+      frames[i] = video + frame * (batch % depth);
+    if (batch >= depth)
+      items += HDCPPoolWait(pool, NULL, NULL, NULL, NULL);
+    HDCPPoolSubmit(pool, e->lanes, frames, width * sizeof(uint32_t));
+    if (batch >= depth && Now() - start >= seconds)
+      break;
+  }
+  HDCPFreePool(pool);
+  free(video);
+  return 1e9 * (Now() - start) / (items * frame);
+}
+
+static void TuneResolution(HDCPTuned *r, double seconds)
+{
+  int ncpu = sysconf(_SC_NPROCESSORS_ONLN), lines, threads, i;
+  double ns, best = 0, *pool_ns;
+  const HDCPEngine *e;
+
+  r->e = NULL;
+  for (i = 0; (e = HDCPListEngines(i)); i++)
+    for (lines = 1; lines <= 64 && lines <= r->height; lines *= 2) {
+      if (lines > 1 && (size_t)lines * r->width * e->lanes * sizeof(uint32_t) > HDCP_TUNE_BYTES)
+        break;
+      ns = TimeFrameStream(e, r->height, r->width, lines, seconds);
+      if (ns > 0 && (!r->e || ns < best)) {
+        r->e = e;
+        r->lines = lines;
+        r->ns = best = ns;
+      }
+    }
+
+  /* 1, 2, 4, ... threads and one per CPU */
+  ncpu = ncpu < 1 ? 1 : ncpu;
+  pool_ns = calloc(ncpu + 1, sizeof(double));
+  r->threads = 1;
+  if (!r->e || !pool_ns) {
+    free(pool_ns);
+    return;
+  }
+  best = 0;
+  for (threads = 1; ; threads *= 2) {
+    threads = threads < ncpu ? threads : ncpu;
+    pool_ns[threads] = TimePool(r->e, r->height, r->width, threads, seconds);
+    if (pool_ns[threads] > 0 && (best == 0 || pool_ns[threads] < best))
+      best = pool_ns[threads];
+    if (threads == ncpu)
+      break;
+  }
+  for (threads = ncpu; threads >= 1; threads--)
+    if (pool_ns[threads] > 0 && pool_ns[threads] <= 1.05 * best)
+      r->threads = threads;
+  free(pool_ns);
+}
+
+int HDCPTune(int n, const int *heights, const int *widths, double seconds, HDCPTuning *t)
+{
+  const HDCPEngine *e;
+  double ns;
+  int i, largest = 0;
+
+  if (n < 1 || n > HDCP_TUNE_MAX)
+    return -1;
+  memset(t, 0, sizeof(*t));
+
+  for (i = 0; (e = HDCPListEngines(i)); i++)
+    if ((ns = TimeBlockCipher(e, seconds)) > 0 && (!t->block || ns < t->block_ns)) {
+      t->block = e;
+      t->block_ns = ns;
+    }
+
+  for (i = 0; i < n; i++) {
+    if (heights[i] < 1 || widths[i] < 1)
+      return -1;
+    t->res[i].height = heights[i];
+    t->res[i].width = widths[i];
+    TuneResolution(&t->res[i], seconds);
+    if (!t->res[i].e)
+      return -1;
+    if ((int64_t)heights[i] * widths[i] > (int64_t)heights[largest] * widths[largest])
+      largest = i;
+  }
+  t->n = n;
+  t->engine = t->res[largest].e;
+  return t->block ? 0 : -1;
+}
+
+int HDCPSaveTuning(const HDCPTuning *t, const char *path)
+{
+  FILE *f = fopen(path, "w");
+  int i, err = 0;
+
+  if (!f)
+    return -1;
+  fprintf(f, "hdcp-tuning %d\n", HDCP_TUNE_VERSION);
+  fprintf(f, "engine %s\n", t->engine->name);
+  fprintf(f, "block %s %.6g\n", t->block->name, t->block_ns);
+  for (i = 0; i < t->n; i++)
+    fprintf(f, "res %d %d %s %d %d %.6g\n", t->res[i].height, t->res[i].width,
+            t->res[i].e->name, t->res[i].lines, t->res[i].threads, t->res[i].ns);
+  if (ferror(f))
+    err = errno ? errno : EIO;
+  if (fclose(f) != 0 && !err)
+    err = errno;
+  if (err) {
+    remove(path);
+    errno = err;
+    return -1;
+  }
+  return 0;
+}
+
+int HDCPLoadTuning(const char *path, HDCPTuning *t)
+{
+  FILE *f = fopen(path, "r");
+  char line[256], key[32], name[32];
+  int version, ok = 1;
+
+  if (!f)
+    return -1;
+  memset(t, 0, sizeof(*t));
+  if (!fgets(line, sizeof(line), f) ||
+      sscanf(line, "hdcp-tuning %d", &version) != 1 || version != HDCP_TUNE_VERSION)
+    ok = 0;
+
+  while (ok && fgets(line, sizeof(line), f)) {
+    HDCPTuned *r = &t->res[t->n];
+
+    if (sscanf(line, "%31s", key) != 1)
+      continue;
+    if (strcmp(key, "engine") == 0)
+      ok = sscanf(line, "engine %31s", name) == 1 && (t->engine = HDCPFindEngine(name));
+    else if (strcmp(key, "block") == 0)
+      ok = sscanf(line, "block %31s %lf", name, &t->block_ns) == 2 && (t->block = HDCPFindEngine(name));
+    else if (strcmp(key, "res") == 0 && t->n < HDCP_TUNE_MAX) {
+      ok = sscanf(line, "res %d %d %31s %d %d %lf", &r->height, &r->width, name,
+                  &r->lines, &r->threads, &r->ns) == 6 &&
+        (r->e = HDCPFindEngine(name)) && r->height > 0 && r->width > 0 &&
+        r->lines > 0 && r->threads > 0;
+      t->n++;
+    } else
+      ok = 0;
+  }
+
+  fclose(f);
+  return ok && t->engine && t->block && t->n > 0 ? 0 : -1;
+}
+
+const HDCPTuned *HDCPTuningFor(const HDCPTuning *t, int height, int width)
+{
+  const HDCPTuned *best = NULL;
+  int64_t pixels = (int64_t)height * width, d, best_d = 0;
+  int i;
+
+  for (i = 0; i < t->n; i++) {
+    if (t->res[i].height == height && t->res[i].width == width)
+      return &t->res[i];
+    d = (int64_t)t->res[i].height * t->res[i].width - pixels;
+    d = d < 0 ? -d : d;
+    if (!best || d < best_d) {
+      best = &t->res[i];
+      best_d = d;
+    }
+  }
+  return best;
+}
+
+static HDCPTuning EnvTuning;
+static const HDCPTuning *EnvTuningLoaded;
+static pthread_once_t EnvTuningOnce = PTHREAD_ONCE_INIT;
+
+static void LoadEnvTuning(void)
+{
+  const char *path = getenv("HDCP_TUNING");
+
+  if (path && HDCPLoadTuning(path, &EnvTuning) == 0)
+    EnvTuningLoaded = &EnvTuning;
+}
+
+const HDCPTuning *HDCPGetTuning(void)
+{
+  pthread_once(&EnvTuningOnce, LoadEnvTuning);
+  return EnvTuningLoaded;
+}
+
+/* The engine to use for height x width: HDCP_ENGINE's if it is set,
+   as HDCPGetEngine() would, or else the tuned one */
+static const HDCPEngine *TunedEngine(const HDCPTuned *r)
+{
+  return !r || getenv("HDCP_ENGINE") ? HDCPGetEngine() : r->e;
+}
+
+HDCPPool *HDCPNewTunedPool(const HDCPTuning *t, int nthreads, int depth, int height, int width,
+                           uint64_t Ks, uint64_t REPEATER, uint64_t Mi0)
+{
+  const HDCPTuned *r = t ? HDCPTuningFor(t, height, width) : NULL;
+
+  if (nthreads <= 0 && r)
+    nthreads = r->threads;
+  return HDCPNewPool(TunedEngine(r), nthreads, depth, height, width, Ks, REPEATER, Mi0);
+}
+
+HDCPStream *HDCPNewTunedStream(const HDCPTuning *t, int height, int width,
+                               uint64_t Ks, uint64_t REPEATER, uint64_t Mi0)
+{
+  const HDCPTuned *r = t ? HDCPTuningFor(t, height, width) : NULL;
+  const HDCPEngine *e = TunedEngine(r);
+  HDCPStream *s = HDCPNewStream(e, e->lanes, height, width, Ks, REPEATER, Mi0);
+
+  if (s && r)
+    HDCPStreamSetLines(s, r->lines);
+  return s;
+}
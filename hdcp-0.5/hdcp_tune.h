@@ -0,0 +1,92 @@
+/************************************************************
+ * Picking the fastest engine, tile and thread count for this machine.
+ *
+ * Which engine generates output fastest, how many lines of it to
+ * generate per FrameStream call, and how many threads a pool should
+ * have all depend on the CPU's vector units and the sizes of its
+ * caches, so rather than guess, HDCPTune() times the candidates on the
+ * machine itself for each resolution:
+ *
+ *  - every engine the CPU supports, with all of its lanes in use;
+ *  - tiles of 1, 2, 4, ... 64 lines (as long as the output buffer
+ *    stays under HDCP_TUNE_BYTES);
+ *  - pools of 1, 2, 4, ... threads up to one per CPU, with the
+ *    fastest engine.
+ *
+ * and the block cipher on every engine.  The result can be saved to a
+ * small text file and loaded again by later runs (HDCPGetTuning()
+ * loads the one the environment variable HDCP_TUNING names), and
+ * HDCPNewTunedPool() and HDCPNewTunedStream() create a pool or stream
+ * with the settings it has for their resolution.  A file tuned on
+ * another machine only loads if this one supports all the engines it
+ * names.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#ifndef __HDCP_TUNE_H__
+#define __HDCP_TUNE_H__
+
+#include "hdcp_engine.h"
+#include "hdcp_pool.h"
+#include "hdcp_stream.h"
+
+#define HDCP_TUNE_VERSION 1
+
+/* Most resolutions a tuning holds */
+#define HDCP_TUNE_MAX 16
+
+/* Largest output buffer a tile of lines may take */
+#define HDCP_TUNE_BYTES (64 << 20)
+
+typedef struct _HDCPTuned
+{
+  int height, width;
+  const HDCPEngine *e;      /* fastest engine for FrameStream */
+  int lines;                /* lines per FrameStream call */
+  int threads;              /* pool threads, fewest within 5% of the fastest */
+  double ns;                /* ns per pixel of output on one thread */
+} HDCPTuned;
+
+typedef struct _HDCPTuning
+{
+  const HDCPEngine *engine; /* fastest at the largest resolution */
+  const HDCPEngine *block;  /* fastest block cipher, per copy */
+  double block_ns;          /* ns per copy of the block cipher */
+  int n;
+  HDCPTuned res[HDCP_TUNE_MAX];
+} HDCPTuning;
+
+/* Time the candidates for each of the n (<= HDCP_TUNE_MAX) resolutions
+   heights[i] x widths[i], giving each measurement about seconds, and
+   fill in *t.  Returns 0, or -1 on failure. */
+int HDCPTune(int n, const int *heights, const int *widths, double seconds, HDCPTuning *t);
+
+/* Write t to a file at path, or read one back.  Both return 0, or -1
+   on failure (with errno set, if saving failed). */
+int HDCPSaveTuning(const HDCPTuning *t, const char *path);
+int HDCPLoadTuning(const char *path, HDCPTuning *t);
+
+/* The tuned settings for height x width, or, if it wasn't tuned for,
+   those of the resolution with the nearest number of pixels.  NULL if
+   t holds no resolutions. */
+const HDCPTuned *HDCPTuningFor(const HDCPTuning *t, int height, int width);
+
+/* The tuning in the file HDCP_TUNING names, loaded on the first call.
+   NULL if the variable isn't set or the file doesn't load. */
+const HDCPTuning *HDCPGetTuning(void);
+
+/* HDCPNewPool, with the engine t has for height x width and, if
+   nthreads <= 0, its number of threads */
+HDCPPool *HDCPNewTunedPool(const HDCPTuning *t, int nthreads, int depth, int height, int width,
+                           uint64_t Ks, uint64_t REPEATER, uint64_t Mi0);
+
+/* HDCPNewStream, with the engine t has for height x width, batches of
+   all of its lanes, and its lines per FrameStream call.  For both, a
+   NULL t means HDCPGetEngine() and the usual defaults, and HDCP_ENGINE
+   overrides the tuned engine. */
+HDCPStream *HDCPNewTunedStream(const HDCPTuning *t, int height, int width,
+                               uint64_t Ks, uint64_t REPEATER, uint64_t Mi0);
+
+#endif /* __HDCP_TUNE_H__ */
@@ -0,0 +1,3492 @@
+/* Auto-generated by Rounds_print: 8 rounds of BS_HDCPStreamCipher */
+static void BS_HDCPRounds8(BS_HDCPCipherState *hs, bsvec_t output[8][24])
+{
+  BS_LFSRModule *m = &hs->lm;
+  bsvec_t (*K)[28] = hs->bm.K, (*B)[28] = hs->bm.B;
+  bsvec_t Kspare[28], Bspare[28], snA[4], snB[4], D;
+  bsvec_t l0[21], l1[22], l2[24], l3[25];
+  int i;
+
+  for (i = 0; i < 13; i++)
+    l0[8 + i] = BS_LFSRBit(&m->lfsrs[0], i);
+  for (i = 0; i < 14; i++)
+    l1[8 + i] = BS_LFSRBit(&m->lfsrs[1], i);
+  for (i = 0; i < 16; i++)
+    l2[8 + i] = BS_LFSRBit(&m->lfsrs[2], i);
+  for (i = 0; i < 17; i++)
+    l3[8 + i] = BS_LFSRBit(&m->lfsrs[3], i);
+  memcpy(snA, m->snA, sizeof(snA));
+  memcpy(snB, m->snB, sizeof(snB));
+
+  /* Round 0 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[0]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[11] ^ l1[12] ^ l2[13] ^ l3[13];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[15]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[16]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[17]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[19]);
+  D ^= l0[20] ^ l1[21] ^ l2[23] ^ l3[24];
+  l0[7] = l0[12] ^ l0[16] ^ l0[18] ^ l0[20];
+  l1[7] = l1[11] ^ l1[13] ^ l1[14] ^ l1[17] ^ l1[18] ^ l1[21];
+  l2[7] = l2[12] ^ l2[14] ^ l2[15] ^ l2[19] ^ l2[22] ^ l2[23];
+  l3[7] = l3[12] ^ l3[18] ^ l3[22] ^ l3[24];
+
+  /* Round 1 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[1]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[10] ^ l1[11] ^ l2[12] ^ l3[12];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[14]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[15]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[16]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[18]);
+  D ^= l0[19] ^ l1[20] ^ l2[22] ^ l3[23];
+  l0[6] = l0[11] ^ l0[15] ^ l0[17] ^ l0[19];
+  l1[6] = l1[10] ^ l1[12] ^ l1[13] ^ l1[16] ^ l1[17] ^ l1[20];
+  l2[6] = l2[11] ^ l2[13] ^ l2[14] ^ l2[18] ^ l2[21] ^ l2[22];
+  l3[6] = l3[11] ^ l3[17] ^ l3[21] ^ l3[23];
+
+  /* Round 2 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[2]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[9] ^ l1[10] ^ l2[11] ^ l3[11];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[13]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[14]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[15]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[17]);
+  D ^= l0[18] ^ l1[19] ^ l2[21] ^ l3[22];
+  l0[5] = l0[10] ^ l0[14] ^ l0[16] ^ l0[18];
+  l1[5] = l1[9] ^ l1[11] ^ l1[12] ^ l1[15] ^ l1[16] ^ l1[19];
+  l2[5] = l2[10] ^ l2[12] ^ l2[13] ^ l2[17] ^ l2[20] ^ l2[21];
+  l3[5] = l3[10] ^ l3[16] ^ l3[20] ^ l3[22];
+
+  /* Round 3 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[3]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[8] ^ l1[9] ^ l2[10] ^ l3[10];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[12]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[13]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[14]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[16]);
+  D ^= l0[17] ^ l1[18] ^ l2[20] ^ l3[21];
+  l0[4] = l0[9] ^ l0[13] ^ l0[15] ^ l0[17];
+  l1[4] = l1[8] ^ l1[10] ^ l1[11] ^ l1[14] ^ l1[15] ^ l1[18];
+  l2[4] = l2[9] ^ l2[11] ^ l2[12] ^ l2[16] ^ l2[19] ^ l2[20];
+  l3[4] = l3[9] ^ l3[15] ^ l3[19] ^ l3[21];
+
+  /* Round 4 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[4]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[7] ^ l1[8] ^ l2[9] ^ l3[9];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[11]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[12]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[13]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[15]);
+  D ^= l0[16] ^ l1[17] ^ l2[19] ^ l3[20];
+  l0[3] = l0[8] ^ l0[12] ^ l0[14] ^ l0[16];
+  l1[3] = l1[7] ^ l1[9] ^ l1[10] ^ l1[13] ^ l1[14] ^ l1[17];
+  l2[3] = l2[8] ^ l2[10] ^ l2[11] ^ l2[15] ^ l2[18] ^ l2[19];
+  l3[3] = l3[8] ^ l3[14] ^ l3[18] ^ l3[20];
+
+  /* Round 5 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[5]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[6] ^ l1[7] ^ l2[8] ^ l3[8];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[10]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[11]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[12]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[14]);
+  D ^= l0[15] ^ l1[16] ^ l2[18] ^ l3[19];
+  l0[2] = l0[7] ^ l0[11] ^ l0[13] ^ l0[15];
+  l1[2] = l1[6] ^ l1[8] ^ l1[9] ^ l1[12] ^ l1[13] ^ l1[16];
+  l2[2] = l2[7] ^ l2[9] ^ l2[10] ^ l2[14] ^ l2[17] ^ l2[18];
+  l3[2] = l3[7] ^ l3[13] ^ l3[17] ^ l3[19];
+
+  /* Round 6 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[6]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[5] ^ l1[6] ^ l2[7] ^ l3[7];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[9]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[10]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[11]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[13]);
+  D ^= l0[14] ^ l1[15] ^ l2[17] ^ l3[18];
+  l0[1] = l0[6] ^ l0[10] ^ l0[12] ^ l0[14];
+  l1[1] = l1[5] ^ l1[7] ^ l1[8] ^ l1[11] ^ l1[12] ^ l1[15];
+  l2[1] = l2[6] ^ l2[8] ^ l2[9] ^ l2[13] ^ l2[16] ^ l2[17];
+  l3[1] = l3[6] ^ l3[12] ^ l3[16] ^ l3[18];
+
+  /* Round 7 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[7]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[4] ^ l1[5] ^ l2[6] ^ l3[6];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[8]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[9]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[10]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[12]);
+  D ^= l0[13] ^ l1[14] ^ l2[16] ^ l3[17];
+  l0[0] = l0[5] ^ l0[9] ^ l0[11] ^ l0[13];
+  l1[0] = l1[4] ^ l1[6] ^ l1[7] ^ l1[10] ^ l1[11] ^ l1[14];
+  l2[0] = l2[5] ^ l2[7] ^ l2[8] ^ l2[12] ^ l2[15] ^ l2[16];
+  l3[0] = l3[5] ^ l3[11] ^ l3[15] ^ l3[17];
+
+  memcpy(m->lfsrs[0].state, l0, 13 * sizeof(bsvec_t));
+  m->lfsrs[0].zero = 0;
+  memcpy(m->lfsrs[1].state, l1, 14 * sizeof(bsvec_t));
+  m->lfsrs[1].zero = 0;
+  memcpy(m->lfsrs[2].state, l2, 16 * sizeof(bsvec_t));
+  m->lfsrs[2].zero = 0;
+  memcpy(m->lfsrs[3].state, l3, 17 * sizeof(bsvec_t));
+  m->lfsrs[3].zero = 0;
+  memcpy(m->snA, snA, sizeof(snA));
+  memcpy(m->snB, snB, sizeof(snB));
+}
+
+/* Auto-generated by Rounds_print: 16 rounds of BS_HDCPStreamCipher */
+static void BS_HDCPRounds16(BS_HDCPCipherState *hs, bsvec_t output[16][24])
+{
+  BS_LFSRModule *m = &hs->lm;
+  bsvec_t (*K)[28] = hs->bm.K, (*B)[28] = hs->bm.B;
+  bsvec_t Kspare[28], Bspare[28], snA[4], snB[4], D;
+  bsvec_t l0[29], l1[30], l2[32], l3[33];
+  int i;
+
+  for (i = 0; i < 13; i++)
+    l0[16 + i] = BS_LFSRBit(&m->lfsrs[0], i);
+  for (i = 0; i < 14; i++)
+    l1[16 + i] = BS_LFSRBit(&m->lfsrs[1], i);
+  for (i = 0; i < 16; i++)
+    l2[16 + i] = BS_LFSRBit(&m->lfsrs[2], i);
+  for (i = 0; i < 17; i++)
+    l3[16 + i] = BS_LFSRBit(&m->lfsrs[3], i);
+  memcpy(snA, m->snA, sizeof(snA));
+  memcpy(snB, m->snB, sizeof(snB));
+
+  /* Round 0 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[0]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[19] ^ l1[20] ^ l2[21] ^ l3[21];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[23]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[24]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[25]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[27]);
+  D ^= l0[28] ^ l1[29] ^ l2[31] ^ l3[32];
+  l0[15] = l0[20] ^ l0[24] ^ l0[26] ^ l0[28];
+  l1[15] = l1[19] ^ l1[21] ^ l1[22] ^ l1[25] ^ l1[26] ^ l1[29];
+  l2[15] = l2[20] ^ l2[22] ^ l2[23] ^ l2[27] ^ l2[30] ^ l2[31];
+  l3[15] = l3[20] ^ l3[26] ^ l3[30] ^ l3[32];
+
+  /* Round 1 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[1]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[18] ^ l1[19] ^ l2[20] ^ l3[20];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[22]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[23]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[24]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[26]);
+  D ^= l0[27] ^ l1[28] ^ l2[30] ^ l3[31];
+  l0[14] = l0[19] ^ l0[23] ^ l0[25] ^ l0[27];
+  l1[14] = l1[18] ^ l1[20] ^ l1[21] ^ l1[24] ^ l1[25] ^ l1[28];
+  l2[14] = l2[19] ^ l2[21] ^ l2[22] ^ l2[26] ^ l2[29] ^ l2[30];
+  l3[14] = l3[19] ^ l3[25] ^ l3[29] ^ l3[31];
+
+  /* Round 2 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[2]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[17] ^ l1[18] ^ l2[19] ^ l3[19];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[21]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[22]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[23]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[25]);
+  D ^= l0[26] ^ l1[27] ^ l2[29] ^ l3[30];
+  l0[13] = l0[18] ^ l0[22] ^ l0[24] ^ l0[26];
+  l1[13] = l1[17] ^ l1[19] ^ l1[20] ^ l1[23] ^ l1[24] ^ l1[27];
+  l2[13] = l2[18] ^ l2[20] ^ l2[21] ^ l2[25] ^ l2[28] ^ l2[29];
+  l3[13] = l3[18] ^ l3[24] ^ l3[28] ^ l3[30];
+
+  /* Round 3 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[3]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[16] ^ l1[17] ^ l2[18] ^ l3[18];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[20]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[21]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[22]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[24]);
+  D ^= l0[25] ^ l1[26] ^ l2[28] ^ l3[29];
+  l0[12] = l0[17] ^ l0[21] ^ l0[23] ^ l0[25];
+  l1[12] = l1[16] ^ l1[18] ^ l1[19] ^ l1[22] ^ l1[23] ^ l1[26];
+  l2[12] = l2[17] ^ l2[19] ^ l2[20] ^ l2[24] ^ l2[27] ^ l2[28];
+  l3[12] = l3[17] ^ l3[23] ^ l3[27] ^ l3[29];
+
+  /* Round 4 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[4]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[15] ^ l1[16] ^ l2[17] ^ l3[17];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[19]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[20]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[21]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[23]);
+  D ^= l0[24] ^ l1[25] ^ l2[27] ^ l3[28];
+  l0[11] = l0[16] ^ l0[20] ^ l0[22] ^ l0[24];
+  l1[11] = l1[15] ^ l1[17] ^ l1[18] ^ l1[21] ^ l1[22] ^ l1[25];
+  l2[11] = l2[16] ^ l2[18] ^ l2[19] ^ l2[23] ^ l2[26] ^ l2[27];
+  l3[11] = l3[16] ^ l3[22] ^ l3[26] ^ l3[28];
+
+  /* Round 5 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[5]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[14] ^ l1[15] ^ l2[16] ^ l3[16];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[18]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[19]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[20]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[22]);
+  D ^= l0[23] ^ l1[24] ^ l2[26] ^ l3[27];
+  l0[10] = l0[15] ^ l0[19] ^ l0[21] ^ l0[23];
+  l1[10] = l1[14] ^ l1[16] ^ l1[17] ^ l1[20] ^ l1[21] ^ l1[24];
+  l2[10] = l2[15] ^ l2[17] ^ l2[18] ^ l2[22] ^ l2[25] ^ l2[26];
+  l3[10] = l3[15] ^ l3[21] ^ l3[25] ^ l3[27];
+
+  /* Round 6 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[6]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[13] ^ l1[14] ^ l2[15] ^ l3[15];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[17]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[18]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[19]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[21]);
+  D ^= l0[22] ^ l1[23] ^ l2[25] ^ l3[26];
+  l0[9] = l0[14] ^ l0[18] ^ l0[20] ^ l0[22];
+  l1[9] = l1[13] ^ l1[15] ^ l1[16] ^ l1[19] ^ l1[20] ^ l1[23];
+  l2[9] = l2[14] ^ l2[16] ^ l2[17] ^ l2[21] ^ l2[24] ^ l2[25];
+  l3[9] = l3[14] ^ l3[20] ^ l3[24] ^ l3[26];
+
+  /* Round 7 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[7]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[12] ^ l1[13] ^ l2[14] ^ l3[14];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[16]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[17]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[18]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[20]);
+  D ^= l0[21] ^ l1[22] ^ l2[24] ^ l3[25];
+  l0[8] = l0[13] ^ l0[17] ^ l0[19] ^ l0[21];
+  l1[8] = l1[12] ^ l1[14] ^ l1[15] ^ l1[18] ^ l1[19] ^ l1[22];
+  l2[8] = l2[13] ^ l2[15] ^ l2[16] ^ l2[20] ^ l2[23] ^ l2[24];
+  l3[8] = l3[13] ^ l3[19] ^ l3[23] ^ l3[25];
+
+  /* Round 8 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[8]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[11] ^ l1[12] ^ l2[13] ^ l3[13];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[15]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[16]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[17]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[19]);
+  D ^= l0[20] ^ l1[21] ^ l2[23] ^ l3[24];
+  l0[7] = l0[12] ^ l0[16] ^ l0[18] ^ l0[20];
+  l1[7] = l1[11] ^ l1[13] ^ l1[14] ^ l1[17] ^ l1[18] ^ l1[21];
+  l2[7] = l2[12] ^ l2[14] ^ l2[15] ^ l2[19] ^ l2[22] ^ l2[23];
+  l3[7] = l3[12] ^ l3[18] ^ l3[22] ^ l3[24];
+
+  /* Round 9 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[9]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[10] ^ l1[11] ^ l2[12] ^ l3[12];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[14]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[15]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[16]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[18]);
+  D ^= l0[19] ^ l1[20] ^ l2[22] ^ l3[23];
+  l0[6] = l0[11] ^ l0[15] ^ l0[17] ^ l0[19];
+  l1[6] = l1[10] ^ l1[12] ^ l1[13] ^ l1[16] ^ l1[17] ^ l1[20];
+  l2[6] = l2[11] ^ l2[13] ^ l2[14] ^ l2[18] ^ l2[21] ^ l2[22];
+  l3[6] = l3[11] ^ l3[17] ^ l3[21] ^ l3[23];
+
+  /* Round 10 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[10]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[9] ^ l1[10] ^ l2[11] ^ l3[11];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[13]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[14]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[15]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[17]);
+  D ^= l0[18] ^ l1[19] ^ l2[21] ^ l3[22];
+  l0[5] = l0[10] ^ l0[14] ^ l0[16] ^ l0[18];
+  l1[5] = l1[9] ^ l1[11] ^ l1[12] ^ l1[15] ^ l1[16] ^ l1[19];
+  l2[5] = l2[10] ^ l2[12] ^ l2[13] ^ l2[17] ^ l2[20] ^ l2[21];
+  l3[5] = l3[10] ^ l3[16] ^ l3[20] ^ l3[22];
+
+  /* Round 11 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[11]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[8] ^ l1[9] ^ l2[10] ^ l3[10];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[12]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[13]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[14]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[16]);
+  D ^= l0[17] ^ l1[18] ^ l2[20] ^ l3[21];
+  l0[4] = l0[9] ^ l0[13] ^ l0[15] ^ l0[17];
+  l1[4] = l1[8] ^ l1[10] ^ l1[11] ^ l1[14] ^ l1[15] ^ l1[18];
+  l2[4] = l2[9] ^ l2[11] ^ l2[12] ^ l2[16] ^ l2[19] ^ l2[20];
+  l3[4] = l3[9] ^ l3[15] ^ l3[19] ^ l3[21];
+
+  /* Round 12 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[12]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[7] ^ l1[8] ^ l2[9] ^ l3[9];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[11]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[12]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[13]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[15]);
+  D ^= l0[16] ^ l1[17] ^ l2[19] ^ l3[20];
+  l0[3] = l0[8] ^ l0[12] ^ l0[14] ^ l0[16];
+  l1[3] = l1[7] ^ l1[9] ^ l1[10] ^ l1[13] ^ l1[14] ^ l1[17];
+  l2[3] = l2[8] ^ l2[10] ^ l2[11] ^ l2[15] ^ l2[18] ^ l2[19];
+  l3[3] = l3[8] ^ l3[14] ^ l3[18] ^ l3[20];
+
+  /* Round 13 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[13]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[6] ^ l1[7] ^ l2[8] ^ l3[8];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[10]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[11]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[12]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[14]);
+  D ^= l0[15] ^ l1[16] ^ l2[18] ^ l3[19];
+  l0[2] = l0[7] ^ l0[11] ^ l0[13] ^ l0[15];
+  l1[2] = l1[6] ^ l1[8] ^ l1[9] ^ l1[12] ^ l1[13] ^ l1[16];
+  l2[2] = l2[7] ^ l2[9] ^ l2[10] ^ l2[14] ^ l2[17] ^ l2[18];
+  l3[2] = l3[7] ^ l3[13] ^ l3[17] ^ l3[19];
+
+  /* Round 14 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[14]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[5] ^ l1[6] ^ l2[7] ^ l3[7];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[9]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[10]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[11]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[13]);
+  D ^= l0[14] ^ l1[15] ^ l2[17] ^ l3[18];
+  l0[1] = l0[6] ^ l0[10] ^ l0[12] ^ l0[14];
+  l1[1] = l1[5] ^ l1[7] ^ l1[8] ^ l1[11] ^ l1[12] ^ l1[15];
+  l2[1] = l2[6] ^ l2[8] ^ l2[9] ^ l2[13] ^ l2[16] ^ l2[17];
+  l3[1] = l3[6] ^ l3[12] ^ l3[16] ^ l3[18];
+
+  /* Round 15 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[15]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[4] ^ l1[5] ^ l2[6] ^ l3[6];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[8]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[9]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[10]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[12]);
+  D ^= l0[13] ^ l1[14] ^ l2[16] ^ l3[17];
+  l0[0] = l0[5] ^ l0[9] ^ l0[11] ^ l0[13];
+  l1[0] = l1[4] ^ l1[6] ^ l1[7] ^ l1[10] ^ l1[11] ^ l1[14];
+  l2[0] = l2[5] ^ l2[7] ^ l2[8] ^ l2[12] ^ l2[15] ^ l2[16];
+  l3[0] = l3[5] ^ l3[11] ^ l3[15] ^ l3[17];
+
+  memcpy(m->lfsrs[0].state, l0, 13 * sizeof(bsvec_t));
+  m->lfsrs[0].zero = 0;
+  memcpy(m->lfsrs[1].state, l1, 14 * sizeof(bsvec_t));
+  m->lfsrs[1].zero = 0;
+  memcpy(m->lfsrs[2].state, l2, 16 * sizeof(bsvec_t));
+  m->lfsrs[2].zero = 0;
+  memcpy(m->lfsrs[3].state, l3, 17 * sizeof(bsvec_t));
+  m->lfsrs[3].zero = 0;
+  memcpy(m->snA, snA, sizeof(snA));
+  memcpy(m->snB, snB, sizeof(snB));
+}
+
+/* Auto-generated by Rounds_print: 64 rounds of BS_HDCPStreamCipher */
+static void BS_HDCPRounds64(BS_HDCPCipherState *hs, bsvec_t output[64][24])
+{
+  BS_LFSRModule *m = &hs->lm;
+  bsvec_t (*K)[28] = hs->bm.K, (*B)[28] = hs->bm.B;
+  bsvec_t Kspare[28], Bspare[28], snA[4], snB[4], D;
+  bsvec_t l0[77], l1[78], l2[80], l3[81];
+  int i;
+
+  for (i = 0; i < 13; i++)
+    l0[64 + i] = BS_LFSRBit(&m->lfsrs[0], i);
+  for (i = 0; i < 14; i++)
+    l1[64 + i] = BS_LFSRBit(&m->lfsrs[1], i);
+  for (i = 0; i < 16; i++)
+    l2[64 + i] = BS_LFSRBit(&m->lfsrs[2], i);
+  for (i = 0; i < 17; i++)
+    l3[64 + i] = BS_LFSRBit(&m->lfsrs[3], i);
+  memcpy(snA, m->snA, sizeof(snA));
+  memcpy(snB, m->snB, sizeof(snB));
+
+  /* Round 0 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[0]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[67] ^ l1[68] ^ l2[69] ^ l3[69];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[71]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[72]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[73]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[75]);
+  D ^= l0[76] ^ l1[77] ^ l2[79] ^ l3[80];
+  l0[63] = l0[68] ^ l0[72] ^ l0[74] ^ l0[76];
+  l1[63] = l1[67] ^ l1[69] ^ l1[70] ^ l1[73] ^ l1[74] ^ l1[77];
+  l2[63] = l2[68] ^ l2[70] ^ l2[71] ^ l2[75] ^ l2[78] ^ l2[79];
+  l3[63] = l3[68] ^ l3[74] ^ l3[78] ^ l3[80];
+
+  /* Round 1 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[1]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[66] ^ l1[67] ^ l2[68] ^ l3[68];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[70]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[71]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[72]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[74]);
+  D ^= l0[75] ^ l1[76] ^ l2[78] ^ l3[79];
+  l0[62] = l0[67] ^ l0[71] ^ l0[73] ^ l0[75];
+  l1[62] = l1[66] ^ l1[68] ^ l1[69] ^ l1[72] ^ l1[73] ^ l1[76];
+  l2[62] = l2[67] ^ l2[69] ^ l2[70] ^ l2[74] ^ l2[77] ^ l2[78];
+  l3[62] = l3[67] ^ l3[73] ^ l3[77] ^ l3[79];
+
+  /* Round 2 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[2]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[65] ^ l1[66] ^ l2[67] ^ l3[67];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[69]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[70]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[71]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[73]);
+  D ^= l0[74] ^ l1[75] ^ l2[77] ^ l3[78];
+  l0[61] = l0[66] ^ l0[70] ^ l0[72] ^ l0[74];
+  l1[61] = l1[65] ^ l1[67] ^ l1[68] ^ l1[71] ^ l1[72] ^ l1[75];
+  l2[61] = l2[66] ^ l2[68] ^ l2[69] ^ l2[73] ^ l2[76] ^ l2[77];
+  l3[61] = l3[66] ^ l3[72] ^ l3[76] ^ l3[78];
+
+  /* Round 3 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[3]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[64] ^ l1[65] ^ l2[66] ^ l3[66];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[68]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[69]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[70]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[72]);
+  D ^= l0[73] ^ l1[74] ^ l2[76] ^ l3[77];
+  l0[60] = l0[65] ^ l0[69] ^ l0[71] ^ l0[73];
+  l1[60] = l1[64] ^ l1[66] ^ l1[67] ^ l1[70] ^ l1[71] ^ l1[74];
+  l2[60] = l2[65] ^ l2[67] ^ l2[68] ^ l2[72] ^ l2[75] ^ l2[76];
+  l3[60] = l3[65] ^ l3[71] ^ l3[75] ^ l3[77];
+
+  /* Round 4 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[4]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[63] ^ l1[64] ^ l2[65] ^ l3[65];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[67]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[68]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[69]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[71]);
+  D ^= l0[72] ^ l1[73] ^ l2[75] ^ l3[76];
+  l0[59] = l0[64] ^ l0[68] ^ l0[70] ^ l0[72];
+  l1[59] = l1[63] ^ l1[65] ^ l1[66] ^ l1[69] ^ l1[70] ^ l1[73];
+  l2[59] = l2[64] ^ l2[66] ^ l2[67] ^ l2[71] ^ l2[74] ^ l2[75];
+  l3[59] = l3[64] ^ l3[70] ^ l3[74] ^ l3[76];
+
+  /* Round 5 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[5]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[62] ^ l1[63] ^ l2[64] ^ l3[64];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[66]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[67]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[68]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[70]);
+  D ^= l0[71] ^ l1[72] ^ l2[74] ^ l3[75];
+  l0[58] = l0[63] ^ l0[67] ^ l0[69] ^ l0[71];
+  l1[58] = l1[62] ^ l1[64] ^ l1[65] ^ l1[68] ^ l1[69] ^ l1[72];
+  l2[58] = l2[63] ^ l2[65] ^ l2[66] ^ l2[70] ^ l2[73] ^ l2[74];
+  l3[58] = l3[63] ^ l3[69] ^ l3[73] ^ l3[75];
+
+  /* Round 6 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[6]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[61] ^ l1[62] ^ l2[63] ^ l3[63];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[65]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[66]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[67]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[69]);
+  D ^= l0[70] ^ l1[71] ^ l2[73] ^ l3[74];
+  l0[57] = l0[62] ^ l0[66] ^ l0[68] ^ l0[70];
+  l1[57] = l1[61] ^ l1[63] ^ l1[64] ^ l1[67] ^ l1[68] ^ l1[71];
+  l2[57] = l2[62] ^ l2[64] ^ l2[65] ^ l2[69] ^ l2[72] ^ l2[73];
+  l3[57] = l3[62] ^ l3[68] ^ l3[72] ^ l3[74];
+
+  /* Round 7 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[7]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[60] ^ l1[61] ^ l2[62] ^ l3[62];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[64]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[65]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[66]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[68]);
+  D ^= l0[69] ^ l1[70] ^ l2[72] ^ l3[73];
+  l0[56] = l0[61] ^ l0[65] ^ l0[67] ^ l0[69];
+  l1[56] = l1[60] ^ l1[62] ^ l1[63] ^ l1[66] ^ l1[67] ^ l1[70];
+  l2[56] = l2[61] ^ l2[63] ^ l2[64] ^ l2[68] ^ l2[71] ^ l2[72];
+  l3[56] = l3[61] ^ l3[67] ^ l3[71] ^ l3[73];
+
+  /* Round 8 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[8]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[59] ^ l1[60] ^ l2[61] ^ l3[61];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[63]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[64]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[65]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[67]);
+  D ^= l0[68] ^ l1[69] ^ l2[71] ^ l3[72];
+  l0[55] = l0[60] ^ l0[64] ^ l0[66] ^ l0[68];
+  l1[55] = l1[59] ^ l1[61] ^ l1[62] ^ l1[65] ^ l1[66] ^ l1[69];
+  l2[55] = l2[60] ^ l2[62] ^ l2[63] ^ l2[67] ^ l2[70] ^ l2[71];
+  l3[55] = l3[60] ^ l3[66] ^ l3[70] ^ l3[72];
+
+  /* Round 9 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[9]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[58] ^ l1[59] ^ l2[60] ^ l3[60];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[62]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[63]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[64]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[66]);
+  D ^= l0[67] ^ l1[68] ^ l2[70] ^ l3[71];
+  l0[54] = l0[59] ^ l0[63] ^ l0[65] ^ l0[67];
+  l1[54] = l1[58] ^ l1[60] ^ l1[61] ^ l1[64] ^ l1[65] ^ l1[68];
+  l2[54] = l2[59] ^ l2[61] ^ l2[62] ^ l2[66] ^ l2[69] ^ l2[70];
+  l3[54] = l3[59] ^ l3[65] ^ l3[69] ^ l3[71];
+
+  /* Round 10 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[10]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[57] ^ l1[58] ^ l2[59] ^ l3[59];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[61]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[62]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[63]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[65]);
+  D ^= l0[66] ^ l1[67] ^ l2[69] ^ l3[70];
+  l0[53] = l0[58] ^ l0[62] ^ l0[64] ^ l0[66];
+  l1[53] = l1[57] ^ l1[59] ^ l1[60] ^ l1[63] ^ l1[64] ^ l1[67];
+  l2[53] = l2[58] ^ l2[60] ^ l2[61] ^ l2[65] ^ l2[68] ^ l2[69];
+  l3[53] = l3[58] ^ l3[64] ^ l3[68] ^ l3[70];
+
+  /* Round 11 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[11]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[56] ^ l1[57] ^ l2[58] ^ l3[58];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[60]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[61]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[62]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[64]);
+  D ^= l0[65] ^ l1[66] ^ l2[68] ^ l3[69];
+  l0[52] = l0[57] ^ l0[61] ^ l0[63] ^ l0[65];
+  l1[52] = l1[56] ^ l1[58] ^ l1[59] ^ l1[62] ^ l1[63] ^ l1[66];
+  l2[52] = l2[57] ^ l2[59] ^ l2[60] ^ l2[64] ^ l2[67] ^ l2[68];
+  l3[52] = l3[57] ^ l3[63] ^ l3[67] ^ l3[69];
+
+  /* Round 12 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[12]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[55] ^ l1[56] ^ l2[57] ^ l3[57];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[59]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[60]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[61]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[63]);
+  D ^= l0[64] ^ l1[65] ^ l2[67] ^ l3[68];
+  l0[51] = l0[56] ^ l0[60] ^ l0[62] ^ l0[64];
+  l1[51] = l1[55] ^ l1[57] ^ l1[58] ^ l1[61] ^ l1[62] ^ l1[65];
+  l2[51] = l2[56] ^ l2[58] ^ l2[59] ^ l2[63] ^ l2[66] ^ l2[67];
+  l3[51] = l3[56] ^ l3[62] ^ l3[66] ^ l3[68];
+
+  /* Round 13 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[13]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[54] ^ l1[55] ^ l2[56] ^ l3[56];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[58]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[59]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[60]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[62]);
+  D ^= l0[63] ^ l1[64] ^ l2[66] ^ l3[67];
+  l0[50] = l0[55] ^ l0[59] ^ l0[61] ^ l0[63];
+  l1[50] = l1[54] ^ l1[56] ^ l1[57] ^ l1[60] ^ l1[61] ^ l1[64];
+  l2[50] = l2[55] ^ l2[57] ^ l2[58] ^ l2[62] ^ l2[65] ^ l2[66];
+  l3[50] = l3[55] ^ l3[61] ^ l3[65] ^ l3[67];
+
+  /* Round 14 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[14]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[53] ^ l1[54] ^ l2[55] ^ l3[55];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[57]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[58]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[59]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[61]);
+  D ^= l0[62] ^ l1[63] ^ l2[65] ^ l3[66];
+  l0[49] = l0[54] ^ l0[58] ^ l0[60] ^ l0[62];
+  l1[49] = l1[53] ^ l1[55] ^ l1[56] ^ l1[59] ^ l1[60] ^ l1[63];
+  l2[49] = l2[54] ^ l2[56] ^ l2[57] ^ l2[61] ^ l2[64] ^ l2[65];
+  l3[49] = l3[54] ^ l3[60] ^ l3[64] ^ l3[66];
+
+  /* Round 15 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[15]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[52] ^ l1[53] ^ l2[54] ^ l3[54];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[56]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[57]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[58]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[60]);
+  D ^= l0[61] ^ l1[62] ^ l2[64] ^ l3[65];
+  l0[48] = l0[53] ^ l0[57] ^ l0[59] ^ l0[61];
+  l1[48] = l1[52] ^ l1[54] ^ l1[55] ^ l1[58] ^ l1[59] ^ l1[62];
+  l2[48] = l2[53] ^ l2[55] ^ l2[56] ^ l2[60] ^ l2[63] ^ l2[64];
+  l3[48] = l3[53] ^ l3[59] ^ l3[63] ^ l3[65];
+
+  /* Round 16 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[16]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[51] ^ l1[52] ^ l2[53] ^ l3[53];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[55]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[56]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[57]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[59]);
+  D ^= l0[60] ^ l1[61] ^ l2[63] ^ l3[64];
+  l0[47] = l0[52] ^ l0[56] ^ l0[58] ^ l0[60];
+  l1[47] = l1[51] ^ l1[53] ^ l1[54] ^ l1[57] ^ l1[58] ^ l1[61];
+  l2[47] = l2[52] ^ l2[54] ^ l2[55] ^ l2[59] ^ l2[62] ^ l2[63];
+  l3[47] = l3[52] ^ l3[58] ^ l3[62] ^ l3[64];
+
+  /* Round 17 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[17]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[50] ^ l1[51] ^ l2[52] ^ l3[52];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[54]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[55]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[56]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[58]);
+  D ^= l0[59] ^ l1[60] ^ l2[62] ^ l3[63];
+  l0[46] = l0[51] ^ l0[55] ^ l0[57] ^ l0[59];
+  l1[46] = l1[50] ^ l1[52] ^ l1[53] ^ l1[56] ^ l1[57] ^ l1[60];
+  l2[46] = l2[51] ^ l2[53] ^ l2[54] ^ l2[58] ^ l2[61] ^ l2[62];
+  l3[46] = l3[51] ^ l3[57] ^ l3[61] ^ l3[63];
+
+  /* Round 18 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[18]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[49] ^ l1[50] ^ l2[51] ^ l3[51];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[53]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[54]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[55]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[57]);
+  D ^= l0[58] ^ l1[59] ^ l2[61] ^ l3[62];
+  l0[45] = l0[50] ^ l0[54] ^ l0[56] ^ l0[58];
+  l1[45] = l1[49] ^ l1[51] ^ l1[52] ^ l1[55] ^ l1[56] ^ l1[59];
+  l2[45] = l2[50] ^ l2[52] ^ l2[53] ^ l2[57] ^ l2[60] ^ l2[61];
+  l3[45] = l3[50] ^ l3[56] ^ l3[60] ^ l3[62];
+
+  /* Round 19 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[19]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[48] ^ l1[49] ^ l2[50] ^ l3[50];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[52]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[53]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[54]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[56]);
+  D ^= l0[57] ^ l1[58] ^ l2[60] ^ l3[61];
+  l0[44] = l0[49] ^ l0[53] ^ l0[55] ^ l0[57];
+  l1[44] = l1[48] ^ l1[50] ^ l1[51] ^ l1[54] ^ l1[55] ^ l1[58];
+  l2[44] = l2[49] ^ l2[51] ^ l2[52] ^ l2[56] ^ l2[59] ^ l2[60];
+  l3[44] = l3[49] ^ l3[55] ^ l3[59] ^ l3[61];
+
+  /* Round 20 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[20]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[47] ^ l1[48] ^ l2[49] ^ l3[49];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[51]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[52]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[53]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[55]);
+  D ^= l0[56] ^ l1[57] ^ l2[59] ^ l3[60];
+  l0[43] = l0[48] ^ l0[52] ^ l0[54] ^ l0[56];
+  l1[43] = l1[47] ^ l1[49] ^ l1[50] ^ l1[53] ^ l1[54] ^ l1[57];
+  l2[43] = l2[48] ^ l2[50] ^ l2[51] ^ l2[55] ^ l2[58] ^ l2[59];
+  l3[43] = l3[48] ^ l3[54] ^ l3[58] ^ l3[60];
+
+  /* Round 21 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[21]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[46] ^ l1[47] ^ l2[48] ^ l3[48];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[50]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[51]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[52]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[54]);
+  D ^= l0[55] ^ l1[56] ^ l2[58] ^ l3[59];
+  l0[42] = l0[47] ^ l0[51] ^ l0[53] ^ l0[55];
+  l1[42] = l1[46] ^ l1[48] ^ l1[49] ^ l1[52] ^ l1[53] ^ l1[56];
+  l2[42] = l2[47] ^ l2[49] ^ l2[50] ^ l2[54] ^ l2[57] ^ l2[58];
+  l3[42] = l3[47] ^ l3[53] ^ l3[57] ^ l3[59];
+
+  /* Round 22 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[22]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[45] ^ l1[46] ^ l2[47] ^ l3[47];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[49]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[50]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[51]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[53]);
+  D ^= l0[54] ^ l1[55] ^ l2[57] ^ l3[58];
+  l0[41] = l0[46] ^ l0[50] ^ l0[52] ^ l0[54];
+  l1[41] = l1[45] ^ l1[47] ^ l1[48] ^ l1[51] ^ l1[52] ^ l1[55];
+  l2[41] = l2[46] ^ l2[48] ^ l2[49] ^ l2[53] ^ l2[56] ^ l2[57];
+  l3[41] = l3[46] ^ l3[52] ^ l3[56] ^ l3[58];
+
+  /* Round 23 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[23]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[44] ^ l1[45] ^ l2[46] ^ l3[46];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[48]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[49]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[50]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[52]);
+  D ^= l0[53] ^ l1[54] ^ l2[56] ^ l3[57];
+  l0[40] = l0[45] ^ l0[49] ^ l0[51] ^ l0[53];
+  l1[40] = l1[44] ^ l1[46] ^ l1[47] ^ l1[50] ^ l1[51] ^ l1[54];
+  l2[40] = l2[45] ^ l2[47] ^ l2[48] ^ l2[52] ^ l2[55] ^ l2[56];
+  l3[40] = l3[45] ^ l3[51] ^ l3[55] ^ l3[57];
+
+  /* Round 24 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[24]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[43] ^ l1[44] ^ l2[45] ^ l3[45];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[47]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[48]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[49]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[51]);
+  D ^= l0[52] ^ l1[53] ^ l2[55] ^ l3[56];
+  l0[39] = l0[44] ^ l0[48] ^ l0[50] ^ l0[52];
+  l1[39] = l1[43] ^ l1[45] ^ l1[46] ^ l1[49] ^ l1[50] ^ l1[53];
+  l2[39] = l2[44] ^ l2[46] ^ l2[47] ^ l2[51] ^ l2[54] ^ l2[55];
+  l3[39] = l3[44] ^ l3[50] ^ l3[54] ^ l3[56];
+
+  /* Round 25 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[25]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[42] ^ l1[43] ^ l2[44] ^ l3[44];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[46]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[47]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[48]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[50]);
+  D ^= l0[51] ^ l1[52] ^ l2[54] ^ l3[55];
+  l0[38] = l0[43] ^ l0[47] ^ l0[49] ^ l0[51];
+  l1[38] = l1[42] ^ l1[44] ^ l1[45] ^ l1[48] ^ l1[49] ^ l1[52];
+  l2[38] = l2[43] ^ l2[45] ^ l2[46] ^ l2[50] ^ l2[53] ^ l2[54];
+  l3[38] = l3[43] ^ l3[49] ^ l3[53] ^ l3[55];
+
+  /* Round 26 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[26]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[41] ^ l1[42] ^ l2[43] ^ l3[43];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[45]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[46]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[47]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[49]);
+  D ^= l0[50] ^ l1[51] ^ l2[53] ^ l3[54];
+  l0[37] = l0[42] ^ l0[46] ^ l0[48] ^ l0[50];
+  l1[37] = l1[41] ^ l1[43] ^ l1[44] ^ l1[47] ^ l1[48] ^ l1[51];
+  l2[37] = l2[42] ^ l2[44] ^ l2[45] ^ l2[49] ^ l2[52] ^ l2[53];
+  l3[37] = l3[42] ^ l3[48] ^ l3[52] ^ l3[54];
+
+  /* Round 27 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[27]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[40] ^ l1[41] ^ l2[42] ^ l3[42];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[44]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[45]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[46]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[48]);
+  D ^= l0[49] ^ l1[50] ^ l2[52] ^ l3[53];
+  l0[36] = l0[41] ^ l0[45] ^ l0[47] ^ l0[49];
+  l1[36] = l1[40] ^ l1[42] ^ l1[43] ^ l1[46] ^ l1[47] ^ l1[50];
+  l2[36] = l2[41] ^ l2[43] ^ l2[44] ^ l2[48] ^ l2[51] ^ l2[52];
+  l3[36] = l3[41] ^ l3[47] ^ l3[51] ^ l3[53];
+
+  /* Round 28 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[28]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[39] ^ l1[40] ^ l2[41] ^ l3[41];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[43]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[44]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[45]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[47]);
+  D ^= l0[48] ^ l1[49] ^ l2[51] ^ l3[52];
+  l0[35] = l0[40] ^ l0[44] ^ l0[46] ^ l0[48];
+  l1[35] = l1[39] ^ l1[41] ^ l1[42] ^ l1[45] ^ l1[46] ^ l1[49];
+  l2[35] = l2[40] ^ l2[42] ^ l2[43] ^ l2[47] ^ l2[50] ^ l2[51];
+  l3[35] = l3[40] ^ l3[46] ^ l3[50] ^ l3[52];
+
+  /* Round 29 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[29]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[38] ^ l1[39] ^ l2[40] ^ l3[40];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[42]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[43]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[44]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[46]);
+  D ^= l0[47] ^ l1[48] ^ l2[50] ^ l3[51];
+  l0[34] = l0[39] ^ l0[43] ^ l0[45] ^ l0[47];
+  l1[34] = l1[38] ^ l1[40] ^ l1[41] ^ l1[44] ^ l1[45] ^ l1[48];
+  l2[34] = l2[39] ^ l2[41] ^ l2[42] ^ l2[46] ^ l2[49] ^ l2[50];
+  l3[34] = l3[39] ^ l3[45] ^ l3[49] ^ l3[51];
+
+  /* Round 30 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[30]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[37] ^ l1[38] ^ l2[39] ^ l3[39];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[41]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[42]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[43]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[45]);
+  D ^= l0[46] ^ l1[47] ^ l2[49] ^ l3[50];
+  l0[33] = l0[38] ^ l0[42] ^ l0[44] ^ l0[46];
+  l1[33] = l1[37] ^ l1[39] ^ l1[40] ^ l1[43] ^ l1[44] ^ l1[47];
+  l2[33] = l2[38] ^ l2[40] ^ l2[41] ^ l2[45] ^ l2[48] ^ l2[49];
+  l3[33] = l3[38] ^ l3[44] ^ l3[48] ^ l3[50];
+
+  /* Round 31 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[31]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[36] ^ l1[37] ^ l2[38] ^ l3[38];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[40]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[41]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[42]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[44]);
+  D ^= l0[45] ^ l1[46] ^ l2[48] ^ l3[49];
+  l0[32] = l0[37] ^ l0[41] ^ l0[43] ^ l0[45];
+  l1[32] = l1[36] ^ l1[38] ^ l1[39] ^ l1[42] ^ l1[43] ^ l1[46];
+  l2[32] = l2[37] ^ l2[39] ^ l2[40] ^ l2[44] ^ l2[47] ^ l2[48];
+  l3[32] = l3[37] ^ l3[43] ^ l3[47] ^ l3[49];
+
+  /* Round 32 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[32]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[35] ^ l1[36] ^ l2[37] ^ l3[37];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[39]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[40]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[41]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[43]);
+  D ^= l0[44] ^ l1[45] ^ l2[47] ^ l3[48];
+  l0[31] = l0[36] ^ l0[40] ^ l0[42] ^ l0[44];
+  l1[31] = l1[35] ^ l1[37] ^ l1[38] ^ l1[41] ^ l1[42] ^ l1[45];
+  l2[31] = l2[36] ^ l2[38] ^ l2[39] ^ l2[43] ^ l2[46] ^ l2[47];
+  l3[31] = l3[36] ^ l3[42] ^ l3[46] ^ l3[48];
+
+  /* Round 33 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[33]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[34] ^ l1[35] ^ l2[36] ^ l3[36];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[38]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[39]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[40]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[42]);
+  D ^= l0[43] ^ l1[44] ^ l2[46] ^ l3[47];
+  l0[30] = l0[35] ^ l0[39] ^ l0[41] ^ l0[43];
+  l1[30] = l1[34] ^ l1[36] ^ l1[37] ^ l1[40] ^ l1[41] ^ l1[44];
+  l2[30] = l2[35] ^ l2[37] ^ l2[38] ^ l2[42] ^ l2[45] ^ l2[46];
+  l3[30] = l3[35] ^ l3[41] ^ l3[45] ^ l3[47];
+
+  /* Round 34 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[34]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[33] ^ l1[34] ^ l2[35] ^ l3[35];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[37]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[38]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[39]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[41]);
+  D ^= l0[42] ^ l1[43] ^ l2[45] ^ l3[46];
+  l0[29] = l0[34] ^ l0[38] ^ l0[40] ^ l0[42];
+  l1[29] = l1[33] ^ l1[35] ^ l1[36] ^ l1[39] ^ l1[40] ^ l1[43];
+  l2[29] = l2[34] ^ l2[36] ^ l2[37] ^ l2[41] ^ l2[44] ^ l2[45];
+  l3[29] = l3[34] ^ l3[40] ^ l3[44] ^ l3[46];
+
+  /* Round 35 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[35]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[32] ^ l1[33] ^ l2[34] ^ l3[34];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[36]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[37]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[38]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[40]);
+  D ^= l0[41] ^ l1[42] ^ l2[44] ^ l3[45];
+  l0[28] = l0[33] ^ l0[37] ^ l0[39] ^ l0[41];
+  l1[28] = l1[32] ^ l1[34] ^ l1[35] ^ l1[38] ^ l1[39] ^ l1[42];
+  l2[28] = l2[33] ^ l2[35] ^ l2[36] ^ l2[40] ^ l2[43] ^ l2[44];
+  l3[28] = l3[33] ^ l3[39] ^ l3[43] ^ l3[45];
+
+  /* Round 36 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[36]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[31] ^ l1[32] ^ l2[33] ^ l3[33];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[35]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[36]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[37]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[39]);
+  D ^= l0[40] ^ l1[41] ^ l2[43] ^ l3[44];
+  l0[27] = l0[32] ^ l0[36] ^ l0[38] ^ l0[40];
+  l1[27] = l1[31] ^ l1[33] ^ l1[34] ^ l1[37] ^ l1[38] ^ l1[41];
+  l2[27] = l2[32] ^ l2[34] ^ l2[35] ^ l2[39] ^ l2[42] ^ l2[43];
+  l3[27] = l3[32] ^ l3[38] ^ l3[42] ^ l3[44];
+
+  /* Round 37 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[37]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[30] ^ l1[31] ^ l2[32] ^ l3[32];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[34]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[35]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[36]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[38]);
+  D ^= l0[39] ^ l1[40] ^ l2[42] ^ l3[43];
+  l0[26] = l0[31] ^ l0[35] ^ l0[37] ^ l0[39];
+  l1[26] = l1[30] ^ l1[32] ^ l1[33] ^ l1[36] ^ l1[37] ^ l1[40];
+  l2[26] = l2[31] ^ l2[33] ^ l2[34] ^ l2[38] ^ l2[41] ^ l2[42];
+  l3[26] = l3[31] ^ l3[37] ^ l3[41] ^ l3[43];
+
+  /* Round 38 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[38]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[29] ^ l1[30] ^ l2[31] ^ l3[31];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[33]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[34]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[35]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[37]);
+  D ^= l0[38] ^ l1[39] ^ l2[41] ^ l3[42];
+  l0[25] = l0[30] ^ l0[34] ^ l0[36] ^ l0[38];
+  l1[25] = l1[29] ^ l1[31] ^ l1[32] ^ l1[35] ^ l1[36] ^ l1[39];
+  l2[25] = l2[30] ^ l2[32] ^ l2[33] ^ l2[37] ^ l2[40] ^ l2[41];
+  l3[25] = l3[30] ^ l3[36] ^ l3[40] ^ l3[42];
+
+  /* Round 39 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[39]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[28] ^ l1[29] ^ l2[30] ^ l3[30];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[32]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[33]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[34]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[36]);
+  D ^= l0[37] ^ l1[38] ^ l2[40] ^ l3[41];
+  l0[24] = l0[29] ^ l0[33] ^ l0[35] ^ l0[37];
+  l1[24] = l1[28] ^ l1[30] ^ l1[31] ^ l1[34] ^ l1[35] ^ l1[38];
+  l2[24] = l2[29] ^ l2[31] ^ l2[32] ^ l2[36] ^ l2[39] ^ l2[40];
+  l3[24] = l3[29] ^ l3[35] ^ l3[39] ^ l3[41];
+
+  /* Round 40 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[40]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[27] ^ l1[28] ^ l2[29] ^ l3[29];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[31]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[32]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[33]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[35]);
+  D ^= l0[36] ^ l1[37] ^ l2[39] ^ l3[40];
+  l0[23] = l0[28] ^ l0[32] ^ l0[34] ^ l0[36];
+  l1[23] = l1[27] ^ l1[29] ^ l1[30] ^ l1[33] ^ l1[34] ^ l1[37];
+  l2[23] = l2[28] ^ l2[30] ^ l2[31] ^ l2[35] ^ l2[38] ^ l2[39];
+  l3[23] = l3[28] ^ l3[34] ^ l3[38] ^ l3[40];
+
+  /* Round 41 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[41]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[26] ^ l1[27] ^ l2[28] ^ l3[28];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[30]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[31]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[32]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[34]);
+  D ^= l0[35] ^ l1[36] ^ l2[38] ^ l3[39];
+  l0[22] = l0[27] ^ l0[31] ^ l0[33] ^ l0[35];
+  l1[22] = l1[26] ^ l1[28] ^ l1[29] ^ l1[32] ^ l1[33] ^ l1[36];
+  l2[22] = l2[27] ^ l2[29] ^ l2[30] ^ l2[34] ^ l2[37] ^ l2[38];
+  l3[22] = l3[27] ^ l3[33] ^ l3[37] ^ l3[39];
+
+  /* Round 42 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[42]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[25] ^ l1[26] ^ l2[27] ^ l3[27];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[29]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[30]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[31]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[33]);
+  D ^= l0[34] ^ l1[35] ^ l2[37] ^ l3[38];
+  l0[21] = l0[26] ^ l0[30] ^ l0[32] ^ l0[34];
+  l1[21] = l1[25] ^ l1[27] ^ l1[28] ^ l1[31] ^ l1[32] ^ l1[35];
+  l2[21] = l2[26] ^ l2[28] ^ l2[29] ^ l2[33] ^ l2[36] ^ l2[37];
+  l3[21] = l3[26] ^ l3[32] ^ l3[36] ^ l3[38];
+
+  /* Round 43 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[43]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[24] ^ l1[25] ^ l2[26] ^ l3[26];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[28]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[29]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[30]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[32]);
+  D ^= l0[33] ^ l1[34] ^ l2[36] ^ l3[37];
+  l0[20] = l0[25] ^ l0[29] ^ l0[31] ^ l0[33];
+  l1[20] = l1[24] ^ l1[26] ^ l1[27] ^ l1[30] ^ l1[31] ^ l1[34];
+  l2[20] = l2[25] ^ l2[27] ^ l2[28] ^ l2[32] ^ l2[35] ^ l2[36];
+  l3[20] = l3[25] ^ l3[31] ^ l3[35] ^ l3[37];
+
+  /* Round 44 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[44]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[23] ^ l1[24] ^ l2[25] ^ l3[25];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[27]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[28]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[29]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[31]);
+  D ^= l0[32] ^ l1[33] ^ l2[35] ^ l3[36];
+  l0[19] = l0[24] ^ l0[28] ^ l0[30] ^ l0[32];
+  l1[19] = l1[23] ^ l1[25] ^ l1[26] ^ l1[29] ^ l1[30] ^ l1[33];
+  l2[19] = l2[24] ^ l2[26] ^ l2[27] ^ l2[31] ^ l2[34] ^ l2[35];
+  l3[19] = l3[24] ^ l3[30] ^ l3[34] ^ l3[36];
+
+  /* Round 45 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[45]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[22] ^ l1[23] ^ l2[24] ^ l3[24];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[26]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[27]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[28]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[30]);
+  D ^= l0[31] ^ l1[32] ^ l2[34] ^ l3[35];
+  l0[18] = l0[23] ^ l0[27] ^ l0[29] ^ l0[31];
+  l1[18] = l1[22] ^ l1[24] ^ l1[25] ^ l1[28] ^ l1[29] ^ l1[32];
+  l2[18] = l2[23] ^ l2[25] ^ l2[26] ^ l2[30] ^ l2[33] ^ l2[34];
+  l3[18] = l3[23] ^ l3[29] ^ l3[33] ^ l3[35];
+
+  /* Round 46 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[46]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[21] ^ l1[22] ^ l2[23] ^ l3[23];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[25]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[26]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[27]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[29]);
+  D ^= l0[30] ^ l1[31] ^ l2[33] ^ l3[34];
+  l0[17] = l0[22] ^ l0[26] ^ l0[28] ^ l0[30];
+  l1[17] = l1[21] ^ l1[23] ^ l1[24] ^ l1[27] ^ l1[28] ^ l1[31];
+  l2[17] = l2[22] ^ l2[24] ^ l2[25] ^ l2[29] ^ l2[32] ^ l2[33];
+  l3[17] = l3[22] ^ l3[28] ^ l3[32] ^ l3[34];
+
+  /* Round 47 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[47]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[20] ^ l1[21] ^ l2[22] ^ l3[22];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[24]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[25]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[26]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[28]);
+  D ^= l0[29] ^ l1[30] ^ l2[32] ^ l3[33];
+  l0[16] = l0[21] ^ l0[25] ^ l0[27] ^ l0[29];
+  l1[16] = l1[20] ^ l1[22] ^ l1[23] ^ l1[26] ^ l1[27] ^ l1[30];
+  l2[16] = l2[21] ^ l2[23] ^ l2[24] ^ l2[28] ^ l2[31] ^ l2[32];
+  l3[16] = l3[21] ^ l3[27] ^ l3[31] ^ l3[33];
+
+  /* Round 48 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[48]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[19] ^ l1[20] ^ l2[21] ^ l3[21];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[23]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[24]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[25]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[27]);
+  D ^= l0[28] ^ l1[29] ^ l2[31] ^ l3[32];
+  l0[15] = l0[20] ^ l0[24] ^ l0[26] ^ l0[28];
+  l1[15] = l1[19] ^ l1[21] ^ l1[22] ^ l1[25] ^ l1[26] ^ l1[29];
+  l2[15] = l2[20] ^ l2[22] ^ l2[23] ^ l2[27] ^ l2[30] ^ l2[31];
+  l3[15] = l3[20] ^ l3[26] ^ l3[30] ^ l3[32];
+
+  /* Round 49 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[49]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[18] ^ l1[19] ^ l2[20] ^ l3[20];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[22]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[23]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[24]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[26]);
+  D ^= l0[27] ^ l1[28] ^ l2[30] ^ l3[31];
+  l0[14] = l0[19] ^ l0[23] ^ l0[25] ^ l0[27];
+  l1[14] = l1[18] ^ l1[20] ^ l1[21] ^ l1[24] ^ l1[25] ^ l1[28];
+  l2[14] = l2[19] ^ l2[21] ^ l2[22] ^ l2[26] ^ l2[29] ^ l2[30];
+  l3[14] = l3[19] ^ l3[25] ^ l3[29] ^ l3[31];
+
+  /* Round 50 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[50]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[17] ^ l1[18] ^ l2[19] ^ l3[19];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[21]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[22]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[23]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[25]);
+  D ^= l0[26] ^ l1[27] ^ l2[29] ^ l3[30];
+  l0[13] = l0[18] ^ l0[22] ^ l0[24] ^ l0[26];
+  l1[13] = l1[17] ^ l1[19] ^ l1[20] ^ l1[23] ^ l1[24] ^ l1[27];
+  l2[13] = l2[18] ^ l2[20] ^ l2[21] ^ l2[25] ^ l2[28] ^ l2[29];
+  l3[13] = l3[18] ^ l3[24] ^ l3[28] ^ l3[30];
+
+  /* Round 51 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[51]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[16] ^ l1[17] ^ l2[18] ^ l3[18];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[20]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[21]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[22]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[24]);
+  D ^= l0[25] ^ l1[26] ^ l2[28] ^ l3[29];
+  l0[12] = l0[17] ^ l0[21] ^ l0[23] ^ l0[25];
+  l1[12] = l1[16] ^ l1[18] ^ l1[19] ^ l1[22] ^ l1[23] ^ l1[26];
+  l2[12] = l2[17] ^ l2[19] ^ l2[20] ^ l2[24] ^ l2[27] ^ l2[28];
+  l3[12] = l3[17] ^ l3[23] ^ l3[27] ^ l3[29];
+
+  /* Round 52 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[52]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[15] ^ l1[16] ^ l2[17] ^ l3[17];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[19]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[20]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[21]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[23]);
+  D ^= l0[24] ^ l1[25] ^ l2[27] ^ l3[28];
+  l0[11] = l0[16] ^ l0[20] ^ l0[22] ^ l0[24];
+  l1[11] = l1[15] ^ l1[17] ^ l1[18] ^ l1[21] ^ l1[22] ^ l1[25];
+  l2[11] = l2[16] ^ l2[18] ^ l2[19] ^ l2[23] ^ l2[26] ^ l2[27];
+  l3[11] = l3[16] ^ l3[22] ^ l3[26] ^ l3[28];
+
+  /* Round 53 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[53]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[14] ^ l1[15] ^ l2[16] ^ l3[16];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[18]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[19]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[20]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[22]);
+  D ^= l0[23] ^ l1[24] ^ l2[26] ^ l3[27];
+  l0[10] = l0[15] ^ l0[19] ^ l0[21] ^ l0[23];
+  l1[10] = l1[14] ^ l1[16] ^ l1[17] ^ l1[20] ^ l1[21] ^ l1[24];
+  l2[10] = l2[15] ^ l2[17] ^ l2[18] ^ l2[22] ^ l2[25] ^ l2[26];
+  l3[10] = l3[15] ^ l3[21] ^ l3[25] ^ l3[27];
+
+  /* Round 54 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[54]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[13] ^ l1[14] ^ l2[15] ^ l3[15];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[17]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[18]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[19]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[21]);
+  D ^= l0[22] ^ l1[23] ^ l2[25] ^ l3[26];
+  l0[9] = l0[14] ^ l0[18] ^ l0[20] ^ l0[22];
+  l1[9] = l1[13] ^ l1[15] ^ l1[16] ^ l1[19] ^ l1[20] ^ l1[23];
+  l2[9] = l2[14] ^ l2[16] ^ l2[17] ^ l2[21] ^ l2[24] ^ l2[25];
+  l3[9] = l3[14] ^ l3[20] ^ l3[24] ^ l3[26];
+
+  /* Round 55 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[55]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[12] ^ l1[13] ^ l2[14] ^ l3[14];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[16]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[17]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[18]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[20]);
+  D ^= l0[21] ^ l1[22] ^ l2[24] ^ l3[25];
+  l0[8] = l0[13] ^ l0[17] ^ l0[19] ^ l0[21];
+  l1[8] = l1[12] ^ l1[14] ^ l1[15] ^ l1[18] ^ l1[19] ^ l1[22];
+  l2[8] = l2[13] ^ l2[15] ^ l2[16] ^ l2[20] ^ l2[23] ^ l2[24];
+  l3[8] = l3[13] ^ l3[19] ^ l3[23] ^ l3[25];
+
+  /* Round 56 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[56]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[11] ^ l1[12] ^ l2[13] ^ l3[13];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[15]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[16]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[17]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[19]);
+  D ^= l0[20] ^ l1[21] ^ l2[23] ^ l3[24];
+  l0[7] = l0[12] ^ l0[16] ^ l0[18] ^ l0[20];
+  l1[7] = l1[11] ^ l1[13] ^ l1[14] ^ l1[17] ^ l1[18] ^ l1[21];
+  l2[7] = l2[12] ^ l2[14] ^ l2[15] ^ l2[19] ^ l2[22] ^ l2[23];
+  l3[7] = l3[12] ^ l3[18] ^ l3[22] ^ l3[24];
+
+  /* Round 57 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[57]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[10] ^ l1[11] ^ l2[12] ^ l3[12];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[14]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[15]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[16]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[18]);
+  D ^= l0[19] ^ l1[20] ^ l2[22] ^ l3[23];
+  l0[6] = l0[11] ^ l0[15] ^ l0[17] ^ l0[19];
+  l1[6] = l1[10] ^ l1[12] ^ l1[13] ^ l1[16] ^ l1[17] ^ l1[20];
+  l2[6] = l2[11] ^ l2[13] ^ l2[14] ^ l2[18] ^ l2[21] ^ l2[22];
+  l3[6] = l3[11] ^ l3[17] ^ l3[21] ^ l3[23];
+
+  /* Round 58 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[58]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[9] ^ l1[10] ^ l2[11] ^ l3[11];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[13]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[14]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[15]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[17]);
+  D ^= l0[18] ^ l1[19] ^ l2[21] ^ l3[22];
+  l0[5] = l0[10] ^ l0[14] ^ l0[16] ^ l0[18];
+  l1[5] = l1[9] ^ l1[11] ^ l1[12] ^ l1[15] ^ l1[16] ^ l1[19];
+  l2[5] = l2[10] ^ l2[12] ^ l2[13] ^ l2[17] ^ l2[20] ^ l2[21];
+  l3[5] = l3[10] ^ l3[16] ^ l3[20] ^ l3[22];
+
+  /* Round 59 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[59]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[8] ^ l1[9] ^ l2[10] ^ l3[10];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[12]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[13]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[14]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[16]);
+  D ^= l0[17] ^ l1[18] ^ l2[20] ^ l3[21];
+  l0[4] = l0[9] ^ l0[13] ^ l0[15] ^ l0[17];
+  l1[4] = l1[8] ^ l1[10] ^ l1[11] ^ l1[14] ^ l1[15] ^ l1[18];
+  l2[4] = l2[9] ^ l2[11] ^ l2[12] ^ l2[16] ^ l2[19] ^ l2[20];
+  l3[4] = l3[9] ^ l3[15] ^ l3[19] ^ l3[21];
+
+  /* Round 60 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[60]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[7] ^ l1[8] ^ l2[9] ^ l3[9];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[11]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[12]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[13]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[15]);
+  D ^= l0[16] ^ l1[17] ^ l2[19] ^ l3[20];
+  l0[3] = l0[8] ^ l0[12] ^ l0[14] ^ l0[16];
+  l1[3] = l1[7] ^ l1[9] ^ l1[10] ^ l1[13] ^ l1[14] ^ l1[17];
+  l2[3] = l2[8] ^ l2[10] ^ l2[11] ^ l2[15] ^ l2[18] ^ l2[19];
+  l3[3] = l3[8] ^ l3[14] ^ l3[18] ^ l3[20];
+
+  /* Round 61 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[61]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[6] ^ l1[7] ^ l2[8] ^ l3[8];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[10]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[11]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[12]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[14]);
+  D ^= l0[15] ^ l1[16] ^ l2[18] ^ l3[19];
+  l0[2] = l0[7] ^ l0[11] ^ l0[13] ^ l0[15];
+  l1[2] = l1[6] ^ l1[8] ^ l1[9] ^ l1[12] ^ l1[13] ^ l1[16];
+  l2[2] = l2[7] ^ l2[9] ^ l2[10] ^ l2[14] ^ l2[17] ^ l2[18];
+  l3[2] = l3[7] ^ l3[13] ^ l3[17] ^ l3[19];
+
+  /* Round 62 */
+  BS_OutputFunction(B[2], B[1], K[2], K[1], output[62]);
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[5] ^ l1[6] ^ l2[7] ^ l3[7];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[9]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[10]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[11]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[13]);
+  D ^= l0[14] ^ l1[15] ^ l2[17] ^ l3[18];
+  l0[1] = l0[6] ^ l0[10] ^ l0[12] ^ l0[14];
+  l1[1] = l1[5] ^ l1[7] ^ l1[8] ^ l1[11] ^ l1[12] ^ l1[15];
+  l2[1] = l2[6] ^ l2[8] ^ l2[9] ^ l2[13] ^ l2[16] ^ l2[17];
+  l3[1] = l3[6] ^ l3[12] ^ l3[16] ^ l3[18];
+
+  /* Round 63 */
+  BS_OutputFunction(Bspare, B[1], Kspare, K[1], output[63]);
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[4] ^ l1[5] ^ l2[6] ^ l3[6];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[8]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[9]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[10]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[12]);
+  D ^= l0[13] ^ l1[14] ^ l2[16] ^ l3[17];
+  l0[0] = l0[5] ^ l0[9] ^ l0[11] ^ l0[13];
+  l1[0] = l1[4] ^ l1[6] ^ l1[7] ^ l1[10] ^ l1[11] ^ l1[14];
+  l2[0] = l2[5] ^ l2[7] ^ l2[8] ^ l2[12] ^ l2[15] ^ l2[16];
+  l3[0] = l3[5] ^ l3[11] ^ l3[15] ^ l3[17];
+
+  memcpy(m->lfsrs[0].state, l0, 13 * sizeof(bsvec_t));
+  m->lfsrs[0].zero = 0;
+  memcpy(m->lfsrs[1].state, l1, 14 * sizeof(bsvec_t));
+  m->lfsrs[1].zero = 0;
+  memcpy(m->lfsrs[2].state, l2, 16 * sizeof(bsvec_t));
+  m->lfsrs[2].zero = 0;
+  memcpy(m->lfsrs[3].state, l3, 17 * sizeof(bsvec_t));
+  m->lfsrs[3].zero = 0;
+  memcpy(m->snA, snA, sizeof(snA));
+  memcpy(m->snB, snB, sizeof(snB));
+}
+
+/* Auto-generated by Rounds_print: 52 rounds of HDCPRekeycipher */
+static void BS_HDCPRekeyRounds52(BS_HDCPCipherState *hs)
+{
+  BS_LFSRModule *m = &hs->lm;
+  bsvec_t (*K)[28] = hs->bm.K, (*B)[28] = hs->bm.B;
+  bsvec_t Kspare[28], Bspare[28], snA[4], snB[4], D;
+  bsvec_t l0[65], l1[66], l2[68], l3[69];
+  int i;
+
+  for (i = 0; i < 13; i++)
+    l0[52 + i] = BS_LFSRBit(&m->lfsrs[0], i);
+  for (i = 0; i < 14; i++)
+    l1[52 + i] = BS_LFSRBit(&m->lfsrs[1], i);
+  for (i = 0; i < 16; i++)
+    l2[52 + i] = BS_LFSRBit(&m->lfsrs[2], i);
+  for (i = 0; i < 17; i++)
+    l3[52 + i] = BS_LFSRBit(&m->lfsrs[3], i);
+  memcpy(snA, m->snA, sizeof(snA));
+  memcpy(snB, m->snB, sizeof(snB));
+
+  /* Round 0 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[55] ^ l1[56] ^ l2[57] ^ l3[57];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[59]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[60]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[61]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[63]);
+  D ^= l0[64] ^ l1[65] ^ l2[67] ^ l3[68];
+  l0[51] = l0[56] ^ l0[60] ^ l0[62] ^ l0[64];
+  l1[51] = l1[55] ^ l1[57] ^ l1[58] ^ l1[61] ^ l1[62] ^ l1[65];
+  l2[51] = l2[56] ^ l2[58] ^ l2[59] ^ l2[63] ^ l2[66] ^ l2[67];
+  l3[51] = l3[56] ^ l3[62] ^ l3[66] ^ l3[68];
+  K[1][13] = D;
+
+  /* Round 1 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[54] ^ l1[55] ^ l2[56] ^ l3[56];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[58]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[59]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[60]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[62]);
+  D ^= l0[63] ^ l1[64] ^ l2[66] ^ l3[67];
+  l0[50] = l0[55] ^ l0[59] ^ l0[61] ^ l0[63];
+  l1[50] = l1[54] ^ l1[56] ^ l1[57] ^ l1[60] ^ l1[61] ^ l1[64];
+  l2[50] = l2[55] ^ l2[57] ^ l2[58] ^ l2[62] ^ l2[65] ^ l2[66];
+  l3[50] = l3[55] ^ l3[61] ^ l3[65] ^ l3[67];
+  K[1][13] = D;
+
+  /* Round 2 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[53] ^ l1[54] ^ l2[55] ^ l3[55];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[57]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[58]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[59]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[61]);
+  D ^= l0[62] ^ l1[63] ^ l2[65] ^ l3[66];
+  l0[49] = l0[54] ^ l0[58] ^ l0[60] ^ l0[62];
+  l1[49] = l1[53] ^ l1[55] ^ l1[56] ^ l1[59] ^ l1[60] ^ l1[63];
+  l2[49] = l2[54] ^ l2[56] ^ l2[57] ^ l2[61] ^ l2[64] ^ l2[65];
+  l3[49] = l3[54] ^ l3[60] ^ l3[64] ^ l3[66];
+  K[1][13] = D;
+
+  /* Round 3 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[52] ^ l1[53] ^ l2[54] ^ l3[54];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[56]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[57]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[58]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[60]);
+  D ^= l0[61] ^ l1[62] ^ l2[64] ^ l3[65];
+  l0[48] = l0[53] ^ l0[57] ^ l0[59] ^ l0[61];
+  l1[48] = l1[52] ^ l1[54] ^ l1[55] ^ l1[58] ^ l1[59] ^ l1[62];
+  l2[48] = l2[53] ^ l2[55] ^ l2[56] ^ l2[60] ^ l2[63] ^ l2[64];
+  l3[48] = l3[53] ^ l3[59] ^ l3[63] ^ l3[65];
+  K[1][13] = D;
+
+  /* Round 4 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[51] ^ l1[52] ^ l2[53] ^ l3[53];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[55]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[56]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[57]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[59]);
+  D ^= l0[60] ^ l1[61] ^ l2[63] ^ l3[64];
+  l0[47] = l0[52] ^ l0[56] ^ l0[58] ^ l0[60];
+  l1[47] = l1[51] ^ l1[53] ^ l1[54] ^ l1[57] ^ l1[58] ^ l1[61];
+  l2[47] = l2[52] ^ l2[54] ^ l2[55] ^ l2[59] ^ l2[62] ^ l2[63];
+  l3[47] = l3[52] ^ l3[58] ^ l3[62] ^ l3[64];
+  K[1][13] = D;
+
+  /* Round 5 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[50] ^ l1[51] ^ l2[52] ^ l3[52];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[54]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[55]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[56]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[58]);
+  D ^= l0[59] ^ l1[60] ^ l2[62] ^ l3[63];
+  l0[46] = l0[51] ^ l0[55] ^ l0[57] ^ l0[59];
+  l1[46] = l1[50] ^ l1[52] ^ l1[53] ^ l1[56] ^ l1[57] ^ l1[60];
+  l2[46] = l2[51] ^ l2[53] ^ l2[54] ^ l2[58] ^ l2[61] ^ l2[62];
+  l3[46] = l3[51] ^ l3[57] ^ l3[61] ^ l3[63];
+  K[1][13] = D;
+
+  /* Round 6 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[49] ^ l1[50] ^ l2[51] ^ l3[51];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[53]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[54]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[55]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[57]);
+  D ^= l0[58] ^ l1[59] ^ l2[61] ^ l3[62];
+  l0[45] = l0[50] ^ l0[54] ^ l0[56] ^ l0[58];
+  l1[45] = l1[49] ^ l1[51] ^ l1[52] ^ l1[55] ^ l1[56] ^ l1[59];
+  l2[45] = l2[50] ^ l2[52] ^ l2[53] ^ l2[57] ^ l2[60] ^ l2[61];
+  l3[45] = l3[50] ^ l3[56] ^ l3[60] ^ l3[62];
+  K[1][13] = D;
+
+  /* Round 7 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[48] ^ l1[49] ^ l2[50] ^ l3[50];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[52]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[53]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[54]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[56]);
+  D ^= l0[57] ^ l1[58] ^ l2[60] ^ l3[61];
+  l0[44] = l0[49] ^ l0[53] ^ l0[55] ^ l0[57];
+  l1[44] = l1[48] ^ l1[50] ^ l1[51] ^ l1[54] ^ l1[55] ^ l1[58];
+  l2[44] = l2[49] ^ l2[51] ^ l2[52] ^ l2[56] ^ l2[59] ^ l2[60];
+  l3[44] = l3[49] ^ l3[55] ^ l3[59] ^ l3[61];
+  K[1][13] = D;
+
+  /* Round 8 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[47] ^ l1[48] ^ l2[49] ^ l3[49];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[51]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[52]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[53]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[55]);
+  D ^= l0[56] ^ l1[57] ^ l2[59] ^ l3[60];
+  l0[43] = l0[48] ^ l0[52] ^ l0[54] ^ l0[56];
+  l1[43] = l1[47] ^ l1[49] ^ l1[50] ^ l1[53] ^ l1[54] ^ l1[57];
+  l2[43] = l2[48] ^ l2[50] ^ l2[51] ^ l2[55] ^ l2[58] ^ l2[59];
+  l3[43] = l3[48] ^ l3[54] ^ l3[58] ^ l3[60];
+  K[1][13] = D;
+
+  /* Round 9 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[46] ^ l1[47] ^ l2[48] ^ l3[48];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[50]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[51]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[52]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[54]);
+  D ^= l0[55] ^ l1[56] ^ l2[58] ^ l3[59];
+  l0[42] = l0[47] ^ l0[51] ^ l0[53] ^ l0[55];
+  l1[42] = l1[46] ^ l1[48] ^ l1[49] ^ l1[52] ^ l1[53] ^ l1[56];
+  l2[42] = l2[47] ^ l2[49] ^ l2[50] ^ l2[54] ^ l2[57] ^ l2[58];
+  l3[42] = l3[47] ^ l3[53] ^ l3[57] ^ l3[59];
+  K[1][13] = D;
+
+  /* Round 10 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[45] ^ l1[46] ^ l2[47] ^ l3[47];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[49]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[50]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[51]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[53]);
+  D ^= l0[54] ^ l1[55] ^ l2[57] ^ l3[58];
+  l0[41] = l0[46] ^ l0[50] ^ l0[52] ^ l0[54];
+  l1[41] = l1[45] ^ l1[47] ^ l1[48] ^ l1[51] ^ l1[52] ^ l1[55];
+  l2[41] = l2[46] ^ l2[48] ^ l2[49] ^ l2[53] ^ l2[56] ^ l2[57];
+  l3[41] = l3[46] ^ l3[52] ^ l3[56] ^ l3[58];
+  K[1][13] = D;
+
+  /* Round 11 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[44] ^ l1[45] ^ l2[46] ^ l3[46];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[48]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[49]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[50]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[52]);
+  D ^= l0[53] ^ l1[54] ^ l2[56] ^ l3[57];
+  l0[40] = l0[45] ^ l0[49] ^ l0[51] ^ l0[53];
+  l1[40] = l1[44] ^ l1[46] ^ l1[47] ^ l1[50] ^ l1[51] ^ l1[54];
+  l2[40] = l2[45] ^ l2[47] ^ l2[48] ^ l2[52] ^ l2[55] ^ l2[56];
+  l3[40] = l3[45] ^ l3[51] ^ l3[55] ^ l3[57];
+  K[1][13] = D;
+
+  /* Round 12 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[43] ^ l1[44] ^ l2[45] ^ l3[45];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[47]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[48]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[49]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[51]);
+  D ^= l0[52] ^ l1[53] ^ l2[55] ^ l3[56];
+  l0[39] = l0[44] ^ l0[48] ^ l0[50] ^ l0[52];
+  l1[39] = l1[43] ^ l1[45] ^ l1[46] ^ l1[49] ^ l1[50] ^ l1[53];
+  l2[39] = l2[44] ^ l2[46] ^ l2[47] ^ l2[51] ^ l2[54] ^ l2[55];
+  l3[39] = l3[44] ^ l3[50] ^ l3[54] ^ l3[56];
+  K[1][13] = D;
+
+  /* Round 13 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[42] ^ l1[43] ^ l2[44] ^ l3[44];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[46]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[47]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[48]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[50]);
+  D ^= l0[51] ^ l1[52] ^ l2[54] ^ l3[55];
+  l0[38] = l0[43] ^ l0[47] ^ l0[49] ^ l0[51];
+  l1[38] = l1[42] ^ l1[44] ^ l1[45] ^ l1[48] ^ l1[49] ^ l1[52];
+  l2[38] = l2[43] ^ l2[45] ^ l2[46] ^ l2[50] ^ l2[53] ^ l2[54];
+  l3[38] = l3[43] ^ l3[49] ^ l3[53] ^ l3[55];
+  K[1][13] = D;
+
+  /* Round 14 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[41] ^ l1[42] ^ l2[43] ^ l3[43];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[45]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[46]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[47]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[49]);
+  D ^= l0[50] ^ l1[51] ^ l2[53] ^ l3[54];
+  l0[37] = l0[42] ^ l0[46] ^ l0[48] ^ l0[50];
+  l1[37] = l1[41] ^ l1[43] ^ l1[44] ^ l1[47] ^ l1[48] ^ l1[51];
+  l2[37] = l2[42] ^ l2[44] ^ l2[45] ^ l2[49] ^ l2[52] ^ l2[53];
+  l3[37] = l3[42] ^ l3[48] ^ l3[52] ^ l3[54];
+  K[1][13] = D;
+
+  /* Round 15 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[40] ^ l1[41] ^ l2[42] ^ l3[42];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[44]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[45]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[46]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[48]);
+  D ^= l0[49] ^ l1[50] ^ l2[52] ^ l3[53];
+  l0[36] = l0[41] ^ l0[45] ^ l0[47] ^ l0[49];
+  l1[36] = l1[40] ^ l1[42] ^ l1[43] ^ l1[46] ^ l1[47] ^ l1[50];
+  l2[36] = l2[41] ^ l2[43] ^ l2[44] ^ l2[48] ^ l2[51] ^ l2[52];
+  l3[36] = l3[41] ^ l3[47] ^ l3[51] ^ l3[53];
+  K[1][13] = D;
+
+  /* Round 16 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[39] ^ l1[40] ^ l2[41] ^ l3[41];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[43]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[44]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[45]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[47]);
+  D ^= l0[48] ^ l1[49] ^ l2[51] ^ l3[52];
+  l0[35] = l0[40] ^ l0[44] ^ l0[46] ^ l0[48];
+  l1[35] = l1[39] ^ l1[41] ^ l1[42] ^ l1[45] ^ l1[46] ^ l1[49];
+  l2[35] = l2[40] ^ l2[42] ^ l2[43] ^ l2[47] ^ l2[50] ^ l2[51];
+  l3[35] = l3[40] ^ l3[46] ^ l3[50] ^ l3[52];
+  K[1][13] = D;
+
+  /* Round 17 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[38] ^ l1[39] ^ l2[40] ^ l3[40];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[42]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[43]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[44]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[46]);
+  D ^= l0[47] ^ l1[48] ^ l2[50] ^ l3[51];
+  l0[34] = l0[39] ^ l0[43] ^ l0[45] ^ l0[47];
+  l1[34] = l1[38] ^ l1[40] ^ l1[41] ^ l1[44] ^ l1[45] ^ l1[48];
+  l2[34] = l2[39] ^ l2[41] ^ l2[42] ^ l2[46] ^ l2[49] ^ l2[50];
+  l3[34] = l3[39] ^ l3[45] ^ l3[49] ^ l3[51];
+  K[1][13] = D;
+
+  /* Round 18 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[37] ^ l1[38] ^ l2[39] ^ l3[39];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[41]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[42]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[43]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[45]);
+  D ^= l0[46] ^ l1[47] ^ l2[49] ^ l3[50];
+  l0[33] = l0[38] ^ l0[42] ^ l0[44] ^ l0[46];
+  l1[33] = l1[37] ^ l1[39] ^ l1[40] ^ l1[43] ^ l1[44] ^ l1[47];
+  l2[33] = l2[38] ^ l2[40] ^ l2[41] ^ l2[45] ^ l2[48] ^ l2[49];
+  l3[33] = l3[38] ^ l3[44] ^ l3[48] ^ l3[50];
+  K[1][13] = D;
+
+  /* Round 19 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[36] ^ l1[37] ^ l2[38] ^ l3[38];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[40]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[41]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[42]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[44]);
+  D ^= l0[45] ^ l1[46] ^ l2[48] ^ l3[49];
+  l0[32] = l0[37] ^ l0[41] ^ l0[43] ^ l0[45];
+  l1[32] = l1[36] ^ l1[38] ^ l1[39] ^ l1[42] ^ l1[43] ^ l1[46];
+  l2[32] = l2[37] ^ l2[39] ^ l2[40] ^ l2[44] ^ l2[47] ^ l2[48];
+  l3[32] = l3[37] ^ l3[43] ^ l3[47] ^ l3[49];
+  K[1][13] = D;
+
+  /* Round 20 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[35] ^ l1[36] ^ l2[37] ^ l3[37];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[39]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[40]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[41]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[43]);
+  D ^= l0[44] ^ l1[45] ^ l2[47] ^ l3[48];
+  l0[31] = l0[36] ^ l0[40] ^ l0[42] ^ l0[44];
+  l1[31] = l1[35] ^ l1[37] ^ l1[38] ^ l1[41] ^ l1[42] ^ l1[45];
+  l2[31] = l2[36] ^ l2[38] ^ l2[39] ^ l2[43] ^ l2[46] ^ l2[47];
+  l3[31] = l3[36] ^ l3[42] ^ l3[46] ^ l3[48];
+  K[1][13] = D;
+
+  /* Round 21 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[34] ^ l1[35] ^ l2[36] ^ l3[36];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[38]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[39]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[40]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[42]);
+  D ^= l0[43] ^ l1[44] ^ l2[46] ^ l3[47];
+  l0[30] = l0[35] ^ l0[39] ^ l0[41] ^ l0[43];
+  l1[30] = l1[34] ^ l1[36] ^ l1[37] ^ l1[40] ^ l1[41] ^ l1[44];
+  l2[30] = l2[35] ^ l2[37] ^ l2[38] ^ l2[42] ^ l2[45] ^ l2[46];
+  l3[30] = l3[35] ^ l3[41] ^ l3[45] ^ l3[47];
+  K[1][13] = D;
+
+  /* Round 22 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[33] ^ l1[34] ^ l2[35] ^ l3[35];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[37]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[38]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[39]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[41]);
+  D ^= l0[42] ^ l1[43] ^ l2[45] ^ l3[46];
+  l0[29] = l0[34] ^ l0[38] ^ l0[40] ^ l0[42];
+  l1[29] = l1[33] ^ l1[35] ^ l1[36] ^ l1[39] ^ l1[40] ^ l1[43];
+  l2[29] = l2[34] ^ l2[36] ^ l2[37] ^ l2[41] ^ l2[44] ^ l2[45];
+  l3[29] = l3[34] ^ l3[40] ^ l3[44] ^ l3[46];
+  K[1][13] = D;
+
+  /* Round 23 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[32] ^ l1[33] ^ l2[34] ^ l3[34];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[36]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[37]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[38]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[40]);
+  D ^= l0[41] ^ l1[42] ^ l2[44] ^ l3[45];
+  l0[28] = l0[33] ^ l0[37] ^ l0[39] ^ l0[41];
+  l1[28] = l1[32] ^ l1[34] ^ l1[35] ^ l1[38] ^ l1[39] ^ l1[42];
+  l2[28] = l2[33] ^ l2[35] ^ l2[36] ^ l2[40] ^ l2[43] ^ l2[44];
+  l3[28] = l3[33] ^ l3[39] ^ l3[43] ^ l3[45];
+  K[1][13] = D;
+
+  /* Round 24 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[31] ^ l1[32] ^ l2[33] ^ l3[33];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[35]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[36]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[37]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[39]);
+  D ^= l0[40] ^ l1[41] ^ l2[43] ^ l3[44];
+  l0[27] = l0[32] ^ l0[36] ^ l0[38] ^ l0[40];
+  l1[27] = l1[31] ^ l1[33] ^ l1[34] ^ l1[37] ^ l1[38] ^ l1[41];
+  l2[27] = l2[32] ^ l2[34] ^ l2[35] ^ l2[39] ^ l2[42] ^ l2[43];
+  l3[27] = l3[32] ^ l3[38] ^ l3[42] ^ l3[44];
+  K[1][13] = D;
+
+  /* Round 25 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[30] ^ l1[31] ^ l2[32] ^ l3[32];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[34]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[35]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[36]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[38]);
+  D ^= l0[39] ^ l1[40] ^ l2[42] ^ l3[43];
+  l0[26] = l0[31] ^ l0[35] ^ l0[37] ^ l0[39];
+  l1[26] = l1[30] ^ l1[32] ^ l1[33] ^ l1[36] ^ l1[37] ^ l1[40];
+  l2[26] = l2[31] ^ l2[33] ^ l2[34] ^ l2[38] ^ l2[41] ^ l2[42];
+  l3[26] = l3[31] ^ l3[37] ^ l3[41] ^ l3[43];
+  K[1][13] = D;
+
+  /* Round 26 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[29] ^ l1[30] ^ l2[31] ^ l3[31];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[33]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[34]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[35]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[37]);
+  D ^= l0[38] ^ l1[39] ^ l2[41] ^ l3[42];
+  l0[25] = l0[30] ^ l0[34] ^ l0[36] ^ l0[38];
+  l1[25] = l1[29] ^ l1[31] ^ l1[32] ^ l1[35] ^ l1[36] ^ l1[39];
+  l2[25] = l2[30] ^ l2[32] ^ l2[33] ^ l2[37] ^ l2[40] ^ l2[41];
+  l3[25] = l3[30] ^ l3[36] ^ l3[40] ^ l3[42];
+  K[1][13] = D;
+
+  /* Round 27 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[28] ^ l1[29] ^ l2[30] ^ l3[30];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[32]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[33]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[34]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[36]);
+  D ^= l0[37] ^ l1[38] ^ l2[40] ^ l3[41];
+  l0[24] = l0[29] ^ l0[33] ^ l0[35] ^ l0[37];
+  l1[24] = l1[28] ^ l1[30] ^ l1[31] ^ l1[34] ^ l1[35] ^ l1[38];
+  l2[24] = l2[29] ^ l2[31] ^ l2[32] ^ l2[36] ^ l2[39] ^ l2[40];
+  l3[24] = l3[29] ^ l3[35] ^ l3[39] ^ l3[41];
+  K[1][13] = D;
+
+  /* Round 28 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[27] ^ l1[28] ^ l2[29] ^ l3[29];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[31]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[32]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[33]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[35]);
+  D ^= l0[36] ^ l1[37] ^ l2[39] ^ l3[40];
+  l0[23] = l0[28] ^ l0[32] ^ l0[34] ^ l0[36];
+  l1[23] = l1[27] ^ l1[29] ^ l1[30] ^ l1[33] ^ l1[34] ^ l1[37];
+  l2[23] = l2[28] ^ l2[30] ^ l2[31] ^ l2[35] ^ l2[38] ^ l2[39];
+  l3[23] = l3[28] ^ l3[34] ^ l3[38] ^ l3[40];
+  K[1][13] = D;
+
+  /* Round 29 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[26] ^ l1[27] ^ l2[28] ^ l3[28];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[30]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[31]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[32]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[34]);
+  D ^= l0[35] ^ l1[36] ^ l2[38] ^ l3[39];
+  l0[22] = l0[27] ^ l0[31] ^ l0[33] ^ l0[35];
+  l1[22] = l1[26] ^ l1[28] ^ l1[29] ^ l1[32] ^ l1[33] ^ l1[36];
+  l2[22] = l2[27] ^ l2[29] ^ l2[30] ^ l2[34] ^ l2[37] ^ l2[38];
+  l3[22] = l3[27] ^ l3[33] ^ l3[37] ^ l3[39];
+  K[1][13] = D;
+
+  /* Round 30 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[25] ^ l1[26] ^ l2[27] ^ l3[27];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[29]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[30]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[31]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[33]);
+  D ^= l0[34] ^ l1[35] ^ l2[37] ^ l3[38];
+  l0[21] = l0[26] ^ l0[30] ^ l0[32] ^ l0[34];
+  l1[21] = l1[25] ^ l1[27] ^ l1[28] ^ l1[31] ^ l1[32] ^ l1[35];
+  l2[21] = l2[26] ^ l2[28] ^ l2[29] ^ l2[33] ^ l2[36] ^ l2[37];
+  l3[21] = l3[26] ^ l3[32] ^ l3[36] ^ l3[38];
+  K[1][13] = D;
+
+  /* Round 31 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[24] ^ l1[25] ^ l2[26] ^ l3[26];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[28]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[29]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[30]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[32]);
+  D ^= l0[33] ^ l1[34] ^ l2[36] ^ l3[37];
+  l0[20] = l0[25] ^ l0[29] ^ l0[31] ^ l0[33];
+  l1[20] = l1[24] ^ l1[26] ^ l1[27] ^ l1[30] ^ l1[31] ^ l1[34];
+  l2[20] = l2[25] ^ l2[27] ^ l2[28] ^ l2[32] ^ l2[35] ^ l2[36];
+  l3[20] = l3[25] ^ l3[31] ^ l3[35] ^ l3[37];
+  K[1][13] = D;
+
+  /* Round 32 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[23] ^ l1[24] ^ l2[25] ^ l3[25];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[27]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[28]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[29]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[31]);
+  D ^= l0[32] ^ l1[33] ^ l2[35] ^ l3[36];
+  l0[19] = l0[24] ^ l0[28] ^ l0[30] ^ l0[32];
+  l1[19] = l1[23] ^ l1[25] ^ l1[26] ^ l1[29] ^ l1[30] ^ l1[33];
+  l2[19] = l2[24] ^ l2[26] ^ l2[27] ^ l2[31] ^ l2[34] ^ l2[35];
+  l3[19] = l3[24] ^ l3[30] ^ l3[34] ^ l3[36];
+  K[1][13] = D;
+
+  /* Round 33 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[22] ^ l1[23] ^ l2[24] ^ l3[24];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[26]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[27]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[28]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[30]);
+  D ^= l0[31] ^ l1[32] ^ l2[34] ^ l3[35];
+  l0[18] = l0[23] ^ l0[27] ^ l0[29] ^ l0[31];
+  l1[18] = l1[22] ^ l1[24] ^ l1[25] ^ l1[28] ^ l1[29] ^ l1[32];
+  l2[18] = l2[23] ^ l2[25] ^ l2[26] ^ l2[30] ^ l2[33] ^ l2[34];
+  l3[18] = l3[23] ^ l3[29] ^ l3[33] ^ l3[35];
+  K[1][13] = D;
+
+  /* Round 34 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[21] ^ l1[22] ^ l2[23] ^ l3[23];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[25]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[26]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[27]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[29]);
+  D ^= l0[30] ^ l1[31] ^ l2[33] ^ l3[34];
+  l0[17] = l0[22] ^ l0[26] ^ l0[28] ^ l0[30];
+  l1[17] = l1[21] ^ l1[23] ^ l1[24] ^ l1[27] ^ l1[28] ^ l1[31];
+  l2[17] = l2[22] ^ l2[24] ^ l2[25] ^ l2[29] ^ l2[32] ^ l2[33];
+  l3[17] = l3[22] ^ l3[28] ^ l3[32] ^ l3[34];
+  K[1][13] = D;
+
+  /* Round 35 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[20] ^ l1[21] ^ l2[22] ^ l3[22];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[24]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[25]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[26]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[28]);
+  D ^= l0[29] ^ l1[30] ^ l2[32] ^ l3[33];
+  l0[16] = l0[21] ^ l0[25] ^ l0[27] ^ l0[29];
+  l1[16] = l1[20] ^ l1[22] ^ l1[23] ^ l1[26] ^ l1[27] ^ l1[30];
+  l2[16] = l2[21] ^ l2[23] ^ l2[24] ^ l2[28] ^ l2[31] ^ l2[32];
+  l3[16] = l3[21] ^ l3[27] ^ l3[31] ^ l3[33];
+  K[1][13] = D;
+
+  /* Round 36 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[19] ^ l1[20] ^ l2[21] ^ l3[21];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[23]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[24]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[25]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[27]);
+  D ^= l0[28] ^ l1[29] ^ l2[31] ^ l3[32];
+  l0[15] = l0[20] ^ l0[24] ^ l0[26] ^ l0[28];
+  l1[15] = l1[19] ^ l1[21] ^ l1[22] ^ l1[25] ^ l1[26] ^ l1[29];
+  l2[15] = l2[20] ^ l2[22] ^ l2[23] ^ l2[27] ^ l2[30] ^ l2[31];
+  l3[15] = l3[20] ^ l3[26] ^ l3[30] ^ l3[32];
+  K[1][13] = D;
+
+  /* Round 37 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[18] ^ l1[19] ^ l2[20] ^ l3[20];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[22]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[23]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[24]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[26]);
+  D ^= l0[27] ^ l1[28] ^ l2[30] ^ l3[31];
+  l0[14] = l0[19] ^ l0[23] ^ l0[25] ^ l0[27];
+  l1[14] = l1[18] ^ l1[20] ^ l1[21] ^ l1[24] ^ l1[25] ^ l1[28];
+  l2[14] = l2[19] ^ l2[21] ^ l2[22] ^ l2[26] ^ l2[29] ^ l2[30];
+  l3[14] = l3[19] ^ l3[25] ^ l3[29] ^ l3[31];
+  K[1][13] = D;
+
+  /* Round 38 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[17] ^ l1[18] ^ l2[19] ^ l3[19];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[21]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[22]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[23]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[25]);
+  D ^= l0[26] ^ l1[27] ^ l2[29] ^ l3[30];
+  l0[13] = l0[18] ^ l0[22] ^ l0[24] ^ l0[26];
+  l1[13] = l1[17] ^ l1[19] ^ l1[20] ^ l1[23] ^ l1[24] ^ l1[27];
+  l2[13] = l2[18] ^ l2[20] ^ l2[21] ^ l2[25] ^ l2[28] ^ l2[29];
+  l3[13] = l3[18] ^ l3[24] ^ l3[28] ^ l3[30];
+  K[1][13] = D;
+
+  /* Round 39 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[16] ^ l1[17] ^ l2[18] ^ l3[18];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[20]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[21]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[22]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[24]);
+  D ^= l0[25] ^ l1[26] ^ l2[28] ^ l3[29];
+  l0[12] = l0[17] ^ l0[21] ^ l0[23] ^ l0[25];
+  l1[12] = l1[16] ^ l1[18] ^ l1[19] ^ l1[22] ^ l1[23] ^ l1[26];
+  l2[12] = l2[17] ^ l2[19] ^ l2[20] ^ l2[24] ^ l2[27] ^ l2[28];
+  l3[12] = l3[17] ^ l3[23] ^ l3[27] ^ l3[29];
+  K[1][13] = D;
+
+  /* Round 40 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[15] ^ l1[16] ^ l2[17] ^ l3[17];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[19]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[20]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[21]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[23]);
+  D ^= l0[24] ^ l1[25] ^ l2[27] ^ l3[28];
+  l0[11] = l0[16] ^ l0[20] ^ l0[22] ^ l0[24];
+  l1[11] = l1[15] ^ l1[17] ^ l1[18] ^ l1[21] ^ l1[22] ^ l1[25];
+  l2[11] = l2[16] ^ l2[18] ^ l2[19] ^ l2[23] ^ l2[26] ^ l2[27];
+  l3[11] = l3[16] ^ l3[22] ^ l3[26] ^ l3[28];
+  K[1][13] = D;
+
+  /* Round 41 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[14] ^ l1[15] ^ l2[16] ^ l3[16];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[18]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[19]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[20]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[22]);
+  D ^= l0[23] ^ l1[24] ^ l2[26] ^ l3[27];
+  l0[10] = l0[15] ^ l0[19] ^ l0[21] ^ l0[23];
+  l1[10] = l1[14] ^ l1[16] ^ l1[17] ^ l1[20] ^ l1[21] ^ l1[24];
+  l2[10] = l2[15] ^ l2[17] ^ l2[18] ^ l2[22] ^ l2[25] ^ l2[26];
+  l3[10] = l3[15] ^ l3[21] ^ l3[25] ^ l3[27];
+  K[1][13] = D;
+
+  /* Round 42 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[13] ^ l1[14] ^ l2[15] ^ l3[15];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[17]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[18]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[19]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[21]);
+  D ^= l0[22] ^ l1[23] ^ l2[25] ^ l3[26];
+  l0[9] = l0[14] ^ l0[18] ^ l0[20] ^ l0[22];
+  l1[9] = l1[13] ^ l1[15] ^ l1[16] ^ l1[19] ^ l1[20] ^ l1[23];
+  l2[9] = l2[14] ^ l2[16] ^ l2[17] ^ l2[21] ^ l2[24] ^ l2[25];
+  l3[9] = l3[14] ^ l3[20] ^ l3[24] ^ l3[26];
+  K[1][13] = D;
+
+  /* Round 43 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[12] ^ l1[13] ^ l2[14] ^ l3[14];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[16]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[17]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[18]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[20]);
+  D ^= l0[21] ^ l1[22] ^ l2[24] ^ l3[25];
+  l0[8] = l0[13] ^ l0[17] ^ l0[19] ^ l0[21];
+  l1[8] = l1[12] ^ l1[14] ^ l1[15] ^ l1[18] ^ l1[19] ^ l1[22];
+  l2[8] = l2[13] ^ l2[15] ^ l2[16] ^ l2[20] ^ l2[23] ^ l2[24];
+  l3[8] = l3[13] ^ l3[19] ^ l3[23] ^ l3[25];
+  K[1][13] = D;
+
+  /* Round 44 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[11] ^ l1[12] ^ l2[13] ^ l3[13];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[15]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[16]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[17]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[19]);
+  D ^= l0[20] ^ l1[21] ^ l2[23] ^ l3[24];
+  l0[7] = l0[12] ^ l0[16] ^ l0[18] ^ l0[20];
+  l1[7] = l1[11] ^ l1[13] ^ l1[14] ^ l1[17] ^ l1[18] ^ l1[21];
+  l2[7] = l2[12] ^ l2[14] ^ l2[15] ^ l2[19] ^ l2[22] ^ l2[23];
+  l3[7] = l3[12] ^ l3[18] ^ l3[22] ^ l3[24];
+  K[1][13] = D;
+
+  /* Round 45 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[10] ^ l1[11] ^ l2[12] ^ l3[12];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[14]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[15]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[16]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[18]);
+  D ^= l0[19] ^ l1[20] ^ l2[22] ^ l3[23];
+  l0[6] = l0[11] ^ l0[15] ^ l0[17] ^ l0[19];
+  l1[6] = l1[10] ^ l1[12] ^ l1[13] ^ l1[16] ^ l1[17] ^ l1[20];
+  l2[6] = l2[11] ^ l2[13] ^ l2[14] ^ l2[18] ^ l2[21] ^ l2[22];
+  l3[6] = l3[11] ^ l3[17] ^ l3[21] ^ l3[23];
+  K[1][13] = D;
+
+  /* Round 46 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[9] ^ l1[10] ^ l2[11] ^ l3[11];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[13]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[14]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[15]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[17]);
+  D ^= l0[18] ^ l1[19] ^ l2[21] ^ l3[22];
+  l0[5] = l0[10] ^ l0[14] ^ l0[16] ^ l0[18];
+  l1[5] = l1[9] ^ l1[11] ^ l1[12] ^ l1[15] ^ l1[16] ^ l1[19];
+  l2[5] = l2[10] ^ l2[12] ^ l2[13] ^ l2[17] ^ l2[20] ^ l2[21];
+  l3[5] = l3[10] ^ l3[16] ^ l3[20] ^ l3[22];
+  K[1][13] = D;
+
+  /* Round 47 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[8] ^ l1[9] ^ l2[10] ^ l3[10];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[12]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[13]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[14]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[16]);
+  D ^= l0[17] ^ l1[18] ^ l2[20] ^ l3[21];
+  l0[4] = l0[9] ^ l0[13] ^ l0[15] ^ l0[17];
+  l1[4] = l1[8] ^ l1[10] ^ l1[11] ^ l1[14] ^ l1[15] ^ l1[18];
+  l2[4] = l2[9] ^ l2[11] ^ l2[12] ^ l2[16] ^ l2[19] ^ l2[20];
+  l3[4] = l3[9] ^ l3[15] ^ l3[19] ^ l3[21];
+  K[1][13] = D;
+
+  /* Round 48 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[7] ^ l1[8] ^ l2[9] ^ l3[9];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[11]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[12]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[13]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[15]);
+  D ^= l0[16] ^ l1[17] ^ l2[19] ^ l3[20];
+  l0[3] = l0[8] ^ l0[12] ^ l0[14] ^ l0[16];
+  l1[3] = l1[7] ^ l1[9] ^ l1[10] ^ l1[13] ^ l1[14] ^ l1[17];
+  l2[3] = l2[8] ^ l2[10] ^ l2[11] ^ l2[15] ^ l2[18] ^ l2[19];
+  l3[3] = l3[8] ^ l3[14] ^ l3[18] ^ l3[20];
+  K[1][13] = D;
+
+  /* Round 49 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[6] ^ l1[7] ^ l2[8] ^ l3[8];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[10]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[11]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[12]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[14]);
+  D ^= l0[15] ^ l1[16] ^ l2[18] ^ l3[19];
+  l0[2] = l0[7] ^ l0[11] ^ l0[13] ^ l0[15];
+  l1[2] = l1[6] ^ l1[8] ^ l1[9] ^ l1[12] ^ l1[13] ^ l1[16];
+  l2[2] = l2[7] ^ l2[9] ^ l2[10] ^ l2[14] ^ l2[17] ^ l2[18];
+  l3[2] = l3[7] ^ l3[13] ^ l3[17] ^ l3[19];
+  K[1][13] = D;
+
+  /* Round 50 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[5] ^ l1[6] ^ l2[7] ^ l3[7];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[9]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[10]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[11]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[13]);
+  D ^= l0[14] ^ l1[15] ^ l2[17] ^ l3[18];
+  l0[1] = l0[6] ^ l0[10] ^ l0[12] ^ l0[14];
+  l1[1] = l1[5] ^ l1[7] ^ l1[8] ^ l1[11] ^ l1[12] ^ l1[15];
+  l2[1] = l2[6] ^ l2[8] ^ l2[9] ^ l2[13] ^ l2[16] ^ l2[17];
+  l3[1] = l3[6] ^ l3[12] ^ l3[16] ^ l3[18];
+  K[1][13] = D;
+
+  /* Round 51 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[4] ^ l1[5] ^ l2[6] ^ l3[6];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[8]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[9]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[10]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[12]);
+  D ^= l0[13] ^ l1[14] ^ l2[16] ^ l3[17];
+  l0[0] = l0[5] ^ l0[9] ^ l0[11] ^ l0[13];
+  l1[0] = l1[4] ^ l1[6] ^ l1[7] ^ l1[10] ^ l1[11] ^ l1[14];
+  l2[0] = l2[5] ^ l2[7] ^ l2[8] ^ l2[12] ^ l2[15] ^ l2[16];
+  l3[0] = l3[5] ^ l3[11] ^ l3[15] ^ l3[17];
+  K[1][13] = D;
+
+  memcpy(m->lfsrs[0].state, l0, 13 * sizeof(bsvec_t));
+  m->lfsrs[0].zero = 0;
+  memcpy(m->lfsrs[1].state, l1, 14 * sizeof(bsvec_t));
+  m->lfsrs[1].zero = 0;
+  memcpy(m->lfsrs[2].state, l2, 16 * sizeof(bsvec_t));
+  m->lfsrs[2].zero = 0;
+  memcpy(m->lfsrs[3].state, l3, 17 * sizeof(bsvec_t));
+  m->lfsrs[3].zero = 0;
+  memcpy(m->snA, snA, sizeof(snA));
+  memcpy(m->snB, snB, sizeof(snB));
+}
+
+/* Auto-generated by Rounds_print: 56 rounds of HDCPRekeycipher */
+static void BS_HDCPRekeyRounds56(BS_HDCPCipherState *hs)
+{
+  BS_LFSRModule *m = &hs->lm;
+  bsvec_t (*K)[28] = hs->bm.K, (*B)[28] = hs->bm.B;
+  bsvec_t Kspare[28], Bspare[28], snA[4], snB[4], D;
+  bsvec_t l0[69], l1[70], l2[72], l3[73];
+  int i;
+
+  for (i = 0; i < 13; i++)
+    l0[56 + i] = BS_LFSRBit(&m->lfsrs[0], i);
+  for (i = 0; i < 14; i++)
+    l1[56 + i] = BS_LFSRBit(&m->lfsrs[1], i);
+  for (i = 0; i < 16; i++)
+    l2[56 + i] = BS_LFSRBit(&m->lfsrs[2], i);
+  for (i = 0; i < 17; i++)
+    l3[56 + i] = BS_LFSRBit(&m->lfsrs[3], i);
+  memcpy(snA, m->snA, sizeof(snA));
+  memcpy(snB, m->snB, sizeof(snB));
+
+  /* Round 0 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[59] ^ l1[60] ^ l2[61] ^ l3[61];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[63]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[64]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[65]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[67]);
+  D ^= l0[68] ^ l1[69] ^ l2[71] ^ l3[72];
+  l0[55] = l0[60] ^ l0[64] ^ l0[66] ^ l0[68];
+  l1[55] = l1[59] ^ l1[61] ^ l1[62] ^ l1[65] ^ l1[66] ^ l1[69];
+  l2[55] = l2[60] ^ l2[62] ^ l2[63] ^ l2[67] ^ l2[70] ^ l2[71];
+  l3[55] = l3[60] ^ l3[66] ^ l3[70] ^ l3[72];
+  K[1][13] = D;
+
+  /* Round 1 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[58] ^ l1[59] ^ l2[60] ^ l3[60];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[62]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[63]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[64]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[66]);
+  D ^= l0[67] ^ l1[68] ^ l2[70] ^ l3[71];
+  l0[54] = l0[59] ^ l0[63] ^ l0[65] ^ l0[67];
+  l1[54] = l1[58] ^ l1[60] ^ l1[61] ^ l1[64] ^ l1[65] ^ l1[68];
+  l2[54] = l2[59] ^ l2[61] ^ l2[62] ^ l2[66] ^ l2[69] ^ l2[70];
+  l3[54] = l3[59] ^ l3[65] ^ l3[69] ^ l3[71];
+  K[1][13] = D;
+
+  /* Round 2 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[57] ^ l1[58] ^ l2[59] ^ l3[59];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[61]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[62]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[63]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[65]);
+  D ^= l0[66] ^ l1[67] ^ l2[69] ^ l3[70];
+  l0[53] = l0[58] ^ l0[62] ^ l0[64] ^ l0[66];
+  l1[53] = l1[57] ^ l1[59] ^ l1[60] ^ l1[63] ^ l1[64] ^ l1[67];
+  l2[53] = l2[58] ^ l2[60] ^ l2[61] ^ l2[65] ^ l2[68] ^ l2[69];
+  l3[53] = l3[58] ^ l3[64] ^ l3[68] ^ l3[70];
+  K[1][13] = D;
+
+  /* Round 3 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[56] ^ l1[57] ^ l2[58] ^ l3[58];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[60]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[61]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[62]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[64]);
+  D ^= l0[65] ^ l1[66] ^ l2[68] ^ l3[69];
+  l0[52] = l0[57] ^ l0[61] ^ l0[63] ^ l0[65];
+  l1[52] = l1[56] ^ l1[58] ^ l1[59] ^ l1[62] ^ l1[63] ^ l1[66];
+  l2[52] = l2[57] ^ l2[59] ^ l2[60] ^ l2[64] ^ l2[67] ^ l2[68];
+  l3[52] = l3[57] ^ l3[63] ^ l3[67] ^ l3[69];
+  K[1][13] = D;
+
+  /* Round 4 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[55] ^ l1[56] ^ l2[57] ^ l3[57];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[59]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[60]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[61]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[63]);
+  D ^= l0[64] ^ l1[65] ^ l2[67] ^ l3[68];
+  l0[51] = l0[56] ^ l0[60] ^ l0[62] ^ l0[64];
+  l1[51] = l1[55] ^ l1[57] ^ l1[58] ^ l1[61] ^ l1[62] ^ l1[65];
+  l2[51] = l2[56] ^ l2[58] ^ l2[59] ^ l2[63] ^ l2[66] ^ l2[67];
+  l3[51] = l3[56] ^ l3[62] ^ l3[66] ^ l3[68];
+  K[1][13] = D;
+
+  /* Round 5 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[54] ^ l1[55] ^ l2[56] ^ l3[56];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[58]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[59]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[60]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[62]);
+  D ^= l0[63] ^ l1[64] ^ l2[66] ^ l3[67];
+  l0[50] = l0[55] ^ l0[59] ^ l0[61] ^ l0[63];
+  l1[50] = l1[54] ^ l1[56] ^ l1[57] ^ l1[60] ^ l1[61] ^ l1[64];
+  l2[50] = l2[55] ^ l2[57] ^ l2[58] ^ l2[62] ^ l2[65] ^ l2[66];
+  l3[50] = l3[55] ^ l3[61] ^ l3[65] ^ l3[67];
+  K[1][13] = D;
+
+  /* Round 6 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[53] ^ l1[54] ^ l2[55] ^ l3[55];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[57]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[58]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[59]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[61]);
+  D ^= l0[62] ^ l1[63] ^ l2[65] ^ l3[66];
+  l0[49] = l0[54] ^ l0[58] ^ l0[60] ^ l0[62];
+  l1[49] = l1[53] ^ l1[55] ^ l1[56] ^ l1[59] ^ l1[60] ^ l1[63];
+  l2[49] = l2[54] ^ l2[56] ^ l2[57] ^ l2[61] ^ l2[64] ^ l2[65];
+  l3[49] = l3[54] ^ l3[60] ^ l3[64] ^ l3[66];
+  K[1][13] = D;
+
+  /* Round 7 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[52] ^ l1[53] ^ l2[54] ^ l3[54];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[56]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[57]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[58]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[60]);
+  D ^= l0[61] ^ l1[62] ^ l2[64] ^ l3[65];
+  l0[48] = l0[53] ^ l0[57] ^ l0[59] ^ l0[61];
+  l1[48] = l1[52] ^ l1[54] ^ l1[55] ^ l1[58] ^ l1[59] ^ l1[62];
+  l2[48] = l2[53] ^ l2[55] ^ l2[56] ^ l2[60] ^ l2[63] ^ l2[64];
+  l3[48] = l3[53] ^ l3[59] ^ l3[63] ^ l3[65];
+  K[1][13] = D;
+
+  /* Round 8 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[51] ^ l1[52] ^ l2[53] ^ l3[53];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[55]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[56]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[57]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[59]);
+  D ^= l0[60] ^ l1[61] ^ l2[63] ^ l3[64];
+  l0[47] = l0[52] ^ l0[56] ^ l0[58] ^ l0[60];
+  l1[47] = l1[51] ^ l1[53] ^ l1[54] ^ l1[57] ^ l1[58] ^ l1[61];
+  l2[47] = l2[52] ^ l2[54] ^ l2[55] ^ l2[59] ^ l2[62] ^ l2[63];
+  l3[47] = l3[52] ^ l3[58] ^ l3[62] ^ l3[64];
+  K[1][13] = D;
+
+  /* Round 9 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[50] ^ l1[51] ^ l2[52] ^ l3[52];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[54]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[55]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[56]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[58]);
+  D ^= l0[59] ^ l1[60] ^ l2[62] ^ l3[63];
+  l0[46] = l0[51] ^ l0[55] ^ l0[57] ^ l0[59];
+  l1[46] = l1[50] ^ l1[52] ^ l1[53] ^ l1[56] ^ l1[57] ^ l1[60];
+  l2[46] = l2[51] ^ l2[53] ^ l2[54] ^ l2[58] ^ l2[61] ^ l2[62];
+  l3[46] = l3[51] ^ l3[57] ^ l3[61] ^ l3[63];
+  K[1][13] = D;
+
+  /* Round 10 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[49] ^ l1[50] ^ l2[51] ^ l3[51];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[53]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[54]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[55]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[57]);
+  D ^= l0[58] ^ l1[59] ^ l2[61] ^ l3[62];
+  l0[45] = l0[50] ^ l0[54] ^ l0[56] ^ l0[58];
+  l1[45] = l1[49] ^ l1[51] ^ l1[52] ^ l1[55] ^ l1[56] ^ l1[59];
+  l2[45] = l2[50] ^ l2[52] ^ l2[53] ^ l2[57] ^ l2[60] ^ l2[61];
+  l3[45] = l3[50] ^ l3[56] ^ l3[60] ^ l3[62];
+  K[1][13] = D;
+
+  /* Round 11 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[48] ^ l1[49] ^ l2[50] ^ l3[50];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[52]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[53]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[54]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[56]);
+  D ^= l0[57] ^ l1[58] ^ l2[60] ^ l3[61];
+  l0[44] = l0[49] ^ l0[53] ^ l0[55] ^ l0[57];
+  l1[44] = l1[48] ^ l1[50] ^ l1[51] ^ l1[54] ^ l1[55] ^ l1[58];
+  l2[44] = l2[49] ^ l2[51] ^ l2[52] ^ l2[56] ^ l2[59] ^ l2[60];
+  l3[44] = l3[49] ^ l3[55] ^ l3[59] ^ l3[61];
+  K[1][13] = D;
+
+  /* Round 12 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[47] ^ l1[48] ^ l2[49] ^ l3[49];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[51]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[52]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[53]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[55]);
+  D ^= l0[56] ^ l1[57] ^ l2[59] ^ l3[60];
+  l0[43] = l0[48] ^ l0[52] ^ l0[54] ^ l0[56];
+  l1[43] = l1[47] ^ l1[49] ^ l1[50] ^ l1[53] ^ l1[54] ^ l1[57];
+  l2[43] = l2[48] ^ l2[50] ^ l2[51] ^ l2[55] ^ l2[58] ^ l2[59];
+  l3[43] = l3[48] ^ l3[54] ^ l3[58] ^ l3[60];
+  K[1][13] = D;
+
+  /* Round 13 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[46] ^ l1[47] ^ l2[48] ^ l3[48];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[50]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[51]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[52]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[54]);
+  D ^= l0[55] ^ l1[56] ^ l2[58] ^ l3[59];
+  l0[42] = l0[47] ^ l0[51] ^ l0[53] ^ l0[55];
+  l1[42] = l1[46] ^ l1[48] ^ l1[49] ^ l1[52] ^ l1[53] ^ l1[56];
+  l2[42] = l2[47] ^ l2[49] ^ l2[50] ^ l2[54] ^ l2[57] ^ l2[58];
+  l3[42] = l3[47] ^ l3[53] ^ l3[57] ^ l3[59];
+  K[1][13] = D;
+
+  /* Round 14 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[45] ^ l1[46] ^ l2[47] ^ l3[47];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[49]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[50]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[51]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[53]);
+  D ^= l0[54] ^ l1[55] ^ l2[57] ^ l3[58];
+  l0[41] = l0[46] ^ l0[50] ^ l0[52] ^ l0[54];
+  l1[41] = l1[45] ^ l1[47] ^ l1[48] ^ l1[51] ^ l1[52] ^ l1[55];
+  l2[41] = l2[46] ^ l2[48] ^ l2[49] ^ l2[53] ^ l2[56] ^ l2[57];
+  l3[41] = l3[46] ^ l3[52] ^ l3[56] ^ l3[58];
+  K[1][13] = D;
+
+  /* Round 15 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[44] ^ l1[45] ^ l2[46] ^ l3[46];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[48]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[49]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[50]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[52]);
+  D ^= l0[53] ^ l1[54] ^ l2[56] ^ l3[57];
+  l0[40] = l0[45] ^ l0[49] ^ l0[51] ^ l0[53];
+  l1[40] = l1[44] ^ l1[46] ^ l1[47] ^ l1[50] ^ l1[51] ^ l1[54];
+  l2[40] = l2[45] ^ l2[47] ^ l2[48] ^ l2[52] ^ l2[55] ^ l2[56];
+  l3[40] = l3[45] ^ l3[51] ^ l3[55] ^ l3[57];
+  K[1][13] = D;
+
+  /* Round 16 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[43] ^ l1[44] ^ l2[45] ^ l3[45];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[47]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[48]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[49]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[51]);
+  D ^= l0[52] ^ l1[53] ^ l2[55] ^ l3[56];
+  l0[39] = l0[44] ^ l0[48] ^ l0[50] ^ l0[52];
+  l1[39] = l1[43] ^ l1[45] ^ l1[46] ^ l1[49] ^ l1[50] ^ l1[53];
+  l2[39] = l2[44] ^ l2[46] ^ l2[47] ^ l2[51] ^ l2[54] ^ l2[55];
+  l3[39] = l3[44] ^ l3[50] ^ l3[54] ^ l3[56];
+  K[1][13] = D;
+
+  /* Round 17 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[42] ^ l1[43] ^ l2[44] ^ l3[44];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[46]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[47]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[48]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[50]);
+  D ^= l0[51] ^ l1[52] ^ l2[54] ^ l3[55];
+  l0[38] = l0[43] ^ l0[47] ^ l0[49] ^ l0[51];
+  l1[38] = l1[42] ^ l1[44] ^ l1[45] ^ l1[48] ^ l1[49] ^ l1[52];
+  l2[38] = l2[43] ^ l2[45] ^ l2[46] ^ l2[50] ^ l2[53] ^ l2[54];
+  l3[38] = l3[43] ^ l3[49] ^ l3[53] ^ l3[55];
+  K[1][13] = D;
+
+  /* Round 18 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[41] ^ l1[42] ^ l2[43] ^ l3[43];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[45]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[46]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[47]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[49]);
+  D ^= l0[50] ^ l1[51] ^ l2[53] ^ l3[54];
+  l0[37] = l0[42] ^ l0[46] ^ l0[48] ^ l0[50];
+  l1[37] = l1[41] ^ l1[43] ^ l1[44] ^ l1[47] ^ l1[48] ^ l1[51];
+  l2[37] = l2[42] ^ l2[44] ^ l2[45] ^ l2[49] ^ l2[52] ^ l2[53];
+  l3[37] = l3[42] ^ l3[48] ^ l3[52] ^ l3[54];
+  K[1][13] = D;
+
+  /* Round 19 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[40] ^ l1[41] ^ l2[42] ^ l3[42];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[44]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[45]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[46]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[48]);
+  D ^= l0[49] ^ l1[50] ^ l2[52] ^ l3[53];
+  l0[36] = l0[41] ^ l0[45] ^ l0[47] ^ l0[49];
+  l1[36] = l1[40] ^ l1[42] ^ l1[43] ^ l1[46] ^ l1[47] ^ l1[50];
+  l2[36] = l2[41] ^ l2[43] ^ l2[44] ^ l2[48] ^ l2[51] ^ l2[52];
+  l3[36] = l3[41] ^ l3[47] ^ l3[51] ^ l3[53];
+  K[1][13] = D;
+
+  /* Round 20 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[39] ^ l1[40] ^ l2[41] ^ l3[41];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[43]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[44]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[45]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[47]);
+  D ^= l0[48] ^ l1[49] ^ l2[51] ^ l3[52];
+  l0[35] = l0[40] ^ l0[44] ^ l0[46] ^ l0[48];
+  l1[35] = l1[39] ^ l1[41] ^ l1[42] ^ l1[45] ^ l1[46] ^ l1[49];
+  l2[35] = l2[40] ^ l2[42] ^ l2[43] ^ l2[47] ^ l2[50] ^ l2[51];
+  l3[35] = l3[40] ^ l3[46] ^ l3[50] ^ l3[52];
+  K[1][13] = D;
+
+  /* Round 21 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[38] ^ l1[39] ^ l2[40] ^ l3[40];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[42]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[43]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[44]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[46]);
+  D ^= l0[47] ^ l1[48] ^ l2[50] ^ l3[51];
+  l0[34] = l0[39] ^ l0[43] ^ l0[45] ^ l0[47];
+  l1[34] = l1[38] ^ l1[40] ^ l1[41] ^ l1[44] ^ l1[45] ^ l1[48];
+  l2[34] = l2[39] ^ l2[41] ^ l2[42] ^ l2[46] ^ l2[49] ^ l2[50];
+  l3[34] = l3[39] ^ l3[45] ^ l3[49] ^ l3[51];
+  K[1][13] = D;
+
+  /* Round 22 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[37] ^ l1[38] ^ l2[39] ^ l3[39];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[41]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[42]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[43]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[45]);
+  D ^= l0[46] ^ l1[47] ^ l2[49] ^ l3[50];
+  l0[33] = l0[38] ^ l0[42] ^ l0[44] ^ l0[46];
+  l1[33] = l1[37] ^ l1[39] ^ l1[40] ^ l1[43] ^ l1[44] ^ l1[47];
+  l2[33] = l2[38] ^ l2[40] ^ l2[41] ^ l2[45] ^ l2[48] ^ l2[49];
+  l3[33] = l3[38] ^ l3[44] ^ l3[48] ^ l3[50];
+  K[1][13] = D;
+
+  /* Round 23 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[36] ^ l1[37] ^ l2[38] ^ l3[38];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[40]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[41]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[42]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[44]);
+  D ^= l0[45] ^ l1[46] ^ l2[48] ^ l3[49];
+  l0[32] = l0[37] ^ l0[41] ^ l0[43] ^ l0[45];
+  l1[32] = l1[36] ^ l1[38] ^ l1[39] ^ l1[42] ^ l1[43] ^ l1[46];
+  l2[32] = l2[37] ^ l2[39] ^ l2[40] ^ l2[44] ^ l2[47] ^ l2[48];
+  l3[32] = l3[37] ^ l3[43] ^ l3[47] ^ l3[49];
+  K[1][13] = D;
+
+  /* Round 24 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[35] ^ l1[36] ^ l2[37] ^ l3[37];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[39]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[40]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[41]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[43]);
+  D ^= l0[44] ^ l1[45] ^ l2[47] ^ l3[48];
+  l0[31] = l0[36] ^ l0[40] ^ l0[42] ^ l0[44];
+  l1[31] = l1[35] ^ l1[37] ^ l1[38] ^ l1[41] ^ l1[42] ^ l1[45];
+  l2[31] = l2[36] ^ l2[38] ^ l2[39] ^ l2[43] ^ l2[46] ^ l2[47];
+  l3[31] = l3[36] ^ l3[42] ^ l3[46] ^ l3[48];
+  K[1][13] = D;
+
+  /* Round 25 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[34] ^ l1[35] ^ l2[36] ^ l3[36];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[38]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[39]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[40]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[42]);
+  D ^= l0[43] ^ l1[44] ^ l2[46] ^ l3[47];
+  l0[30] = l0[35] ^ l0[39] ^ l0[41] ^ l0[43];
+  l1[30] = l1[34] ^ l1[36] ^ l1[37] ^ l1[40] ^ l1[41] ^ l1[44];
+  l2[30] = l2[35] ^ l2[37] ^ l2[38] ^ l2[42] ^ l2[45] ^ l2[46];
+  l3[30] = l3[35] ^ l3[41] ^ l3[45] ^ l3[47];
+  K[1][13] = D;
+
+  /* Round 26 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[33] ^ l1[34] ^ l2[35] ^ l3[35];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[37]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[38]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[39]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[41]);
+  D ^= l0[42] ^ l1[43] ^ l2[45] ^ l3[46];
+  l0[29] = l0[34] ^ l0[38] ^ l0[40] ^ l0[42];
+  l1[29] = l1[33] ^ l1[35] ^ l1[36] ^ l1[39] ^ l1[40] ^ l1[43];
+  l2[29] = l2[34] ^ l2[36] ^ l2[37] ^ l2[41] ^ l2[44] ^ l2[45];
+  l3[29] = l3[34] ^ l3[40] ^ l3[44] ^ l3[46];
+  K[1][13] = D;
+
+  /* Round 27 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[32] ^ l1[33] ^ l2[34] ^ l3[34];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[36]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[37]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[38]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[40]);
+  D ^= l0[41] ^ l1[42] ^ l2[44] ^ l3[45];
+  l0[28] = l0[33] ^ l0[37] ^ l0[39] ^ l0[41];
+  l1[28] = l1[32] ^ l1[34] ^ l1[35] ^ l1[38] ^ l1[39] ^ l1[42];
+  l2[28] = l2[33] ^ l2[35] ^ l2[36] ^ l2[40] ^ l2[43] ^ l2[44];
+  l3[28] = l3[33] ^ l3[39] ^ l3[43] ^ l3[45];
+  K[1][13] = D;
+
+  /* Round 28 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[31] ^ l1[32] ^ l2[33] ^ l3[33];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[35]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[36]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[37]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[39]);
+  D ^= l0[40] ^ l1[41] ^ l2[43] ^ l3[44];
+  l0[27] = l0[32] ^ l0[36] ^ l0[38] ^ l0[40];
+  l1[27] = l1[31] ^ l1[33] ^ l1[34] ^ l1[37] ^ l1[38] ^ l1[41];
+  l2[27] = l2[32] ^ l2[34] ^ l2[35] ^ l2[39] ^ l2[42] ^ l2[43];
+  l3[27] = l3[32] ^ l3[38] ^ l3[42] ^ l3[44];
+  K[1][13] = D;
+
+  /* Round 29 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[30] ^ l1[31] ^ l2[32] ^ l3[32];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[34]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[35]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[36]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[38]);
+  D ^= l0[39] ^ l1[40] ^ l2[42] ^ l3[43];
+  l0[26] = l0[31] ^ l0[35] ^ l0[37] ^ l0[39];
+  l1[26] = l1[30] ^ l1[32] ^ l1[33] ^ l1[36] ^ l1[37] ^ l1[40];
+  l2[26] = l2[31] ^ l2[33] ^ l2[34] ^ l2[38] ^ l2[41] ^ l2[42];
+  l3[26] = l3[31] ^ l3[37] ^ l3[41] ^ l3[43];
+  K[1][13] = D;
+
+  /* Round 30 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[29] ^ l1[30] ^ l2[31] ^ l3[31];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[33]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[34]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[35]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[37]);
+  D ^= l0[38] ^ l1[39] ^ l2[41] ^ l3[42];
+  l0[25] = l0[30] ^ l0[34] ^ l0[36] ^ l0[38];
+  l1[25] = l1[29] ^ l1[31] ^ l1[32] ^ l1[35] ^ l1[36] ^ l1[39];
+  l2[25] = l2[30] ^ l2[32] ^ l2[33] ^ l2[37] ^ l2[40] ^ l2[41];
+  l3[25] = l3[30] ^ l3[36] ^ l3[40] ^ l3[42];
+  K[1][13] = D;
+
+  /* Round 31 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[28] ^ l1[29] ^ l2[30] ^ l3[30];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[32]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[33]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[34]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[36]);
+  D ^= l0[37] ^ l1[38] ^ l2[40] ^ l3[41];
+  l0[24] = l0[29] ^ l0[33] ^ l0[35] ^ l0[37];
+  l1[24] = l1[28] ^ l1[30] ^ l1[31] ^ l1[34] ^ l1[35] ^ l1[38];
+  l2[24] = l2[29] ^ l2[31] ^ l2[32] ^ l2[36] ^ l2[39] ^ l2[40];
+  l3[24] = l3[29] ^ l3[35] ^ l3[39] ^ l3[41];
+  K[1][13] = D;
+
+  /* Round 32 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[27] ^ l1[28] ^ l2[29] ^ l3[29];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[31]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[32]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[33]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[35]);
+  D ^= l0[36] ^ l1[37] ^ l2[39] ^ l3[40];
+  l0[23] = l0[28] ^ l0[32] ^ l0[34] ^ l0[36];
+  l1[23] = l1[27] ^ l1[29] ^ l1[30] ^ l1[33] ^ l1[34] ^ l1[37];
+  l2[23] = l2[28] ^ l2[30] ^ l2[31] ^ l2[35] ^ l2[38] ^ l2[39];
+  l3[23] = l3[28] ^ l3[34] ^ l3[38] ^ l3[40];
+  K[1][13] = D;
+
+  /* Round 33 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[26] ^ l1[27] ^ l2[28] ^ l3[28];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[30]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[31]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[32]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[34]);
+  D ^= l0[35] ^ l1[36] ^ l2[38] ^ l3[39];
+  l0[22] = l0[27] ^ l0[31] ^ l0[33] ^ l0[35];
+  l1[22] = l1[26] ^ l1[28] ^ l1[29] ^ l1[32] ^ l1[33] ^ l1[36];
+  l2[22] = l2[27] ^ l2[29] ^ l2[30] ^ l2[34] ^ l2[37] ^ l2[38];
+  l3[22] = l3[27] ^ l3[33] ^ l3[37] ^ l3[39];
+  K[1][13] = D;
+
+  /* Round 34 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[25] ^ l1[26] ^ l2[27] ^ l3[27];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[29]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[30]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[31]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[33]);
+  D ^= l0[34] ^ l1[35] ^ l2[37] ^ l3[38];
+  l0[21] = l0[26] ^ l0[30] ^ l0[32] ^ l0[34];
+  l1[21] = l1[25] ^ l1[27] ^ l1[28] ^ l1[31] ^ l1[32] ^ l1[35];
+  l2[21] = l2[26] ^ l2[28] ^ l2[29] ^ l2[33] ^ l2[36] ^ l2[37];
+  l3[21] = l3[26] ^ l3[32] ^ l3[36] ^ l3[38];
+  K[1][13] = D;
+
+  /* Round 35 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[24] ^ l1[25] ^ l2[26] ^ l3[26];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[28]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[29]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[30]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[32]);
+  D ^= l0[33] ^ l1[34] ^ l2[36] ^ l3[37];
+  l0[20] = l0[25] ^ l0[29] ^ l0[31] ^ l0[33];
+  l1[20] = l1[24] ^ l1[26] ^ l1[27] ^ l1[30] ^ l1[31] ^ l1[34];
+  l2[20] = l2[25] ^ l2[27] ^ l2[28] ^ l2[32] ^ l2[35] ^ l2[36];
+  l3[20] = l3[25] ^ l3[31] ^ l3[35] ^ l3[37];
+  K[1][13] = D;
+
+  /* Round 36 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[23] ^ l1[24] ^ l2[25] ^ l3[25];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[27]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[28]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[29]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[31]);
+  D ^= l0[32] ^ l1[33] ^ l2[35] ^ l3[36];
+  l0[19] = l0[24] ^ l0[28] ^ l0[30] ^ l0[32];
+  l1[19] = l1[23] ^ l1[25] ^ l1[26] ^ l1[29] ^ l1[30] ^ l1[33];
+  l2[19] = l2[24] ^ l2[26] ^ l2[27] ^ l2[31] ^ l2[34] ^ l2[35];
+  l3[19] = l3[24] ^ l3[30] ^ l3[34] ^ l3[36];
+  K[1][13] = D;
+
+  /* Round 37 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[22] ^ l1[23] ^ l2[24] ^ l3[24];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[26]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[27]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[28]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[30]);
+  D ^= l0[31] ^ l1[32] ^ l2[34] ^ l3[35];
+  l0[18] = l0[23] ^ l0[27] ^ l0[29] ^ l0[31];
+  l1[18] = l1[22] ^ l1[24] ^ l1[25] ^ l1[28] ^ l1[29] ^ l1[32];
+  l2[18] = l2[23] ^ l2[25] ^ l2[26] ^ l2[30] ^ l2[33] ^ l2[34];
+  l3[18] = l3[23] ^ l3[29] ^ l3[33] ^ l3[35];
+  K[1][13] = D;
+
+  /* Round 38 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[21] ^ l1[22] ^ l2[23] ^ l3[23];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[25]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[26]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[27]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[29]);
+  D ^= l0[30] ^ l1[31] ^ l2[33] ^ l3[34];
+  l0[17] = l0[22] ^ l0[26] ^ l0[28] ^ l0[30];
+  l1[17] = l1[21] ^ l1[23] ^ l1[24] ^ l1[27] ^ l1[28] ^ l1[31];
+  l2[17] = l2[22] ^ l2[24] ^ l2[25] ^ l2[29] ^ l2[32] ^ l2[33];
+  l3[17] = l3[22] ^ l3[28] ^ l3[32] ^ l3[34];
+  K[1][13] = D;
+
+  /* Round 39 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[20] ^ l1[21] ^ l2[22] ^ l3[22];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[24]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[25]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[26]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[28]);
+  D ^= l0[29] ^ l1[30] ^ l2[32] ^ l3[33];
+  l0[16] = l0[21] ^ l0[25] ^ l0[27] ^ l0[29];
+  l1[16] = l1[20] ^ l1[22] ^ l1[23] ^ l1[26] ^ l1[27] ^ l1[30];
+  l2[16] = l2[21] ^ l2[23] ^ l2[24] ^ l2[28] ^ l2[31] ^ l2[32];
+  l3[16] = l3[21] ^ l3[27] ^ l3[31] ^ l3[33];
+  K[1][13] = D;
+
+  /* Round 40 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[19] ^ l1[20] ^ l2[21] ^ l3[21];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[23]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[24]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[25]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[27]);
+  D ^= l0[28] ^ l1[29] ^ l2[31] ^ l3[32];
+  l0[15] = l0[20] ^ l0[24] ^ l0[26] ^ l0[28];
+  l1[15] = l1[19] ^ l1[21] ^ l1[22] ^ l1[25] ^ l1[26] ^ l1[29];
+  l2[15] = l2[20] ^ l2[22] ^ l2[23] ^ l2[27] ^ l2[30] ^ l2[31];
+  l3[15] = l3[20] ^ l3[26] ^ l3[30] ^ l3[32];
+  K[1][13] = D;
+
+  /* Round 41 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[18] ^ l1[19] ^ l2[20] ^ l3[20];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[22]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[23]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[24]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[26]);
+  D ^= l0[27] ^ l1[28] ^ l2[30] ^ l3[31];
+  l0[14] = l0[19] ^ l0[23] ^ l0[25] ^ l0[27];
+  l1[14] = l1[18] ^ l1[20] ^ l1[21] ^ l1[24] ^ l1[25] ^ l1[28];
+  l2[14] = l2[19] ^ l2[21] ^ l2[22] ^ l2[26] ^ l2[29] ^ l2[30];
+  l3[14] = l3[19] ^ l3[25] ^ l3[29] ^ l3[31];
+  K[1][13] = D;
+
+  /* Round 42 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[17] ^ l1[18] ^ l2[19] ^ l3[19];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[21]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[22]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[23]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[25]);
+  D ^= l0[26] ^ l1[27] ^ l2[29] ^ l3[30];
+  l0[13] = l0[18] ^ l0[22] ^ l0[24] ^ l0[26];
+  l1[13] = l1[17] ^ l1[19] ^ l1[20] ^ l1[23] ^ l1[24] ^ l1[27];
+  l2[13] = l2[18] ^ l2[20] ^ l2[21] ^ l2[25] ^ l2[28] ^ l2[29];
+  l3[13] = l3[18] ^ l3[24] ^ l3[28] ^ l3[30];
+  K[1][13] = D;
+
+  /* Round 43 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[16] ^ l1[17] ^ l2[18] ^ l3[18];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[20]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[21]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[22]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[24]);
+  D ^= l0[25] ^ l1[26] ^ l2[28] ^ l3[29];
+  l0[12] = l0[17] ^ l0[21] ^ l0[23] ^ l0[25];
+  l1[12] = l1[16] ^ l1[18] ^ l1[19] ^ l1[22] ^ l1[23] ^ l1[26];
+  l2[12] = l2[17] ^ l2[19] ^ l2[20] ^ l2[24] ^ l2[27] ^ l2[28];
+  l3[12] = l3[17] ^ l3[23] ^ l3[27] ^ l3[29];
+  K[1][13] = D;
+
+  /* Round 44 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[15] ^ l1[16] ^ l2[17] ^ l3[17];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[19]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[20]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[21]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[23]);
+  D ^= l0[24] ^ l1[25] ^ l2[27] ^ l3[28];
+  l0[11] = l0[16] ^ l0[20] ^ l0[22] ^ l0[24];
+  l1[11] = l1[15] ^ l1[17] ^ l1[18] ^ l1[21] ^ l1[22] ^ l1[25];
+  l2[11] = l2[16] ^ l2[18] ^ l2[19] ^ l2[23] ^ l2[26] ^ l2[27];
+  l3[11] = l3[16] ^ l3[22] ^ l3[26] ^ l3[28];
+  K[1][13] = D;
+
+  /* Round 45 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[14] ^ l1[15] ^ l2[16] ^ l3[16];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[18]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[19]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[20]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[22]);
+  D ^= l0[23] ^ l1[24] ^ l2[26] ^ l3[27];
+  l0[10] = l0[15] ^ l0[19] ^ l0[21] ^ l0[23];
+  l1[10] = l1[14] ^ l1[16] ^ l1[17] ^ l1[20] ^ l1[21] ^ l1[24];
+  l2[10] = l2[15] ^ l2[17] ^ l2[18] ^ l2[22] ^ l2[25] ^ l2[26];
+  l3[10] = l3[15] ^ l3[21] ^ l3[25] ^ l3[27];
+  K[1][13] = D;
+
+  /* Round 46 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[13] ^ l1[14] ^ l2[15] ^ l3[15];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[17]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[18]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[19]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[21]);
+  D ^= l0[22] ^ l1[23] ^ l2[25] ^ l3[26];
+  l0[9] = l0[14] ^ l0[18] ^ l0[20] ^ l0[22];
+  l1[9] = l1[13] ^ l1[15] ^ l1[16] ^ l1[19] ^ l1[20] ^ l1[23];
+  l2[9] = l2[14] ^ l2[16] ^ l2[17] ^ l2[21] ^ l2[24] ^ l2[25];
+  l3[9] = l3[14] ^ l3[20] ^ l3[24] ^ l3[26];
+  K[1][13] = D;
+
+  /* Round 47 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[12] ^ l1[13] ^ l2[14] ^ l3[14];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[16]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[17]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[18]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[20]);
+  D ^= l0[21] ^ l1[22] ^ l2[24] ^ l3[25];
+  l0[8] = l0[13] ^ l0[17] ^ l0[19] ^ l0[21];
+  l1[8] = l1[12] ^ l1[14] ^ l1[15] ^ l1[18] ^ l1[19] ^ l1[22];
+  l2[8] = l2[13] ^ l2[15] ^ l2[16] ^ l2[20] ^ l2[23] ^ l2[24];
+  l3[8] = l3[13] ^ l3[19] ^ l3[23] ^ l3[25];
+  K[1][13] = D;
+
+  /* Round 48 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[11] ^ l1[12] ^ l2[13] ^ l3[13];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[15]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[16]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[17]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[19]);
+  D ^= l0[20] ^ l1[21] ^ l2[23] ^ l3[24];
+  l0[7] = l0[12] ^ l0[16] ^ l0[18] ^ l0[20];
+  l1[7] = l1[11] ^ l1[13] ^ l1[14] ^ l1[17] ^ l1[18] ^ l1[21];
+  l2[7] = l2[12] ^ l2[14] ^ l2[15] ^ l2[19] ^ l2[22] ^ l2[23];
+  l3[7] = l3[12] ^ l3[18] ^ l3[22] ^ l3[24];
+  K[1][13] = D;
+
+  /* Round 49 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[10] ^ l1[11] ^ l2[12] ^ l3[12];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[14]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[15]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[16]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[18]);
+  D ^= l0[19] ^ l1[20] ^ l2[22] ^ l3[23];
+  l0[6] = l0[11] ^ l0[15] ^ l0[17] ^ l0[19];
+  l1[6] = l1[10] ^ l1[12] ^ l1[13] ^ l1[16] ^ l1[17] ^ l1[20];
+  l2[6] = l2[11] ^ l2[13] ^ l2[14] ^ l2[18] ^ l2[21] ^ l2[22];
+  l3[6] = l3[11] ^ l3[17] ^ l3[21] ^ l3[23];
+  K[1][13] = D;
+
+  /* Round 50 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[9] ^ l1[10] ^ l2[11] ^ l3[11];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[13]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[14]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[15]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[17]);
+  D ^= l0[18] ^ l1[19] ^ l2[21] ^ l3[22];
+  l0[5] = l0[10] ^ l0[14] ^ l0[16] ^ l0[18];
+  l1[5] = l1[9] ^ l1[11] ^ l1[12] ^ l1[15] ^ l1[16] ^ l1[19];
+  l2[5] = l2[10] ^ l2[12] ^ l2[13] ^ l2[17] ^ l2[20] ^ l2[21];
+  l3[5] = l3[10] ^ l3[16] ^ l3[20] ^ l3[22];
+  K[1][13] = D;
+
+  /* Round 51 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[8] ^ l1[9] ^ l2[10] ^ l3[10];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[12]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[13]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[14]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[16]);
+  D ^= l0[17] ^ l1[18] ^ l2[20] ^ l3[21];
+  l0[4] = l0[9] ^ l0[13] ^ l0[15] ^ l0[17];
+  l1[4] = l1[8] ^ l1[10] ^ l1[11] ^ l1[14] ^ l1[15] ^ l1[18];
+  l2[4] = l2[9] ^ l2[11] ^ l2[12] ^ l2[16] ^ l2[19] ^ l2[20];
+  l3[4] = l3[9] ^ l3[15] ^ l3[19] ^ l3[21];
+  K[1][13] = D;
+
+  /* Round 52 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[7] ^ l1[8] ^ l2[9] ^ l3[9];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[11]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[12]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[13]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[15]);
+  D ^= l0[16] ^ l1[17] ^ l2[19] ^ l3[20];
+  l0[3] = l0[8] ^ l0[12] ^ l0[14] ^ l0[16];
+  l1[3] = l1[7] ^ l1[9] ^ l1[10] ^ l1[13] ^ l1[14] ^ l1[17];
+  l2[3] = l2[8] ^ l2[10] ^ l2[11] ^ l2[15] ^ l2[18] ^ l2[19];
+  l3[3] = l3[8] ^ l3[14] ^ l3[18] ^ l3[20];
+  K[1][13] = D;
+
+  /* Round 53 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[6] ^ l1[7] ^ l2[8] ^ l3[8];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[10]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[11]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[12]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[14]);
+  D ^= l0[15] ^ l1[16] ^ l2[18] ^ l3[19];
+  l0[2] = l0[7] ^ l0[11] ^ l0[13] ^ l0[15];
+  l1[2] = l1[6] ^ l1[8] ^ l1[9] ^ l1[12] ^ l1[13] ^ l1[16];
+  l2[2] = l2[7] ^ l2[9] ^ l2[10] ^ l2[14] ^ l2[17] ^ l2[18];
+  l3[2] = l3[7] ^ l3[13] ^ l3[17] ^ l3[19];
+  K[1][13] = D;
+
+  /* Round 54 */
+  BS_SBoxB(B[0], Bspare);
+  BS_DiffuseNetworkB(B[2], B[1], B[0], K[1]);
+  BS_SBoxK(K[0], Kspare);
+  BS_DiffuseNetworkK(K[2], K[1], K[0]);
+  D = l0[5] ^ l1[6] ^ l2[7] ^ l3[7];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[9]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[10]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[11]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[13]);
+  D ^= l0[14] ^ l1[15] ^ l2[17] ^ l3[18];
+  l0[1] = l0[6] ^ l0[10] ^ l0[12] ^ l0[14];
+  l1[1] = l1[5] ^ l1[7] ^ l1[8] ^ l1[11] ^ l1[12] ^ l1[15];
+  l2[1] = l2[6] ^ l2[8] ^ l2[9] ^ l2[13] ^ l2[16] ^ l2[17];
+  l3[1] = l3[6] ^ l3[12] ^ l3[16] ^ l3[18];
+  K[1][13] = D;
+
+  /* Round 55 */
+  BS_SBoxB(B[0], B[2]);
+  BS_DiffuseNetworkB(Bspare, B[1], B[0], K[1]);
+  BS_SBoxK(K[0], K[2]);
+  BS_DiffuseNetworkK(Kspare, K[1], K[0]);
+  D = l0[4] ^ l1[5] ^ l2[6] ^ l3[6];
+  D = BS_ShuffleNetwork(&snA[0], &snB[0], D, l0[8]);
+  D = BS_ShuffleNetwork(&snA[1], &snB[1], D, l1[9]);
+  D = BS_ShuffleNetwork(&snA[2], &snB[2], D, l2[10]);
+  D = BS_ShuffleNetwork(&snA[3], &snB[3], D, l3[12]);
+  D ^= l0[13] ^ l1[14] ^ l2[16] ^ l3[17];
+  l0[0] = l0[5] ^ l0[9] ^ l0[11] ^ l0[13];
+  l1[0] = l1[4] ^ l1[6] ^ l1[7] ^ l1[10] ^ l1[11] ^ l1[14];
+  l2[0] = l2[5] ^ l2[7] ^ l2[8] ^ l2[12] ^ l2[15] ^ l2[16];
+  l3[0] = l3[5] ^ l3[11] ^ l3[15] ^ l3[17];
+  K[1][13] = D;
+
+  memcpy(m->lfsrs[0].state, l0, 13 * sizeof(bsvec_t));
+  m->lfsrs[0].zero = 0;
+  memcpy(m->lfsrs[1].state, l1, 14 * sizeof(bsvec_t));
+  m->lfsrs[1].zero = 0;
+  memcpy(m->lfsrs[2].state, l2, 16 * sizeof(bsvec_t));
+  m->lfsrs[2].zero = 0;
+  memcpy(m->lfsrs[3].state, l3, 17 * sizeof(bsvec_t));
+  m->lfsrs[3].zero = 0;
+  memcpy(m->snA, snA, sizeof(snA));
+  memcpy(m->snB, snB, sizeof(snB));
+}
+
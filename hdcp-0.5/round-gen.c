@@ -0,0 +1,135 @@
+/************************************************************
+ * Generate straight-line kernels for k consecutive HDCP rounds.
+ *
+ * BS_HDCPRound spends much of its time on bookkeeping: the LFSRs are
+ * indexed modulo their length, and the round functions memcpy their
+ * new z registers into place.  The kernels generated here do the same
+ * work as k calls to BS_HDCPRound, but
+ * - each LFSR is copied into a window of len + k slices on entry, so
+ *   that clocking it is just a matter of writing the new bit one slot
+ *   lower, and every tap and feedback is a constant index;
+ * - the new z registers are written into a spare register, and the
+ *   spare and the z register swap roles from one round to the next.
+ * On exit the LFSRs are stored back with zero = 0.
+ *
+ * Usage: round-gen [k...] [rk...]
+ *   k   generate BS_HDCPRounds<k>, which outputs k rounds of output
+ *   rk  generate BS_HDCPRekeyRounds<k>, which runs k rounds in rekey
+ *       mode (no output, K[1][13] replaced by the LFSR output)
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Must match BS_LFSRModule_init in hdcp_cipher.c */
+static const struct {
+  int taps[3];
+  int feedbacks[6];
+  int len;
+} lfsrs[4] = {
+  { { 3, 7, 12}, { 4, 8, 10, 12, -1 },    13 },
+  { { 4, 8, 13}, { 3, 5, 6, 9, 10, 13},   14 },
+  { { 5, 9, 15}, { 4, 6, 7, 11, 14, 15},  16 },
+  { { 5, 11, 16}, { 4, 10, 14, 16, -1},   17 },
+};
+
+/* Slice j of LFSR i before round r of a k-round kernel */
+static int bit(int k, int r, int j)
+{
+  return k - r + j;
+}
+
+void Rounds_print(int k, int rekey)
+{
+  int i, j, r, zspare;
+
+  if (rekey)
+    printf("/* Auto-generated by %s: %d rounds of HDCPRekeycipher */\n"
+           "static void BS_HDCPRekeyRounds%d(BS_HDCPCipherState *hs)\n",
+           __func__, k, k);
+  else
+    printf("/* Auto-generated by %s: %d rounds of BS_HDCPStreamCipher */\n"
+           "static void BS_HDCPRounds%d(BS_HDCPCipherState *hs, bsvec_t output[%d][24])\n",
+           __func__, k, k, k);
+  printf("{\n"
+         "  BS_LFSRModule *m = &hs->lm;\n"
+         "  bsvec_t (*K)[28] = hs->bm.K, (*B)[28] = hs->bm.B;\n"
+         "  bsvec_t Kspare[28], Bspare[28], snA[4], snB[4], D;\n"
+         "  bsvec_t l0[%d], l1[%d], l2[%d], l3[%d];\n"
+         "  int i;\n"
+         "\n",
+         lfsrs[0].len + k, lfsrs[1].len + k, lfsrs[2].len + k, lfsrs[3].len + k);
+
+  for (i = 0; i < 4; i++)
+    printf("  for (i = 0; i < %d; i++)\n"
+           "    l%d[%d + i] = BS_LFSRBit(&m->lfsrs[%d], i);\n",
+           lfsrs[i].len, i, k, i);
+  printf("  memcpy(snA, m->snA, sizeof(snA));\n"
+         "  memcpy(snB, m->snB, sizeof(snB));\n");
+
+  /* zspare: whether the z registers currently live in the spares */
+  zspare = 0;
+  for (r = 0; r < k; r++) {
+    const char *Kz = zspare ? "Kspare" : "K[2]", *Knew = zspare ? "K[2]" : "Kspare";
+    const char *Bz = zspare ? "Bspare" : "B[2]", *Bnew = zspare ? "B[2]" : "Bspare";
+
+    printf("\n  /* Round %d */\n", r);
+    if (!rekey)
+      printf("  BS_OutputFunction(%s, B[1], %s, K[1], output[%d]);\n", Bz, Kz, r);
+    printf("  BS_SBoxB(B[0], %s);\n"
+           "  BS_DiffuseNetworkB(%s, B[1], B[0], K[1]);\n"
+           "  BS_SBoxK(K[0], %s);\n"
+           "  BS_DiffuseNetworkK(%s, K[1], K[0]);\n",
+           Bnew, Bz, Knew, Kz);
+    zspare = !zspare;
+
+    printf("  D = ");
+    for (i = 0; i < 4; i++)
+      printf("%sl%d[%d]", i ? " ^ " : "", i, bit(k, r, lfsrs[i].taps[0]));
+    printf(";\n");
+    for (i = 0; i < 4; i++)
+      printf("  D = BS_ShuffleNetwork(&snA[%d], &snB[%d], D, l%d[%d]);\n",
+             i, i, i, bit(k, r, lfsrs[i].taps[1]));
+    printf("  D ^= ");
+    for (i = 0; i < 4; i++)
+      printf("%sl%d[%d]", i ? " ^ " : "", i, bit(k, r, lfsrs[i].taps[2]));
+    printf(";\n");
+    for (i = 0; i < 4; i++) {
+      printf("  l%d[%d] = ", i, bit(k, r, -1));
+      for (j = 0; j < 6 && lfsrs[i].feedbacks[j] >= 0; j++)
+        printf("%sl%d[%d]", j ? " ^ " : "", i, bit(k, r, lfsrs[i].feedbacks[j]));
+      printf(";\n");
+    }
+    if (rekey)
+      printf("  K[1][13] = D;\n");
+  }
+
+  printf("\n");
+  if (zspare)
+    printf("  memcpy(K[2], Kspare, sizeof(Kspare));\n"
+           "  memcpy(B[2], Bspare, sizeof(Bspare));\n");
+  for (i = 0; i < 4; i++)
+    printf("  memcpy(m->lfsrs[%d].state, l%d, %d * sizeof(bsvec_t));\n"
+           "  m->lfsrs[%d].zero = 0;\n",
+           i, i, lfsrs[i].len, i);
+  printf("  memcpy(m->snA, snA, sizeof(snA));\n"
+         "  memcpy(m->snB, snB, sizeof(snB));\n"
+         "}\n\n");
+}
+
+int main(int argc, char **argv)
+{
+  int i;
+
+  for (i = 1; i < argc; i++) {
+    if (argv[i][0] == 'r')
+      Rounds_print(atoi(argv[i] + 1), 1);
+    else
+      Rounds_print(atoi(argv[i]), 0);
+  }
+
+  return 0;
+}
@@ -0,0 +1,552 @@
+#if BSVEC_BITS == 512 && defined(__AVX512F__)
+#include <immintrin.h>
+#define BS_SBOX_TERNLOG
+#define BS_TERNLOG(a, b, c, imm) \
+  ((bsvec_t)_mm512_ternarylogic_epi64((__m512i)(a), (__m512i)(b), (__m512i)(c), (imm)))
+#endif
+
+/* Auto-generated by SBox_gates_print: 124 gates */
+static inline void BS_SBoxB_gates(const bsvec_t input[28], bsvec_t output[28])
+{
+  bsvec_t A, B, C, D, t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14, t15, t16, t17, t18;
+
+  D = input[0]; C = input[7]; B = input[14]; A = input[21];
+  t0 = B ^ A;
+  t1 = D | C;
+  t2 = B ^ t1;
+  t3 = t0 & t2;
+  t4 = C ^ t3;
+  t5 = D ^ t4;
+  t6 = B & ~C;
+  t7 = t0 | t6;
+  t8 = t1 ^ t7;
+  t9 = ~t8;
+  t10 = A ^ t5;
+  t11 = t4 ^ t6;
+  t12 = t10 & t11;
+  t13 = t7 ^ t12;
+  t14 = t2 & t8;
+  t15 = t10 & ~t14;
+  t16 = C ^ t15;
+  t17 = ~t16;
+  output[0] = t5;
+  output[7] = t13;
+  output[14] = t9;
+  output[21] = t17;
+
+  D = input[1]; C = input[8]; B = input[15]; A = input[22];
+  t0 = B & ~A;
+  t1 = D & ~t0;
+  t2 = A & ~B;
+  t3 = C | t2;
+  t4 = t1 ^ t3;
+  t5 = D ^ t4;
+  t6 = A ^ t1;
+  t7 = t5 & ~t6;
+  t8 = B ^ t7;
+  t9 = D & t7;
+  t10 = C & ~B;
+  t11 = t9 ^ t10;
+  t12 = t6 ^ t11;
+  t13 = ~t12;
+  t14 = D & t8;
+  t15 = t13 ^ t14;
+  t16 = t3 ^ t15;
+  t17 = B ^ t16;
+  output[1] = t13;
+  output[8] = t17;
+  output[15] = t8;
+  output[22] = t4;
+
+  D = input[2]; C = input[9]; B = input[16]; A = input[23];
+  t0 = A & ~D;
+  t1 = C & ~t0;
+  t2 = D & ~A;
+  t3 = B & ~t2;
+  t4 = t1 ^ t3;
+  t5 = ~t4;
+  t6 = t5 & ~D;
+  t7 = C | t6;
+  t8 = t7 & ~t2;
+  t9 = A ^ t8;
+  t10 = B ^ t9;
+  t11 = A | t10;
+  t12 = t11 & ~t6;
+  t13 = t0 ^ t12;
+  t14 = C ^ t13;
+  t15 = t4 & ~t14;
+  t16 = t10 | t15;
+  t17 = t16 & ~t2;
+  t18 = C ^ t17;
+  output[2] = t10;
+  output[9] = t18;
+  output[16] = t5;
+  output[23] = t14;
+
+  D = input[3]; C = input[10]; B = input[17]; A = input[24];
+  t0 = D & C;
+  t1 = B & ~t0;
+  t2 = D | C;
+  t3 = A & t2;
+  t4 = t1 ^ t3;
+  t5 = C & ~A;
+  t6 = B | t5;
+  t7 = t2 & t6;
+  t8 = A ^ t7;
+  t9 = D ^ t8;
+  t10 = A & ~D;
+  t11 = B | t10;
+  t12 = t8 & t11;
+  t13 = C ^ t12;
+  t14 = ~t13;
+  t15 = t8 & ~t13;
+  t16 = t6 ^ t15;
+  t17 = D ^ t16;
+  t18 = ~t17;
+  output[3] = t9;
+  output[10] = t14;
+  output[17] = t18;
+  output[24] = t4;
+
+  D = input[4]; C = input[11]; B = input[18]; A = input[25];
+  t0 = D & B;
+  t1 = C & ~t0;
+  t2 = D | B;
+  t3 = A & t2;
+  t4 = t1 ^ t3;
+  t5 = D ^ t3;
+  t6 = A ^ t4;
+  t7 = t5 | t6;
+  t8 = B ^ t7;
+  t9 = A | t8;
+  t10 = t5 ^ t9;
+  t11 = C ^ t10;
+  t12 = ~t11;
+  t13 = B & t4;
+  t14 = t12 ^ t13;
+  t15 = t7 ^ t14;
+  t16 = t1 ^ t15;
+  output[4] = t16;
+  output[11] = t12;
+  output[18] = t8;
+  output[25] = t4;
+
+  D = input[5]; C = input[12]; B = input[19]; A = input[26];
+  t0 = C & ~D;
+  t1 = A ^ t0;
+  t2 = B & ~t1;
+  t3 = C ^ t2;
+  t4 = D ^ t3;
+  t5 = C & A;
+  t6 = B & ~t5;
+  t7 = t1 ^ t6;
+  t8 = ~t7;
+  t9 = C & ~t7;
+  t10 = t4 ^ t9;
+  t11 = B ^ t10;
+  t12 = ~t11;
+  t13 = t12 & ~t4;
+  t14 = t9 ^ t13;
+  t15 = t1 ^ t14;
+  t16 = D ^ t15;
+  output[5] = t12;
+  output[12] = t16;
+  output[19] = t4;
+  output[26] = t8;
+
+  D = input[6]; C = input[13]; B = input[20]; A = input[27];
+  t0 = D & B;
+  t1 = A ^ t0;
+  t2 = C & ~t1;
+  t3 = B ^ t2;
+  t4 = D ^ t3;
+  t5 = D & A;
+  t6 = C & ~t5;
+  t7 = t1 ^ t6;
+  t8 = D & t7;
+  t9 = t3 ^ t8;
+  t10 = C ^ t9;
+  t11 = ~t10;
+  t12 = t1 & ~C;
+  t13 = t10 & ~t4;
+  t14 = t12 | t13;
+  t15 = D ^ t14;
+  output[6] = t11;
+  output[13] = t4;
+  output[20] = t7;
+  output[27] = t15;
+}
+
+/* Auto-generated by SBox_gates_print: 122 gates */
+static inline void BS_SBoxK_gates(const bsvec_t input[28], bsvec_t output[28])
+{
+  bsvec_t A, B, C, D, t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14, t15, t16, t17, t18, t19;
+
+  D = input[0]; C = input[7]; B = input[14]; A = input[21];
+  t0 = D & ~C;
+  t1 = B | t0;
+  t2 = C & ~D;
+  t3 = A | t2;
+  t4 = t1 ^ t3;
+  t5 = D ^ t4;
+  t6 = t3 & t5;
+  t7 = B | t6;
+  t8 = A ^ t7;
+  t9 = C ^ t8;
+  t10 = D ^ t9;
+  t11 = t10 & ~t5;
+  t12 = B ^ t8;
+  t13 = t2 | t12;
+  t14 = t11 ^ t13;
+  t15 = t1 ^ t13;
+  t16 = t3 & ~t15;
+  t17 = t9 | t16;
+  t18 = C ^ t17;
+  t19 = ~t18;
+  output[0] = t5;
+  output[7] = t10;
+  output[14] = t14;
+  output[21] = t19;
+
+  D = input[1]; C = input[8]; B = input[15]; A = input[22];
+  t0 = A & ~D;
+  t1 = B ^ t0;
+  t2 = C & t1;
+  t3 = A ^ t2;
+  t4 = D ^ t3;
+  t5 = B & ~A;
+  t6 = C ^ t5;
+  t7 = t4 | t6;
+  t8 = t1 ^ t7;
+  t9 = D & C;
+  t10 = t4 & t6;
+  t11 = t9 | t10;
+  t12 = t1 ^ t11;
+  t13 = t10 ^ t12;
+  t14 = C ^ t13;
+  t15 = D ^ t14;
+  t16 = ~t15;
+  output[1] = t16;
+  output[8] = t4;
+  output[15] = t8;
+  output[22] = t12;
+
+  D = input[2]; C = input[9]; B = input[16]; A = input[23];
+  t0 = D & A;
+  t1 = C | t0;
+  t2 = D | A;
+  t3 = B & t2;
+  t4 = t1 ^ t3;
+  t5 = ~t4;
+  t6 = C ^ t5;
+  t7 = A ^ t1;
+  t8 = t6 & ~t7;
+  t9 = D ^ t8;
+  t10 = D | B;
+  t11 = C | t4;
+  t12 = t11 & ~t7;
+  t13 = t10 ^ t12;
+  t14 = C & ~t9;
+  t15 = t7 ^ t14;
+  t16 = B ^ t15;
+  t17 = ~t16;
+  output[2] = t5;
+  output[9] = t13;
+  output[16] = t9;
+  output[23] = t17;
+
+  D = input[3]; C = input[10]; B = input[17]; A = input[24];
+  t0 = D & ~A;
+  t1 = C ^ t0;
+  t2 = t1 & ~B;
+  t3 = A ^ t2;
+  t4 = D ^ t3;
+  t5 = A & t4;
+  t6 = B | t5;
+  t7 = t1 ^ t6;
+  t8 = B & ~C;
+  t9 = t5 ^ t8;
+  t10 = D ^ t9;
+  t11 = t3 & ~t0;
+  t12 = t9 | t11;
+  t13 = B ^ t12;
+  t14 = D ^ t13;
+  output[3] = t4;
+  output[10] = t14;
+  output[17] = t10;
+  output[24] = t7;
+
+  D = input[4]; C = input[11]; B = input[18]; A = input[25];
+  t0 = A & ~B;
+  t1 = D & ~t0;
+  t2 = B & ~A;
+  t3 = C | t2;
+  t4 = t1 ^ t3;
+  t5 = A & ~C;
+  t6 = D | t5;
+  t7 = t6 & ~t2;
+  t8 = B ^ t7;
+  t9 = C ^ t8;
+  t10 = D ^ t4;
+  t11 = A ^ t1;
+  t12 = t10 & t11;
+  t13 = B ^ t12;
+  t14 = ~t13;
+  t15 = B & t9;
+  t16 = t14 ^ t15;
+  t17 = t16 & ~t5;
+  t18 = D ^ t17;
+  output[4] = t4;
+  output[11] = t9;
+  output[18] = t14;
+  output[25] = t18;
+
+  D = input[5]; C = input[12]; B = input[19]; A = input[26];
+  t0 = A & ~C;
+  t1 = D ^ t0;
+  t2 = t1 & ~B;
+  t3 = A ^ t2;
+  t4 = C ^ t3;
+  t5 = B | t4;
+  t6 = t5 & ~A;
+  t7 = t1 ^ t6;
+  t8 = B ^ t7;
+  t9 = t6 | t8;
+  t10 = t4 ^ t9;
+  t11 = t0 | t10;
+  t12 = D ^ t11;
+  t13 = t11 & ~t7;
+  t14 = t3 ^ t13;
+  t15 = B ^ t14;
+  t16 = ~t15;
+  output[5] = t16;
+  output[12] = t8;
+  output[19] = t4;
+  output[26] = t12;
+
+  D = input[6]; C = input[13]; B = input[20]; A = input[27];
+  t0 = C | A;
+  t1 = D ^ t0;
+  t2 = t1 & ~B;
+  t3 = A ^ t2;
+  t4 = C ^ t3;
+  t5 = A & ~D;
+  t6 = B ^ t5;
+  t7 = t4 & t6;
+  t8 = t1 ^ t7;
+  t9 = t2 ^ t6;
+  t10 = t4 | t9;
+  t11 = t1 ^ t10;
+  t12 = ~t11;
+  t13 = t7 ^ t12;
+  t14 = t5 ^ t13;
+  t15 = t3 ^ t14;
+  output[6] = t4;
+  output[13] = t12;
+  output[20] = t8;
+  output[27] = t15;
+}
+
+#ifdef BS_SBOX_TERNLOG
+
+/* Auto-generated by SBox_ternlog_print */
+static inline void BS_SBoxB_ternlog(const bsvec_t input[28], bsvec_t output[28])
+{
+  bsvec_t in[4], h, t0, t1;
+
+  in[0] = input[0]; in[1] = input[7]; in[2] = input[14]; in[3] = input[21];
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x3e);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x68);
+  output[0] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x86);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0xe5);
+  output[7] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  h = BS_TERNLOG(in[1], in[2], in[3], 0x61);
+  output[14] = BS_TERNLOG(h, in[0], in[1], 0xb4);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x1b);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0xa6);
+  output[21] = BS_TERNLOG(in[3], t1, t0, 0xca);
+
+  in[0] = input[1]; in[1] = input[8]; in[2] = input[15]; in[3] = input[22];
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0xcb);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x64);
+  output[1] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x2d);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x63);
+  output[8] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x86);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x7a);
+  output[15] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x9c);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x2d);
+  output[22] = BS_TERNLOG(in[3], t1, t0, 0xca);
+
+  in[0] = input[2]; in[1] = input[9]; in[2] = input[16]; in[3] = input[23];
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0xa7);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x98);
+  output[2] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0xcb);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x16);
+  output[9] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x39);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x95);
+  output[16] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x6a);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x39);
+  output[23] = BS_TERNLOG(in[3], t1, t0, 0xca);
+
+  in[0] = input[3]; in[1] = input[10]; in[2] = input[17]; in[3] = input[24];
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x1c);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0xa7);
+  output[3] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x9b);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x34);
+  output[10] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x69);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0xb1);
+  output[17] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x2a);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0xd6);
+  output[24] = BS_TERNLOG(in[3], t1, t0, 0xca);
+
+  in[0] = input[4]; in[1] = input[11]; in[2] = input[18]; in[3] = input[25];
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x2d);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x63);
+  output[4] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x95);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0xc6);
+  output[11] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x56);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0xe1);
+  output[18] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x4c);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0xb6);
+  output[25] = BS_TERNLOG(in[3], t1, t0, 0xca);
+
+  in[0] = input[5]; in[1] = input[12]; in[2] = input[19]; in[3] = input[26];
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x83);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x6d);
+  output[5] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0xb5);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x46);
+  output[12] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  h = BS_TERNLOG(in[0], in[1], in[2], 0x34);
+  output[19] = BS_TERNLOG(h, in[3], in[2], 0xd2);
+  h = BS_TERNLOG(in[1], in[2], in[3], 0x16);
+  output[26] = BS_TERNLOG(h, in[0], in[1], 0x87);
+
+  in[0] = input[6]; in[1] = input[13]; in[2] = input[20]; in[3] = input[27];
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0xb5);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x49);
+  output[6] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  h = BS_TERNLOG(in[0], in[1], in[2], 0x16);
+  output[13] = BS_TERNLOG(h, in[3], in[1], 0x78);
+  h = BS_TERNLOG(in[3], in[0], in[1], 0x16);
+  output[20] = BS_TERNLOG(h, in[2], in[0], 0xd2);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x98);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0xc7);
+  output[27] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  /* 79 lookups */
+}
+
+/* Auto-generated by SBox_ternlog_print */
+static inline void BS_SBoxK_ternlog(const bsvec_t input[28], bsvec_t output[28])
+{
+  bsvec_t in[4], h, t0, t1;
+
+  in[0] = input[0]; in[1] = input[7]; in[2] = input[14]; in[3] = input[21];
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x46);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0xb5);
+  output[0] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x92);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x7c);
+  output[7] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x9c);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0xa6);
+  output[14] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x59);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x9c);
+  output[21] = BS_TERNLOG(in[3], t1, t0, 0xca);
+
+  in[0] = input[1]; in[1] = input[8]; in[2] = input[15]; in[3] = input[22];
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0xe9);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x26);
+  output[1] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  h = BS_TERNLOG(in[3], in[0], in[1], 0x1c);
+  output[8] = BS_TERNLOG(h, in[2], in[1], 0x78);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0xd4);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x6a);
+  output[15] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x4a);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x6d);
+  output[22] = BS_TERNLOG(in[3], t1, t0, 0xca);
+
+  in[0] = input[2]; in[1] = input[9]; in[2] = input[16]; in[3] = input[23];
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x93);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0xa9);
+  output[2] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0xda);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x26);
+  output[9] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0xe3);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x94);
+  output[16] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x95);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x1e);
+  output[23] = BS_TERNLOG(in[3], t1, t0, 0xca);
+
+  in[0] = input[3]; in[1] = input[10]; in[2] = input[17]; in[3] = input[24];
+  h = BS_TERNLOG(in[2], in[3], in[0], 0x64);
+  output[3] = BS_TERNLOG(h, in[1], in[2], 0xb4);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x7c);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0xa1);
+  output[10] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  h = BS_TERNLOG(in[1], in[2], in[3], 0x2c);
+  output[17] = BS_TERNLOG(h, in[0], in[3], 0x1e);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x96);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x27);
+  output[24] = BS_TERNLOG(in[3], t1, t0, 0xca);
+
+  in[0] = input[4]; in[1] = input[11]; in[2] = input[18]; in[3] = input[25];
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x1e);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x6c);
+  output[4] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x36);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x95);
+  output[11] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0xb5);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x49);
+  output[18] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x67);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x38);
+  output[25] = BS_TERNLOG(in[3], t1, t0, 0xca);
+
+  in[0] = input[5]; in[1] = input[12]; in[2] = input[19]; in[3] = input[26];
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x25);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0xd3);
+  output[5] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0xe4);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x69);
+  output[12] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  h = BS_TERNLOG(in[1], in[2], in[3], 0x58);
+  output[19] = BS_TERNLOG(h, in[0], in[2], 0xb4);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x92);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0xcb);
+  output[26] = BS_TERNLOG(in[3], t1, t0, 0xca);
+
+  in[0] = input[6]; in[1] = input[13]; in[2] = input[20]; in[3] = input[27];
+  h = BS_TERNLOG(in[1], in[2], in[3], 0x5b);
+  output[6] = BS_TERNLOG(h, in[0], in[2], 0xe1);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x3d);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x46);
+  output[13] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0xb4);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x2b);
+  output[20] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  t0 = BS_TERNLOG(in[0], in[1], in[2], 0xa1);
+  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x97);
+  output[27] = BS_TERNLOG(in[3], t1, t0, 0xca);
+  /* 79 lookups */
+}
+
+#endif /* BS_SBOX_TERNLOG */
@@ -0,0 +1,394 @@
+/************************************************************
+ * Search for small bit-sliced circuits for the 14 HDCP S-boxes.
+ *
+ * BS_SBoxB_ and BS_SBoxK_ in hdcp_cipher.c evaluate each output bit
+ * as a sum of products.  This program finds circuits that compute all
+ * four outputs of an S-box together, sharing gates between them, and
+ * emits them as BS_SBoxB_gates/BS_SBoxK_gates.  For AVX-512 builds it
+ * also emits BS_SBoxB_ternlog/BS_SBoxK_ternlog, where every output is
+ * one to three 3-input lookups (vpternlogq).
+ *
+ * The gates are AND, OR, XOR, AND-NOT and NOT.  The search finds the
+ * smallest formula for every function of the 4 inputs (treating the
+ * signals already in the circuit as free), and adds the outputs to
+ * the circuit one at a time, cheapest first, reusing every function
+ * it already computes.  Every circuit is checked against the truth
+ * table before it is printed, and hdcp -t checks the compiled
+ * functions against BS_SBoxB_/BS_SBoxK_ for all inputs.
+ *
+ * This software is released under the FreeBSD license.
+ * Copyright Rob Johnson and Mikhail Rubnich.
+ ************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+/* S-box i maps (A B C D) = bits 3..0 of v, where D = input[i],
+   C = input[i+7], B = input[i+14] and A = input[i+21], to S[i][v],
+   whose bit j is output[i + 7*j].  These are the tables computed by
+   BS_SBoxB_ and BS_SBoxK_. */
+static const unsigned char SBoxB[7][16] = {
+  {12,  9,  3,  0, 11,  5, 13,  6,  2,  4, 14,  7,  8, 15,  1, 10},
+  { 3,  8, 14,  1,  5,  2, 11, 13, 10,  4,  9,  7,  6, 15, 12,  0},
+  { 7,  4,  1, 10, 11, 13, 14,  3, 12, 15,  6,  0,  2,  8,  9,  5},
+  { 6,  3,  1,  4, 10, 12, 15,  2,  5, 14, 11,  8,  9,  7,  0, 13},
+  { 3,  6, 15, 12,  4,  1,  9,  2,  5,  8, 10,  7, 11, 13,  0, 14},
+  {11, 14,  6,  8,  5,  2, 12,  7,  1,  4, 15,  3, 10, 13,  9,  0},
+  { 1, 11,  7,  4,  2,  5, 12,  9, 13,  6,  8, 15, 14,  0,  3, 10}
+};
+
+static const unsigned char SBoxK[7][16] = {
+  { 8, 14,  5,  9,  3,  0, 12,  6,  1, 11, 15,  2,  4,  7, 10, 13},
+  { 1,  6,  4, 15,  8,  3, 11,  5, 10,  0,  9, 12,  7, 13, 14,  2},
+  {13, 11,  8,  6,  7,  4,  2, 15,  1, 12, 14,  0, 10,  3,  9,  5},
+  { 0, 14, 11,  7, 12,  3,  2, 13, 15,  4,  8,  1,  9, 10,  5,  6},
+  {12,  7, 15,  8, 11, 14,  1,  4,  6, 10,  3,  5,  0,  9, 13,  2},
+  { 1, 12,  7,  2,  8,  3,  4, 14, 11,  5,  0, 15, 13,  6, 10,  9},
+  {10,  7,  6,  1,  0, 14,  3, 13, 12,  9, 11,  2, 15,  5,  4,  8}
+};
+
+/* Truth tables of D, C, B and A over the 16 input values */
+static const uint16_t inputs[4] = { 0xaaaa, 0xcccc, 0xf0f0, 0xff00 };
+static const char *input_names[4] = { "D", "C", "B", "A" };
+
+enum { OP_AND, OP_OR, OP_XOR, OP_ANDN, OP_NOT, NOPS };
+static const char *op_fmt[NOPS] = { "%s & %s", "%s | %s", "%s ^ %s", "%s & ~%s", "~%s" };
+
+#define MAXGATES 40
+#define NSIG (4 + MAXGATES)
+
+typedef struct {
+  int ngates;
+  int op[MAXGATES], a[MAXGATES], b[MAXGATES];
+  uint16_t tt[NSIG];
+  int out[4];   /* signal computing each output */
+} Circuit;
+
+static uint16_t apply(int op, uint16_t a, uint16_t b)
+{
+  switch (op) {
+  case OP_AND:  return a & b;
+  case OP_OR:   return a | b;
+  case OP_XOR:  return a ^ b;
+  case OP_ANDN: return a & ~b;
+  default:      return ~a;
+  }
+}
+
+static int find(const Circuit *c, uint16_t tt)
+{
+  int i;
+
+  for (i = 0; i < 4 + c->ngates; i++)
+    if (c->tt[i] == tt)
+      return i;
+  return -1;
+}
+
+static void add_gate(Circuit *c, int op, int a, int b)
+{
+  int n = 4 + c->ngates;
+
+  c->op[c->ngates] = op;
+  c->a[c->ngates] = a;
+  c->b[c->ngates] = b;
+  c->tt[n] = apply(op, c->tt[a], c->tt[b]);
+  c->ngates++;
+}
+
+static void check(int ok, const char *what, int i)
+{
+  if (!ok) {
+    fprintf(stderr, "sbox-gen: %s for S-box %d is wrong\n", what, i);
+    exit(1);
+  }
+}
+
+/* The search state: for every function of the 4 inputs, the size of
+   the smallest formula found for it on top of the signals already in
+   the circuit, and the last gate of that formula.  level[l] lists the
+   functions of size l. */
+#define MAXLEVEL 16
+#define UNSEEN 255
+
+static unsigned char cost[65536], how_op[65536];
+static uint16_t how_a[65536], how_b[65536];
+static uint16_t level[MAXLEVEL][65536];
+static int nlevel[MAXLEVEL];
+
+static void note(int l, uint16_t tt, int op, uint16_t a, uint16_t b)
+{
+  if (cost[tt] == UNSEEN) {
+    cost[tt] = l;
+    how_op[tt] = op;
+    how_a[tt] = a;
+    how_b[tt] = b;
+    level[l][nlevel[l]++] = tt;
+  }
+}
+
+/* Build all formulas of 1, 2, ... gates over the signals of c until
+   every target not yet computed shows up. */
+static void formulas(const Circuit *c, const uint16_t target[4], const int done[4])
+{
+  int l, a, i, j, t, missing;
+
+  memset(cost, UNSEEN, sizeof(cost));
+  nlevel[0] = 0;
+  for (i = 0; i < 4 + c->ngates; i++)
+    note(0, c->tt[i], OP_NOT, 0, 0);
+
+  for (l = 1; l < MAXLEVEL; l++) {
+    for (t = missing = 0; t < 4; t++)
+      missing |= !done[t] && cost[target[t]] == UNSEEN;
+    if (!missing)
+      return;
+
+    nlevel[l] = 0;
+    for (i = 0; i < nlevel[l-1]; i++)
+      note(l, ~level[l-1][i], OP_NOT, level[l-1][i], 0);
+    for (a = 0; a <= (l-1) / 2; a++) {
+      int b = l-1 - a;
+
+      for (i = 0; i < nlevel[a]; i++)
+        for (j = a == b ? i + 1 : 0; j < nlevel[b]; j++) {
+          uint16_t x = level[a][i], y = level[b][j];
+
+          note(l, x & y, OP_AND, x, y);
+          note(l, x | y, OP_OR, x, y);
+          note(l, x ^ y, OP_XOR, x, y);
+          note(l, x & ~y, OP_ANDN, x, y);
+          note(l, y & ~x, OP_ANDN, y, x);
+        }
+    }
+  }
+  check(0, "search", -1);
+}
+
+/* Add the gates of the formula found for tt to c, reusing any
+   function c already computes.  Returns the signal computing tt. */
+static int build(Circuit *c, uint16_t tt)
+{
+  int op = how_op[tt], a, b;
+
+  if ((a = find(c, tt)) >= 0)
+    return a;
+  a = build(c, how_a[tt]);
+  b = op == OP_NOT ? a : build(c, how_b[tt]);
+  check(c->ngates < MAXGATES, "gate circuit", -1);
+  add_gate(c, op, a, b);
+  return 4 + c->ngates - 1;
+}
+
+/* Add the outputs to the circuit one at a time, always picking the
+   one with the smallest formula on top of the gates already there. */
+static void search(const unsigned char sbox[16], Circuit *c)
+{
+  uint16_t target[4] = { 0 };
+  int done[4] = { 0 };
+  int v, j, n, best;
+
+  for (v = 0; v < 16; v++)
+    for (j = 0; j < 4; j++)
+      if ((sbox[v] >> j) & 1)
+        target[j] |= 1 << v;
+
+  memset(c, 0, sizeof(*c));
+  memcpy(c->tt, inputs, sizeof(inputs));
+  for (n = 0; n < 4; n++) {
+    formulas(c, target, done);
+    for (best = -1, j = 0; j < 4; j++)
+      if (!done[j] && (best < 0 || cost[target[j]] < cost[target[best]]))
+        best = j;
+    c->out[best] = build(c, target[best]);
+    done[best] = 1;
+  }
+
+  for (j = 0; j < 4; j++)
+    check(c->tt[c->out[j]] == target[j], "gate circuit", j);
+}
+
+static void signal_name(char buf[16], int s)
+{
+  if (s < 4)
+    strcpy(buf, input_names[s]);
+  else
+    sprintf(buf, "t%d", s - 4);
+}
+
+void SBox_gates_print(const char *name, const unsigned char sboxes[7][16])
+{
+  Circuit c[7];
+  int i, g, j, total = 0, maxgates = 0;
+  char a[16], b[16];
+
+  for (i = 0; i < 7; i++) {
+    search(sboxes[i], &c[i]);
+    total += c[i].ngates;
+    if (c[i].ngates > maxgates)
+      maxgates = c[i].ngates;
+  }
+
+  printf("/* Auto-generated by %s: %d gates */\n"
+         "static inline void BS_%s_gates(const bsvec_t input[28], bsvec_t output[28])\n"
+         "{\n"
+         "  bsvec_t A, B, C, D",
+         __func__, total, name);
+  for (g = 0; g < maxgates; g++)
+    printf(", t%d", g);
+  printf(";\n");
+
+  for (i = 0; i < 7; i++) {
+    printf("\n  D = input[%d]; C = input[%d]; B = input[%d]; A = input[%d];\n",
+           i, i + 7, i + 14, i + 21);
+    for (g = 0; g < c[i].ngates; g++) {
+      signal_name(a, c[i].a[g]);
+      signal_name(b, c[i].b[g]);
+      printf("  t%d = ", g);
+      printf(op_fmt[c[i].op[g]], a, b);
+      printf(";\n");
+    }
+    for (j = 0; j < 4; j++) {
+      signal_name(a, c[i].out[j]);
+      printf("  output[%d] = %s;\n", i + 7*j, a);
+    }
+  }
+  printf("}\n");
+}
+
+/* The truth table of vpternlog(imm) applied to a, b and c */
+static uint16_t ternlog(uint16_t a, uint16_t b, uint16_t c, int imm)
+{
+  uint16_t r = 0;
+  int k;
+
+  for (k = 0; k < 8; k++)
+    if ((imm >> k) & 1)
+      r |= (k & 4 ? a : ~a) & (k & 2 ? b : ~b) & (k & 1 ? c : ~c);
+  return r;
+}
+
+/* The imm for which vpternlog(imm) on a, b and c gives tt, or -1 if
+   tt isn't a function of a, b and c */
+static int ternlog_imm(uint16_t a, uint16_t b, uint16_t c, uint16_t tt)
+{
+  int imm = 0, seen = 0, v, k;
+
+  for (v = 0; v < 16; v++) {
+    k = ((a >> v) & 1) << 2 | ((b >> v) & 1) << 1 | ((c >> v) & 1);
+    if (seen & (1 << k)) {
+      if (((imm >> k) & 1) != ((tt >> v) & 1))
+        return -1;
+    } else {
+      seen |= 1 << k;
+      imm |= ((tt >> v) & 1) << k;
+    }
+  }
+  return imm;
+}
+
+/* Each output is the cheapest of
+   - one lookup on 3 of the inputs, if it only depends on those,
+   - h = lookup(3 inputs), output = lookup(h, the 4th input, another input),
+   - t0, t1 = lookups of 3 inputs for the 4th = 0, 1, output = mux. */
+void SBox_ternlog_print(const char *name, const unsigned char sboxes[7][16])
+{
+  int i, j, total = 0;
+
+  printf("/* Auto-generated by %s */\n"
+         "static inline void BS_%s_ternlog(const bsvec_t input[28], bsvec_t output[28])\n"
+         "{\n"
+         "  bsvec_t in[4], h, t0, t1;\n",
+         __func__, name);
+
+  for (i = 0; i < 7; i++) {
+    printf("\n  in[0] = input[%d]; in[1] = input[%d]; in[2] = input[%d]; in[3] = input[%d];\n",
+           i, i + 7, i + 14, i + 21);
+    for (j = 0; j < 4; j++) {
+      uint16_t tt = 0;
+      int v, w, x, y, z, u, imm, imm2, done = 0;
+
+      for (v = 0; v < 16; v++)
+        if ((sboxes[i][v] >> j) & 1)
+          tt |= 1 << v;
+
+      /* w is the input left out of the first lookup */
+      for (w = 3; w >= 0 && !done; w--) {
+        x = (w + 1) % 4; y = (w + 2) % 4; z = (w + 3) % 4;
+        if ((imm = ternlog_imm(inputs[x], inputs[y], inputs[z], tt)) >= 0) {
+          check(ternlog(inputs[x], inputs[y], inputs[z], imm) == tt, "ternlog circuit", i);
+          printf("  output[%d] = BS_TERNLOG(in[%d], in[%d], in[%d], 0x%02x);\n",
+                 i + 7*j, x, y, z, imm);
+          total += 1;
+          done = 1;
+        }
+      }
+      for (w = 3; w >= 0 && !done; w--) {
+        x = (w + 1) % 4; y = (w + 2) % 4; z = (w + 3) % 4;
+        for (imm = 0; imm < 256 && !done; imm++) {
+          uint16_t htt = ternlog(inputs[x], inputs[y], inputs[z], imm);
+
+          for (u = 1; u < 4 && !done; u++) {
+            int other = (w + u) % 4;
+
+            if ((imm2 = ternlog_imm(htt, inputs[w], inputs[other], tt)) >= 0) {
+              check(ternlog(htt, inputs[w], inputs[other], imm2) == tt, "ternlog circuit", i);
+              printf("  h = BS_TERNLOG(in[%d], in[%d], in[%d], 0x%02x);\n"
+                     "  output[%d] = BS_TERNLOG(h, in[%d], in[%d], 0x%02x);\n",
+                     x, y, z, imm, i + 7*j, w, other, imm2);
+              total += 2;
+              done = 1;
+            }
+          }
+        }
+      }
+      if (!done) {
+        /* Split on A */
+        uint16_t t0 = 0, t1 = 0;
+        int imm0, imm1;
+
+        for (v = 0; v < 16; v++) {
+          t0 |= ((tt >> (v & 7)) & 1) << v;
+          t1 |= ((tt >> (v | 8)) & 1) << v;
+        }
+        imm0 = ternlog_imm(inputs[0], inputs[1], inputs[2], t0);
+        imm1 = ternlog_imm(inputs[0], inputs[1], inputs[2], t1);
+        check(imm0 >= 0 && imm1 >= 0 &&
+              ternlog(inputs[3], ternlog(inputs[0], inputs[1], inputs[2], imm1),
+                      ternlog(inputs[0], inputs[1], inputs[2], imm0), 0xca) == tt,
+              "ternlog circuit", i);
+        printf("  t0 = BS_TERNLOG(in[0], in[1], in[2], 0x%02x);\n"
+               "  t1 = BS_TERNLOG(in[0], in[1], in[2], 0x%02x);\n"
+               "  output[%d] = BS_TERNLOG(in[3], t1, t0, 0xca);\n",
+               imm0, imm1, i + 7*j);
+        total += 3;
+      }
+    }
+  }
+  printf("  /* %d lookups */\n"
+         "}\n", total);
+}
+
+int main(void)
+{
+  printf("#if BSVEC_BITS == 512 && defined(__AVX512F__)\n"
+         "#include <immintrin.h>\n"
+         "#define BS_SBOX_TERNLOG\n"
+         "#define BS_TERNLOG(a, b, c, imm) \\\n"
+         "  ((bsvec_t)_mm512_ternarylogic_epi64((__m512i)(a), (__m512i)(b), (__m512i)(c), (imm)))\n"
+         "#endif\n\n");
+
+  SBox_gates_print("SBoxB", SBoxB);
+  printf("\n");
+  SBox_gates_print("SBoxK", SBoxK);
+
+  printf("\n#ifdef BS_SBOX_TERNLOG\n\n");
+  SBox_ternlog_print("SBoxB", SBoxB);
+  printf("\n");
+  SBox_ternlog_print("SBoxK", SBoxK);
+  printf("\n#endif /* BS_SBOX_TERNLOG */\n");
+
+  return 0;
+}